@@ -0,0 +1,540 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/** The settings that every benchmark is run with. */
+struct BenchmarkSettings
+{
+    Array<int> blockSizes { 64, 256, 1024 };
+    Array<int> channelCounts { 1, 2, 8 };
+    double sampleRate = 48000.0;
+    double minimumSecondsPerCase = 0.25;
+    int minimumBlocksPerCase = 16;
+    String filter;
+};
+
+/** One configuration of a benchmark. The setup function is called before timing
+    starts, and returns the function that processes a single block.
+*/
+struct BenchmarkCase
+{
+    String name, variant;
+    int blockSize, numChannels;
+    std::function<std::function<void()>()> setup;
+};
+
+//==============================================================================
+static AudioBuffer<float> createNoise (int numChannels, int numSamples, Random& random)
+{
+    AudioBuffer<float> buffer (numChannels, numSamples);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        for (int i = 0; i < numSamples; ++i)
+            buffer.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+    return buffer;
+}
+
+//==============================================================================
+struct SineSound  : public SynthesiserSound
+{
+    bool appliesToNote (int) override     { return true; }
+    bool appliesToChannel (int) override  { return true; }
+};
+
+struct SineVoice  : public SynthesiserVoice
+{
+    bool canPlaySound (SynthesiserSound*) override  { return true; }
+
+    void startNote (int midiNoteNumber, float velocity, SynthesiserSound*, int) override
+    {
+        phase = 0.0;
+        level = velocity * 0.1;
+        phaseDelta = MathConstants<double>::twoPi * MidiMessage::getMidiNoteInHertz (midiNoteNumber) / getSampleRate();
+    }
+
+    void stopNote (float, bool) override    { clearCurrentNote(); }
+    void pitchWheelMoved (int) override     {}
+    void controllerMoved (int, int) override {}
+
+    void renderNextBlock (AudioBuffer<float>& output, int startSample, int numSamples) override
+    {
+        for (int i = startSample; i < startSample + numSamples; ++i)
+        {
+            const auto sample = (float) (std::sin (phase) * level);
+            phase += phaseDelta;
+
+            for (int ch = output.getNumChannels(); --ch >= 0;)
+                output.addSample (ch, i, sample);
+        }
+    }
+
+    using SynthesiserVoice::renderNextBlock;
+
+    double phase = 0, phaseDelta = 0, level = 0;
+};
+
+//==============================================================================
+static std::vector<BenchmarkCase> createBenchmarks (const BenchmarkSettings& settings)
+{
+    std::vector<BenchmarkCase> cases;
+    const auto sampleRate = settings.sampleRate;
+
+    for (auto blockSize : settings.blockSizes)
+    {
+        for (auto numChannels : settings.channelCounts)
+        {
+            const auto spec = dsp::ProcessSpec { sampleRate, (uint32) blockSize, (uint32) numChannels };
+
+            //==============================================================================
+            if (isPowerOfTwo (blockSize))
+            {
+                cases.push_back ({ "FFT", "performRealOnlyForwardTransform", blockSize, numChannels, [=]
+                {
+                    auto fft = std::make_shared<dsp::FFT> (roundToInt (std::log2 (blockSize)));
+                    Random random (1);
+                    auto source = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+                    auto work = std::make_shared<AudioBuffer<float>> (numChannels, blockSize * 2);
+
+                    return [=]
+                    {
+                        for (int ch = 0; ch < numChannels; ++ch)
+                        {
+                            work->copyFrom (ch, 0, *source, ch, 0, blockSize);
+                            fft->performRealOnlyForwardTransform (work->getWritePointer (ch));
+                        }
+                    };
+                }});
+            }
+
+            //==============================================================================
+            if (numChannels <= 2)
+            {
+                for (auto irLength : { 1024, 16384 })
+                {
+                    cases.push_back ({ "Convolution", "uniform, ir=" + String (irLength), blockSize, numChannels, [=]
+                    {
+                        auto convolution = std::make_shared<dsp::Convolution>();
+                        convolution->prepare (spec);
+
+                        Random random (2);
+                        auto ir = createNoise (numChannels, irLength, random);
+                        ir.applyGainRamp (0, irLength, 1.0f, 0.0f);
+                        convolution->loadImpulseResponse (std::move (ir), sampleRate,
+                                                          numChannels == 2 ? dsp::Convolution::Stereo::yes
+                                                                           : dsp::Convolution::Stereo::no,
+                                                          dsp::Convolution::Trim::no,
+                                                          dsp::Convolution::Normalise::no);
+
+                        auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+
+                        auto process = [=]
+                        {
+                            dsp::AudioBlock<float> block (*buffer);
+                            convolution->process (dsp::ProcessContextReplacing<float> (block));
+                        };
+
+                        // The impulse response is loaded on a background thread, and swapped
+                        // in during processing, so keep processing until it's been picked up
+                        for (int i = 0; i < 5000 && convolution->getCurrentIRSize() != irLength; ++i)
+                        {
+                            process();
+                            Thread::sleep (1);
+                        }
+
+                        return process;
+                    }});
+                }
+            }
+
+            //==============================================================================
+            for (auto numTaps : { 32, 256 })
+            {
+                cases.push_back ({ "FIR::Filter", "taps=" + String (numTaps), blockSize, numChannels, [=]
+                {
+                    auto coefficients = dsp::FilterDesign<float>::designFIRLowpassWindowMethod (8000.0f, sampleRate, (size_t) numTaps,
+                                                                                               dsp::WindowingFunction<float>::hann);
+                    using Duplicator = dsp::ProcessorDuplicator<dsp::FIR::Filter<float>, dsp::FIR::Coefficients<float>>;
+                    auto filter = std::make_shared<Duplicator> (coefficients);
+                    filter->prepare (spec);
+
+                    Random random (3);
+                    auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+
+                    return [=]
+                    {
+                        dsp::AudioBlock<float> block (*buffer);
+                        filter->process (dsp::ProcessContextReplacing<float> (block));
+                    };
+                }});
+            }
+
+            //==============================================================================
+            cases.push_back ({ "IIR::Filter", "lowpass", blockSize, numChannels, [=]
+            {
+                using Duplicator = dsp::ProcessorDuplicator<dsp::IIR::Filter<float>, dsp::IIR::Coefficients<float>>;
+                auto filter = std::make_shared<Duplicator> (dsp::IIR::Coefficients<float>::makeLowPass (sampleRate, 1000.0f));
+                filter->prepare (spec);
+
+                Random random (4);
+                auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+
+                return [=]
+                {
+                    dsp::AudioBlock<float> block (*buffer);
+                    filter->process (dsp::ProcessContextReplacing<float> (block));
+                };
+            }});
+
+            //==============================================================================
+            for (auto filterType : { dsp::Oversampling<float>::filterHalfBandPolyphaseIIR,
+                                     dsp::Oversampling<float>::filterHalfBandFIREquiripple })
+            {
+                const auto variant = String (filterType == dsp::Oversampling<float>::filterHalfBandPolyphaseIIR ? "polyphaseIIR"
+                                                                                                                 : "FIREquiripple") + ", 4x";
+
+                cases.push_back ({ "Oversampling", variant, blockSize, numChannels, [=]
+                {
+                    auto oversampling = std::make_shared<dsp::Oversampling<float>> ((size_t) numChannels, 2, filterType);
+                    oversampling->initProcessing ((size_t) blockSize);
+
+                    Random random (5);
+                    auto buffer = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+
+                    return [=]
+                    {
+                        dsp::AudioBlock<float> block (*buffer);
+                        oversampling->processSamplesUp (block);
+                        oversampling->processSamplesDown (block);
+                    };
+                }});
+            }
+
+            //==============================================================================
+            cases.push_back ({ "FloatVectorOperations", "multiply", blockSize, numChannels, [=]
+            {
+                Random random (6);
+                auto a = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+                auto b = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+                auto result = std::make_shared<AudioBuffer<float>> (numChannels, blockSize);
+
+                return [=]
+                {
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        FloatVectorOperations::multiply (result->getWritePointer (ch), a->getReadPointer (ch),
+                                                         b->getReadPointer (ch), blockSize);
+                };
+            }});
+
+            cases.push_back ({ "FloatVectorOperations", "addWithMultiply", blockSize, numChannels, [=]
+            {
+                Random random (7);
+                auto a = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+                auto b = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+
+                return [=]
+                {
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        FloatVectorOperations::addWithMultiply (a->getWritePointer (ch), b->getReadPointer (ch), 0.5f, blockSize);
+                };
+            }});
+
+            cases.push_back ({ "FloatVectorOperations", "findMinAndMax", blockSize, numChannels, [=]
+            {
+                Random random (8);
+                auto a = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, blockSize, random));
+                auto result = std::make_shared<float> (0.0f);
+
+                return [=]
+                {
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        *result += FloatVectorOperations::findMinAndMax (a->getReadPointer (ch), blockSize).getLength();
+                };
+            }});
+
+            //==============================================================================
+            cases.push_back ({ "ResamplingAudioSource", "44100 to 48000", blockSize, numChannels, [=]
+            {
+                auto tone = std::make_shared<ToneGeneratorAudioSource>();
+                auto resampler = std::make_shared<ResamplingAudioSource> (tone.get(), false, numChannels);
+                resampler->setResamplingRatio (44100.0 / 48000.0);
+                resampler->prepareToPlay (blockSize, sampleRate);
+
+                auto buffer = std::make_shared<AudioBuffer<float>> (numChannels, blockSize);
+
+                return [=]
+                {
+                    // The tone generator must outlive the resampler that reads from it
+                    ignoreUnused (tone);
+                    resampler->getNextAudioBlock (AudioSourceChannelInfo (*buffer));
+                };
+            }});
+
+            //==============================================================================
+            cases.push_back ({ "LagrangeInterpolator", "ratio=1.0884", blockSize, numChannels, [=]
+            {
+                const auto ratio = 48000.0 / 44100.0;
+                const auto numInputSamples = (int) std::ceil (blockSize * ratio) + 8;
+
+                auto interpolators = std::make_shared<std::vector<LagrangeInterpolator>> ((size_t) numChannels);
+                Random random (9);
+                auto input = std::make_shared<AudioBuffer<float>> (createNoise (numChannels, numInputSamples, random));
+                auto output = std::make_shared<AudioBuffer<float>> (numChannels, blockSize);
+
+                return [=]
+                {
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        (*interpolators)[(size_t) ch].process (ratio, input->getReadPointer (ch),
+                                                               output->getWritePointer (ch), blockSize);
+                };
+            }});
+
+            //==============================================================================
+            cases.push_back ({ "Synthesiser::renderNextBlock", "16 voices", blockSize, numChannels, [=]
+            {
+                auto synth = std::make_shared<Synthesiser>();
+
+                for (int i = 0; i < 16; ++i)
+                    synth->addVoice (new SineVoice());
+
+                synth->addSound (new SineSound());
+                synth->setCurrentPlaybackSampleRate (sampleRate);
+
+                for (int i = 0; i < 16; ++i)
+                    synth->noteOn (1, 48 + i, 0.8f);
+
+                auto buffer = std::make_shared<AudioBuffer<float>> (numChannels, blockSize);
+                auto midi = std::make_shared<MidiBuffer>();
+
+                return [=]
+                {
+                    buffer->clear();
+                    synth->renderNextBlock (*buffer, *midi, 0, blockSize);
+                };
+            }});
+        }
+    }
+
+    return cases;
+}
+
+//==============================================================================
+static var runBenchmark (const BenchmarkCase& benchmark, const BenchmarkSettings& settings)
+{
+    auto processBlock = benchmark.setup();
+
+    ScopedNoDenormals noDenormals;
+
+    // Warm up the caches and branch predictors before timing anything
+    for (int i = 0; i < 8; ++i)
+        processBlock();
+
+    auto timeBatch = [&processBlock] (int numBlocksInBatch)
+    {
+        const auto batchStart = Time::getHighResolutionTicks();
+
+        for (int i = 0; i < numBlocksInBatch; ++i)
+            processBlock();
+
+        return Time::highResolutionTicksToSeconds (Time::getHighResolutionTicks() - batchStart);
+    };
+
+    // The fastest kernels take much less time than the timer's resolution, so they're
+    // timed in batches which are long enough to measure accurately
+    int batchSize = 1;
+
+    while (batchSize < (1 << 20) && timeBatch (batchSize) < 1.0e-4)
+        batchSize *= 2;
+
+    std::vector<double> blockTimes;
+    blockTimes.reserve (4096);
+
+    int numBlocks = 0;
+    const auto minimumTicks = Time::secondsToHighResolutionTicks (settings.minimumSecondsPerCase);
+    const auto startTicks = Time::getHighResolutionTicks();
+
+    while (numBlocks < settings.minimumBlocksPerCase
+            || Time::getHighResolutionTicks() - startTicks < minimumTicks)
+    {
+        blockTimes.push_back (timeBatch (batchSize) / batchSize);
+        numBlocks += batchSize;
+    }
+
+    std::sort (blockTimes.begin(), blockTimes.end());
+
+    const auto numBatches = blockTimes.size();
+    const auto median = blockTimes[numBatches / 2];
+    const auto mean = std::accumulate (blockTimes.begin(), blockTimes.end(), 0.0) / (double) numBatches;
+    const auto secondsPerBlock = benchmark.blockSize / settings.sampleRate;
+
+    auto* result = new DynamicObject();
+    result->setProperty ("benchmark",            benchmark.name);
+    result->setProperty ("variant",              benchmark.variant);
+    result->setProperty ("blockSize",            benchmark.blockSize);
+    result->setProperty ("numChannels",          benchmark.numChannels);
+    result->setProperty ("numBlocks",            numBlocks);
+    result->setProperty ("batchSize",            batchSize);
+    result->setProperty ("nsPerBlockMin",        blockTimes.front() * 1.0e9);
+    result->setProperty ("nsPerBlockMedian",     median * 1.0e9);
+    result->setProperty ("nsPerBlockMean",       mean * 1.0e9);
+    result->setProperty ("nsPerBlockMax",        blockTimes.back() * 1.0e9);
+    result->setProperty ("nsPerSample",          median * 1.0e9 / (benchmark.blockSize * benchmark.numChannels));
+    result->setProperty ("realtimeFactor",       median > 0 ? secondsPerBlock / median : 0.0);
+
+    return result;
+}
+
+static String getInstructionSetName()
+{
+    switch (FloatVectorOperations::getInstructionSet())
+    {
+        case FloatVectorOperations::InstructionSet::sse:     return "sse";
+        case FloatVectorOperations::InstructionSet::avx2:    return "avx2";
+        case FloatVectorOperations::InstructionSet::avx512:  return "avx512";
+        case FloatVectorOperations::InstructionSet::neon:    return "neon";
+        case FloatVectorOperations::InstructionSet::none:    break;
+    }
+
+    return "none";
+}
+
+static var createSystemInfo (const BenchmarkSettings& settings)
+{
+    auto* system = new DynamicObject();
+    system->setProperty ("juceVersion",          SystemStats::getJUCEVersion());
+    system->setProperty ("os",                   SystemStats::getOperatingSystemName());
+    system->setProperty ("cpuVendor",            SystemStats::getCpuVendor());
+    system->setProperty ("cpuModel",             SystemStats::getCpuModel());
+    system->setProperty ("cpuSpeedMHz",          SystemStats::getCpuSpeedInMegahertz());
+    system->setProperty ("numCpus",              SystemStats::getNumCpus());
+    system->setProperty ("vectorOps",            getInstructionSetName());
+   #if JUCE_DEBUG
+    system->setProperty ("buildConfig",          "Debug");
+   #else
+    system->setProperty ("buildConfig",          "Release");
+   #endif
+
+    auto* root = new DynamicObject();
+    root->setProperty ("timestamp",             Time::getCurrentTime().toISO8601 (true));
+    root->setProperty ("system",                system);
+    root->setProperty ("sampleRate",            settings.sampleRate);
+    root->setProperty ("minimumSecondsPerCase", settings.minimumSecondsPerCase);
+
+    return root;
+}
+
+//==============================================================================
+static Array<int> parseIntList (const String& text)
+{
+    Array<int> values;
+
+    for (auto& token : StringArray::fromTokens (text, ",", {}))
+        if (token.trim().getIntValue() > 0)
+            values.add (token.trim().getIntValue());
+
+    return values;
+}
+
+int main (int argc, char* argv[])
+{
+    ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        std::cout << argv[0] << " [--help|-h] [--list] [--filter=name] [--block-sizes=64,256,...]"
+                                " [--channels=1,2,...] [--sample-rate=rate] [--min-time=seconds] [--output=file]" << std::endl;
+        return 0;
+    }
+
+    BenchmarkSettings settings;
+
+    auto blockSizes = parseIntList (args.getValueForOption ("--block-sizes"));
+    auto channelCounts = parseIntList (args.getValueForOption ("--channels"));
+
+    if (! blockSizes.isEmpty())
+        settings.blockSizes = blockSizes;
+
+    if (! channelCounts.isEmpty())
+        settings.channelCounts = channelCounts;
+
+    if (args.containsOption ("--sample-rate"))
+        settings.sampleRate = jmax (1.0, args.getValueForOption ("--sample-rate").getDoubleValue());
+
+    if (args.containsOption ("--min-time"))
+        settings.minimumSecondsPerCase = jmax (0.0, args.getValueForOption ("--min-time").getDoubleValue());
+
+    if (args.containsOption ("--filter"))
+        settings.filter = args.getValueForOption ("--filter");
+
+    std::vector<BenchmarkCase> cases;
+
+    for (auto& benchmark : createBenchmarks (settings))
+        if (settings.filter.isEmpty() || benchmark.name.containsIgnoreCase (settings.filter))
+            cases.push_back (benchmark);
+
+    if (args.containsOption ("--list"))
+    {
+        for (auto& benchmark : cases)
+            std::cout << benchmark.name << " [" << benchmark.variant << "] block=" << benchmark.blockSize
+                      << " channels=" << benchmark.numChannels << std::endl;
+
+        return 0;
+    }
+
+    Array<var> results;
+
+    for (auto& benchmark : cases)
+    {
+        // Progress goes to stderr, so that the JSON on stdout can be piped straight into a file
+        std::cerr << benchmark.name << " [" << benchmark.variant << "] block=" << benchmark.blockSize
+                  << " channels=" << benchmark.numChannels << std::endl;
+
+        results.add (runBenchmark (benchmark, settings));
+    }
+
+    auto report = createSystemInfo (settings);
+    report.getDynamicObject()->setProperty ("results", results);
+
+    const auto json = JSON::toString (report);
+
+    if (args.containsOption ("--output"))
+    {
+        auto file = args.getFileForOption ("--output");
+
+        if (! file.replaceWithText (json))
+        {
+            std::cerr << "Couldn't write to " << file.getFullPathName() << std::endl;
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json << std::endl;
+    }
+
+    return 0;
+}
@@ -484,6 +484,363 @@ namespace FloatVectorHelpers
             return Range<Type>::findMinAndMax (src, num);
         }
     };
+
+    template <typename Mode>
+    struct DotProduct
+    {
+        using Type = typename Mode::Type;
+        using ParallelType = typename Mode::ParallelType;
+
+        static Type dotProduct (const Type* src1, const Type* src2, int num) noexcept
+        {
+            ParallelType sum = Mode::load1 ((Type) 0);
+
+            for (int i = num / Mode::numParallel; --i >= 0; src1 += Mode::numParallel, src2 += Mode::numParallel)
+                sum = Mode::add (sum, Mode::mul (Mode::loadU (src1), Mode::loadU (src2)));
+
+            Type values[Mode::numParallel];
+            Mode::storeU (values, sum);
+            Type result = 0;
+
+            for (auto v : values)
+                result += v;
+
+            for (int i = 0; i < (num & (Mode::numParallel - 1)); ++i)
+                result += src1[i] * src2[i];
+
+            return result;
+        }
+    };
+   #endif
+
+   #if JUCE_USE_AVX_INTRINSICS
+    //==============================================================================
+    // The AVX2 and AVX-512 kernels are compiled alongside the SSE ones without needing
+    // any special compiler flags, and are only called if the CPU supports them. Because
+    // of this, any function that touches the wider registers has to be tagged with the
+    // instruction set that it needs.
+   #if JUCE_MSVC
+    #define JUCE_AVX2_TARGET
+    #define JUCE_AVX512_TARGET
+   #elif JUCE_GCC
+    // AVX-512 implies FMA, and GCC would otherwise fuse the multiplies and adds, which
+    // would round differently to the other instruction sets
+    #define JUCE_AVX2_TARGET    __attribute__ ((target ("avx2")))
+    #define JUCE_AVX512_TARGET  __attribute__ ((target ("avx512f"), optimize ("fp-contract=off")))
+   #else
+    #define JUCE_AVX2_TARGET    __attribute__ ((target ("avx2")))
+    #define JUCE_AVX512_TARGET  __attribute__ ((target ("avx512f")))
+   #endif
+
+    // CPUID only says what the processor can do. The OS also has to save the wider
+    // registers on a context switch, which it reports by setting bits in XCR0.
+    enum : uint64
+    {
+        osSavesYMMRegisters = 0x06,    // XMM and YMM state
+        osSavesZMMRegisters = 0xe6     // ..plus the opmask and both halves of the ZMM state
+    };
+
+    static bool isRegisterStateSavedByOS (uint64 requiredBits) noexcept
+    {
+       #if JUCE_MSVC
+        int info[4];
+        __cpuid (info, 1);
+
+        if ((info[2] & (1 << 27)) == 0)   // OSXSAVE
+            return false;
+
+        return (_xgetbv (0) & requiredBits) == requiredBits;
+       #else
+        unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+
+        if (__get_cpuid (1, &eax, &ebx, &ecx, &edx) == 0 || (ecx & bit_OSXSAVE) == 0)
+            return false;
+
+        unsigned int xcr0Low = 0, xcr0High = 0;
+        __asm__ volatile ("xgetbv" : "=a" (xcr0Low), "=d" (xcr0High) : "c" (0));
+
+        const auto xcr0 = ((uint64) xcr0High << 32) | xcr0Low;
+        return (xcr0 & requiredBits) == requiredBits;
+       #endif
+    }
+
+    static bool canUseAVX2() noexcept
+    {
+        return SystemStats::hasAVX2() && isRegisterStateSavedByOS (osSavesYMMRegisters);
+    }
+
+    static bool canUseAVX512() noexcept
+    {
+        return SystemStats::hasAVX512F() && isRegisterStateSavedByOS (osSavesZMMRegisters);
+    }
+
+    struct AVX2Ops32
+    {
+        using Type = float;
+        using ParallelType = __m256;
+        enum { numParallel = 8 };
+
+        JUCE_AVX2_TARGET static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_ps (v); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_ps (v); }
+        JUCE_AVX2_TARGET static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_ps (dest, a); }
+
+        JUCE_AVX2_TARGET static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_ps (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_ps (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_ps (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_ps (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_ps (a, b); }
+    };
+
+    struct AVX2Ops64
+    {
+        using Type = double;
+        using ParallelType = __m256d;
+        enum { numParallel = 4 };
+
+        JUCE_AVX2_TARGET static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm256_set1_pd (v); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm256_loadu_pd (v); }
+        JUCE_AVX2_TARGET static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm256_storeu_pd (dest, a); }
+
+        JUCE_AVX2_TARGET static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm256_add_pd (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm256_sub_pd (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm256_mul_pd (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm256_max_pd (a, b); }
+        JUCE_AVX2_TARGET static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm256_min_pd (a, b); }
+    };
+
+    // Some versions of GCC's AVX-512 headers trigger spurious warnings from inside min and max
+    JUCE_BEGIN_IGNORE_WARNINGS_GCC_LIKE ("-Wmaybe-uninitialized")
+
+    struct AVX512Ops32
+    {
+        using Type = float;
+        using ParallelType = __m512;
+        enum { numParallel = 16 };
+
+        JUCE_AVX512_TARGET static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_ps (v); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_ps (v); }
+        JUCE_AVX512_TARGET static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_ps (dest, a); }
+
+        JUCE_AVX512_TARGET static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_ps (a, b); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_ps (a, b); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_ps (a, b); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_ps (a, b); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_ps (a, b); }
+    };
+
+    struct AVX512Ops64
+    {
+        using Type = double;
+        using ParallelType = __m512d;
+        enum { numParallel = 8 };
+
+        JUCE_AVX512_TARGET static forcedinline ParallelType load1 (Type v) noexcept                        { return _mm512_set1_pd (v); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType loadU (const Type* v) noexcept                 { return _mm512_loadu_pd (v); }
+        JUCE_AVX512_TARGET static forcedinline void storeU (Type* dest, ParallelType a) noexcept           { _mm512_storeu_pd (dest, a); }
+
+        JUCE_AVX512_TARGET static forcedinline ParallelType add (ParallelType a, ParallelType b) noexcept  { return _mm512_add_pd (a, b); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType sub (ParallelType a, ParallelType b) noexcept  { return _mm512_sub_pd (a, b); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType mul (ParallelType a, ParallelType b) noexcept  { return _mm512_mul_pd (a, b); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType max (ParallelType a, ParallelType b) noexcept  { return _mm512_max_pd (a, b); }
+        JUCE_AVX512_TARGET static forcedinline ParallelType min (ParallelType a, ParallelType b) noexcept  { return _mm512_min_pd (a, b); }
+    };
+
+    JUCE_END_IGNORE_WARNINGS_GCC_LIKE
+
+    template<int typeSize> struct AVX2ModeType       { using Mode = AVX2Ops32; };
+    template<>             struct AVX2ModeType<8>    { using Mode = AVX2Ops64; };
+    template<int typeSize> struct AVX512ModeType     { using Mode = AVX512Ops32; };
+    template<>             struct AVX512ModeType<8>  { using Mode = AVX512Ops64; };
+
+    enum class VecOp { add, subtract, multiply };
+
+    template <VecOp op, typename Type>
+    static forcedinline Type applyScalar (Type a, Type b) noexcept
+    {
+        return op == VecOp::add ? a + b : (op == VecOp::subtract ? a - b : a * b);
+    }
+
+    // Each kernel runs over as many whole registers as possible, and then finishes off
+    // any remaining values one at a time. The arithmetic is done in the same order as
+    // the SSE versions, so the results are identical whichever instruction set is used,
+    // except for dotProduct, where the number of lanes changes how the sum is rounded.
+    #define JUCE_DECLARE_WIDE_VEC_KERNELS(KernelsName, isaTarget) \
+    template <typename Mode> \
+    struct KernelsName \
+    { \
+        using Type = typename Mode::Type; \
+        using ParallelType = typename Mode::ParallelType; \
+        enum { numParallel = Mode::numParallel }; \
+     \
+        template <VecOp op> \
+        isaTarget static forcedinline ParallelType apply (ParallelType a, ParallelType b) noexcept \
+        { \
+            return op == VecOp::add ? Mode::add (a, b) : (op == VecOp::subtract ? Mode::sub (a, b) : Mode::mul (a, b)); \
+        } \
+     \
+        template <VecOp op> \
+        isaTarget static void opDestScalar (Type* dest, Type value, int num) noexcept \
+        { \
+            const ParallelType v = Mode::load1 (value); \
+     \
+            for (int i = num / numParallel; --i >= 0; dest += numParallel) \
+                Mode::storeU (dest, apply<op> (Mode::loadU (dest), v)); \
+     \
+            for (int i = 0; i < (num & (numParallel - 1)); ++i) \
+                dest[i] = applyScalar<op> (dest[i], value); \
+        } \
+     \
+        template <VecOp op> \
+        isaTarget static void opSrcScalar (Type* dest, const Type* src, Type value, int num) noexcept \
+        { \
+            const ParallelType v = Mode::load1 (value); \
+     \
+            for (int i = num / numParallel; --i >= 0; dest += numParallel, src += numParallel) \
+                Mode::storeU (dest, apply<op> (Mode::loadU (src), v)); \
+     \
+            for (int i = 0; i < (num & (numParallel - 1)); ++i) \
+                dest[i] = applyScalar<op> (src[i], value); \
+        } \
+     \
+        template <VecOp op> \
+        isaTarget static void opDestSrc (Type* dest, const Type* src, int num) noexcept \
+        { \
+            for (int i = num / numParallel; --i >= 0; dest += numParallel, src += numParallel) \
+                Mode::storeU (dest, apply<op> (Mode::loadU (dest), Mode::loadU (src))); \
+     \
+            for (int i = 0; i < (num & (numParallel - 1)); ++i) \
+                dest[i] = applyScalar<op> (dest[i], src[i]); \
+        } \
+     \
+        template <VecOp op> \
+        isaTarget static void opSrc1Src2 (Type* dest, const Type* src1, const Type* src2, int num) noexcept \
+        { \
+            for (int i = num / numParallel; --i >= 0; dest += numParallel, src1 += numParallel, src2 += numParallel) \
+                Mode::storeU (dest, apply<op> (Mode::loadU (src1), Mode::loadU (src2))); \
+     \
+            for (int i = 0; i < (num & (numParallel - 1)); ++i) \
+                dest[i] = applyScalar<op> (src1[i], src2[i]); \
+        } \
+     \
+        template <VecOp op> \
+        isaTarget static void opDestSrcTimesScalar (Type* dest, const Type* src, Type multiplier, int num) noexcept \
+        { \
+            const ParallelType mult = Mode::load1 (multiplier); \
+     \
+            for (int i = num / numParallel; --i >= 0; dest += numParallel, src += numParallel) \
+                Mode::storeU (dest, apply<op> (Mode::loadU (dest), Mode::mul (mult, Mode::loadU (src)))); \
+     \
+            for (int i = 0; i < (num & (numParallel - 1)); ++i) \
+                dest[i] = applyScalar<op> (dest[i], src[i] * multiplier); \
+        } \
+     \
+        template <VecOp op> \
+        isaTarget static void opDestSrc1TimesSrc2 (Type* dest, const Type* src1, const Type* src2, int num) noexcept \
+        { \
+            for (int i = num / numParallel; --i >= 0; dest += numParallel, src1 += numParallel, src2 += numParallel) \
+                Mode::storeU (dest, apply<op> (Mode::loadU (dest), Mode::mul (Mode::loadU (src1), Mode::loadU (src2)))); \
+     \
+            for (int i = 0; i < (num & (numParallel - 1)); ++i) \
+                dest[i] = applyScalar<op> (dest[i], src1[i] * src2[i]); \
+        } \
+     \
+        isaTarget static Type findMinOrMax (const Type* src, int num, bool isMinimum) noexcept \
+        { \
+            ParallelType val = Mode::loadU (src); \
+     \
+            for (int i = num / numParallel; --i > 0;) \
+            { \
+                src += numParallel; \
+                val = isMinimum ? Mode::min (val, Mode::loadU (src)) \
+                                : Mode::max (val, Mode::loadU (src)); \
+            } \
+     \
+            Type values[numParallel]; \
+            Mode::storeU (values, val); \
+            Type result = isMinimum ? juce::findMinimum (values, (int) numParallel) \
+                                    : juce::findMaximum (values, (int) numParallel); \
+            src += numParallel; \
+     \
+            for (int i = 0; i < (num & (numParallel - 1)); ++i) \
+                result = isMinimum ? jmin (result, src[i]) \
+                                   : jmax (result, src[i]); \
+     \
+            return result; \
+        } \
+     \
+        isaTarget static Range<Type> findMinAndMax (const Type* src, int num) noexcept \
+        { \
+            ParallelType mn = Mode::loadU (src), mx = mn; \
+     \
+            for (int i = num / numParallel; --i > 0;) \
+            { \
+                src += numParallel; \
+                const ParallelType v = Mode::loadU (src); \
+                mn = Mode::min (mn, v); \
+                mx = Mode::max (mx, v); \
+            } \
+     \
+            Type mins[numParallel], maxes[numParallel]; \
+            Mode::storeU (mins, mn); \
+            Mode::storeU (maxes, mx); \
+            Range<Type> result (juce::findMinimum (mins, (int) numParallel), \
+                                juce::findMaximum (maxes, (int) numParallel)); \
+            src += numParallel; \
+     \
+            for (int i = 0; i < (num & (numParallel - 1)); ++i) \
+                result = result.getUnionWith (src[i]); \
+     \
+            return result; \
+        } \
+     \
+        isaTarget static Type dotProduct (const Type* src1, const Type* src2, int num) noexcept \
+        { \
+            ParallelType sum = Mode::load1 ((Type) 0); \
+     \
+            for (int i = num / numParallel; --i >= 0; src1 += numParallel, src2 += numParallel) \
+                sum = Mode::add (sum, Mode::mul (Mode::loadU (src1), Mode::loadU (src2))); \
+     \
+            Type values[numParallel]; \
+            Mode::storeU (values, sum); \
+            Type result = 0; \
+     \
+            for (auto v : values) \
+                result += v; \
+     \
+            for (int i = 0; i < (num & (numParallel - 1)); ++i) \
+                result += src1[i] * src2[i]; \
+     \
+            return result; \
+        } \
+    };
+
+    JUCE_DECLARE_WIDE_VEC_KERNELS (AVX2Kernels, JUCE_AVX2_TARGET)
+    JUCE_DECLARE_WIDE_VEC_KERNELS (AVX512Kernels, JUCE_AVX512_TARGET)
+
+    #undef JUCE_DECLARE_WIDE_VEC_KERNELS
+
+    // For very short arrays, the wider registers don't save enough work to make up for
+    // the longer scalar tail, so these are left to the SSE code.
+    static FloatVectorOperations::InstructionSet getInstructionSetForSize (int num) noexcept
+    {
+        return num >= 32 ? FloatVectorOperations::getInstructionSet()
+                         : FloatVectorOperations::InstructionSet::sse;
+    }
+
+    #define JUCE_PERFORM_WIDE_VEC_OP(typedPtr, kernel) \
+        switch (FloatVectorHelpers::getInstructionSetForSize (num)) \
+        { \
+            case FloatVectorOperations::InstructionSet::avx512: \
+                return FloatVectorHelpers::AVX512Kernels<FloatVectorHelpers::AVX512ModeType<sizeof (*typedPtr)>::Mode>::kernel; \
+            case FloatVectorOperations::InstructionSet::avx2: \
+                return FloatVectorHelpers::AVX2Kernels<FloatVectorHelpers::AVX2ModeType<sizeof (*typedPtr)>::Mode>::kernel; \
+            case FloatVectorOperations::InstructionSet::none: \
+            case FloatVectorOperations::InstructionSet::sse: \
+            case FloatVectorOperations::InstructionSet::neon: \
+                break; \
+        }
+   #else
+    #define JUCE_PERFORM_WIDE_VEC_OP(typedPtr, kernel)
    #endif
 }
 
@@ -552,6 +909,7 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (float* dest, const f
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrcScalar<FloatVectorHelpers::VecOp::multiply> (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -563,6 +921,7 @@ void JUCE_CALLTYPE FloatVectorOperations::copyWithMultiply (double* dest, const
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (src, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrcScalar<FloatVectorHelpers::VecOp::multiply> (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -574,6 +933,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int nu
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (dest, 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestScalar<FloatVectorHelpers::VecOp::add> (dest, amount, num))
     JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
                               const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
    #endif
@@ -581,6 +941,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, float amount, int nu
 
 void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, double amount, int num) noexcept
 {
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestScalar<FloatVectorHelpers::VecOp::add> (dest, amount, num))
     JUCE_PERFORM_VEC_OP_DEST (dest[i] += amount, Mode::add (d, amountToAdd), JUCE_LOAD_DEST,
                               const Mode::ParallelType amountToAdd = Mode::load1 (amount);)
 }
@@ -590,6 +951,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsadd (osx108sdkCompatibilityCast (src), 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrcScalar<FloatVectorHelpers::VecOp::add> (dest, src, amount, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount, Mode::add (am, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType am = Mode::load1 (amount);)
@@ -601,6 +963,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsaddD (osx108sdkCompatibilityCast (src), 1, &amount, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrcScalar<FloatVectorHelpers::VecOp::add> (dest, src, amount, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] + amount, Mode::add (am, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType am = Mode::load1 (amount);)
@@ -612,6 +975,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src, in
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc<FloatVectorHelpers::VecOp::add> (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -621,6 +985,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc<FloatVectorHelpers::VecOp::add> (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i], Mode::add (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -630,6 +995,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (float* dest, const float* src1, c
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vadd (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrc1Src2<FloatVectorHelpers::VecOp::add> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -639,6 +1005,7 @@ void JUCE_CALLTYPE FloatVectorOperations::add (double* dest, const double* src1,
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vaddD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrc1Src2<FloatVectorHelpers::VecOp::add> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] + src2[i], Mode::add (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -648,6 +1015,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsub (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc<FloatVectorHelpers::VecOp::subtract> (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i], Mode::sub (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -657,6 +1025,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsubD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc<FloatVectorHelpers::VecOp::subtract> (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i], Mode::sub (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -666,6 +1035,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsub (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrc1Src2<FloatVectorHelpers::VecOp::subtract> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i], Mode::sub (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -675,6 +1045,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtract (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsubD (src2, 1, src1, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrc1Src2<FloatVectorHelpers::VecOp::subtract> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] - src2[i], Mode::sub (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -684,6 +1055,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsma (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrcTimesScalar<FloatVectorHelpers::VecOp::add> (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -695,6 +1067,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmaD (src, 1, &multiplier, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrcTimesScalar<FloatVectorHelpers::VecOp::add> (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] += src[i] * multiplier, Mode::add (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -706,6 +1079,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (float* dest, const fl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vma ((float*) src1, 1, (float*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc1TimesSrc2<FloatVectorHelpers::VecOp::add> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -717,6 +1091,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmaD ((double*) src1, 1, (double*) src2, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc1TimesSrc2<FloatVectorHelpers::VecOp::add> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] += src1[i] * src2[i], Mode::add (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -725,6 +1100,7 @@ void JUCE_CALLTYPE FloatVectorOperations::addWithMultiply (double* dest, const d
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrcTimesScalar<FloatVectorHelpers::VecOp::subtract> (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -732,6 +1108,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, con
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrcTimesScalar<FloatVectorHelpers::VecOp::subtract> (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] -= src[i] * multiplier, Mode::sub (d, Mode::mul (mult, s)),
                                   JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -739,6 +1116,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, co
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, const float* src1, const float* src2, int num) noexcept
 {
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc1TimesSrc2<FloatVectorHelpers::VecOp::subtract> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -746,6 +1124,7 @@ void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (float* dest, con
 
 void JUCE_CALLTYPE FloatVectorOperations::subtractWithMultiply (double* dest, const double* src1, const double* src2, int num) noexcept
 {
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc1TimesSrc2<FloatVectorHelpers::VecOp::subtract> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST_DEST (dest[i] -= src1[i] * src2[i], Mode::sub (d, Mode::mul (s1, s2)),
                                              JUCE_LOAD_SRC1_SRC2_DEST,
                                              JUCE_INCREMENT_SRC1_SRC2_DEST, )
@@ -756,6 +1135,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc<FloatVectorHelpers::VecOp::multiply> (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -765,6 +1145,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src, 1, dest, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestSrc<FloatVectorHelpers::VecOp::multiply> (dest, src, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] *= src[i], Mode::mul (d, s), JUCE_LOAD_SRC_DEST, JUCE_INCREMENT_SRC_DEST, )
    #endif
 }
@@ -774,6 +1155,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmul (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrc1Src2<FloatVectorHelpers::VecOp::multiply> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -783,6 +1165,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double*
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vmulD (src1, 1, src2, 1, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrc1Src2<FloatVectorHelpers::VecOp::multiply> (dest, src1, src2, num))
     JUCE_PERFORM_VEC_OP_SRC1_SRC2_DEST (dest[i] = src1[i] * src2[i], Mode::mul (s1, s2), JUCE_LOAD_SRC1_SRC2, JUCE_INCREMENT_SRC1_SRC2_DEST, )
    #endif
 }
@@ -792,6 +1175,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, float multiplie
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmul (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestScalar<FloatVectorHelpers::VecOp::multiply> (dest, multiplier, num))
     JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
                               const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -802,6 +1186,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
    #if JUCE_USE_VDSP_FRAMEWORK
     vDSP_vsmulD (dest, 1, &multiplier, dest, 1, (vDSP_Length) num);
    #else
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opDestScalar<FloatVectorHelpers::VecOp::multiply> (dest, multiplier, num))
     JUCE_PERFORM_VEC_OP_DEST (dest[i] *= multiplier, Mode::mul (d, mult), JUCE_LOAD_DEST,
                               const Mode::ParallelType mult = Mode::load1 (multiplier);)
    #endif
@@ -809,6 +1194,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, double multipl
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* src, float multiplier, int num) noexcept
 {
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrcScalar<FloatVectorHelpers::VecOp::multiply> (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -816,6 +1202,7 @@ void JUCE_CALLTYPE FloatVectorOperations::multiply (float* dest, const float* sr
 
 void JUCE_CALLTYPE FloatVectorOperations::multiply (double* dest, const double* src, double multiplier, int num) noexcept
 {
+    JUCE_PERFORM_WIDE_VEC_OP (dest, opSrcScalar<FloatVectorHelpers::VecOp::multiply> (dest, src, multiplier, num))
     JUCE_PERFORM_VEC_OP_SRC_DEST (dest[i] = src[i] * multiplier, Mode::mul (mult, s),
                                   JUCE_LOAD_SRC, JUCE_INCREMENT_SRC_DEST,
                                   const Mode::ParallelType mult = Mode::load1 (multiplier);)
@@ -977,6 +1364,7 @@ void JUCE_CALLTYPE FloatVectorOperations::clip (double* dest, const double* src,
 Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_PERFORM_WIDE_VEC_OP (src, findMinAndMax (src, num))
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinAndMax (src, num);
    #else
     return Range<float>::findMinAndMax (src, num);
@@ -986,6 +1374,7 @@ Range<float> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const float* sr
 Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_PERFORM_WIDE_VEC_OP (src, findMinAndMax (src, num))
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinAndMax (src, num);
    #else
     return Range<double>::findMinAndMax (src, num);
@@ -995,6 +1384,7 @@ Range<double> JUCE_CALLTYPE FloatVectorOperations::findMinAndMax (const double*
 float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_PERFORM_WIDE_VEC_OP (src, findMinOrMax (src, num, true))
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, true);
    #else
     return juce::findMinimum (src, num);
@@ -1004,6 +1394,7 @@ float JUCE_CALLTYPE FloatVectorOperations::findMinimum (const float* src, int nu
 double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_PERFORM_WIDE_VEC_OP (src, findMinOrMax (src, num, true))
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, true);
    #else
     return juce::findMinimum (src, num);
@@ -1013,6 +1404,7 @@ double JUCE_CALLTYPE FloatVectorOperations::findMinimum (const double* src, int
 float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_PERFORM_WIDE_VEC_OP (src, findMinOrMax (src, num, false))
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps32>::findMinOrMax (src, num, false);
    #else
     return juce::findMaximum (src, num);
@@ -1022,12 +1414,72 @@ float JUCE_CALLTYPE FloatVectorOperations::findMaximum (const float* src, int nu
 double JUCE_CALLTYPE FloatVectorOperations::findMaximum (const double* src, int num) noexcept
 {
    #if JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_PERFORM_WIDE_VEC_OP (src, findMinOrMax (src, num, false))
     return FloatVectorHelpers::MinMax<FloatVectorHelpers::BasicOps64>::findMinOrMax (src, num, false);
    #else
     return juce::findMaximum (src, num);
    #endif
 }
 
+float JUCE_CALLTYPE FloatVectorOperations::dotProduct (const float* src1, const float* src2, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    float result = 0;
+    vDSP_dotpr (src1, 1, src2, 1, &result, (vDSP_Length) num);
+    return result;
+   #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_PERFORM_WIDE_VEC_OP (src1, dotProduct (src1, src2, num))
+    return FloatVectorHelpers::DotProduct<FloatVectorHelpers::BasicOps32>::dotProduct (src1, src2, num);
+   #else
+    float result = 0;
+
+    for (int i = 0; i < num; ++i)
+        result += src1[i] * src2[i];
+
+    return result;
+   #endif
+}
+
+double JUCE_CALLTYPE FloatVectorOperations::dotProduct (const double* src1, const double* src2, int num) noexcept
+{
+   #if JUCE_USE_VDSP_FRAMEWORK
+    double result = 0;
+    vDSP_dotprD (src1, 1, src2, 1, &result, (vDSP_Length) num);
+    return result;
+   #elif JUCE_USE_SSE_INTRINSICS || JUCE_USE_ARM_NEON
+    JUCE_PERFORM_WIDE_VEC_OP (src1, dotProduct (src1, src2, num))
+    return FloatVectorHelpers::DotProduct<FloatVectorHelpers::BasicOps64>::dotProduct (src1, src2, num);
+   #else
+    double result = 0;
+
+    for (int i = 0; i < num; ++i)
+        result += src1[i] * src2[i];
+
+    return result;
+   #endif
+}
+
+FloatVectorOperations::InstructionSet JUCE_CALLTYPE FloatVectorOperations::getInstructionSet() noexcept
+{
+   #if JUCE_USE_AVX_INTRINSICS
+    static const auto instructionSet = []
+    {
+        if (FloatVectorHelpers::canUseAVX512())  return InstructionSet::avx512;
+        if (FloatVectorHelpers::canUseAVX2())    return InstructionSet::avx2;
+
+        return InstructionSet::sse;
+    }();
+
+    return instructionSet;
+   #elif JUCE_USE_SSE_INTRINSICS
+    return InstructionSet::sse;
+   #elif JUCE_USE_ARM_NEON
+    return InstructionSet::neon;
+   #else
+    return InstructionSet::none;
+   #endif
+}
+
 intptr_t JUCE_CALLTYPE FloatVectorOperations::getFpStatusRegister() noexcept
 {
     intptr_t fpsr = 0;
@@ -1187,6 +1639,8 @@ public:
             u.expect (valuesMatch (FloatVectorOperations::findMinimum (data2, num), juce::findMinimum (data2, num)));
             u.expect (valuesMatch (FloatVectorOperations::findMaximum (data2, num), juce::findMaximum (data2, num)));
 
+            u.expect (dotProductsMatch (FloatVectorOperations::dotProduct (data1, data2, num), data1, data2, num));
+
             FloatVectorOperations::clear (data1, num);
             u.expect (areAllValuesEqual (data1, num, 0));
 
@@ -1284,8 +1738,71 @@ public:
         {
             return std::abs (v1 - v2) < std::numeric_limits<ValueType>::epsilon();
         }
+
+        // The vector versions add the products up in a different order, so this allows
+        // for some rounding error relative to the size of the sum.
+        static bool dotProductsMatch (ValueType result, const ValueType* src1, const ValueType* src2, int num)
+        {
+            double expected = 0, magnitude = 0;
+
+            for (int i = 0; i < num; ++i)
+            {
+                expected  += (double) src1[i] * (double) src2[i];
+                magnitude += std::abs ((double) src1[i] * (double) src2[i]);
+            }
+
+            return std::abs ((double) result - expected) <= magnitude * (double) std::numeric_limits<ValueType>::epsilon() * 4.0 * (double) num;
+        }
     };
 
+   #if JUCE_USE_AVX_INTRINSICS
+    // Checks a set of wide kernels directly against plain loops, so that each instruction
+    // set gets tested on a CPU that supports it, regardless of which one is picked by default.
+    template <typename Kernels>
+    void runWideKernelTest()
+    {
+        using ValueType = typename Kernels::Type;
+        using VecOp = FloatVectorHelpers::VecOp;
+
+        auto random = getRandom();
+
+        for (int i = 100; --i >= 0;)
+        {
+            const int num = random.nextInt (500) + 32;
+
+            HeapBlock<ValueType> buffer1 (num + 16), buffer2 (num + 16), buffer3 (num + 16);
+            ValueType* const data1 = addBytesToPointer (buffer1.get(), sizeof (ValueType) * (size_t) random.nextInt (8));
+            ValueType* const data2 = addBytesToPointer (buffer2.get(), sizeof (ValueType) * (size_t) random.nextInt (8));
+            ValueType* const data3 = buffer3.get();
+
+            TestRunner<ValueType>::fillRandomly (random, data1, num);
+            TestRunner<ValueType>::fillRandomly (random, data2, num);
+
+            expect (Kernels::findMinAndMax (data1, num) == Range<ValueType>::findMinAndMax (data1, num));
+            expect (Kernels::findMinOrMax (data1, num, true)  == juce::findMinimum (data1, num));
+            expect (Kernels::findMinOrMax (data1, num, false) == juce::findMaximum (data1, num));
+            expect (TestRunner<ValueType>::dotProductsMatch (Kernels::dotProduct (data1, data2, num), data1, data2, num));
+
+            Kernels::template opSrc1Src2<VecOp::subtract> (data3, data1, data2, num);
+
+            for (int j = 0; j < num; ++j)
+                expect (data3[j] == data1[j] - data2[j]);
+
+            FloatVectorOperations::copy (data3, data1, num);
+            Kernels::template opDestSrcTimesScalar<VecOp::add> (data3, data2, (ValueType) 3, num);
+
+            for (int j = 0; j < num; ++j)
+                expect (data3[j] == data1[j] + data2[j] * (ValueType) 3);
+
+            FloatVectorOperations::copy (data3, data1, num);
+            Kernels::template opDestScalar<VecOp::multiply> (data3, (ValueType) 0.5, num);
+
+            for (int j = 0; j < num; ++j)
+                expect (data3[j] == data1[j] * (ValueType) 0.5);
+        }
+    }
+   #endif
+
     void runTest() override
     {
         beginTest ("FloatVectorOperations");
@@ -1295,6 +1812,22 @@ public:
             TestRunner<float>::runTest (*this, getRandom());
             TestRunner<double>::runTest (*this, getRandom());
         }
+
+       #if JUCE_USE_AVX_INTRINSICS
+        if (FloatVectorHelpers::canUseAVX2())
+        {
+            beginTest ("AVX2 kernels");
+            runWideKernelTest<FloatVectorHelpers::AVX2Kernels<FloatVectorHelpers::AVX2Ops32>>();
+            runWideKernelTest<FloatVectorHelpers::AVX2Kernels<FloatVectorHelpers::AVX2Ops64>>();
+        }
+
+        if (FloatVectorHelpers::canUseAVX512())
+        {
+            beginTest ("AVX-512 kernels");
+            runWideKernelTest<FloatVectorHelpers::AVX512Kernels<FloatVectorHelpers::AVX512Ops32>>();
+            runWideKernelTest<FloatVectorHelpers::AVX512Kernels<FloatVectorHelpers::AVX512Ops64>>();
+        }
+       #endif
     }
 };
 
@@ -214,6 +214,12 @@ public:
     /** Finds the maximum value in the given array. */
     static double JUCE_CALLTYPE findMaximum (const double* src, int numValues) noexcept;
 
+    /** Returns the sum of the products of the corresponding elements of src1 and src2. */
+    static float JUCE_CALLTYPE dotProduct (const float* src1, const float* src2, int num) noexcept;
+
+    /** Returns the sum of the products of the corresponding elements of src1 and src2. */
+    static double JUCE_CALLTYPE dotProduct (const double* src1, const double* src2, int num) noexcept;
+
     /** This method enables or disables the SSE/NEON flush-to-zero mode. */
     static void JUCE_CALLTYPE enableFlushToZeroMode (bool shouldEnable) noexcept;
 
@@ -228,6 +234,29 @@ public:
     /** This method returns true if denormals are currently disabled. */
     static bool JUCE_CALLTYPE areDenormalsDisabled() noexcept;
 
+    //==============================================================================
+    /** The sets of vector instructions that these functions can be accelerated with. */
+    enum class InstructionSet
+    {
+        none,       /**< Plain loops, with no vector instructions. */
+        sse,        /**< 128-bit SSE registers. */
+        avx2,       /**< 256-bit AVX2 registers. */
+        avx512,     /**< 512-bit AVX-512 registers. */
+        neon        /**< 128-bit ARM NEON registers. */
+    };
+
+    /** Returns the widest set of vector instructions that these functions will use on
+        the machine that the code is running on.
+
+        On Intel CPUs, the AVX2 and AVX-512 versions are always compiled in (unless
+        JUCE_USE_AVX_INTRINSICS is set to 0), and the best one that is supported by both
+        the CPU and the operating system is chosen the first time this is called, so the
+        same binary will make the most of whatever hardware it runs on.
+
+        @see SystemStats::hasAVX2, SystemStats::hasAVX512F
+    */
+    static InstructionSet JUCE_CALLTYPE getInstructionSet() noexcept;
+
 private:
     friend ScopedNoDenormals;
 
@@ -69,6 +69,14 @@
  #undef JUCE_USE_SSE_INTRINSICS
 #endif
 
+#if ! defined (JUCE_USE_AVX_INTRINSICS) && ! JUCE_MINGW
+ #define JUCE_USE_AVX_INTRINSICS 1
+#endif
+
+#if ! JUCE_USE_SSE_INTRINSICS
+ #undef JUCE_USE_AVX_INTRINSICS
+#endif
+
 #if __ARM_NEON__ && ! (JUCE_USE_VDSP_FRAMEWORK || defined (JUCE_USE_ARM_NEON))
  #define JUCE_USE_ARM_NEON 1
 #endif
@@ -90,11 +98,13 @@
 #include "utilities/juce_IIRFilter.h"
 #include "utilities/juce_GenericInterpolator.h"
 #include "utilities/juce_Interpolators.h"
+#include "utilities/juce_SincResampler.h"
 #include "utilities/juce_SmoothedValue.h"
 #include "utilities/juce_Reverb.h"
 #include "utilities/juce_ADSR.h"
 #include "midi/juce_MidiMessage.h"
 #include "midi/juce_MidiBuffer.h"
+#include "midi/juce_FixedCapacityMidiBuffer.h"
 #include "midi/juce_MidiMessageSequence.h"
 #include "midi/juce_MidiFile.h"
 #include "midi/juce_MidiKeyboardState.h"
@@ -0,0 +1,356 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+FixedCapacityMidiBuffer::FixedCapacityMidiBuffer (size_t capacityInBytes)
+{
+    ensureSize (capacityInBytes);
+}
+
+FixedCapacityMidiBuffer::FixedCapacityMidiBuffer (FixedCapacityMidiBuffer&& other) noexcept
+{
+    swapWith (other);
+}
+
+FixedCapacityMidiBuffer& FixedCapacityMidiBuffer::operator= (FixedCapacityMidiBuffer&& other) noexcept
+{
+    swapWith (other);
+    other.clear();
+    return *this;
+}
+
+void FixedCapacityMidiBuffer::ensureSize (size_t minimumNumBytes)
+{
+    if (minimumNumBytes > capacity)
+    {
+        data.realloc (minimumNumBytes);
+        capacity = minimumNumBytes;
+    }
+}
+
+void FixedCapacityMidiBuffer::clear() noexcept
+{
+    numBytesUsed = 0;
+    numEvents = 0;
+    lastEventTime = 0;
+}
+
+void FixedCapacityMidiBuffer::swapWith (FixedCapacityMidiBuffer& other) noexcept
+{
+    data.swapWith (other.data);
+    std::swap (capacity,      other.capacity);
+    std::swap (numBytesUsed,  other.numBytesUsed);
+    std::swap (numEvents,     other.numEvents);
+    std::swap (lastEventTime, other.lastEventTime);
+}
+
+int FixedCapacityMidiBuffer::getFirstEventTime() const noexcept
+{
+    return numBytesUsed > 0 ? MidiBufferHelpers::getEventTime (data.get()) : 0;
+}
+
+//==============================================================================
+bool FixedCapacityMidiBuffer::addRawEvent (const uint8* midiData, int numBytes, int sampleNumber) noexcept
+{
+    const auto itemSize = (size_t) numBytes + sizeof (int32) + sizeof (uint16);
+
+    if (numBytesUsed + itemSize > capacity)
+        return false;
+
+    auto* end = data.get() + numBytesUsed;
+    auto* d = end;
+
+    if (numEvents > 0 && sampleNumber < lastEventTime)
+    {
+        d = MidiBufferHelpers::findEventAfter (data.get(), end, sampleNumber);
+        memmove (d + itemSize, d, (size_t) (end - d));
+    }
+    else
+    {
+        lastEventTime = sampleNumber;
+    }
+
+    writeUnaligned<int32>  (d, sampleNumber);
+    d += sizeof (int32);
+    writeUnaligned<uint16> (d, static_cast<uint16> (numBytes));
+    d += sizeof (uint16);
+    memcpy (d, midiData, (size_t) numBytes);
+
+    numBytesUsed += itemSize;
+    ++numEvents;
+    return true;
+}
+
+bool FixedCapacityMidiBuffer::addEvent (const MidiMessage& m, int sampleNumber) noexcept
+{
+    return addEvent (m.getRawData(), m.getRawDataSize(), sampleNumber);
+}
+
+bool FixedCapacityMidiBuffer::addEvent (const void* newData, int maxBytes, int sampleNumber) noexcept
+{
+    auto* midiData = static_cast<const uint8*> (newData);
+    auto numBytes = MidiBufferHelpers::findActualEventLength (midiData, maxBytes);
+
+    return numBytes <= 0 || addRawEvent (midiData, numBytes, sampleNumber);
+}
+
+template <typename BufferType>
+bool FixedCapacityMidiBuffer::addEventsFrom (const BufferType& otherBuffer, int startSample,
+                                             int numSamples, int sampleDeltaToAdd) noexcept
+{
+    for (auto i = otherBuffer.findNextSamplePosition (startSample); i != otherBuffer.cend(); ++i)
+    {
+        const auto metadata = *i;
+
+        if (metadata.samplePosition >= startSample + numSamples && numSamples >= 0)
+            break;
+
+        if (! addRawEvent (metadata.data, metadata.numBytes, metadata.samplePosition + sampleDeltaToAdd))
+            return false;
+    }
+
+    return true;
+}
+
+bool FixedCapacityMidiBuffer::addEvents (const MidiBuffer& otherBuffer, int startSample,
+                                         int numSamples, int sampleDeltaToAdd) noexcept
+{
+    return addEventsFrom (otherBuffer, startSample, numSamples, sampleDeltaToAdd);
+}
+
+bool FixedCapacityMidiBuffer::addEvents (const FixedCapacityMidiBuffer& otherBuffer, int startSample,
+                                         int numSamples, int sampleDeltaToAdd) noexcept
+{
+    jassert (&otherBuffer != this);
+    return addEventsFrom (otherBuffer, startSample, numSamples, sampleDeltaToAdd);
+}
+
+//==============================================================================
+bool FixedCapacityMidiBuffer::mergeFrom (const Source* sources, int numSources) noexcept
+{
+    // None of the sources can point into this buffer, because it's about to be overwritten!
+    jassert (std::none_of (sources, sources + numSources, [this] (const Source& s)
+                           { return s.begin != s.end && s.begin == cbegin(); }));
+
+    clear();
+
+    constexpr int maxSourcesPerPass = 16;
+    MidiBufferIterator positions[maxSourcesPerPass], ends[maxSourcesPerPass];
+    const auto numInPass = jmin (numSources, maxSourcesPerPass);
+
+    for (int i = 0; i < numInPass; ++i)
+    {
+        positions[i] = sources[i].begin;
+        ends[i] = sources[i].end;
+    }
+
+    for (;;)
+    {
+        int earliest = -1;
+        int earliestTime = 0;
+
+        // Ties go to the earliest source, so events at the same time keep the order of their sources
+        for (int i = 0; i < numInPass; ++i)
+        {
+            if (positions[i] != ends[i])
+            {
+                const auto time = (*positions[i]).samplePosition;
+
+                if (earliest < 0 || time < earliestTime)
+                {
+                    earliest = i;
+                    earliestTime = time;
+                }
+            }
+        }
+
+        if (earliest < 0)
+            break;
+
+        const auto metadata = *positions[earliest]++;
+
+        if (! addRawEvent (metadata.data, metadata.numBytes, metadata.samplePosition))
+            return false;
+    }
+
+    for (int i = numInPass; i < numSources; ++i)
+    {
+        for (auto it = sources[i].begin; it != sources[i].end; ++it)
+        {
+            const auto metadata = *it;
+
+            if (! addRawEvent (metadata.data, metadata.numBytes, metadata.samplePosition))
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool FixedCapacityMidiBuffer::mergeFrom (std::initializer_list<Source> sources) noexcept
+{
+    return mergeFrom (sources.begin(), (int) sources.size());
+}
+
+void FixedCapacityMidiBuffer::copyTo (MidiBuffer& destination) const
+{
+    destination.data.clearQuick();
+    destination.data.addArray (data.get(), (int) numBytesUsed);
+}
+
+MidiBufferIterator FixedCapacityMidiBuffer::findNextSamplePosition (int samplePosition) const noexcept
+{
+    return Source (*this).findNextSamplePosition (samplePosition);
+}
+
+MidiBufferIterator FixedCapacityMidiBuffer::Source::findNextSamplePosition (int samplePosition) const noexcept
+{
+    return std::find_if (begin, end, [&] (const MidiMessageMetadata& metadata) noexcept
+    {
+        return metadata.samplePosition >= samplePosition;
+    });
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class FixedCapacityMidiBufferTests  : public UnitTest
+{
+public:
+    FixedCapacityMidiBufferTests()
+        : UnitTest ("FixedCapacityMidiBuffer", UnitTestCategories::midi)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Events are kept sorted");
+        {
+            FixedCapacityMidiBuffer buffer (1024);
+            MidiBuffer reference;
+
+            auto random = getRandom();
+
+            for (int i = 0; i < 50; ++i)
+            {
+                const auto message = MidiMessage::noteOn (1, random.nextInt (128), (uint8) 100);
+                const auto time = random.nextInt (64);
+
+                expect (buffer.addEvent (message, time));
+                reference.addEvent (message, time);
+            }
+
+            expectEquals (buffer.getNumEvents(), 50);
+            expectEquals (buffer.getFirstEventTime(), reference.getFirstEventTime());
+            expectEquals (buffer.getLastEventTime(), reference.getLastEventTime());
+            expect (buffersMatch (buffer, reference));
+        }
+
+        beginTest ("Events that don't fit are dropped without reallocating");
+        {
+            const auto eventSize = (size_t) 3 + sizeof (int32) + sizeof (uint16);
+            FixedCapacityMidiBuffer buffer (eventSize * 4);
+
+            for (int i = 0; i < 4; ++i)
+                expect (buffer.addEvent (MidiMessage::noteOn (1, 60 + i, (uint8) 100), i));
+
+            expect (! buffer.addEvent (MidiMessage::noteOn (1, 70, (uint8) 100), 10));
+            expect (! buffer.addEvent (MidiMessage::noteOn (1, 70, (uint8) 100), 0));
+
+            expectEquals (buffer.getNumEvents(), 4);
+            expectEquals (buffer.getLastEventTime(), 3);
+            expect (buffer.getCapacity() == eventSize * 4);
+
+            buffer.clear();
+            expect (buffer.isEmpty());
+            expect (buffer.getCapacity() == eventSize * 4);
+        }
+
+        beginTest ("Merging matches MidiBuffer::addEvents");
+        {
+            auto random = getRandom();
+
+            for (auto numSources : { 1, 2, 5, 20 })
+            {
+                std::vector<MidiBuffer> sources ((size_t) numSources);
+
+                for (auto& source : sources)
+                    for (int i = random.nextInt (30); --i >= 0;)
+                        source.addEvent (MidiMessage::controllerEvent (1, random.nextInt (128), random.nextInt (128)),
+                                         random.nextInt (32));
+
+                MidiBuffer reference;
+                std::vector<FixedCapacityMidiBuffer::Source> ranges;
+
+                for (auto& source : sources)
+                {
+                    reference.addEvents (source, 0, -1, 0);
+                    ranges.emplace_back (source);
+                }
+
+                FixedCapacityMidiBuffer merged (4096);
+                expect (merged.mergeFrom (ranges.data(), numSources));
+                expect (buffersMatch (merged, reference));
+
+                MidiBuffer copy;
+                merged.copyTo (copy);
+                expect (buffersMatch (merged, copy));
+            }
+        }
+
+        beginTest ("Sub-ranges can be added with an offset");
+        {
+            MidiBuffer source;
+
+            for (int i = 0; i < 10; ++i)
+                source.addEvent (MidiMessage::noteOff (1, 60 + i), i * 10);
+
+            FixedCapacityMidiBuffer buffer (512);
+            expect (buffer.addEvents (source, 20, 30, -20));
+
+            expectEquals (buffer.getNumEvents(), 3);
+            expectEquals (buffer.getFirstEventTime(), 0);
+            expectEquals (buffer.getLastEventTime(), 20);
+            expectEquals ((*buffer.findNextSamplePosition (5)).samplePosition, 10);
+        }
+    }
+
+private:
+    static bool buffersMatch (const FixedCapacityMidiBuffer& a, const MidiBuffer& b)
+    {
+        return std::equal (a.cbegin(), a.cend(), b.cbegin(), b.cend(),
+                           [] (const MidiMessageMetadata& x, const MidiMessageMetadata& y)
+                           {
+                               return x.samplePosition == y.samplePosition
+                                   && x.numBytes == y.numBytes
+                                   && memcmp (x.data, y.data, (size_t) x.numBytes) == 0;
+                           });
+    }
+};
+
+static FixedCapacityMidiBufferTests fixedCapacityMidiBufferTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,227 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a sequence of time-stamped midi events in a block of memory which is
+    allocated up-front, and never reallocated while events are being added.
+
+    This is an alternative to MidiBuffer for use on the audio thread. Call
+    ensureSize() somewhere like AudioProcessor::prepareToPlay(), and after that,
+    none of the other methods will allocate or free any memory. Events that don't
+    fit into the remaining space are dropped, and the method that tried to add them
+    will return false.
+
+    Events are stored in the same format as a MidiBuffer, so you can iterate over
+    them with a MidiBufferIterator, and pass them to Synthesiser::renderNextBlock()
+    or MPESynthesiserBase::renderNextBlock().
+
+    The buffer is designed to be filled in time order: adding an event whose
+    timestamp is the same as or later than the last one just appends it to the end.
+    Adding an event that's earlier than the last one is still allowed, but has to
+    move the later events along to make room for it.
+
+    To combine several streams of events, mergeFrom() will interleave any number
+    of sorted sources in a single pass.
+
+    @see MidiBuffer, MidiBufferIterator
+
+    @tags{Audio}
+*/
+class JUCE_API  FixedCapacityMidiBuffer
+{
+public:
+    //==============================================================================
+    /** Creates an empty buffer with no space allocated. */
+    FixedCapacityMidiBuffer() noexcept = default;
+
+    /** Creates an empty buffer which can hold the given number of bytes of events.
+        @see ensureSize
+    */
+    explicit FixedCapacityMidiBuffer (size_t capacityInBytes);
+
+    FixedCapacityMidiBuffer (FixedCapacityMidiBuffer&&) noexcept;
+    FixedCapacityMidiBuffer& operator= (FixedCapacityMidiBuffer&&) noexcept;
+
+    //==============================================================================
+    /** Makes sure that the buffer can hold at least this many bytes of events.
+
+        Each event takes up the size of its midi data, plus 6 bytes for its timestamp
+        and length. This may allocate memory, so it shouldn't be called on the audio
+        thread. Any events that are already in the buffer will be kept.
+    */
+    void ensureSize (size_t minimumNumBytes);
+
+    /** Returns the number of bytes that the buffer can hold. */
+    size_t getCapacity() const noexcept                 { return capacity; }
+
+    /** Returns the number of bytes currently used by the events in the buffer. */
+    size_t getNumBytesUsed() const noexcept             { return numBytesUsed; }
+
+    //==============================================================================
+    /** Removes all events from the buffer, without freeing any memory. */
+    void clear() noexcept;
+
+    /** Returns true if the buffer is empty. */
+    bool isEmpty() const noexcept                       { return numBytesUsed == 0; }
+
+    /** Returns the number of events in the buffer. */
+    int getNumEvents() const noexcept                   { return numEvents; }
+
+    /** Returns the sample number of the first event in the buffer.
+        If the buffer's empty, this will just return 0.
+    */
+    int getFirstEventTime() const noexcept;
+
+    /** Returns the sample number of the last event in the buffer.
+        If the buffer's empty, this will just return 0.
+    */
+    int getLastEventTime() const noexcept               { return lastEventTime; }
+
+    //==============================================================================
+    /** Adds an event to the buffer.
+
+        If an event is added whose sample position is the same as one or more events
+        already in the buffer, the new event will be placed after the existing ones.
+
+        @returns false if there wasn't enough space left for the event
+    */
+    bool addEvent (const MidiMessage& midiMessage, int sampleNumber) noexcept;
+
+    /** Adds an event to the buffer from raw midi data.
+
+        The data is inspected in the same way as MidiBuffer::addEvent() to find out
+        the number of bytes that the event really takes up.
+
+        @returns false if there wasn't enough space left for the event
+    */
+    bool addEvent (const void* rawMidiData, int maxBytesOfMidiData, int sampleNumber) noexcept;
+
+    /** Adds some events from a MidiBuffer to this one.
+
+        The arguments behave in the same way as in MidiBuffer::addEvents().
+
+        @returns false if there wasn't enough space left for all of the events
+    */
+    bool addEvents (const MidiBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept;
+
+    /** Adds some events from another FixedCapacityMidiBuffer to this one.
+
+        The arguments behave in the same way as in MidiBuffer::addEvents().
+
+        @returns false if there wasn't enough space left for all of the events
+    */
+    bool addEvents (const FixedCapacityMidiBuffer& otherBuffer, int startSample, int numSamples, int sampleDeltaToAdd) noexcept;
+
+    //==============================================================================
+    /** A sorted range of events, which can be passed to mergeFrom(), or used to
+        render a Synthesiser or MPESynthesiserBase.
+    */
+    struct Source
+    {
+        /** Uses all the events in a MidiBuffer. */
+        Source (const MidiBuffer& b) noexcept                   : begin (b.cbegin()), end (b.cend()) {}
+
+        /** Uses all the events in a FixedCapacityMidiBuffer. */
+        Source (const FixedCapacityMidiBuffer& b) noexcept      : begin (b.cbegin()), end (b.cend()) {}
+
+        /** Uses a range of events from any buffer which stores its events in the MidiBuffer format. */
+        Source (MidiBufferIterator b, MidiBufferIterator e) noexcept  : begin (b), end (e) {}
+
+        /** Returns the first event in the range with a timestamp greater-than or
+            equal-to `samplePosition`.
+        */
+        MidiBufferIterator findNextSamplePosition (int samplePosition) const noexcept;
+
+        MidiBufferIterator begin, end;
+    };
+
+    /** Replaces the contents of this buffer with the events from a set of sources,
+        sorted by their timestamps.
+
+        The sources are combined in a single pass, and each of them must already be
+        sorted, which will always be true for a MidiBuffer or FixedCapacityMidiBuffer.
+        Events with the same timestamp keep the order of the sources that they came from,
+        so merging { a, b } gives the same result as adding all the events in b to a copy
+        of a with MidiBuffer::addEvents(). None of the sources may refer to this buffer.
+
+        Up to 16 sources are merged in one pass; the events of any further sources
+        are then inserted one at a time, which is slower but still won't allocate.
+
+        @returns false if there wasn't enough space for all of the events, in which
+                 case the buffer holds the earliest events that did fit
+    */
+    bool mergeFrom (const Source* sources, int numSources) noexcept;
+
+    /** Replaces the contents of this buffer with the events from a set of sources,
+        sorted by their timestamps.
+        @see mergeFrom
+    */
+    bool mergeFrom (std::initializer_list<Source> sources) noexcept;
+
+    //==============================================================================
+    /** Replaces the contents of a MidiBuffer with the events in this buffer.
+
+        This won't allocate if the MidiBuffer has already been given enough space with
+        MidiBuffer::ensureSize().
+    */
+    void copyTo (MidiBuffer& destination) const;
+
+    //==============================================================================
+    /** Exchanges the contents of this buffer with another one, without allocating. */
+    void swapWith (FixedCapacityMidiBuffer&) noexcept;
+
+    /** Get a read-only iterator pointing to the beginning of this buffer. */
+    MidiBufferIterator begin()  const noexcept { return cbegin(); }
+
+    /** Get a read-only iterator pointing one past the end of this buffer. */
+    MidiBufferIterator end()    const noexcept { return cend(); }
+
+    /** Get a read-only iterator pointing to the beginning of this buffer. */
+    MidiBufferIterator cbegin() const noexcept { return MidiBufferIterator (data.get()); }
+
+    /** Get a read-only iterator pointing one past the end of this buffer. */
+    MidiBufferIterator cend()   const noexcept { return MidiBufferIterator (data.get() + numBytesUsed); }
+
+    /** Get an iterator pointing to the first event with a timestamp greater-than or
+        equal-to `samplePosition`.
+    */
+    MidiBufferIterator findNextSamplePosition (int samplePosition) const noexcept;
+
+private:
+    //==============================================================================
+    HeapBlock<uint8> data;
+    size_t capacity = 0, numBytesUsed = 0;
+    int numEvents = 0, lastEventTime = 0;
+
+    bool addRawEvent (const uint8* midiData, int numBytes, int sampleNumber) noexcept;
+
+    template <typename BufferType>
+    bool addEventsFrom (const BufferType&, int startSample, int numSamples, int sampleDeltaToAdd) noexcept;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FixedCapacityMidiBuffer)
+};
+
+} // namespace juce
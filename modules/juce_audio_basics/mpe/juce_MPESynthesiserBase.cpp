@@ -106,6 +106,25 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
                                           const MidiBuffer& inputMidi,
                                           int startSample,
                                           int numSamples)
+{
+    processNextBlock (outputAudio, inputMidi.findNextSamplePosition (startSample), inputMidi.cend(), startSample, numSamples);
+}
+
+template <typename floatType>
+void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
+                                          const FixedCapacityMidiBuffer::Source& inputMidi,
+                                          int startSample,
+                                          int numSamples)
+{
+    processNextBlock (outputAudio, inputMidi.findNextSamplePosition (startSample), inputMidi.end, startSample, numSamples);
+}
+
+template <typename floatType>
+void MPESynthesiserBase::processNextBlock (AudioBuffer<floatType>& outputAudio,
+                                           MidiBufferIterator midiIterator,
+                                           MidiBufferIterator midiEnd,
+                                           int startSample,
+                                           int numSamples)
 {
     // you must set the sample rate before using this!
     jassert (sampleRate != 0);
@@ -115,9 +134,9 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
     auto prevSample = startSample;
     const auto endSample = startSample + numSamples;
 
-    for (auto it = inputMidi.findNextSamplePosition (startSample); it != inputMidi.cend(); ++it)
+    for (; midiIterator != midiEnd; ++midiIterator)
     {
-        const auto metadata = *it;
+        const auto metadata = *midiIterator;
 
         if (metadata.samplePosition >= endSample)
             break;
@@ -141,6 +160,8 @@ void MPESynthesiserBase::renderNextBlock (AudioBuffer<floatType>& outputAudio,
 // explicit instantiation for supported float types:
 template void MPESynthesiserBase::renderNextBlock<float> (AudioBuffer<float>&, const MidiBuffer&, int, int);
 template void MPESynthesiserBase::renderNextBlock<double> (AudioBuffer<double>&, const MidiBuffer&, int, int);
+template void MPESynthesiserBase::renderNextBlock<float> (AudioBuffer<float>&, const FixedCapacityMidiBuffer::Source&, int, int);
+template void MPESynthesiserBase::renderNextBlock<double> (AudioBuffer<double>&, const FixedCapacityMidiBuffer::Source&, int, int);
 
 //==============================================================================
 void MPESynthesiserBase::setCurrentPlaybackSampleRate (const double newRate)
@@ -103,6 +103,17 @@ public:
                           int startSample,
                           int numSamples);
 
+    /** Creates the next block of audio output, using the midi events from a
+        FixedCapacityMidiBuffer, or any other sorted range of events.
+
+        This behaves in the same way as the version that takes a MidiBuffer.
+    */
+    template <typename floatType>
+    void renderNextBlock (AudioBuffer<floatType>& outputAudio,
+                          const FixedCapacityMidiBuffer::Source& inputMidi,
+                          int startSample,
+                          int numSamples);
+
     //==============================================================================
     /** Handle incoming MIDI events (called from renderNextBlock).
 
@@ -209,6 +220,10 @@ private:
     int minimumSubBlockSize = 32;
     bool subBlockSubdivisionIsStrict = false;
 
+    template <typename floatType>
+    void processNextBlock (AudioBuffer<floatType>&, MidiBufferIterator midiIterator, MidiBufferIterator midiEnd,
+                           int startSample, int numSamples);
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MPESynthesiserBase)
 };
 
@@ -57,9 +57,72 @@ void ResamplingAudioSource::prepareToPlay (int samplesPerBlockExpected, double s
     destBuffers.calloc (numChannels);
     createLowPass (ratio);
 
+    if (useSincResampling)
+    {
+        auto newResamplers = createSincResamplers (sincQuality, ratio);
+        sincResamplers.swapWith (newResamplers);
+
+        auto latency = sincResamplers.getFirst()->getLatencyInSamples();
+
+        if (buffer.getNumSamples() < latency)
+            buffer.setSize (numChannels, latency);
+    }
+
     flushBuffers();
 }
 
+void ResamplingAudioSource::setUsingSincResampling (bool shouldUseSincResampling, SincResampler::Quality quality)
+{
+    // Everything that needs allocating is built before taking the lock, so that the
+    // audio thread is only held up for as long as it takes to swap it in
+    OwnedArray<SincResampler> newResamplers;
+    AudioBuffer<float> newBuffer;
+
+    if (shouldUseSincResampling)
+    {
+        double currentRatio;
+
+        {
+            const SpinLock::ScopedLockType sl (ratioLock);
+            currentRatio = ratio;
+        }
+
+        newResamplers = createSincResamplers (quality, currentRatio);
+
+        // the buffer has to be big enough to read the samples that prime the resamplers
+        auto latency = newResamplers.getFirst()->getLatencyInSamples();
+
+        if (buffer.getNumSamples() < latency)
+            newBuffer.setSize (numChannels, latency);
+    }
+
+    {
+        const ScopedLock sl (callbackLock);
+
+        useSincResampling = shouldUseSincResampling;
+        sincQuality = quality;
+        sincResamplers.swapWith (newResamplers);
+
+        if (newBuffer.getNumSamples() > 0)
+            std::swap (buffer, newBuffer);
+    }
+
+    flushBuffers();
+}
+
+OwnedArray<SincResampler> ResamplingAudioSource::createSincResamplers (SincResampler::Quality quality,
+                                                                      double ratioToSupport) const
+{
+    auto maxRatio = jmin (jmax (2.0, ratioToSupport), SincResampler::maximumSupportedSpeedRatio);
+
+    OwnedArray<SincResampler> resamplers;
+
+    for (int i = 0; i < numChannels; ++i)
+        resamplers.add (new SincResampler (quality, maxRatio));
+
+    return resamplers;
+}
+
 void ResamplingAudioSource::flushBuffers()
 {
     const ScopedLock sl (callbackLock);
@@ -69,6 +132,11 @@ void ResamplingAudioSource::flushBuffers()
     sampsInBuffer = 0;
     subSampleOffset = 0.0;
     resetFilters();
+
+    for (auto* r : sincResamplers)
+        r->reset();
+
+    sincResamplersNeedPriming = true;
 }
 
 void ResamplingAudioSource::releaseResources()
@@ -88,6 +156,12 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
         localRatio = ratio;
     }
 
+    if (useSincResampling && ! sincResamplers.isEmpty())
+    {
+        getNextSincResampledBlock (info, localRatio);
+        return;
+    }
+
     if (lastRatio != localRatio)
     {
         createLowPass (localRatio);
@@ -195,6 +269,42 @@ void ResamplingAudioSource::getNextAudioBlock (const AudioSourceChannelInfo& inf
     jassert (sampsInBuffer >= 0);
 }
 
+void ResamplingAudioSource::getNextSincResampledBlock (const AudioSourceChannelInfo& info, double localRatio)
+{
+    const int channelsToProcess = jmin (numChannels, info.buffer->getNumChannels());
+
+    if (sincResamplersNeedPriming)
+    {
+        auto latency = sincResamplers.getFirst()->getLatencyInSamples();
+
+        AudioSourceChannelInfo readInfo (&buffer, 0, latency);
+        input->getNextAudioBlock (readInfo);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            sincResamplers.getUnchecked (channel)->pushSamples (buffer.getReadPointer (channel), latency);
+
+        sincResamplersNeedPriming = false;
+    }
+
+    // All the channels use the same amount of input, so it's read in one go
+    auto sampsNeeded = sincResamplers.getFirst()->getNumInputSamplesNeeded (localRatio, info.numSamples);
+
+    if (buffer.getNumSamples() < sampsNeeded)
+        buffer.setSize (numChannels, sampsNeeded + 32, false, false, true);
+
+    if (sampsNeeded > 0)
+    {
+        AudioSourceChannelInfo readInfo (&buffer, 0, sampsNeeded);
+        input->getNextAudioBlock (readInfo);
+    }
+
+    for (int channel = 0; channel < channelsToProcess; ++channel)
+        sincResamplers.getUnchecked (channel)->process (localRatio,
+                                                        buffer.getReadPointer (channel),
+                                                        info.buffer->getWritePointer (channel, info.startSample),
+                                                        info.numSamples);
+}
+
 void ResamplingAudioSource::createLowPass (const double frequencyRatio)
 {
     const double proportionalRate = (frequencyRatio > 1.0) ? 0.5 / frequencyRatio
@@ -27,7 +27,11 @@ namespace juce
 /**
     A type of AudioSource that takes an input source and changes its sample rate.
 
-    @see AudioSource, LagrangeInterpolator, CatmullRomInterpolator
+    By default this uses linear interpolation with a simple low-pass filter, which
+    is cheap but lets through some aliasing. Call setUsingSincResampling() to use a
+    SincResampler for each channel instead.
+
+    @see AudioSource, SincResampler, LagrangeInterpolator, CatmullRomInterpolator
 
     @tags{Audio}
 */
@@ -68,6 +72,26 @@ public:
     /** Clears any buffers and filters that the resampler is using. */
     void flushBuffers();
 
+    /** Chooses whether to use a high quality SincResampler rather than linear
+        interpolation.
+
+        The sinc resamplers read ahead by their latency when they start, so the
+        output still lines up with the input. Ratios up to the one that's set when
+        prepareToPlay() is called, or 2.0 if that's higher, will be filtered without
+        any aliasing.
+
+        The new resamplers are built before the audio callback's lock is taken, so this
+        can be called while the source is playing, although it does allocate memory on
+        the calling thread.
+    */
+    void setUsingSincResampling (bool shouldUseSincResampling,
+                                 SincResampler::Quality quality = SincResampler::Quality::high);
+
+    /** Returns true if a SincResampler is being used.
+        @see setUsingSincResampling
+    */
+    bool isUsingSincResampling() const noexcept                 { return useSincResampling; }
+
     //==============================================================================
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
     void releaseResources() override;
@@ -87,6 +111,13 @@ private:
     HeapBlock<float*> destBuffers;
     HeapBlock<const float*> srcBuffers;
 
+    bool useSincResampling = false, sincResamplersNeedPriming = true;
+    SincResampler::Quality sincQuality = SincResampler::Quality::high;
+    OwnedArray<SincResampler> sincResamplers;
+
+    OwnedArray<SincResampler> createSincResamplers (SincResampler::Quality, double ratioToSupport) const;
+    void getNextSincResampledBlock (const AudioSourceChannelInfo&, double localRatio);
+
     void setFilterCoefficients (double c1, double c2, double c3, double c4, double c5, double c6);
     void createLowPass (double proportionalRate);
 
@@ -72,6 +72,44 @@ void SynthesiserVoice::renderNextBlock (AudioBuffer<double>& outputBuffer,
     subBuffer.makeCopyOf (tempBuffer, true);
 }
 
+//==============================================================================
+/*  Shares a block's voices out between the audio thread and the rendering threads.
+    Each slice is a set of voices that are mixed into one of the scratch buffers.
+*/
+struct Synthesiser::RenderSlices  : public RealtimeWorkerPool::Task
+{
+    template <typename RenderSliceFn>
+    void perform (RealtimeWorkerPool& pool, int numSlicesToRender, RenderSliceFn& renderSlice) noexcept
+    {
+        render = [] (void* context, int index) { (*static_cast<RenderSliceFn*> (context)) (index); };
+        context = &renderSlice;
+        numSlices = numSlicesToRender;
+        nextSlice = 0;
+
+        pool.perform (*this);
+    }
+
+    void runConcurrently() noexcept override
+    {
+        const ScopedNoDenormals noDenormals;
+
+        for (;;)
+        {
+            auto index = nextSlice++;
+
+            if (index >= numSlices)
+                return;
+
+            render (context, index);
+        }
+    }
+
+    void (*render) (void*, int) = nullptr;
+    void* context = nullptr;
+    int numSlices = 0;
+    std::atomic<int> nextSlice { 0 };
+};
+
 //==============================================================================
 Synthesiser::Synthesiser()
 {
@@ -83,6 +121,29 @@ Synthesiser::~Synthesiser()
 {
 }
 
+//==============================================================================
+// In the lock-free rendering mode, the event handlers are only allowed to be called
+// from the audio thread, so they can skip the lock.
+struct Synthesiser::OptionalScopedLock
+{
+    explicit OptionalScopedLock (const Synthesiser& s) noexcept
+        : lockToUse (s.lockFreeRendering ? nullptr : &s.lock)
+    {
+        if (lockToUse != nullptr)
+            lockToUse->enter();
+    }
+
+    ~OptionalScopedLock() noexcept
+    {
+        if (lockToUse != nullptr)
+            lockToUse->exit();
+    }
+
+    const CriticalSection* lockToUse;
+
+    JUCE_DECLARE_NON_COPYABLE (OptionalScopedLock)
+};
+
 //==============================================================================
 SynthesiserVoice* Synthesiser::getVoice (const int index) const
 {
@@ -94,19 +155,23 @@ void Synthesiser::clearVoices()
 {
     const ScopedLock sl (lock);
     voices.clear();
+    rebuildVoicePool();
 }
 
 SynthesiserVoice* Synthesiser::addVoice (SynthesiserVoice* const newVoice)
 {
     const ScopedLock sl (lock);
     newVoice->setCurrentPlaybackSampleRate (sampleRate);
-    return voices.add (newVoice);
+    voices.add (newVoice);
+    rebuildVoicePool();
+    return newVoice;
 }
 
 void Synthesiser::removeVoice (const int index)
 {
     const ScopedLock sl (lock);
     voices.remove (index);
+    rebuildVoicePool();
 }
 
 void Synthesiser::clearSounds()
@@ -155,15 +220,21 @@ void Synthesiser::setCurrentPlaybackSampleRate (const double newRate)
 
 template <typename floatType>
 void Synthesiser::processNextBlock (AudioBuffer<floatType>& outputAudio,
-                                    const MidiBuffer& midiData,
+                                    MidiBufferIterator midiIterator,
+                                    MidiBufferIterator midiEnd,
                                     int startSample,
                                     int numSamples)
 {
     // must set the sample rate before using this!
     jassert (sampleRate != 0);
-    const int targetChannels = outputAudio.getNumChannels();
 
-    auto midiIterator = midiData.findNextSamplePosition (startSample);
+    if (lockFreeRendering)
+    {
+        processNextBlockLockFree (outputAudio, midiIterator, midiEnd, startSample, numSamples);
+        return;
+    }
+
+    const int targetChannels = outputAudio.getNumChannels();
 
     bool firstEvent = true;
 
@@ -171,7 +242,7 @@ void Synthesiser::processNextBlock (AudioBuffer<floatType>& outputAudio,
 
     for (; numSamples > 0; ++midiIterator)
     {
-        if (midiIterator == midiData.cend())
+        if (midiIterator == midiEnd)
         {
             if (targetChannels > 0)
                 renderVoices (outputAudio, startSample, numSamples);
@@ -208,24 +279,36 @@ void Synthesiser::processNextBlock (AudioBuffer<floatType>& outputAudio,
     }
 
     std::for_each (midiIterator,
-                   midiData.cend(),
+                   midiEnd,
                    [&] (const MidiMessageMetadata& meta) { handleMidiEvent (meta.getMessage()); });
 }
 
 // explicit template instantiation
-template void Synthesiser::processNextBlock<float>  (AudioBuffer<float>&,  const MidiBuffer&, int, int);
-template void Synthesiser::processNextBlock<double> (AudioBuffer<double>&, const MidiBuffer&, int, int);
+template void Synthesiser::processNextBlock<float>  (AudioBuffer<float>&,  MidiBufferIterator, MidiBufferIterator, int, int);
+template void Synthesiser::processNextBlock<double> (AudioBuffer<double>&, MidiBufferIterator, MidiBufferIterator, int, int);
 
 void Synthesiser::renderNextBlock (AudioBuffer<float>& outputAudio, const MidiBuffer& inputMidi,
                                    int startSample, int numSamples)
 {
-    processNextBlock (outputAudio, inputMidi, startSample, numSamples);
+    processNextBlock (outputAudio, inputMidi.findNextSamplePosition (startSample), inputMidi.cend(), startSample, numSamples);
 }
 
 void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const MidiBuffer& inputMidi,
                                    int startSample, int numSamples)
 {
-    processNextBlock (outputAudio, inputMidi, startSample, numSamples);
+    processNextBlock (outputAudio, inputMidi.findNextSamplePosition (startSample), inputMidi.cend(), startSample, numSamples);
+}
+
+void Synthesiser::renderNextBlock (AudioBuffer<float>& outputAudio, const FixedCapacityMidiBuffer::Source& inputMidi,
+                                   int startSample, int numSamples)
+{
+    processNextBlock (outputAudio, inputMidi.findNextSamplePosition (startSample), inputMidi.end, startSample, numSamples);
+}
+
+void Synthesiser::renderNextBlock (AudioBuffer<double>& outputAudio, const FixedCapacityMidiBuffer::Source& inputMidi,
+                                   int startSample, int numSamples)
+{
+    processNextBlock (outputAudio, inputMidi.findNextSamplePosition (startSample), inputMidi.end, startSample, numSamples);
 }
 
 void Synthesiser::renderVoices (AudioBuffer<float>& buffer, int startSample, int numSamples)
@@ -240,6 +323,234 @@ void Synthesiser::renderVoices (AudioBuffer<double>& buffer, int startSample, in
         voice->renderNextBlock (buffer, startSample, numSamples);
 }
 
+//==============================================================================
+void Synthesiser::enableLockFreeRendering (int maximumBlockSize, int numOutputChannels, int numRenderingThreads)
+{
+    jassert (maximumBlockSize > 0 && numOutputChannels >= 0 && numRenderingThreads >= 0);
+
+    const ScopedLock sl (lock);
+
+    if (postedMessages == nullptr)
+        postedMessages.reset (new MPSCQueue<MidiMessage> (1024));
+
+    maximumBlockSizeForPool = maximumBlockSize;
+    floatScratchBuffers.clear();
+    doubleScratchBuffers.clear();
+
+    if (renderThreads == nullptr || renderThreads->getNumWorkers() != numRenderingThreads)
+        renderThreads.reset (numRenderingThreads > 0 ? new RealtimeWorkerPool ("Synth render thread", numRenderingThreads) : nullptr);
+
+    if (renderSlices == nullptr)
+        renderSlices.reset (new RenderSlices());
+
+    if (renderThreads != nullptr)
+    {
+        // the audio thread renders some of the voices too
+        for (int i = numRenderingThreads + 1; --i >= 0;)
+        {
+            floatScratchBuffers.add (new AudioBuffer<float> (numOutputChannels, maximumBlockSize));
+            doubleScratchBuffers.add (new AudioBuffer<double> (numOutputChannels, maximumBlockSize));
+        }
+    }
+
+    lockFreeRendering = true;
+    rebuildVoicePool();
+}
+
+void Synthesiser::disableLockFreeRendering()
+{
+    const ScopedLock sl (lock);
+
+    // The flag is cleared first, so that postMidiMessage() can tell whether a message
+    // it has just queued will be handled here or whether it must handle it itself
+    lockFreeRendering = false;
+    handlePostedMessages();
+
+    renderThreads.reset();
+    floatScratchBuffers.clear();
+    doubleScratchBuffers.clear();
+    rebuildVoicePool();
+}
+
+bool Synthesiser::postMidiMessage (const MidiMessage& message)
+{
+    if (lockFreeRendering)
+    {
+        if (! postedMessages->push (message))
+            return false;
+
+        if (lockFreeRendering)
+            return true;
+
+        // The mode was switched off while the message was being queued, and it might
+        // have missed being handled by disableLockFreeRendering()
+        const ScopedLock sl (lock);
+        handlePostedMessages();
+        return true;
+    }
+
+    const ScopedLock sl (lock);
+    handleMidiEvent (message);
+    return true;
+}
+
+void Synthesiser::handlePostedMessages()
+{
+    if (postedMessages == nullptr)
+        return;
+
+    MidiMessage message;
+
+    while (postedMessages->pop (message))
+        handleMidiEvent (message);
+}
+
+void Synthesiser::renderVoiceUpToCurrentEvent (SynthesiserVoice* voice)
+{
+    jassert (voice != nullptr);
+
+    if (floatBufferBeingRendered == nullptr && doubleBufferBeingRendered == nullptr)
+        return;
+
+    const auto numSamples = currentEventSample - voice->renderPosition;
+
+    if (numSamples > 0 && voice->isVoiceActive())
+    {
+        if (floatBufferBeingRendered != nullptr)
+            voice->renderNextBlock (*floatBufferBeingRendered, voice->renderPosition, numSamples);
+        else
+            voice->renderNextBlock (*doubleBufferBeingRendered, voice->renderPosition, numSamples);
+    }
+
+    voice->renderPosition = currentEventSample;
+}
+
+template <typename floatType>
+void Synthesiser::processNextBlockLockFree (AudioBuffer<floatType>& outputAudio,
+                                            MidiBufferIterator midiIterator,
+                                            MidiBufferIterator midiEnd,
+                                            int startSample,
+                                            int numSamples)
+{
+    const auto endSample = startSample + numSamples;
+
+    if (outputAudio.getNumChannels() > 0)
+        setBufferBeingRendered (&outputAudio);
+
+    for (int i = 0; i < numActivePooledVoices; ++i)
+        pooledVoices.getUnchecked (i)->renderPosition = startSample;
+
+    currentEventSample = startSample;
+
+    handlePostedMessages();
+
+    for (; midiIterator != midiEnd; ++midiIterator)
+    {
+        const auto metadata = *midiIterator;
+        currentEventSample = jlimit (startSample, endSample, metadata.samplePosition);
+        handleMidiEvent (metadata.getMessage());
+    }
+
+    currentEventSample = endSample;
+
+    if (outputAudio.getNumChannels() > 0)
+    {
+        renderPooledVoicesInParallel (outputAudio, getScratchBuffers (outputAudio), startSample, numSamples);
+
+        for (int i = 0; i < numActivePooledVoices; ++i)
+            renderVoiceUpToCurrentEvent (pooledVoices.getUnchecked (i));
+    }
+
+    setBufferBeingRendered (static_cast<AudioBuffer<floatType>*> (nullptr));
+    releaseFinishedPooledVoices();
+}
+
+template <typename floatType>
+void Synthesiser::renderPooledVoicesInParallel (AudioBuffer<floatType>& outputAudio,
+                                                OwnedArray<AudioBuffer<floatType>>& scratchBuffers,
+                                                int startSample, int numSamples)
+{
+    // Below this, handing the voices to other threads costs more than it saves
+    constexpr int minVoicesPerThread = 4;
+
+    const auto numThreadsToUse = jmin (scratchBuffers.size(), numActivePooledVoices / minVoicesPerThread);
+
+    if (numThreadsToUse < 2 || renderThreads == nullptr || numSamples > maximumBlockSizeForPool)
+        return;
+
+    // the buffers being rendered need to have the number of channels that was passed to enableLockFreeRendering()
+    jassert (outputAudio.getNumChannels() == scratchBuffers.getUnchecked (0)->getNumChannels());
+
+    if (outputAudio.getNumChannels() != scratchBuffers.getUnchecked (0)->getNumChannels())
+        return;
+
+    auto renderSlice = [&] (int thread)
+    {
+        auto& scratch = *scratchBuffers.getUnchecked (thread);
+        scratch.clear (0, numSamples);
+
+        for (int i = thread; i < numActivePooledVoices; i += numThreadsToUse)
+        {
+            auto* voice = pooledVoices.getUnchecked (i);
+            const auto voiceStart = voice->renderPosition - startSample;
+
+            if (voiceStart < numSamples && voice->isVoiceActive())
+                voice->renderNextBlock (scratch, voiceStart, numSamples - voiceStart);
+
+            voice->renderPosition = currentEventSample;
+        }
+    };
+
+    renderSlices->perform (*renderThreads, numThreadsToUse, renderSlice);
+
+    for (int i = 0; i < numThreadsToUse; ++i)
+        for (int ch = 0; ch < outputAudio.getNumChannels(); ++ch)
+            outputAudio.addFrom (ch, startSample, *scratchBuffers.getUnchecked (i), ch, 0, numSamples);
+}
+
+void Synthesiser::rebuildVoicePool()
+{
+    pooledVoices.clearQuick();
+    numActivePooledVoices = 0;
+
+    if (! lockFreeRendering)
+        return;
+
+    pooledVoices.ensureStorageAllocated (voices.size());
+
+    for (auto* voice : voices)
+    {
+        voice->poolIndex = pooledVoices.size();
+        pooledVoices.add (voice);
+
+        if (voice->isVoiceActive())
+            markPooledVoiceAsActive (voice);
+    }
+}
+
+void Synthesiser::swapPooledVoices (int index1, int index2) noexcept
+{
+    pooledVoices.swap (index1, index2);
+    pooledVoices.getUnchecked (index1)->poolIndex = index1;
+    pooledVoices.getUnchecked (index2)->poolIndex = index2;
+}
+
+void Synthesiser::markPooledVoiceAsActive (SynthesiserVoice* voice) noexcept
+{
+    // The voices that are playing are kept at the start of the pool, and the free ones after them
+    jassert (pooledVoices[voice->poolIndex] == voice);
+
+    if (voice->poolIndex >= numActivePooledVoices)
+        swapPooledVoices (voice->poolIndex, numActivePooledVoices++);
+}
+
+void Synthesiser::releaseFinishedPooledVoices() noexcept
+{
+    for (int i = numActivePooledVoices; --i >= 0;)
+        if (! pooledVoices.getUnchecked (i)->isVoiceActive())
+            swapPooledVoices (i, --numActivePooledVoices);
+}
+
 void Synthesiser::handleMidiEvent (const MidiMessage& m)
 {
     const int channel = m.getChannel();
@@ -285,7 +596,7 @@ void Synthesiser::noteOn (const int midiChannel,
                           const int midiNoteNumber,
                           const float velocity)
 {
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
     for (auto* sound : sounds)
     {
@@ -311,6 +622,11 @@ void Synthesiser::startVoice (SynthesiserVoice* const voice,
 {
     if (voice != nullptr && sound != nullptr)
     {
+        renderVoiceUpToCurrentEvent (voice);
+
+        if (lockFreeRendering)
+            markPooledVoiceAsActive (voice);
+
         if (voice->currentlyPlayingSound != nullptr)
             voice->stopNote (0.0f, false);
 
@@ -331,6 +647,7 @@ void Synthesiser::stopVoice (SynthesiserVoice* voice, float velocity, const bool
 {
     jassert (voice != nullptr);
 
+    renderVoiceUpToCurrentEvent (voice);
     voice->stopNote (velocity, allowTailOff);
 
     // the subclass MUST call clearCurrentNote() if it's not tailing off! RTFM for stopNote()!
@@ -342,7 +659,7 @@ void Synthesiser::noteOff (const int midiChannel,
                            const float velocity,
                            const bool allowTailOff)
 {
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
     for (auto* voice : voices)
     {
@@ -368,22 +685,32 @@ void Synthesiser::noteOff (const int midiChannel,
 
 void Synthesiser::allNotesOff (const int midiChannel, const bool allowTailOff)
 {
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
     for (auto* voice : voices)
+    {
         if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
+        {
+            renderVoiceUpToCurrentEvent (voice);
             voice->stopNote (1.0f, allowTailOff);
+        }
+    }
 
     sustainPedalsDown.clear();
 }
 
 void Synthesiser::handlePitchWheel (const int midiChannel, const int wheelValue)
 {
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
     for (auto* voice : voices)
+    {
         if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
+        {
+            renderVoiceUpToCurrentEvent (voice);
             voice->pitchWheelMoved (wheelValue);
+        }
+    }
 }
 
 void Synthesiser::handleController (const int midiChannel,
@@ -398,36 +725,51 @@ void Synthesiser::handleController (const int midiChannel,
         default:    break;
     }
 
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
     for (auto* voice : voices)
+    {
         if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
+        {
+            renderVoiceUpToCurrentEvent (voice);
             voice->controllerMoved (controllerNumber, controllerValue);
+        }
+    }
 }
 
 void Synthesiser::handleAftertouch (int midiChannel, int midiNoteNumber, int aftertouchValue)
 {
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
     for (auto* voice : voices)
+    {
         if (voice->getCurrentlyPlayingNote() == midiNoteNumber
               && (midiChannel <= 0 || voice->isPlayingChannel (midiChannel)))
+        {
+            renderVoiceUpToCurrentEvent (voice);
             voice->aftertouchChanged (aftertouchValue);
+        }
+    }
 }
 
 void Synthesiser::handleChannelPressure (int midiChannel, int channelPressureValue)
 {
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
     for (auto* voice : voices)
+    {
         if (midiChannel <= 0 || voice->isPlayingChannel (midiChannel))
+        {
+            renderVoiceUpToCurrentEvent (voice);
             voice->channelPressureChanged (channelPressureValue);
+        }
+    }
 }
 
 void Synthesiser::handleSustainPedal (int midiChannel, bool isDown)
 {
     jassert (midiChannel > 0 && midiChannel <= 16);
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
     if (isDown)
     {
@@ -457,7 +799,7 @@ void Synthesiser::handleSustainPedal (int midiChannel, bool isDown)
 void Synthesiser::handleSostenutoPedal (int midiChannel, bool isDown)
 {
     jassert (midiChannel > 0 && midiChannel <= 16);
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
     for (auto* voice : voices)
     {
@@ -488,11 +830,34 @@ SynthesiserVoice* Synthesiser::findFreeVoice (SynthesiserSound* soundToPlay,
                                               int midiChannel, int midiNoteNumber,
                                               const bool stealIfNoneAvailable) const
 {
-    const ScopedLock sl (lock);
+    const OptionalScopedLock sl (*this);
 
-    for (auto* voice : voices)
-        if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
-            return voice;
+    if (lockFreeRendering)
+    {
+        // Normally the first free voice will do, but voices that have finished during
+        // the current block won't have been moved out of the playing part of the pool yet
+        for (int i = numActivePooledVoices; i < pooledVoices.size(); ++i)
+        {
+            auto* voice = pooledVoices.getUnchecked (i);
+
+            if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
+                return voice;
+        }
+
+        for (int i = 0; i < numActivePooledVoices; ++i)
+        {
+            auto* voice = pooledVoices.getUnchecked (i);
+
+            if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
+                return voice;
+        }
+    }
+    else
+    {
+        for (auto* voice : voices)
+            if ((! voice->isVoiceActive()) && voice->canPlaySound (soundToPlay))
+                return voice;
+    }
 
     if (stealIfNoneAvailable)
         return findVoiceToSteal (soundToPlay, midiChannel, midiNoteNumber);
@@ -582,4 +947,235 @@ SynthesiserVoice* Synthesiser::findVoiceToSteal (SynthesiserSound* soundToPlay,
     return low;
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SynthesiserTests  : public UnitTest
+{
+public:
+    SynthesiserTests()
+        : UnitTest ("Synthesiser", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Events are sample-accurate in the lock-free mode");
+        {
+            Synthesiser synth;
+            setUpSynth (synth, 4, false);
+            synth.enableLockFreeRendering (blockSize, 2);
+            synth.setMinimumRenderingSubdivisionSize (32, true);
+
+            MidiBuffer midi;
+            midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), 5);
+            midi.addEvent (MidiMessage::noteOn (1, 64, 1.0f), 6);
+            midi.addEvent (MidiMessage::noteOff (1, 60), 37);
+
+            AudioBuffer<float> buffer (2, blockSize);
+            buffer.clear();
+            synth.renderNextBlock (buffer, midi, 0, blockSize);
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                int numWrong = 0;
+
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    auto expected = (i >= 5 && i < 37 ? getLevel (60) : 0.0f)
+                                      + (i >= 6 ? getLevel (64) : 0.0f);
+
+                    if (! approximatelyEqual (buffer.getSample (ch, i), expected))
+                        ++numWrong;
+                }
+
+                expectEquals (numWrong, 0);
+            }
+
+            expectEquals (getNumActiveVoices (synth), 1);
+        }
+
+        beginTest ("Voices are reused and stolen from the pool");
+        {
+            Synthesiser synth;
+            setUpSynth (synth, 4, false);
+            synth.enableLockFreeRendering (blockSize, 2);
+            synth.setNoteStealingEnabled (false);
+
+            AudioBuffer<float> buffer (2, blockSize);
+            MidiBuffer midi;
+
+            for (int note = 60; note < 65; ++note)
+                midi.addEvent (MidiMessage::noteOn (1, note, 1.0f), note - 60);
+
+            synth.renderNextBlock (buffer, midi, 0, blockSize);
+            expectEquals (getNumActiveVoices (synth), 4);
+            expect (! isPlayingNote (synth, 64));
+
+            midi.clear();
+            midi.addEvent (MidiMessage::noteOff (1, 61), 0);
+            midi.addEvent (MidiMessage::noteOn (1, 70, 1.0f), 1);
+            synth.renderNextBlock (buffer, midi, 0, blockSize);
+            expectEquals (getNumActiveVoices (synth), 4);
+            expect (isPlayingNote (synth, 70));
+            expect (! isPlayingNote (synth, 61));
+
+            synth.setNoteStealingEnabled (true);
+            midi.clear();
+            midi.addEvent (MidiMessage::noteOn (1, 71, 1.0f), 0);
+            synth.renderNextBlock (buffer, midi, 0, blockSize);
+            expectEquals (getNumActiveVoices (synth), 4);
+            expect (isPlayingNote (synth, 71));
+        }
+
+        beginTest ("Posted messages are handled at the start of the next block");
+        {
+            Synthesiser synth;
+            setUpSynth (synth, 4, false);
+            synth.enableLockFreeRendering (blockSize, 2);
+
+            expect (synth.postMidiMessage (MidiMessage::noteOn (1, 60, 1.0f)));
+            expectEquals (getNumActiveVoices (synth), 0);
+
+            AudioBuffer<double> buffer (2, blockSize);
+            buffer.clear();
+            synth.renderNextBlock (buffer, MidiBuffer(), 0, blockSize);
+
+            expectEquals (getNumActiveVoices (synth), 1);
+            expect (approximatelyEqual (buffer.getSample (1, 0), (double) getLevel (60)));
+
+            // Switching the mode off handles anything still in the queue, and later
+            // messages are handled straight away
+            expect (synth.postMidiMessage (MidiMessage::noteOn (1, 61, 1.0f)));
+            synth.disableLockFreeRendering();
+            expectEquals (getNumActiveVoices (synth), 2);
+
+            expect (synth.postMidiMessage (MidiMessage::noteOn (1, 62, 1.0f)));
+            expectEquals (getNumActiveVoices (synth), 3);
+        }
+
+        beginTest ("Rendering on several threads matches rendering on one thread");
+        {
+            const int numVoices = 64;
+
+            Synthesiser serialSynth, parallelSynth;
+            setUpSynth (serialSynth, numVoices, true);
+            setUpSynth (parallelSynth, numVoices, true);
+            serialSynth.enableLockFreeRendering (blockSize, 2);
+            parallelSynth.enableLockFreeRendering (blockSize, 2, 3);
+
+            AudioBuffer<float> serialBuffer (2, blockSize * 2), parallelBuffer (2, blockSize * 2);
+
+            for (int block = 0; block < 8; ++block)
+            {
+                MidiBuffer midi;
+
+                for (int i = 0; i < 10; ++i)
+                    midi.addEvent (MidiMessage::noteOn (1, 20 + (block * 10 + i) % numVoices, 0.5f),
+                                   blockSize / 2 + i * 3);
+
+                midi.addEvent (MidiMessage::noteOff (1, 20 + block), blockSize / 2 + 7);
+
+                serialBuffer.clear();
+                parallelBuffer.clear();
+                serialSynth.renderNextBlock (serialBuffer, midi, blockSize / 2, blockSize);
+                parallelSynth.renderNextBlock (parallelBuffer, midi, blockSize / 2, blockSize);
+
+                for (int ch = 0; ch < 2; ++ch)
+                    for (int i = 0; i < blockSize * 2; ++i)
+                        expectWithinAbsoluteError (parallelBuffer.getSample (ch, i), serialBuffer.getSample (ch, i), 1.0e-4f);
+            }
+
+            expectEquals (getNumActiveVoices (parallelSynth), getNumActiveVoices (serialSynth));
+            expectGreaterThan (getNumActiveVoices (parallelSynth), 8);
+        }
+    }
+
+private:
+    static constexpr int blockSize = 64;
+
+    static float getLevel (int note)    { return (float) note / 128.0f; }
+
+    struct TestSound  : public SynthesiserSound
+    {
+        bool appliesToNote (int) override       { return true; }
+        bool appliesToChannel (int) override    { return true; }
+    };
+
+    // Plays a level that depends on the note, or a ramp that depends on the note
+    // and the number of samples it's been playing for
+    struct TestVoice  : public SynthesiserVoice
+    {
+        explicit TestVoice (bool shouldRamp) : ramps (shouldRamp) {}
+
+        bool canPlaySound (SynthesiserSound*) override          { return true; }
+        void pitchWheelMoved (int) override                     {}
+        void controllerMoved (int, int) override                {}
+
+        void startNote (int note, float, SynthesiserSound*, int) override
+        {
+            level = getLevel (note);
+            numSamplesPlayed = 0;
+        }
+
+        void stopNote (float, bool) override
+        {
+            clearCurrentNote();
+        }
+
+        void renderNextBlock (AudioBuffer<float>& buffer, int startSample, int numSamples) override
+        {
+            if (! isVoiceActive())
+                return;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto value = ramps ? level * std::sin ((float) numSamplesPlayed++ * level) : level;
+
+                for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                    buffer.addSample (ch, startSample + i, value);
+            }
+        }
+
+        using SynthesiserVoice::renderNextBlock;
+
+        bool ramps;
+        float level = 0;
+        int numSamplesPlayed = 0;
+    };
+
+    static void setUpSynth (Synthesiser& synth, int numVoices, bool voicesShouldRamp)
+    {
+        for (int i = 0; i < numVoices; ++i)
+            synth.addVoice (new TestVoice (voicesShouldRamp));
+
+        synth.addSound (new TestSound());
+        synth.setCurrentPlaybackSampleRate (44100.0);
+    }
+
+    static int getNumActiveVoices (Synthesiser& synth)
+    {
+        int numActive = 0;
+
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            if (synth.getVoice (i)->isVoiceActive())
+                ++numActive;
+
+        return numActive;
+    }
+
+    static bool isPlayingNote (Synthesiser& synth, int note)
+    {
+        for (int i = 0; i < synth.getNumVoices(); ++i)
+            if (synth.getVoice (i)->getCurrentlyPlayingNote() == note)
+                return true;
+
+        return false;
+    }
+};
+
+static SynthesiserTests synthesiserTests;
+
+#endif
+
 } // namespace juce
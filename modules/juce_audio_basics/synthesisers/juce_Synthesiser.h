@@ -271,6 +271,7 @@ private:
     uint32 noteOnTime = 0;
     SynthesiserSound::Ptr currentlyPlayingSound;
     bool keyIsDown = false, sustainPedalDown = false, sostenutoPedalDown = false;
+    int renderPosition = 0, poolIndex = -1;
 
     AudioBuffer<float> tempBuffer;
 
@@ -530,6 +531,21 @@ public:
                           int startSample,
                           int numSamples);
 
+    /** Creates the next block of audio output, using the midi events from a
+        FixedCapacityMidiBuffer, or any other sorted range of events.
+
+        This behaves in the same way as the version that takes a MidiBuffer.
+    */
+    void renderNextBlock (AudioBuffer<float>& outputAudio,
+                          const FixedCapacityMidiBuffer::Source& inputMidi,
+                          int startSample,
+                          int numSamples);
+
+    void renderNextBlock (AudioBuffer<double>& outputAudio,
+                          const FixedCapacityMidiBuffer::Source& inputMidi,
+                          int startSample,
+                          int numSamples);
+
     /** Returns the current target sample rate at which rendering is being done.
         Subclasses may need to know this so that they can pitch things correctly.
     */
@@ -557,6 +573,78 @@ public:
     */
     void setMinimumRenderingSubdivisionSize (int numSamples, bool shouldBeStrict = false) noexcept;
 
+    //==============================================================================
+    /** Switches the synth into its lock-free rendering mode.
+
+        In this mode, renderNextBlock() doesn't split the block up between the midi events.
+        Instead, whenever an event is about to change a voice, just that voice is rendered
+        up to the event's position first, so every event is sample-accurate, and voices
+        that aren't affected by any events are rendered for the whole block in one go.
+        The minimum subdivision size is ignored.
+
+        The voices are kept in a pool which is split into playing and free voices, so
+        finding a free voice for a new note doesn't need to search through all of them,
+        and only the playing voices get rendered.
+
+        If you ask for some rendering threads, then when there are enough voices playing,
+        they'll be shared out between the audio thread and the rendering threads and rendered
+        in parallel, each thread mixing its voices into a buffer of its own, which are then
+        added together. The threads are started by this method, and handing a block to them
+        doesn't allocate or take any locks, but they'll use some CPU spinning while they wait
+        for the next block. Your voices must be able to render at the same time as each other
+        for this to work, and the output buffers must have numOutputChannels channels.
+
+        The rendering code doesn't take the synth's lock in this mode, so while audio is
+        running, you mustn't add or remove voices and sounds, or call methods like noteOn()
+        from any other thread. Use postMidiMessage() to send events from other threads.
+
+        This allocates some memory, and changes things that the rendering code uses
+        without taking the lock, so it must not be called while audio is being rendered.
+        Call it before you start rendering, e.g. in your prepareToPlay() method. The same
+        goes for calling it again to change the number of threads.
+
+        Note that in this mode renderVoices() isn't used. If your subclass talks to its
+        voices directly from its event handling methods, it should call
+        renderVoiceUpToCurrentEvent() before making any changes to a voice.
+
+        @param maximumBlockSize     the largest number of samples that will be rendered at once
+        @param numOutputChannels    the number of channels in the buffers that will be rendered
+        @param numRenderingThreads  the number of extra threads to render voices on. If this is
+                                    0, all the voices are rendered on the audio thread
+        @see disableLockFreeRendering, postMidiMessage
+    */
+    void enableLockFreeRendering (int maximumBlockSize,
+                                  int numOutputChannels,
+                                  int numRenderingThreads = 0);
+
+    /** Switches the synth back to the normal rendering mode.
+
+        Any messages that are still waiting in the postMidiMessage() queue are handled
+        straight away. Like enableLockFreeRendering(), this frees things that the
+        rendering code uses without taking the lock, so it must not be called while
+        audio is being rendered, e.g. call it from your releaseResources() method.
+
+        @see enableLockFreeRendering
+    */
+    void disableLockFreeRendering();
+
+    /** Returns true if the lock-free rendering mode is enabled.
+        @see enableLockFreeRendering
+    */
+    bool isLockFreeRenderingEnabled() const noexcept                { return lockFreeRendering.load(); }
+
+    /** Sends a midi message to the synth from any thread.
+
+        In the lock-free rendering mode, the message is added to a queue without taking any
+        locks, and is handled at the start of the next block that gets rendered. Otherwise,
+        it's handled straight away.
+
+        Sysex messages will allocate memory, so it's best to only use this for short messages.
+
+        @returns false if the queue was full, and the message was dropped
+    */
+    bool postMidiMessage (const MidiMessage& message);
+
 protected:
     //==============================================================================
     /** This is used to control access to the rendering callback and the note trigger methods. */
@@ -619,6 +707,17 @@ protected:
     /** Can be overridden to do custom handling of incoming midi events. */
     virtual void handleMidiEvent (const MidiMessage&);
 
+    /** In the lock-free rendering mode, this renders a voice up to the position of the
+        event that's currently being handled.
+
+        The built-in event handlers call this before they change a voice, so that the
+        changes start at the right sample. If you override them and change any voices
+        yourself, you should call it first too. Outside of rendering, it does nothing.
+
+        @see enableLockFreeRendering
+    */
+    void renderVoiceUpToCurrentEvent (SynthesiserVoice* voice);
+
 private:
     //==============================================================================
     double sampleRate = 0;
@@ -628,8 +727,43 @@ private:
     bool shouldStealNotes = true;
     BigInteger sustainPedalsDown;
 
+    struct OptionalScopedLock;
+
+    struct RenderSlices;
+
+    std::atomic<bool> lockFreeRendering { false };
+    Array<SynthesiserVoice*> pooledVoices;
+    int numActivePooledVoices = 0, maximumBlockSizeForPool = 0, currentEventSample = 0;
+    std::unique_ptr<RealtimeWorkerPool> renderThreads;
+    std::unique_ptr<RenderSlices> renderSlices;
+    OwnedArray<AudioBuffer<float>> floatScratchBuffers;
+    OwnedArray<AudioBuffer<double>> doubleScratchBuffers;
+    AudioBuffer<float>* floatBufferBeingRendered = nullptr;
+    AudioBuffer<double>* doubleBufferBeingRendered = nullptr;
+    std::unique_ptr<MPSCQueue<MidiMessage>> postedMessages;
+
+    template <typename floatType>
+    void processNextBlock (AudioBuffer<floatType>&, MidiBufferIterator midiIterator, MidiBufferIterator midiEnd,
+                           int startSample, int numSamples);
+
+    template <typename floatType>
+    void processNextBlockLockFree (AudioBuffer<floatType>&, MidiBufferIterator midiIterator, MidiBufferIterator midiEnd,
+                                   int startSample, int numSamples);
+
     template <typename floatType>
-    void processNextBlock (AudioBuffer<floatType>&, const MidiBuffer&, int startSample, int numSamples);
+    void renderPooledVoicesInParallel (AudioBuffer<floatType>&, OwnedArray<AudioBuffer<floatType>>& scratchBuffers,
+                                       int startSample, int numSamples);
+
+    void setBufferBeingRendered (AudioBuffer<float>* b) noexcept                { floatBufferBeingRendered = b; }
+    void setBufferBeingRendered (AudioBuffer<double>* b) noexcept               { doubleBufferBeingRendered = b; }
+    OwnedArray<AudioBuffer<float>>&  getScratchBuffers (AudioBuffer<float>&) noexcept   { return floatScratchBuffers; }
+    OwnedArray<AudioBuffer<double>>& getScratchBuffers (AudioBuffer<double>&) noexcept  { return doubleScratchBuffers; }
+
+    void rebuildVoicePool();
+    void handlePostedMessages();
+    void swapPooledVoices (int, int) noexcept;
+    void markPooledVoiceAsActive (SynthesiserVoice*) noexcept;
+    void releaseFinishedPooledVoices() noexcept;
 
    #if JUCE_CATCH_DEPRECATED_CODE_MISUSE
     // Note the new parameters for these methods.
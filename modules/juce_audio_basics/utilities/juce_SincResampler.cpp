@@ -0,0 +1,518 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+// The prototype filter is a Kaiser-windowed sinc spanning numHalfTaps zero crossings
+// either side of its centre. Its cutoff is pulled down a little below Nyquist so that
+// the transition band finishes at Nyquist rather than straddling it.
+struct SincResampler::FilterTables
+{
+    FilterTables (int halfTaps, int phases, double beta, double rolloff)
+        : numHalfTaps (halfTaps), numPhases (phases)
+    {
+        auto numTaps = 2 * numHalfTaps;
+        auto tableSize = numHalfTaps * numPhases;
+
+        // One side of the impulse response, used to build the stretched filters for downsampling
+        impulse.malloc (tableSize + 1);
+
+        for (int i = 0; i <= tableSize; ++i)
+            impulse[i] = (float) getImpulseValue ((double) i / numPhases, beta, rolloff);
+
+        // The polyphase bank, with one extra row so that the last phase can be interpolated
+        bank.malloc ((numPhases + 1) * numTaps);
+
+        for (int phase = 0; phase <= numPhases; ++phase)
+        {
+            auto* row = bank + phase * numTaps;
+            double sum = 0;
+
+            for (int tap = 0; tap < numTaps; ++tap)
+            {
+                auto value = getImpulseValue ((double) (numHalfTaps - 1 - tap) + (double) phase / numPhases, beta, rolloff);
+                row[tap] = (float) value;
+                sum += value;
+            }
+
+            // normalise each phase so that none of them change the gain at DC
+            FloatVectorOperations::multiply (row, (float) (1.0 / sum), numTaps);
+        }
+    }
+
+    double getImpulseValue (double x, double beta, double rolloff) const noexcept
+    {
+        auto proportion = x / numHalfTaps;
+
+        if (proportion <= -1.0 || proportion >= 1.0)
+            return 0.0;
+
+        auto window = besselI0 (beta * std::sqrt (1.0 - proportion * proportion)) / besselI0 (beta);
+        auto sincPosition = MathConstants<double>::pi * rolloff * x;
+
+        return rolloff * window * (x == 0.0 ? 1.0 : std::sin (sincPosition) / sincPosition);
+    }
+
+    static double besselI0 (double x) noexcept
+    {
+        double result = 1.0, term = 1.0;
+        auto halfX = x * 0.5;
+
+        for (int k = 1; k < 50; ++k)
+        {
+            term *= (halfX / k) * (halfX / k);
+            result += term;
+
+            if (term < result * 1.0e-12)
+                break;
+        }
+
+        return result;
+    }
+
+    const int numHalfTaps, numPhases;
+    HeapBlock<float> impulse, bank;
+
+    JUCE_DECLARE_NON_COPYABLE (FilterTables)
+};
+
+const SincResampler::FilterTables& SincResampler::getFilterTables (Quality q)
+{
+    switch (q)
+    {
+        case Quality::low:      { static const FilterTables tables (8,  128,  5.65,  0.77); return tables; }
+        case Quality::medium:   { static const FilterTables tables (16, 256,  7.86,  0.84); return tables; }
+        case Quality::best:     { static const FilterTables tables (64, 1024, 12.26, 0.94); return tables; }
+        case Quality::high:
+        default:                break;
+    }
+
+    static const FilterTables tables (32, 512, 10.06, 0.9);
+    return tables;
+}
+
+//==============================================================================
+SincResampler::SincResampler (Quality q, double maximumSpeedRatio)
+{
+    setQuality (q, maximumSpeedRatio);
+}
+
+SincResampler::~SincResampler() {}
+
+SincResampler::SincResampler (SincResampler&&) noexcept = default;
+SincResampler& SincResampler::operator= (SincResampler&&) noexcept = default;
+
+void SincResampler::setQuality (Quality newQuality, double newMaximumSpeedRatio)
+{
+    jassert (newMaximumSpeedRatio <= maximumSupportedSpeedRatio);
+
+    quality = newQuality;
+    tables = &getFilterTables (newQuality);
+    maxSpeedRatio = jlimit (1.0, maximumSupportedSpeedRatio, newMaximumSpeedRatio);
+
+    // The stretched filter needs this many samples either side of the output position,
+    // and older samples are moved back to the start of the history when it fills up.
+    latency = (int) std::ceil (tables->numHalfTaps * maxSpeedRatio);
+    numToKeep = 2 * latency;
+    historySize = numToKeep + 1024;
+
+    history.malloc (historySize);
+
+    // Enough space for the stretched bank at any ratio up to the maximum, so that
+    // changing the ratio never needs to allocate
+    auto numHalfTaps = tables->numHalfTaps;
+    auto numPhases = tables->numPhases;
+    stretchedBank.malloc (2 * numHalfTaps * numPhases + 2 * numPhases + 4 * latency + 4);
+    stretchedRatio = 0;
+
+    reset();
+}
+
+void SincResampler::reset() noexcept
+{
+    FloatVectorOperations::clear (history, numToKeep);
+    numInHistory = numToKeep;
+    subSamplePos = 1.0;
+}
+
+//==============================================================================
+int SincResampler::getNumInputSamplesNeeded (double speedRatio, int numOutputSamplesToProduce) const noexcept
+{
+    auto pos = subSamplePos;
+    int numNeeded = 0;
+
+    for (int i = 0; i < numOutputSamplesToProduce; ++i)
+    {
+        while (pos >= 1.0)
+        {
+            ++numNeeded;
+            pos -= 1.0;
+        }
+
+        pos += speedRatio;
+    }
+
+    return numNeeded;
+}
+
+int SincResampler::getNumOutputSamplesAvailable (double speedRatio, int numInputSamplesAvailable) const noexcept
+{
+    auto pos = subSamplePos;
+    int numUsed = 0, numOutput = 0;
+
+    for (;;)
+    {
+        while (pos >= 1.0)
+        {
+            if (++numUsed > numInputSamplesAvailable)
+                return numOutput;
+
+            pos -= 1.0;
+        }
+
+        pos += speedRatio;
+        ++numOutput;
+    }
+}
+
+void SincResampler::pushSamples (const float* inputSamples, int numSamples) noexcept
+{
+    while (numSamples > 0)
+    {
+        if (numInHistory == historySize)
+        {
+            memmove (history, history + (historySize - numToKeep), sizeof (float) * (size_t) numToKeep);
+            numInHistory = numToKeep;
+        }
+
+        auto numToCopy = jmin (numSamples, historySize - numInHistory);
+        FloatVectorOperations::copy (history + numInHistory, inputSamples, numToCopy);
+
+        numInHistory += numToCopy;
+        inputSamples += numToCopy;
+        numSamples -= numToCopy;
+    }
+}
+
+forcedinline void SincResampler::pushSample (float newValue) noexcept
+{
+    if (numInHistory == historySize)
+    {
+        memmove (history, history + (historySize - numToKeep), sizeof (float) * (size_t) numToKeep);
+        numInHistory = numToKeep;
+    }
+
+    history[numInHistory++] = newValue;
+}
+
+//==============================================================================
+int SincResampler::process (double speedRatio, const float* inputSamples, float* outputSamples,
+                            int numOutputSamplesToProduce) noexcept
+{
+    return resample<false> (speedRatio, inputSamples, outputSamples, numOutputSamplesToProduce,
+                            std::numeric_limits<int>::max(), 1.0f);
+}
+
+int SincResampler::process (double speedRatio, const float* inputSamples, float* outputSamples,
+                            int numOutputSamplesToProduce, int numInputSamplesAvailable) noexcept
+{
+    return resample<false> (speedRatio, inputSamples, outputSamples, numOutputSamplesToProduce,
+                            numInputSamplesAvailable, 1.0f);
+}
+
+int SincResampler::processAdding (double speedRatio, const float* inputSamples, float* outputSamples,
+                                  int numOutputSamplesToProduce, float gain) noexcept
+{
+    return resample<true> (speedRatio, inputSamples, outputSamples, numOutputSamplesToProduce,
+                           std::numeric_limits<int>::max(), gain);
+}
+
+template <bool isAdding>
+int SincResampler::resample (double speedRatio, const float* input, float* output,
+                             int numOutputSamplesToProduce, int numInputSamplesAvailable, float gain) noexcept
+{
+    jassert (speedRatio > 0);
+
+    if (speedRatio > 1.0)
+        prepareStretchedBank (jmin (speedRatio, maxSpeedRatio));
+
+    auto pos = subSamplePos;
+    int numUsed = 0;
+
+    for (int i = 0; i < numOutputSamplesToProduce; ++i)
+    {
+        while (pos >= 1.0)
+        {
+            pushSample (numUsed < numInputSamplesAvailable ? input[numUsed] : 0.0f);
+            ++numUsed;
+            pos -= 1.0;
+        }
+
+        auto value = speedRatio <= 1.0 ? getUpsampledValue (pos)
+                                       : getDownsampledValue (pos);
+
+        if (isAdding)
+            output[i] += gain * value;
+        else
+            output[i] = value;
+
+        pos += speedRatio;
+    }
+
+    subSamplePos = pos;
+    return jmin (numUsed, numInputSamplesAvailable);
+}
+
+// The output position is latency samples behind the newest input, plus the offset.
+float SincResampler::getUpsampledValue (double offset) const noexcept
+{
+    auto numHalfTaps = tables->numHalfTaps;
+    auto numTaps = 2 * numHalfTaps;
+    auto* src = history + (numInHistory - latency - numHalfTaps);
+
+    auto phase = offset * tables->numPhases;
+    auto phaseIndex = (int) phase;
+    auto alpha = (float) (phase - phaseIndex);
+
+    auto* row = tables->bank + phaseIndex * numTaps;
+    auto value1 = FloatVectorOperations::dotProduct (src, row, numTaps);
+    auto value2 = FloatVectorOperations::dotProduct (src, row + numTaps, numTaps);
+
+    return value1 + alpha * (value2 - value1);
+}
+
+// When downsampling, the impulse response is stretched by the speed ratio, which lowers
+// its cutoff to the new Nyquist frequency. The stretched filter is smoother, so it needs
+// fewer phases to be interpolated as accurately as the unstretched one.
+void SincResampler::prepareStretchedBank (double ratio) noexcept
+{
+    if (ratio == stretchedRatio)
+        return;
+
+    stretchedRatio = ratio;
+    stretchedHalfWidth = (int) std::ceil (tables->numHalfTaps * ratio);
+    stretchedNumPhases = jmax (1, (int) std::ceil (tables->numPhases / ratio));
+
+    auto numTaps = 2 * stretchedHalfWidth;
+    auto tableStep = tables->numPhases / ratio;
+    auto tableEnd = tables->numHalfTaps * tables->numPhases;
+    const auto* impulse = tables->impulse.get();
+
+    for (int phase = 0; phase <= stretchedNumPhases; ++phase)
+    {
+        auto* row = stretchedBank + phase * numTaps;
+        auto offset = (double) phase / stretchedNumPhases;
+        double sum = 0;
+
+        for (int tap = 0; tap < numTaps; ++tap)
+        {
+            auto index = std::abs ((double) (stretchedHalfWidth - 1 - tap) + offset) * tableStep;
+            auto i = (int) index;
+
+            row[tap] = i < tableEnd ? impulse[i] + (float) (index - i) * (impulse[i + 1] - impulse[i])
+                                    : 0.0f;
+            sum += row[tap];
+        }
+
+        // normalise each phase so that none of them change the gain at DC
+        FloatVectorOperations::multiply (row, (float) (1.0 / sum), numTaps);
+    }
+}
+
+float SincResampler::getDownsampledValue (double offset) const noexcept
+{
+    auto numTaps = 2 * stretchedHalfWidth;
+    auto* src = history + (numInHistory - latency - stretchedHalfWidth);
+
+    auto phase = offset * stretchedNumPhases;
+    auto phaseIndex = (int) phase;
+    auto alpha = (float) (phase - phaseIndex);
+
+    auto* row = stretchedBank + phaseIndex * numTaps;
+    auto value1 = FloatVectorOperations::dotProduct (src, row, numTaps);
+    auto value2 = FloatVectorOperations::dotProduct (src, row + numTaps, numTaps);
+
+    return value1 + alpha * (value2 - value1);
+}
+
+//==============================================================================
+AudioBuffer<float> SincResampler::resampleBuffer (const AudioBuffer<float>& source, double speedRatio, Quality q)
+{
+    jassert (speedRatio > 0);
+
+    auto numInputSamples = source.getNumSamples();
+    AudioBuffer<float> result (source.getNumChannels(), (int) std::ceil (numInputSamples / speedRatio));
+
+    for (int channel = 0; channel < source.getNumChannels(); ++channel)
+    {
+        SincResampler resampler (q, jmin (jmax (1.0, speedRatio), maximumSupportedSpeedRatio));
+        auto* src = source.getReadPointer (channel);
+
+        auto numToPrime = jmin (resampler.getLatencyInSamples(), numInputSamples);
+        resampler.pushSamples (src, numToPrime);
+
+        for (int i = numToPrime; i < resampler.getLatencyInSamples(); ++i)
+            resampler.pushSample (0.0f);
+
+        resampler.process (speedRatio, src + numToPrime, result.getWritePointer (channel),
+                           result.getNumSamples(), numInputSamples - numToPrime);
+    }
+
+    return result;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SincResamplerTests  : public UnitTest
+{
+public:
+    SincResamplerTests()
+        : UnitTest ("SincResampler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        const SincResampler::Quality qualities[] = { SincResampler::Quality::low,  SincResampler::Quality::medium,
+                                                     SincResampler::Quality::high, SincResampler::Quality::best };
+        const double ratios[] = { 44100.0 / 48000.0, 48000.0 / 44100.0, 0.5, 3.0 };
+
+        beginTest ("Resampled sine waves stay in phase");
+        {
+            const float maxErrors[] = { 1.0e-2f, 1.0e-3f, 1.0e-4f, 1.0e-5f };
+
+            for (int q = 0; q < 4; ++q)
+                for (auto ratio : ratios)
+                    expectLessThan (getSineError (qualities[q], ratio, 0.02), maxErrors[q]);
+        }
+
+        beginTest ("Downsampling removes frequencies above Nyquist");
+        {
+            const float maxLevels[] = { 2.0e-3f, 2.0e-4f, 2.0e-5f, 2.0e-6f };
+
+            for (int q = 0; q < 4; ++q)
+            {
+                // with a ratio of 2 these are above the new Nyquist frequency, so they must be removed
+                expectLessThan (getSineError (qualities[q], 2.0, 0.3,  false), maxLevels[q]);
+                expectLessThan (getSineError (qualities[q], 2.0, 0.45, false), maxLevels[q]);
+            }
+        }
+
+        beginTest ("Resampling doesn't change the gain at DC");
+        {
+            AudioBuffer<float> input (1, 4096);
+            FloatVectorOperations::fill (input.getWritePointer (0), 1.0f, input.getNumSamples());
+
+            for (auto& q : qualities)
+            {
+                for (auto ratio : ratios)
+                {
+                    auto output = SincResampler::resampleBuffer (input, ratio, q);
+                    auto range = FloatVectorOperations::findMinAndMax (output.getReadPointer (0, 500), output.getNumSamples() - 1000);
+
+                    expectWithinAbsoluteError (range.getStart(), 1.0f, 1.0e-5f);
+                    expectWithinAbsoluteError (range.getEnd(),   1.0f, 1.0e-5f);
+                }
+            }
+        }
+
+        beginTest ("Processing in blocks matches processing in one go");
+        {
+            auto random = getRandom();
+
+            for (auto ratio : ratios)
+            {
+                AudioBuffer<float> input (1, 5000);
+
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    input.setSample (0, i, random.nextFloat() * 2.0f - 1.0f);
+
+                auto expected = SincResampler::resampleBuffer (input, ratio, SincResampler::Quality::medium);
+
+                SincResampler resampler (SincResampler::Quality::medium, jmax (1.0, ratio));
+                auto* src = input.getReadPointer (0);
+                resampler.pushSamples (src, resampler.getLatencyInSamples());
+                src += resampler.getLatencyInSamples();
+
+                std::vector<float> output ((size_t) expected.getNumSamples());
+                int numDone = 0, numInputLeft = input.getNumSamples() - resampler.getLatencyInSamples();
+
+                for (;;)
+                {
+                    auto numToDo = jmin (random.nextInt (300) + 1, resampler.getNumOutputSamplesAvailable (ratio, numInputLeft));
+
+                    if (numToDo == 0)
+                        break;
+
+                    auto numNeeded = resampler.getNumInputSamplesNeeded (ratio, numToDo);
+                    expect (numNeeded <= numInputLeft);
+                    expectEquals (resampler.process (ratio, src, output.data() + numDone, numToDo), numNeeded);
+
+                    src += numNeeded;
+                    numInputLeft -= numNeeded;
+                    numDone += numToDo;
+                }
+
+                expect (numDone > expected.getNumSamples() - (int) std::ceil (resampler.getLatencyInSamples() / ratio) - 2);
+
+                for (int i = 0; i < numDone; ++i)
+                    expectEquals (output[(size_t) i], expected.getSample (0, i));
+            }
+        }
+    }
+
+private:
+    // Resamples a sine wave and returns the largest difference from the ideal result,
+    // or from silence, ignoring the edges where the filter runs off the ends of the input.
+    static float getSineError (SincResampler::Quality quality, double ratio, double normalisedFrequency, bool compareWithSine = true)
+    {
+        const int numSamples = 8192;
+        AudioBuffer<float> input (1, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            input.setSample (0, i, (float) std::sin (MathConstants<double>::twoPi * normalisedFrequency * i));
+
+        auto output = SincResampler::resampleBuffer (input, ratio, quality);
+        auto margin = 1000;
+        float maxError = 0;
+
+        for (int i = margin; i < output.getNumSamples() - margin; ++i)
+        {
+            auto expected = compareWithSine ? std::sin (MathConstants<double>::twoPi * normalisedFrequency * i * ratio) : 0.0;
+            maxError = jmax (maxError, (float) std::abs (output.getSample (0, i) - expected));
+        }
+
+        return maxError;
+    }
+};
+
+static SincResamplerTests sincResamplerTests;
+
+#endif
+
+} // namespace juce
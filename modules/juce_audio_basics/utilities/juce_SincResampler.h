@@ -0,0 +1,225 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A high quality resampler for streams of floats, using a Kaiser-windowed sinc
+    filter bank.
+
+    This works with any ratio, which can change from one block to the next. When
+    upsampling, each output sample is made by interpolating between two of the
+    precomputed polyphase filters, and when downsampling the same is done with a
+    stretched copy of the filters, which also removes anything above the new
+    Nyquist frequency. The simpler interpolators in GenericInterpolator don't do
+    this. The stretched filters are rebuilt whenever the ratio changes, so they're
+    cheapest when it stays the same from one block to the next.
+
+    The filter tables are built the first time a resampler with a particular
+    Quality is created, and are then shared between all the resamplers that use
+    it, so creating more of them is cheap.
+
+    Unlike the other interpolators, the output is delayed by getLatencyInSamples()
+    input samples. If you need the output to line up with the input, you can feed
+    that many samples to pushSamples() before you start calling process().
+
+    Like the other interpolators, this is stateful, so call reset() when there's a
+    break in the input stream, and use a separate object for each channel.
+
+    @see GenericInterpolator, ResamplingAudioSource
+
+    @tags{Audio}
+*/
+class JUCE_API  SincResampler
+{
+public:
+    //==============================================================================
+    /** The available trade-offs between speed and quality. */
+    enum class Quality
+    {
+        low,        /**< 16 taps, with about 60dB of stopband rejection. */
+        medium,     /**< 32 taps, with about 80dB of stopband rejection. */
+        high,       /**< 64 taps, with about 100dB of stopband rejection. */
+        best        /**< 128 taps, with about 120dB of stopband rejection. */
+    };
+
+    /** The largest speed ratio that a resampler can be set up to handle without aliasing. */
+    static constexpr double maximumSupportedSpeedRatio = 16.0;
+
+    /** Creates a resampler.
+
+        @param quality              the size of the filter to use
+        @param maximumSpeedRatio    the largest speed ratio that you'll be using. Ratios above
+                                    this will still work, but the filter won't be stretched any
+                                    further, so may let through some aliasing. The latency gets
+                                    longer as this increases.
+    */
+    explicit SincResampler (Quality quality = Quality::high,
+                            double maximumSpeedRatio = 1.0);
+
+    /** Destructor. */
+    ~SincResampler();
+
+    SincResampler (SincResampler&&) noexcept;
+    SincResampler& operator= (SincResampler&&) noexcept;
+
+    //==============================================================================
+    /** Changes the quality and maximum speed ratio, and resets the resampler.
+
+        This may allocate memory, so shouldn't be called on the audio thread.
+    */
+    void setQuality (Quality newQuality, double newMaximumSpeedRatio);
+
+    /** Returns the quality that is being used. */
+    Quality getQuality() const noexcept                 { return quality; }
+
+    /** Returns the largest speed ratio that the filter will be stretched for. */
+    double getMaximumSpeedRatio() const noexcept        { return maxSpeedRatio; }
+
+    /** Returns the number of input samples that the output lags behind the input. */
+    int getLatencyInSamples() const noexcept            { return latency; }
+
+    /** Resets the state of the resampler.
+
+        Call this when there's a break in the continuity of the input data stream.
+    */
+    void reset() noexcept;
+
+    //==============================================================================
+    /** Returns the number of input samples that a call to process() will use when
+        making the given number of output samples.
+    */
+    int getNumInputSamplesNeeded (double speedRatio, int numOutputSamplesToProduce) const noexcept;
+
+    /** Returns the number of output samples that can be made from a given number of
+        input samples, without needing any more.
+    */
+    int getNumOutputSamplesAvailable (double speedRatio, int numInputSamplesAvailable) const noexcept;
+
+    /** Feeds some input into the resampler without making any output.
+
+        This is mainly useful for compensating for the latency, by pushing the first
+        getLatencyInSamples() samples of a stream before calling process().
+    */
+    void pushSamples (const float* inputSamples, int numSamples) noexcept;
+
+    //==============================================================================
+    /** Resamples a stream of samples.
+
+        @param speedRatio                   the number of input samples to use for each output sample
+        @param inputSamples                 the source data to read from. This must contain at least
+                                            getNumInputSamplesNeeded (speedRatio, numOutputSamplesToProduce)
+                                            samples.
+        @param outputSamples                the buffer to write the results into
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+
+        @returns the actual number of input samples that were used
+    */
+    int process (double speedRatio,
+                 const float* inputSamples,
+                 float* outputSamples,
+                 int numOutputSamplesToProduce) noexcept;
+
+    /** Resamples a stream of samples, feeding zeroes after the end of the input.
+
+        @param speedRatio                   the number of input samples to use for each output sample
+        @param inputSamples                 the source data to read from
+        @param outputSamples                the buffer to write the results into
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+        @param numInputSamplesAvailable     the number of available input samples. If it needs more
+                                            samples than this, it will feed zeroes
+
+        @returns the actual number of input samples that were used
+    */
+    int process (double speedRatio,
+                 const float* inputSamples,
+                 float* outputSamples,
+                 int numOutputSamplesToProduce,
+                 int numInputSamplesAvailable) noexcept;
+
+    /** Resamples a stream of samples, adding the results to the output data
+        with a gain.
+
+        @param speedRatio                   the number of input samples to use for each output sample
+        @param inputSamples                 the source data to read from. This must contain at least
+                                            getNumInputSamplesNeeded (speedRatio, numOutputSamplesToProduce)
+                                            samples.
+        @param outputSamples                the buffer to write the results to - the result values will be added
+                                            to any pre-existing data in this buffer after being multiplied by
+                                            the gain factor
+        @param numOutputSamplesToProduce    the number of output samples that should be created
+        @param gain                         a gain factor to multiply the resulting samples by before
+                                            adding them to the destination buffer
+
+        @returns the actual number of input samples that were used
+    */
+    int processAdding (double speedRatio,
+                       const float* inputSamples,
+                       float* outputSamples,
+                       int numOutputSamplesToProduce,
+                       float gain) noexcept;
+
+    //==============================================================================
+    /** Resamples a whole buffer in one go, for offline work.
+
+        The latency is compensated for, so the first output sample lines up with the
+        first input sample, and the result is long enough to hold all of the input.
+
+        @param source       the audio to resample
+        @param speedRatio   the number of input samples to use for each output sample,
+                            i.e. the source sample rate divided by the new one
+        @param quality      the size of filter to use
+    */
+    static AudioBuffer<float> resampleBuffer (const AudioBuffer<float>& source,
+                                              double speedRatio,
+                                              Quality quality = Quality::best);
+
+private:
+    //==============================================================================
+    struct FilterTables;
+    static const FilterTables& getFilterTables (Quality);
+
+    template <bool isAdding>
+    int resample (double, const float*, float*, int, int, float) noexcept;
+
+    void pushSample (float) noexcept;
+    float getUpsampledValue (double offset) const noexcept;
+    void prepareStretchedBank (double speedRatio) noexcept;
+    float getDownsampledValue (double offset) const noexcept;
+
+    //==============================================================================
+    Quality quality;
+    const FilterTables* tables = nullptr;
+    double maxSpeedRatio = 1.0, subSamplePos = 1.0, stretchedRatio = 0;
+    int latency = 0, numToKeep = 0, historySize = 0, numInHistory = 0;
+    int stretchedHalfWidth = 0, stretchedNumPhases = 0;
+    HeapBlock<float> history, stretchedBank;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SincResampler)
+};
+
+} // namespace juce
@@ -35,6 +35,12 @@ bool AudioIODevice::setAudioPreprocessingEnabled (bool)         { return false;
 bool AudioIODevice::hasControlPanel() const                     { return false; }
 int  AudioIODevice::getXRunCount() const noexcept               { return -1; }
 
+Range<int> AudioIODevice::getChannelLatencyRange (int, bool isInput)
+{
+    auto latency = isInput ? getInputLatencyInSamples() : getOutputLatencyInSamples();
+    return { latency, latency };
+}
+
 bool AudioIODevice::showControlPanel()
 {
     jassertfalse;    // this should only be called for devices which return true from
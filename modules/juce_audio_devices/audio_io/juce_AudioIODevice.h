@@ -278,6 +278,16 @@ public:
     */
     virtual int getInputLatencyInSamples() = 0;
 
+    /** Returns the range of latencies, in samples, of one of the device's input or
+        output channels.
+
+        Some devices (e.g. JACK) can report a different latency for each channel,
+        depending on what it's connected to. The channel index is an index into the
+        list returned by getInputChannelNames() or getOutputChannelNames(). The default
+        implementation just returns getInputLatencyInSamples() or getOutputLatencyInSamples()
+        for every channel.
+    */
+    virtual Range<int> getChannelLatencyRange (int channelIndex, bool isInput);
 
     //==============================================================================
     /** True if this device can show a pop-up control panel for editing its settings.
@@ -108,6 +108,32 @@
  #define JUCE_ALSA 1
 #endif
 
+/** Config: JUCE_ALSA_USE_MMAP
+    If enabled, ALSA devices that support it will have their audio converted straight
+    into and out of the hardware buffer, rather than being copied with read and write
+    calls. Devices that don't support mmap access will still use read and write calls.
+*/
+#ifndef JUCE_ALSA_USE_MMAP
+ #define JUCE_ALSA_USE_MMAP 1
+#endif
+
+/** Config: JUCE_ALSA_REALTIME_PRIORITY
+    If this is set to a value between 1 and 99, the ALSA audio thread will ask to be
+    scheduled with the SCHED_FIFO policy at this priority. If it's 0, or if the request
+    is refused, the thread runs at the normal high priority used for audio threads.
+*/
+#ifndef JUCE_ALSA_REALTIME_PRIORITY
+ #define JUCE_ALSA_REALTIME_PRIORITY 0
+#endif
+
+/** Config: JUCE_ALSA_CPU_AFFINITY_MASK
+    If this is non-zero, the ALSA audio thread will be restricted to the CPUs whose
+    bits are set in this mask.
+*/
+#ifndef JUCE_ALSA_CPU_AFFINITY_MASK
+ #define JUCE_ALSA_CPU_AFFINITY_MASK 0
+#endif
+
 /** Config: JUCE_JACK
     Enables JACK audio devices (Linux only).
 */
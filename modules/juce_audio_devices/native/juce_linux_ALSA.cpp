@@ -210,6 +210,18 @@ public:
             return false;
         }
 
+        isMMap = false;
+
+       #if JUCE_ALSA_USE_MMAP
+        if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) >= 0)
+            isMMap = isInterleaved = true;
+        else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_MMAP_NONINTERLEAVED) >= 0)
+        {
+            isMMap = true;
+            isInterleaved = false;
+        }
+        else
+       #endif
         if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_INTERLEAVED) >= 0) // works better for plughw..
             isInterleaved = true;
         else if (snd_pcm_hw_params_set_access (handle, hwParams, SND_PCM_ACCESS_RW_NONINTERLEAVED) >= 0)
@@ -239,6 +251,7 @@ public:
             {
                 const int type = formatsToTry [i + 1];
                 bitDepth = type & 255;
+                format = (snd_pcm_format_t) formatsToTry [i];
 
                 converter.reset (createConverter (isInput, bitDepth,
                                                   (type & isFloatBit) != 0,
@@ -291,11 +304,20 @@ public:
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_silence_size (handle, swParams, boundary))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_start_threshold (handle, swParams, samplesPerPeriod))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_stop_threshold (handle, swParams, boundary))
+            || JUCE_ALSA_FAILED (snd_pcm_sw_params_set_avail_min (handle, swParams, (snd_pcm_uframes_t) bufferSize))
             || JUCE_ALSA_FAILED (snd_pcm_sw_params (handle, swParams)))
         {
             return false;
         }
 
+        numPollDescriptors = snd_pcm_poll_descriptors_count (handle);
+
+        if (numPollDescriptors <= 0)
+        {
+            error = "device doesn't provide any poll descriptors";
+            return false;
+        }
+
        #if JUCE_ALSA_LOGGING
         // enable this to dump the config of the devices that get opened
         snd_output_t* out;
@@ -313,6 +335,10 @@ public:
     bool writeToOutputDevice (AudioBuffer<float>& outputChannelBuffer, const int numSamples)
     {
         jassert (numChannelsRunning <= outputChannelBuffer.getNumChannels());
+
+        if (isMMap)
+            return transferMMap (outputChannelBuffer, numSamples);
+
         float* const* const data = outputChannelBuffer.getArrayOfWritePointers();
         snd_pcm_sframes_t numDone = 0;
 
@@ -351,6 +377,10 @@ public:
     bool readFromInputDevice (AudioBuffer<float>& inputChannelBuffer, const int numSamples)
     {
         jassert (numChannelsRunning <= inputChannelBuffer.getNumChannels());
+
+        if (isMMap)
+            return transferMMap (inputChannelBuffer, numSamples);
+
         float* const* const data = inputChannelBuffer.getArrayOfWritePointers();
 
         if (isInterleaved)
@@ -399,6 +429,66 @@ public:
         return true;
     }
 
+    /* A stream that has been prepared (either when it was opened, or after recovering
+       from an xrun) won't wake up a poll() until it's running. Capture streams just need
+       to be started, and in mmap mode, playback streams get their buffer filled with
+       silence, which starts them once it passes the start threshold.
+    */
+    void startIfPrepared()
+    {
+        if (handle == nullptr || snd_pcm_state (handle) != SND_PCM_STATE_PREPARED)
+            return;
+
+        if (isInput)
+        {
+            JUCE_CHECKED_RESULT (snd_pcm_start (handle));
+            return;
+        }
+
+        if (! isMMap)
+            return;
+
+        for (auto avail = snd_pcm_avail_update (handle); avail > 0;)
+        {
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0, frames = (snd_pcm_uframes_t) avail;
+
+            if (JUCE_CHECKED_RESULT (snd_pcm_mmap_begin (handle, &areas, &offset, &frames)) < 0)
+                break;
+
+            snd_pcm_areas_silence (areas, offset, (unsigned int) numChannelsRunning, frames, format);
+
+            if (JUCE_CHECKED_RESULT ((int) snd_pcm_mmap_commit (handle, offset, frames)) < 0)
+                break;
+
+            avail -= (snd_pcm_sframes_t) frames;
+        }
+    }
+
+    //==============================================================================
+    int getNumPollDescriptors() const noexcept      { return numPollDescriptors; }
+
+    /* Fills the given array (which must have space for getNumPollDescriptors() items)
+       with the descriptors to poll() on while waiting for this device.
+    */
+    void fillPollDescriptors (pollfd* descriptors)
+    {
+        snd_pcm_poll_descriptors (handle, descriptors, (unsigned int) numPollDescriptors);
+    }
+
+    /* After a poll(), this returns true if the device is ready for the next transfer,
+       or has failed in a way that the transfer will need to recover from.
+    */
+    bool isReadyAfterPoll (pollfd* descriptors)
+    {
+        unsigned short revents = 0;
+
+        if (snd_pcm_poll_descriptors_revents (handle, descriptors, (unsigned int) numPollDescriptors, &revents) < 0)
+            return true;
+
+        return (revents & (POLLERR | (isInput ? POLLIN : POLLOUT))) != 0;
+    }
+
     //==============================================================================
     snd_pcm_t* handle;
     String error;
@@ -409,10 +499,111 @@ private:
     //==============================================================================
     String deviceID;
     const bool isInput;
-    bool isInterleaved;
+    bool isInterleaved, isMMap = false;
+    snd_pcm_format_t format = SND_PCM_FORMAT_UNKNOWN;
+    int numPollDescriptors = 0;
     MemoryBlock scratch;
     std::unique_ptr<AudioData::Converter> converter;
 
+    //==============================================================================
+    /* Converts a block of samples directly to or from the device's own buffer. If the
+       device doesn't have enough space or data for the whole block, this waits for it,
+       and if there's an xrun, the rest of the block is skipped.
+    */
+    bool transferMMap (AudioBuffer<float>& buffer, const int numSamples)
+    {
+        float* const* const data = buffer.getArrayOfWritePointers();
+        int numDone = 0;
+
+        while (numDone < numSamples)
+        {
+            auto avail = snd_pcm_avail_update (handle);
+
+            if (avail == 0)
+            {
+                auto result = snd_pcm_wait (handle, 1000);
+
+                if (result > 0)
+                    continue;
+
+                if (result == 0)
+                {
+                    JUCE_ALSA_LOG ("Timed out waiting for the device");
+                    break;
+                }
+
+                avail = result;
+            }
+
+            const snd_pcm_channel_area_t* areas = nullptr;
+            snd_pcm_uframes_t offset = 0;
+            auto frames = (snd_pcm_uframes_t) jmin ((snd_pcm_sframes_t) (numSamples - numDone), avail);
+
+            auto err = avail < 0 ? (int) avail
+                                 : snd_pcm_mmap_begin (handle, &areas, &offset, &frames);
+
+            if (err < 0)
+            {
+                if (! recoverFromError (err))
+                    return false;
+
+                break;
+            }
+
+            for (int i = 0; i < numChannelsRunning; ++i)
+            {
+                auto& area = areas[isInterleaved ? 0 : i];
+                auto* deviceData = addBytesToPointer (area.addr, (area.first + offset * area.step) / 8);
+                auto* floatData = data[i] + numDone;
+
+                if (isInterleaved)
+                {
+                    if (isInput)
+                        converter->convertSamples (floatData, 0, deviceData, i, (int) frames);
+                    else
+                        converter->convertSamples (deviceData, i, floatData, 0, (int) frames);
+                }
+                else
+                {
+                    if (isInput)
+                        converter->convertSamples (floatData, deviceData, (int) frames);
+                    else
+                        converter->convertSamples (deviceData, floatData, (int) frames);
+                }
+            }
+
+            auto numCommitted = snd_pcm_mmap_commit (handle, offset, frames);
+
+            if (numCommitted < 0 || (snd_pcm_uframes_t) numCommitted != frames)
+            {
+                if (! recoverFromError (numCommitted < 0 ? (int) numCommitted : -EPIPE))
+                    return false;
+
+                break;
+            }
+
+            numDone += (int) frames;
+        }
+
+        if (numDone < numSamples)
+        {
+            JUCE_ALSA_LOG ("Did not transfer all samples: numDone: " << numDone << ", numSamples: " << numSamples);
+
+            if (isInput)
+                buffer.clear (numDone, numSamples - numDone);
+        }
+
+        return true;
+    }
+
+    bool recoverFromError (int err)
+    {
+        if (err == -EPIPE)
+            ++(isInput ? overrunCount : underrunCount);
+
+        return ! JUCE_ALSA_FAILED (snd_pcm_recover (handle, err, 1 /* silent */));
+    }
+
     //==============================================================================
     template <class SampleType>
     struct ConverterHelper
@@ -620,6 +811,16 @@ public:
         if (outputDevice != nullptr && JUCE_ALSA_FAILED (snd_pcm_prepare (outputDevice->handle)))
             return;
 
+        pollDescriptors.resize ((size_t) ((inputDevice != nullptr ? inputDevice->getNumPollDescriptors() : 0)
+                                            + (outputDevice != nullptr ? outputDevice->getNumPollDescriptors() : 0)
+                                            + 1));
+
+        if (::pipe (wakeupPipe) != 0)
+        {
+            error = "couldn't create the audio thread's wakeup pipe";
+            return;
+        }
+
         startThread (9);
 
         int count = 1000;
@@ -645,6 +846,7 @@ public:
             // (that is without the "killing thread by force" of stopThread) , is to just call snd_pcm_close from
             // here which will cause the thread to resume, and exit
             signalThreadShouldExit();
+            wakeUpThread();
 
             const int callbacksToStop = numCallbacks;
 
@@ -659,6 +861,14 @@ public:
 
         stopThread (6000);
 
+        for (auto& fd : wakeupPipe)
+        {
+            if (fd >= 0)
+                ::close (fd);
+
+            fd = -1;
+        }
+
         inputDevice.reset();
         outputDevice.reset();
 
@@ -676,23 +886,20 @@ public:
 
     void run() override
     {
+        setRealtimeSchedulingIfRequested();
+
         while (! threadShouldExit())
         {
-            if (inputDevice != nullptr && inputDevice->handle != nullptr)
-            {
-                if (outputDevice == nullptr || outputDevice->handle == nullptr)
-                {
-                    JUCE_ALSA_FAILED (snd_pcm_wait (inputDevice->handle, 2000));
-
-                    if (threadShouldExit())
-                        break;
+            // (the output goes first, so that if the devices are linked, they're started
+            // by its silence rather than by the input, which would leave the output empty)
+            if (outputDevice != nullptr)  outputDevice->startIfPrepared();
+            if (inputDevice != nullptr)   inputDevice->startIfPrepared();
 
-                    auto avail = snd_pcm_avail_update (inputDevice->handle);
-
-                    if (avail < 0)
-                        JUCE_ALSA_FAILED (snd_pcm_recover (inputDevice->handle, (int) avail, 0));
-                }
+            if (! waitForDevices())
+                break;
 
+            if (inputDevice != nullptr && inputDevice->handle != nullptr)
+            {
                 audioIoInProgress = true;
 
                 if (! inputDevice->readFromInputDevice (inputChannelBuffer, bufferSize))
@@ -728,16 +935,6 @@ public:
 
             if (outputDevice != nullptr && outputDevice->handle != nullptr)
             {
-                JUCE_ALSA_FAILED (snd_pcm_wait (outputDevice->handle, 2000));
-
-                if (threadShouldExit())
-                    break;
-
-                auto avail = snd_pcm_avail_update (outputDevice->handle);
-
-                if (avail < 0)
-                    JUCE_ALSA_FAILED (snd_pcm_recover (outputDevice->handle, (int) avail, 0));
-
                 audioIoInProgress = true;
 
                 if (! outputDevice->writeToOutputDevice (outputChannelBuffer, bufferSize))
@@ -794,6 +991,9 @@ private:
     std::atomic<int> numCallbacks { 0 };
     bool audioIoInProgress = false;
 
+    std::vector<pollfd> pollDescriptors;
+    int wakeupPipe[2] = { -1, -1 };
+
     CriticalSection callbackLock;
 
     AudioBuffer<float> inputChannelBuffer, outputChannelBuffer;
@@ -813,6 +1013,89 @@ private:
         return true;
     }
 
+    //==============================================================================
+    /* Waits in a single poll() until all the open devices are ready for the next
+       block, or the thread is woken up because it needs to stop. Returns false if
+       the thread should exit.
+    */
+    bool waitForDevices()
+    {
+        auto waitingForInput  = inputDevice  != nullptr && inputDevice->handle  != nullptr;
+        auto waitingForOutput = outputDevice != nullptr && outputDevice->handle != nullptr;
+
+        while (waitingForInput || waitingForOutput)
+        {
+            auto* descriptors = pollDescriptors.data();
+            auto* inputDescriptors = descriptors;
+            int numDescriptors = 0;
+
+            if (waitingForInput)
+            {
+                inputDevice->fillPollDescriptors (descriptors);
+                numDescriptors += inputDevice->getNumPollDescriptors();
+            }
+
+            auto* outputDescriptors = descriptors + numDescriptors;
+
+            if (waitingForOutput)
+            {
+                outputDevice->fillPollDescriptors (outputDescriptors);
+                numDescriptors += outputDevice->getNumPollDescriptors();
+            }
+
+            descriptors[numDescriptors++] = { wakeupPipe[0], POLLIN, 0 };
+
+            auto result = ::poll (descriptors, (nfds_t) numDescriptors, 2000);
+
+            if (threadShouldExit())
+                return false;
+
+            if (result < 0 && errno == EINTR)
+                continue;
+
+            if (result <= 0)
+            {
+                // leave it to the transfers to sort out whatever has gone wrong
+                JUCE_ALSA_LOG ("poll() returned " << result);
+                break;
+            }
+
+            if (waitingForInput && inputDevice->isReadyAfterPoll (inputDescriptors))
+                waitingForInput = false;
+
+            if (waitingForOutput && outputDevice->isReadyAfterPoll (outputDescriptors))
+                waitingForOutput = false;
+        }
+
+        return true;
+    }
+
+    void wakeUpThread()
+    {
+        if (wakeupPipe[1] >= 0)
+        {
+            const char dummy = 0;
+            ignoreUnused (::write (wakeupPipe[1], &dummy, 1));
+        }
+    }
+
+    static void setRealtimeSchedulingIfRequested()
+    {
+       #if JUCE_ALSA_CPU_AFFINITY_MASK
+        Thread::setCurrentThreadAffinityMask ((uint32) JUCE_ALSA_CPU_AFFINITY_MASK);
+       #endif
+
+       #if JUCE_ALSA_REALTIME_PRIORITY > 0
+        sched_param param {};
+        param.sched_priority = jlimit (sched_get_priority_min (SCHED_FIFO),
+                                       sched_get_priority_max (SCHED_FIFO),
+                                       JUCE_ALSA_REALTIME_PRIORITY);
+
+        if (pthread_setschedparam (pthread_self(), SCHED_FIFO, &param) != 0)
+            JUCE_ALSA_LOG ("Couldn't use SCHED_FIFO for the audio thread (check the user's rtprio limit)");
+       #endif
+    }
+
     void initialiseRatesAndChannels()
     {
         sampleRates.clear();
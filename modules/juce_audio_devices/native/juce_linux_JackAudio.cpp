@@ -62,7 +62,7 @@ JUCE_DECL_JACK_FUNCTION (jack_nframes_t, jack_get_sample_rate, (jack_client_t* c
 JUCE_DECL_VOID_JACK_FUNCTION (jack_on_shutdown, (jack_client_t* client, void (*function)(void* arg), void* arg), (client, function, arg))
 JUCE_DECL_VOID_JACK_FUNCTION (jack_on_info_shutdown, (jack_client_t* client, JackInfoShutdownCallback function, void* arg), (client, function, arg))
 JUCE_DECL_JACK_FUNCTION (void* , jack_port_get_buffer, (jack_port_t* port, jack_nframes_t nframes), (port, nframes))
-JUCE_DECL_JACK_FUNCTION (jack_nframes_t, jack_port_get_total_latency, (jack_client_t* client, jack_port_t* port), (client, port))
+JUCE_DECL_VOID_JACK_FUNCTION (jack_port_get_latency_range, (jack_port_t* port, jack_latency_callback_mode_t mode, jack_latency_range_t* range), (port, mode, range))
 JUCE_DECL_JACK_FUNCTION (jack_port_t* , jack_port_register, (jack_client_t* client, const char* port_name, const char* port_type, unsigned long flags, unsigned long buffer_size), (client, port_name, port_type, flags, buffer_size))
 JUCE_DECL_VOID_JACK_FUNCTION (jack_set_error_function, (void (*func)(const char*)), (func))
 JUCE_DECL_JACK_FUNCTION (int, jack_set_process_callback, (jack_client_t* client, JackProcessCallback process_callback, void* arg), (client, process_callback, arg))
@@ -397,8 +397,8 @@ public:
     {
         int latency = 0;
 
-        for (int i = 0; i < outputPorts.size(); i++)
-            latency = jmax (latency, (int) juce::jack_port_get_total_latency (client, outputPorts[i]));
+        for (auto* port : outputPorts)
+            latency = jmax (latency, getLatencyRange (port, false).getEnd());
 
         return latency;
     }
@@ -407,12 +407,22 @@ public:
     {
         int latency = 0;
 
-        for (int i = 0; i < inputPorts.size(); i++)
-            latency = jmax (latency, (int) juce::jack_port_get_total_latency (client, inputPorts[i]));
+        for (auto* port : inputPorts)
+            latency = jmax (latency, getLatencyRange (port, true).getEnd());
 
         return latency;
     }
 
+    Range<int> getChannelLatencyRange (int channelIndex, bool isInput) override
+    {
+        auto& ports = isInput ? inputPorts : outputPorts;
+
+        if (! isPositiveAndBelow (channelIndex, ports.size()))
+            return {};
+
+        return getLatencyRange (ports.getUnchecked (channelIndex), isInput);
+    }
+
     String inputName, outputName;
 
 private:
@@ -438,27 +448,28 @@ private:
     };
 
     //==============================================================================
+    static Range<int> getLatencyRange (jack_port_t* port, bool isInput)
+    {
+        jack_latency_range_t range {};
+        juce::jack_port_get_latency_range (port, isInput ? JackCaptureLatency : JackPlaybackLatency, &range);
+        return { (int) range.min, (int) range.max };
+    }
+
+    // JACK's sample format is always the same as the callback's, so the port buffers
+    // are passed straight to the callback, without being copied.
     void process (const int numSamples)
     {
-        int numActiveInChans = 0, numActiveOutChans = 0;
+        const ScopedLock sl (callbackLock);
 
-        for (int i = 0; i < totalNumberOfInputChannels; ++i)
-        {
-            if (activeInputChannels[i])
-                if (auto* in = (jack_default_audio_sample_t*) juce::jack_port_get_buffer (inputPorts.getUnchecked (i),
-                                                                                          static_cast<jack_nframes_t> (numSamples)))
-                    inChans[numActiveInChans++] = (float*) in;
-        }
+        int numActiveInChans = 0, numActiveOutChans = 0;
 
-        for (int i = 0; i < totalNumberOfOutputChannels; ++i)
-        {
-            if (activeOutputChannels[i])
-                if (auto* out = (jack_default_audio_sample_t*) juce::jack_port_get_buffer (outputPorts.getUnchecked (i),
-                                                                                           static_cast<jack_nframes_t> (numSamples)))
-                    outChans[numActiveOutChans++] = (float*) out;
-        }
+        for (auto* port : activeInputPorts)
+            if (auto* in = (jack_default_audio_sample_t*) juce::jack_port_get_buffer (port, static_cast<jack_nframes_t> (numSamples)))
+                inChans[numActiveInChans++] = (float*) in;
 
-        const ScopedLock sl (callbackLock);
+        for (auto* port : activeOutputPorts)
+            if (auto* out = (jack_default_audio_sample_t*) juce::jack_port_get_buffer (port, static_cast<jack_nframes_t> (numSamples)))
+                outChans[numActiveOutChans++] = (float*) out;
 
         if (callback != nullptr)
         {
@@ -511,6 +522,21 @@ private:
             activeOutputChannels = newOutputChannels;
             activeInputChannels  = newInputChannels;
 
+            {
+                const ScopedLock sl (callbackLock);
+
+                activeInputPorts.clearQuick();
+                activeOutputPorts.clearQuick();
+
+                for (int i = 0; i < inputPorts.size(); ++i)
+                    if (activeInputChannels[i])
+                        activeInputPorts.add (inputPorts.getUnchecked (i));
+
+                for (int i = 0; i < outputPorts.size(); ++i)
+                    if (activeOutputChannels[i])
+                        activeOutputPorts.add (outputPorts.getUnchecked (i));
+            }
+
             if (oldCallback != nullptr)
                 start (oldCallback);
 
@@ -568,7 +594,7 @@ private:
     HeapBlock<float*> inChans, outChans;
     int totalNumberOfInputChannels = 0;
     int totalNumberOfOutputChannels = 0;
-    Array<jack_port_t*> inputPorts, outputPorts;
+    Array<jack_port_t*> inputPorts, outputPorts, activeInputPorts, activeOutputPorts;
     BigInteger activeInputChannels, activeOutputChannels;
 
     std::atomic<int> xruns { 0 };
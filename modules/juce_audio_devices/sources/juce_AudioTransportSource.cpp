@@ -75,8 +75,13 @@ void AudioTransportSource::setSource (PositionableAudioSource* const newSource,
         newPositionableSource->setNextReadPosition (0);
 
         if (sourceSampleRateToCorrectFor > 0)
+        {
             newMasterSource = newResamplerSource
                 = new ResamplingAudioSource (newPositionableSource, false, maxNumChannels);
+
+            if (useSincResampling)
+                newResamplerSource->setUsingSincResampling (true, sincQuality);
+        }
         else
             newMasterSource = newPositionableSource;
 
@@ -208,6 +213,17 @@ void AudioTransportSource::setGain (const float newGain) noexcept
     gain = newGain;
 }
 
+void AudioTransportSource::setUsingSincResampling (bool shouldUseSincResampling, SincResampler::Quality quality)
+{
+    // The sources are only replaced by setSource(), which is called from the same thread
+    // as this, so there's no need to hold the callback lock while the resampler allocates
+    useSincResampling = shouldUseSincResampling;
+    sincQuality = quality;
+
+    if (resamplerSource != nullptr)
+        resamplerSource->setUsingSincResampling (shouldUseSincResampling, quality);
+}
+
 void AudioTransportSource::prepareToPlay (int samplesPerBlockExpected, double newSampleRate)
 {
     const ScopedLock sl (callbackLock);
@@ -215,12 +231,13 @@ void AudioTransportSource::prepareToPlay (int samplesPerBlockExpected, double ne
     sampleRate = newSampleRate;
     blockSize = samplesPerBlockExpected;
 
-    if (masterSource != nullptr)
-        masterSource->prepareToPlay (samplesPerBlockExpected, sampleRate);
-
+    // the ratio is set first, so that the resampler can be prepared for it
     if (resamplerSource != nullptr && sourceSampleRate > 0)
         resamplerSource->setResamplingRatio (sourceSampleRate / sampleRate);
 
+    if (masterSource != nullptr)
+        masterSource->prepareToPlay (samplesPerBlockExpected, sampleRate);
+
     inputStreamEOF = false;
     isPrepared = true;
 }
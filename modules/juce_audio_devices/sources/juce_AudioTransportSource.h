@@ -134,6 +134,23 @@ public:
     */
     float getGain() const noexcept      { return gain; }
 
+    //==============================================================================
+    /** Chooses whether sample-rate correction should use a high quality SincResampler
+        rather than linear interpolation.
+
+        This only has an effect when a source sample rate was passed to setSource(), and
+        the setting is kept for any sources that are set afterwards.
+
+        @see ResamplingAudioSource::setUsingSincResampling
+    */
+    void setUsingSincResampling (bool shouldUseSincResampling,
+                                 SincResampler::Quality quality = SincResampler::Quality::high);
+
+    /** Returns true if sample-rate correction uses a SincResampler.
+        @see setUsingSincResampling
+    */
+    bool isUsingSincResampling() const noexcept         { return useSincResampling; }
+
     //==============================================================================
     /** Implementation of the AudioSource method. */
     void prepareToPlay (int samplesPerBlockExpected, double sampleRate) override;
@@ -171,6 +188,8 @@ private:
     double sampleRate = 44100.0, sourceSampleRate = 0;
     int blockSize = 128, readAheadBufferSize = 0;
     bool isPrepared = false, inputStreamEOF = false;
+    bool useSincResampling = false;
+    SincResampler::Quality sincQuality = SincResampler::Quality::high;
 
     void releaseMasterResources();
 
@@ -383,17 +383,7 @@ public:
           streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
     {
         encoder = FlacNamespace::FLAC__stream_encoder_new();
-
-        if (qualityOptionIndex > 0)
-            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
-
-        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
-        FLAC__stream_encoder_set_channels (encoder, numChannels);
-        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
-        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
-        FLAC__stream_encoder_set_blocksize (encoder, 0);
-        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+        configureEncoder (encoder, numChannels, bitsPerSample, sampleRate, qualityOptionIndex);
 
         ok = FLAC__stream_encoder_init_stream (encoder,
                                                encodeWriteCallback, encodeSeekCallback,
@@ -417,6 +407,22 @@ public:
         FlacNamespace::FLAC__stream_encoder_delete (encoder);
     }
 
+    //==============================================================================
+    static void configureEncoder (FlacNamespace::FLAC__StreamEncoder* encoder, uint32 numChannels,
+                                  uint32 bitsPerSample, double sampleRate, int qualityOptionIndex)
+    {
+        if (qualityOptionIndex > 0)
+            FLAC__stream_encoder_set_compression_level (encoder, (uint32) jmin (8, qualityOptionIndex));
+
+        FLAC__stream_encoder_set_do_mid_side_stereo (encoder, numChannels == 2);
+        FLAC__stream_encoder_set_loose_mid_side_stereo (encoder, numChannels == 2);
+        FLAC__stream_encoder_set_channels (encoder, numChannels);
+        FLAC__stream_encoder_set_bits_per_sample (encoder, jmin ((unsigned int) 24, bitsPerSample));
+        FLAC__stream_encoder_set_sample_rate (encoder, (unsigned int) sampleRate);
+        FLAC__stream_encoder_set_blocksize (encoder, 0);
+        FLAC__stream_encoder_set_do_escape_coding (encoder, true);
+    }
+
     //==============================================================================
     bool write (const int** samplesToWrite, int numSamples) override
     {
@@ -466,12 +472,9 @@ public:
         }
     }
 
-    void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
+    static void packStreamInfo (const FlacNamespace::FLAC__StreamMetadata_StreamInfo& info, unsigned char* buffer)
     {
         using namespace FlacNamespace;
-        auto& info = metadata->data.stream_info;
-
-        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
         const unsigned int channelsMinus1 = info.channels - 1;
         const unsigned int bitsMinus1 = info.bits_per_sample - 1;
 
@@ -485,6 +488,14 @@ public:
         buffer[13] = (FLAC__byte) (((bitsMinus1 & 0x0f) << 4) | (unsigned int) ((info.total_samples >> 32) & 0x0f));
         packUint32 ((FLAC__uint32) info.total_samples, buffer + 14, 4);
         memcpy (buffer + 18, info.md5sum, 16);
+    }
+
+    void writeMetaData (const FlacNamespace::FLAC__StreamMetadata* metadata)
+    {
+        using namespace FlacNamespace;
+
+        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
+        packStreamInfo (metadata->data.stream_info, buffer);
 
         const bool seekOk = output->setPosition (streamStartPos + 4);
         ignoreUnused (seekOk);
@@ -538,6 +549,339 @@ private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacWriter)
 };
 
+#if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+
+//==============================================================================
+// FLAC frames don't depend on each other, so this writer splits the audio into
+// chunks of whole frames, encodes each chunk with its own encoder on a ThreadPool,
+// and then writes the frames out in order, renumbering them as it goes.
+class ParallelFlacWriter  : public AudioFormatWriter
+{
+public:
+    ParallelFlacWriter (OutputStream* out, double rate, uint32 numChans, uint32 bits,
+                        int quality, ThreadPool& poolToUse)
+        : AudioFormatWriter (out, flacFormatName, rate, numChans, bits),
+          threadPool (poolToUse),
+          qualityOptionIndex (quality),
+          maxChunksInProgress ((size_t) jmax (2, poolToUse.getNumThreads() * 2)),
+          streamStartPos (output != nullptr ? jmax (output->getPosition(), 0ll) : 0ll)
+    {
+        using namespace FlacNamespace;
+
+        // Let libFLAC decide the block size, so that every chunk will agree on it
+        auto* encoder = FLAC__stream_encoder_new();
+        FlacWriter::configureEncoder (encoder, numChannels, bitsPerSample, sampleRate, qualityOptionIndex);
+
+        ok = FLAC__stream_encoder_init_stream (encoder, ignoreWriteCallback, nullptr, nullptr, nullptr, nullptr)
+                == FLAC__STREAM_ENCODER_INIT_STATUS_OK;
+
+        if (ok)
+        {
+            blockSize = (int) FLAC__stream_encoder_get_blocksize (encoder);
+            FLAC__stream_encoder_finish (encoder);
+        }
+
+        FLAC__stream_encoder_delete (encoder);
+
+        FLAC__MD5Init (&md5);
+
+        // The STREAMINFO block is filled in when the writer is deleted
+        uint8 header[8 + FLAC__STREAM_METADATA_STREAMINFO_LENGTH] = {};
+        memcpy (header, "fLaC", 4);
+        header[4] = 0x80; // this is the last metadata block
+        header[7] = FLAC__STREAM_METADATA_STREAMINFO_LENGTH;
+
+        ok = ok && output->write (header, sizeof (header));
+    }
+
+    ~ParallelFlacWriter() override
+    {
+        if (ok)
+        {
+            if (currentChunk != nullptr && currentChunk->numSamples > 0)
+                startEncoding (std::move (currentChunk));
+
+            while (! chunksInProgress.empty())
+                writeOldestChunk();
+
+            writeStreamInfo();
+            output->flush();
+        }
+        else
+        {
+            output = nullptr; // to stop the base class deleting this, as it needs to be returned
+                              // to the caller of createWriter()
+        }
+    }
+
+    //==============================================================================
+    bool write (const int** samplesToWrite, int numSamples) override
+    {
+        if (! ok || writeFailed)
+            return false;
+
+        auto bitsToShift = 32 - (int) bitsPerSample;
+
+        // The caller's pointer array is left alone, as the base class helpers reuse it
+        int startOffset = 0;
+
+        while (numSamples > 0)
+        {
+            if (currentChunk == nullptr)
+                currentChunk.reset (new Chunk ((int) numChannels, blockSize * framesPerChunk));
+
+            auto& chunk = *currentChunk;
+            auto numToDo = jmin (numSamples, chunk.samples.getNumSamples() - chunk.numSamples);
+
+            for (int i = 0; i < (int) numChannels; ++i)
+            {
+                auto* dest = chunk.samples.getWritePointer (i, chunk.numSamples);
+
+                if (samplesToWrite[i] == nullptr)
+                    zeromem (dest, (size_t) numToDo * sizeof (int));
+                else
+                    for (int j = 0; j < numToDo; ++j)
+                        dest[j] = samplesToWrite[i][startOffset + j] >> bitsToShift;
+            }
+
+            FLAC__MD5Accumulate (&md5, chunk.getChannels (chunk.numSamples), numChannels,
+                                 (unsigned) numToDo, (bitsPerSample + 7) / 8);
+
+            chunk.numSamples += numToDo;
+            totalSamples += (uint64) numToDo;
+            numSamples -= numToDo;
+            startOffset += numToDo;
+
+            if (chunk.numSamples == chunk.samples.getNumSamples())
+                startEncoding (std::move (currentChunk));
+        }
+
+        return ! writeFailed;
+    }
+
+    bool ok = false;
+
+private:
+    //==============================================================================
+    struct Chunk
+    {
+        Chunk (int numChans, int maxSamples)  : samples (numChans, maxSamples) {}
+
+        const FlacNamespace::FLAC__int32* const* getChannels (int startSample)
+        {
+            for (int i = 0; i < samples.getNumChannels(); ++i)
+                channelPointers[i] = samples.getReadPointer (i, startSample);
+
+            return channelPointers;
+        }
+
+        AudioBuffer<int> samples;
+        int numSamples = 0;
+        const FlacNamespace::FLAC__int32* channelPointers[FLAC__MAX_CHANNELS] = {};
+
+        std::vector<MemoryBlock> frames;
+        bool encodedOk = false;
+        WaitableEvent finished;
+    };
+
+    ThreadPool& threadPool;
+    const int qualityOptionIndex;
+    const size_t maxChunksInProgress;
+    int64 streamStartPos;
+    int blockSize = 0;
+    enum { framesPerChunk = 32 };
+
+    std::unique_ptr<Chunk> currentChunk;
+    std::deque<std::unique_ptr<Chunk>> chunksInProgress;
+
+    FlacNamespace::FLAC__MD5Context md5;
+    uint64 totalSamples = 0;
+    bool writeFailed = false;
+    uint32 numFramesWritten = 0, minFrameSize = 0, maxFrameSize = 0;
+    HeapBlock<uint8> frameBuffer;
+    size_t frameBufferSize = 0;
+
+    //==============================================================================
+    void startEncoding (std::unique_ptr<Chunk> chunk)
+    {
+        auto* c = chunk.get();
+        chunksInProgress.push_back (std::move (chunk));
+
+        threadPool.addJob ([this, c]
+        {
+            encodeChunk (*c);
+            c->finished.signal();
+        });
+
+        while (chunksInProgress.size() > maxChunksInProgress)
+            writeOldestChunk();
+    }
+
+    void encodeChunk (Chunk& chunk) const
+    {
+        using namespace FlacNamespace;
+
+        auto* encoder = FLAC__stream_encoder_new();
+        FlacWriter::configureEncoder (encoder, numChannels, bitsPerSample, sampleRate, qualityOptionIndex);
+        FLAC__stream_encoder_set_blocksize (encoder, (unsigned) blockSize);
+        FLAC__stream_encoder_set_do_md5 (encoder, false);
+
+        chunk.encodedOk = FLAC__stream_encoder_init_stream (encoder, chunkWriteCallback, nullptr, nullptr, nullptr, &chunk)
+                            == FLAC__STREAM_ENCODER_INIT_STATUS_OK
+                       && FLAC__stream_encoder_process (encoder, chunk.getChannels (0), (unsigned) chunk.numSamples) != 0;
+
+        chunk.encodedOk = FLAC__stream_encoder_finish (encoder) != 0 && chunk.encodedOk;
+        FLAC__stream_encoder_delete (encoder);
+    }
+
+    void writeOldestChunk()
+    {
+        auto chunk = std::move (chunksInProgress.front());
+        chunksInProgress.pop_front();
+        chunk->finished.wait();
+
+        writeFailed = writeFailed || ! chunk->encodedOk;
+
+        for (auto& frame : chunk->frames)
+            writeFailed = writeFailed || ! writeFrame (static_cast<const uint8*> (frame.getData()), frame.getSize());
+    }
+
+    //==============================================================================
+    // Each chunk's frames are numbered from zero, so the frame number in the header has
+    // to be replaced, which also means recalculating the header and frame checksums.
+    bool writeFrame (const uint8* frame, size_t size)
+    {
+        using namespace FlacNamespace;
+
+        jassert (size > 7 && frame[0] == 0xff && frame[1] == 0xf8); // should be a fixed-blocksize frame header
+
+        auto oldNumberSize = getCodedNumberSize (frame[4]);
+        auto blockSizeCode = frame[2] >> 4;
+        auto sampleRateCode = frame[2] & 0x0f;
+        auto extraHeaderSize = (size_t) (blockSizeCode == 6 ? 1 : (blockSizeCode == 7 ? 2 : 0))
+                                 + (size_t) (sampleRateCode == 12 ? 1 : (sampleRateCode == 13 || sampleRateCode == 14 ? 2 : 0));
+
+        auto bodyStart = 4 + oldNumberSize + extraHeaderSize + 1;
+        auto bodySize = size - bodyStart - 2;
+
+        auto maxNewSize = size + 6;
+
+        if (frameBufferSize < maxNewSize)
+        {
+            frameBufferSize = maxNewSize;
+            frameBuffer.malloc (frameBufferSize);
+        }
+
+        auto* d = frameBuffer.get();
+        memcpy (d, frame, 4);
+
+        auto headerSize = 4 + writeCodedNumber (d + 4, numFramesWritten++);
+        memcpy (d + headerSize, frame + 4 + oldNumberSize, extraHeaderSize);
+        headerSize += extraHeaderSize;
+        d[headerSize] = FLAC__crc8 (d, (unsigned) headerSize);
+
+        memcpy (d + headerSize + 1, frame + bodyStart, bodySize);
+        auto newSize = headerSize + 1 + bodySize;
+        auto crc = FLAC__crc16 (d, (unsigned) newSize);
+        d[newSize++] = (uint8) (crc >> 8);
+        d[newSize++] = (uint8) (crc & 0xff);
+
+        minFrameSize = minFrameSize == 0 ? (uint32) newSize : jmin (minFrameSize, (uint32) newSize);
+        maxFrameSize = jmax (maxFrameSize, (uint32) newSize);
+
+        return output->write (d, newSize);
+    }
+
+    static size_t getCodedNumberSize (uint8 firstByte) noexcept
+    {
+        size_t numBytes = 1;
+
+        if ((firstByte & 0x80) != 0)
+            for (auto mask = 0x40; (firstByte & mask) != 0 && numBytes < 7; mask >>= 1)
+                ++numBytes;
+
+        return numBytes;
+    }
+
+    // Frame numbers are stored in the same variable-length format as UTF-8
+    static size_t writeCodedNumber (uint8* dest, uint32 value) noexcept
+    {
+        if (value < 0x80)
+        {
+            dest[0] = (uint8) value;
+            return 1;
+        }
+
+        size_t numBytes = 2;
+
+        while (numBytes < 6 && value >= (1u << (5 * numBytes + 1)))
+            ++numBytes;
+
+        for (auto i = numBytes; --i > 0;)
+        {
+            dest[i] = (uint8) (0x80 | (value & 0x3f));
+            value >>= 6;
+        }
+
+        dest[0] = (uint8) ((0xff00 >> numBytes) | value);
+        return numBytes;
+    }
+
+    void writeStreamInfo()
+    {
+        using namespace FlacNamespace;
+
+        FLAC__StreamMetadata_StreamInfo info {};
+        info.min_blocksize = (unsigned) blockSize;
+        info.max_blocksize = (unsigned) blockSize;
+        info.min_framesize = minFrameSize;
+        info.max_framesize = maxFrameSize;
+        info.sample_rate = (unsigned) sampleRate;
+        info.channels = numChannels;
+        info.bits_per_sample = jmin ((unsigned int) 24, bitsPerSample);
+        info.total_samples = totalSamples;
+        FLAC__MD5Final (info.md5sum, &md5);
+
+        unsigned char buffer[FLAC__STREAM_METADATA_STREAMINFO_LENGTH];
+        FlacWriter::packStreamInfo (info, buffer);
+
+        const bool seekOk = output->setPosition (streamStartPos + 8);
+        ignoreUnused (seekOk);
+
+        // if this fails, you've given it an output stream that can't seek! It needs
+        // to be able to seek back to write the header
+        jassert (seekOk);
+
+        output->write (buffer, FLAC__STREAM_METADATA_STREAMINFO_LENGTH);
+    }
+
+    //==============================================================================
+    static FlacNamespace::FLAC__StreamEncoderWriteStatus chunkWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                             const FlacNamespace::FLAC__byte buffer[],
+                                                                             size_t bytes,
+                                                                             unsigned int samples,
+                                                                             unsigned int /*current_frame*/,
+                                                                             void* client_data)
+    {
+        // The stream header is written with no samples, and is thrown away
+        if (samples > 0)
+            static_cast<Chunk*> (client_data)->frames.emplace_back (buffer, bytes);
+
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    static FlacNamespace::FLAC__StreamEncoderWriteStatus ignoreWriteCallback (const FlacNamespace::FLAC__StreamEncoder*,
+                                                                              const FlacNamespace::FLAC__byte[], size_t,
+                                                                              unsigned int, unsigned int, void*)
+    {
+        return FlacNamespace::FLAC__STREAM_ENCODER_WRITE_STATUS_OK;
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParallelFlacWriter)
+};
+
+#endif
+
 
 //==============================================================================
 FlacAudioFormat::FlacAudioFormat()  : AudioFormat (flacFormatName, ".flac") {}
@@ -589,11 +933,225 @@ AudioFormatWriter* FlacAudioFormat::createWriterFor (OutputStream* out,
     return nullptr;
 }
 
+AudioFormatWriter* FlacAudioFormat::createParallelWriterFor (OutputStream* out,
+                                                             double sampleRate,
+                                                             unsigned int numberOfChannels,
+                                                             int bitsPerSample,
+                                                             int qualityOptionIndex,
+                                                             ThreadPool& threadPool)
+{
+   #if JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE)
+    if (out != nullptr && getPossibleBitDepths().contains (bitsPerSample))
+    {
+        std::unique_ptr<ParallelFlacWriter> w (new ParallelFlacWriter (out, sampleRate, numberOfChannels,
+                                                                     (uint32) bitsPerSample, qualityOptionIndex,
+                                                                     threadPool));
+        if (w->ok)
+            return w.release();
+    }
+
+    return nullptr;
+   #else
+    ignoreUnused (threadPool);
+    return createWriterFor (out, sampleRate, numberOfChannels, bitsPerSample, {}, qualityOptionIndex);
+   #endif
+}
+
 StringArray FlacAudioFormat::getQualityOptions()
 {
     return { "0 (Fastest)", "1", "2", "3", "4", "5 (Default)","6", "7", "8 (Highest quality)" };
 }
 
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS && (JUCE_INCLUDE_FLAC_CODE || ! defined (JUCE_INCLUDE_FLAC_CODE))
+
+class FlacAudioFormatTests  : public UnitTest
+{
+public:
+    FlacAudioFormatTests()
+        : UnitTest ("FLAC audio format", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Parallel writer output decodes to the original samples");
+        {
+            ThreadPool pool (4);
+
+            for (auto bits : { 16, 24 })
+                for (auto numChannels : { 1, 2 })
+                    for (auto quality : { 0, 5 })
+                        checkRoundTrip (pool, bits, numChannels, quality, 150000);
+        }
+
+        beginTest ("Parallel writer handles short and empty files");
+        {
+            ThreadPool pool (2);
+
+            for (auto numSamples : { 0, 1, 1000, 4096 })
+                checkRoundTrip (pool, 16, 2, 5, numSamples);
+        }
+
+        beginTest ("Parallel writer works with the float helpers and ThreadedWriter");
+        {
+            ThreadPool pool (2);
+            auto random = getRandom();
+            AudioBuffer<float> source (2, 20000);
+
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                for (int i = 0; i < source.getNumSamples(); ++i)
+                    source.setSample (ch, i, (random.nextFloat() * 2.0f - 1.0f) * 0.9f);
+
+            FlacAudioFormat format;
+
+            {
+                // This converts the data in blocks of 4096 samples, reusing the same channel pointers
+                MemoryBlock data;
+
+                {
+                    std::unique_ptr<AudioFormatWriter> writer (format.createParallelWriterFor (new MemoryOutputStream (data, false),
+                                                                                               44100.0, 2, 16, 5, pool));
+                    expect (writer != nullptr);
+                    expect (writer->writeFromAudioSampleBuffer (source, 0, source.getNumSamples()));
+                }
+
+                checkDecodesTo (format, data, source);
+            }
+
+            {
+                MemoryBlock data;
+
+                {
+                    TimeSliceThread thread ("FLAC test writer");
+                    thread.startThread();
+
+                    AudioFormatWriter::ThreadedWriter writer (format.createParallelWriterFor (new MemoryOutputStream (data, false),
+                                                                                              44100.0, 2, 16, 5, pool),
+                                                              thread, 32768);
+
+                    for (int pos = 0; pos < source.getNumSamples(); pos += 1000)
+                    {
+                        const float* channels[] = { source.getReadPointer (0, pos), source.getReadPointer (1, pos) };
+                        expect (writer.write (channels, jmin (1000, source.getNumSamples() - pos)));
+                    }
+                }
+
+                checkDecodesTo (format, data, source);
+            }
+        }
+    }
+
+private:
+    void checkRoundTrip (ThreadPool& pool, int bits, int numChannels, int quality, int numSamples)
+    {
+        auto random = getRandom();
+        AudioBuffer<int> source (numChannels, numSamples);
+
+        // A noisy sine wave gives the encoder a mix of predictable and unpredictable data
+        for (int ch = 0; ch < numChannels; ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                source.setSample (ch, i, (int) ((std::sin (i * 0.01 * (ch + 1)) * 0.8 + (random.nextDouble() - 0.5) * 0.1)
+                                                  * (1 << (bits - 1))) * (1 << (32 - bits)));
+
+        FlacAudioFormat format;
+        MemoryBlock serialData, parallelData;
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createWriterFor (new MemoryOutputStream (serialData, false),
+                                                                               44100.0, (unsigned int) numChannels, bits, {}, quality));
+            expect (writeInPieces (*writer, source));
+        }
+
+        {
+            std::unique_ptr<AudioFormatWriter> writer (format.createParallelWriterFor (new MemoryOutputStream (parallelData, false),
+                                                                                       44100.0, (unsigned int) numChannels,
+                                                                                       bits, quality, pool));
+            expect (writer != nullptr);
+            expect (writeInPieces (*writer, source));
+        }
+
+        // Apart from the frame sizes, the STREAMINFO blocks should be the same
+        expect (parallelData.getSize() >= 42);
+        expect (streamInfoMatches (serialData, parallelData, 0, 4));
+        expect (streamInfoMatches (serialData, parallelData, 8, 4));
+        expect (streamInfoMatches (serialData, parallelData, 18, 24));
+
+        std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (parallelData, false), true));
+        expect (reader != nullptr);
+        expectEquals ((int) reader->lengthInSamples, numSamples);
+        expectEquals ((int) reader->numChannels, numChannels);
+
+        if (numSamples > 0)
+        {
+            AudioBuffer<int> decoded (numChannels, numSamples);
+            expect (reader->read (decoded.getArrayOfWritePointers(), numChannels, 0, numSamples, false));
+
+            bool allMatch = true;
+
+            for (int ch = 0; ch < numChannels; ++ch)
+                allMatch = allMatch && memcmp (source.getReadPointer (ch), decoded.getReadPointer (ch),
+                                               (size_t) numSamples * sizeof (int)) == 0;
+
+            expect (allMatch);
+        }
+    }
+
+    void checkDecodesTo (FlacAudioFormat& format, const MemoryBlock& data, const AudioBuffer<float>& expected)
+    {
+        std::unique_ptr<AudioFormatReader> reader (format.createReaderFor (new MemoryInputStream (data, false), true));
+        expect (reader != nullptr);
+
+        if (reader == nullptr)
+            return;
+
+        auto numSamples = expected.getNumSamples();
+        expectEquals ((int) reader->lengthInSamples, numSamples);
+
+        AudioBuffer<float> decoded (expected.getNumChannels(), numSamples);
+        reader->read (&decoded, 0, numSamples, 0, true, true);
+
+        float maxError = 0;
+
+        for (int ch = 0; ch < expected.getNumChannels(); ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                maxError = jmax (maxError, std::abs (decoded.getSample (ch, i) - expected.getSample (ch, i)));
+
+        // Only the conversion to 16 bits should make any difference
+        expectLessThan (maxError, 1.0f / 16384.0f);
+    }
+
+    static bool streamInfoMatches (const MemoryBlock& a, const MemoryBlock& b, size_t start, size_t size)
+    {
+        return memcmp (addBytesToPointer (a.getData(), start), addBytesToPointer (b.getData(), start), size) == 0;
+    }
+
+    bool writeInPieces (AudioFormatWriter& writer, const AudioBuffer<int>& source)
+    {
+        auto random = getRandom();
+
+        for (int pos = 0; pos < source.getNumSamples();)
+        {
+            auto numToDo = jmin (source.getNumSamples() - pos, 1 + random.nextInt (10000));
+            const int* channels[3] = {};
+
+            for (int ch = 0; ch < source.getNumChannels(); ++ch)
+                channels[ch] = source.getReadPointer (ch, pos);
+
+            if (! writer.write (channels, numToDo))
+                return false;
+
+            pos += numToDo;
+        }
+
+        return true;
+    }
+};
+
+static FlacAudioFormatTests flacAudioFormatTests;
+
+#endif
+
 #endif
 
 } // namespace juce
@@ -65,6 +65,27 @@ public:
                                         int qualityOptionIndex) override;
     using AudioFormat::createWriterFor;
 
+    /** Creates a writer which encodes the audio on a ThreadPool.
+
+        FLAC frames can be encoded independently, so this writer collects the incoming
+        audio into chunks of several frames, and hands each chunk to the thread pool
+        to be encoded. The encoded frames are written to the stream in order, so the
+        file is the same as one made by createWriterFor(), apart from the exact
+        compression of each frame.
+
+        The stream must be able to seek, because the header is filled in when the
+        writer is deleted. Deleting the writer will block until all of the chunks
+        have been encoded.
+
+        The parameters and return value are the same as for createWriterFor().
+    */
+    AudioFormatWriter* createParallelWriterFor (OutputStream* streamToWriteTo,
+                                                double sampleRateToUse,
+                                                unsigned int numberOfChannels,
+                                                int bitsPerSample,
+                                                int qualityOptionIndex,
+                                                ThreadPool& threadPoolToUse);
+
 private:
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FlacAudioFormat)
 };
@@ -124,10 +124,23 @@ AudioFormatReader* AudioFormatManager::createReaderFor (const File& file)
     jassert (getNumKnownFormats() > 0);
 
     for (auto* af : knownFormats)
+    {
         if (af->canHandleFile (file))
+        {
             if (auto in = file.createInputStream())
+            {
                 if (auto* r = af->createReaderFor (in.release(), true))
+                {
+                    if (decodedBlockCache != nullptr && af->isCompressed())
+                        return decodedBlockCache->createCachingReader (r, file.getFullPathName()
+                                                                            + ":" + String (file.getSize())
+                                                                            + ":" + String (file.getLastModificationTime().toMilliseconds()));
+
                     return r;
+                }
+            }
+        }
+    }
 
     return nullptr;
 }
@@ -161,4 +174,14 @@ AudioFormatReader* AudioFormatManager::createReaderFor (std::unique_ptr<InputStr
     return nullptr;
 }
 
+void AudioFormatManager::setDecodedBlockCacheSize (size_t maxSizeInBytes)
+{
+    if (maxSizeInBytes == 0)
+        decodedBlockCache.reset();
+    else if (decodedBlockCache == nullptr)
+        decodedBlockCache.reset (new DecodedAudioBlockCache (maxSizeInBytes));
+    else
+        decodedBlockCache->setMaximumSize (maxSizeInBytes);
+}
+
 } // namespace juce
@@ -122,6 +122,10 @@ public:
 
         If none of the registered formats can open the file, it'll return nullptr.
         It's the caller's responsibility to delete the reader that is returned.
+
+        If setDecodedBlockCacheSize() has been used to enable the cache, and the file
+        is in a compressed format, then the reader that is returned will read via the
+        cache, so it won't be an instance of the format's own reader class.
     */
     AudioFormatReader* createReaderFor (const File& audioFile);
 
@@ -139,10 +143,33 @@ public:
     */
     AudioFormatReader* createReaderFor (std::unique_ptr<InputStream> audioFileStream);
 
+    //==============================================================================
+    /** Enables a cache of decoded audio which is shared by all the readers that this
+        manager creates for compressed files.
+
+        When this is enabled, any reader which createReaderFor (const File&) creates for
+        a format whose AudioFormat::isCompressed() method returns true will keep the
+        blocks that it decodes in the cache, so that other readers for the same file can
+        use them, and random-access reads don't need to decode the same data repeatedly.
+        Blocks are identified by the file's path, size and modification time.
+
+        Passing 0 will disable the cache for any readers created after this call. Any
+        existing readers will keep using the old cache until they're deleted.
+
+        @see DecodedAudioBlockCache
+    */
+    void setDecodedBlockCacheSize (size_t maxSizeInBytes);
+
+    /** Returns the cache which was enabled by setDecodedBlockCacheSize(), or nullptr
+        if it's not enabled.
+    */
+    DecodedAudioBlockCache* getDecodedBlockCache() const noexcept     { return decodedBlockCache.get(); }
+
 private:
     //==============================================================================
     OwnedArray<AudioFormat> knownFormats;
     int defaultFormatIndex = 0;
+    std::unique_ptr<DecodedAudioBlockCache> decodedBlockCache;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AudioFormatManager)
 };
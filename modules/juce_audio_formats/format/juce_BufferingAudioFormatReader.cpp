@@ -26,11 +26,63 @@
 namespace juce
 {
 
-BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
-                                            TimeSliceThread& timeSliceThread,
-                                            int samplesToBuffer)
+#if JUCE_LINUX
+// Tells the OS which bytes of the source file are about to be needed, so that it can
+// start pulling them into its page cache while the reads for other streams are happening.
+// The byte positions are only estimated from the sample positions, which is fine for a hint.
+struct BufferingAudioReader::ReadAheadHint
+{
+    explicit ReadAheadHint (const File& file)
+        : fileDescriptor (open (file.getFullPathName().toUTF8(), O_RDONLY)),
+          fileSize (file.getSize())
+    {
+    }
+
+    ~ReadAheadHint()
+    {
+        if (fileDescriptor >= 0)
+            close (fileDescriptor);
+    }
+
+    void hint (Range<int64> samples, int64 lengthInSamples)
+    {
+        if (fileDescriptor < 0 || lengthInSamples <= 0 || hinted.contains (samples))
+            return;
+
+        // If this carries on from the last hint, only the new part needs mentioning
+        if (samples.getStart() >= hinted.getStart() && samples.getStart() <= hinted.getEnd())
+        {
+            samples = samples.withStart (hinted.getEnd());
+            hinted = hinted.getUnionWith (samples);
+        }
+        else
+        {
+            hinted = samples;
+        }
+
+        auto bytesPerSample = (double) fileSize / (double) lengthInSamples;
+        auto startByte = (int64) ((double) samples.getStart() * bytesPerSample);
+        auto numBytes  = (int64) ((double) samples.getLength() * bytesPerSample) + 1;
+
+        posix_fadvise (fileDescriptor, (off_t) startByte, (off_t) numBytes, POSIX_FADV_WILLNEED);
+    }
+
+    const int fileDescriptor;
+    const int64 fileSize;
+    Range<int64> hinted;
+};
+#else
+struct BufferingAudioReader::ReadAheadHint
+{
+    explicit ReadAheadHint (const File&) {}
+    void hint (Range<int64>, int64) {}
+};
+#endif
+
+//==============================================================================
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader, int samplesToBuffer)
     : AudioFormatReader (nullptr, sourceReader->getFormatName()),
-      source (sourceReader), thread (timeSliceThread),
+      source (sourceReader),
       numBlocks (1 + (samplesToBuffer / samplesPerBlock))
 {
     sampleRate            = source->sampleRate;
@@ -40,15 +92,34 @@ BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
     bitsPerSample         = 32;
     usesFloatingPointData = true;
 
-    for (int i = 3; --i >= 0;)
-        readNextBufferChunk();
+    readNextBufferChunk (3);
+}
 
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            TimeSliceThread& timeSliceThread,
+                                            int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, samplesToBuffer)
+{
+    thread = &timeSliceThread;
     timeSliceThread.addTimeSliceClient (this);
 }
 
+BufferingAudioReader::BufferingAudioReader (AudioFormatReader* sourceReader,
+                                            DiskStreamingScheduler& diskStreamingScheduler,
+                                            int samplesToBuffer)
+    : BufferingAudioReader (sourceReader, samplesToBuffer)
+{
+    scheduler = &diskStreamingScheduler;
+    diskStreamingScheduler.addReader (this);
+}
+
 BufferingAudioReader::~BufferingAudioReader()
 {
-    thread.removeTimeSliceClient (this);
+    if (thread != nullptr)
+        thread->removeTimeSliceClient (this);
+
+    if (scheduler != nullptr)
+        scheduler->removeReader (this);
 }
 
 void BufferingAudioReader::setReadTimeout (int timeoutMilliseconds) noexcept
@@ -64,7 +135,11 @@ bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels,
                                        startSampleInFile, numSamples, lengthInSamples);
 
     const ScopedLock sl (lock);
-    nextReadPosition = startSampleInFile;
+    auto previousPosition = nextReadPosition.exchange (startSampleInFile);
+
+    // The scheduler only needs waking when the read position moves into another block
+    if (scheduler != nullptr && previousPosition / samplesPerBlock != startSampleInFile / samplesPerBlock)
+        scheduler->notify();
 
     while (numSamples > 0)
     {
@@ -98,10 +173,14 @@ bool BufferingAudioReader::readSamples (int** destSamples, int numDestChannels,
                     if (auto dest = (float*) destSamples[j])
                         FloatVectorOperations::clear (dest + startOffsetInDestBuffer, numSamples);
 
+                ++numUnderruns;
                 break;
             }
             else
             {
+                if (scheduler != nullptr)
+                    scheduler->notify();
+
                 ScopedUnlock ul (lock);
                 Thread::yield();
             }
@@ -127,38 +206,89 @@ BufferingAudioReader::BufferedBlock* BufferingAudioReader::getBlockContaining (i
     return nullptr;
 }
 
-int BufferingAudioReader::useTimeSlice()
+Range<int64> BufferingAudioReader::getBufferWindow (int64 pos) const noexcept
 {
-    return readNextBufferChunk() ? 1 : 100;
+    auto startPos = ((pos - 1024) / samplesPerBlock) * samplesPerBlock;
+    auto endPos = startPos + numBlocks * samplesPerBlock;
+
+    // there's no point reading any blocks that start beyond the end of the source
+    return { startPos, jmax (startPos, jmin (endPos, lengthInSamples)) };
 }
 
-bool BufferingAudioReader::readNextBufferChunk()
+BufferingAudioReader::BufferHealth BufferingAudioReader::getBufferHealth() const
 {
     auto pos = nextReadPosition.load();
-    auto startPos = ((pos - 1024) / samplesPerBlock) * samplesPerBlock;
-    auto endPos = startPos + numBlocks * samplesPerBlock;
+    auto windowEnd = jmax (pos, getBufferWindow (pos).getEnd());
+
+    BufferHealth health;
+    health.numSamplesToBuffer = windowEnd - pos;
+    health.numUnderruns = numUnderruns;
+
+    const ScopedLock sl (lock);
+    auto bufferedEnd = pos;
+
+    while (bufferedEnd < windowEnd)
+    {
+        if (auto* block = getBlockContaining (bufferedEnd))
+            bufferedEnd = block->range.getEnd();
+        else
+            break;
+    }
+
+    health.numSamplesBufferedAhead = jmin (bufferedEnd, windowEnd) - pos;
+    return health;
+}
+
+int BufferingAudioReader::useTimeSlice()
+{
+    return readNextBufferChunk (1) ? 1 : 100;
+}
+
+bool BufferingAudioReader::readNextBufferChunk (int maxBlocksToRead, bool hintReadAhead)
+{
+    auto window = getBufferWindow (nextReadPosition.load());
 
     OwnedArray<BufferedBlock> newBlocks;
 
     for (int i = blocks.size(); --i >= 0;)
-        if (blocks.getUnchecked(i)->range.intersects (Range<int64> (startPos, endPos)))
+        if (blocks.getUnchecked(i)->range.intersects (window))
             newBlocks.add (blocks.getUnchecked(i));
 
-    if (newBlocks.size() == numBlocks)
+    auto gapStart = window.getStart();
+
+    while (gapStart < window.getEnd())
+    {
+        if (auto* block = getBlockContaining (gapStart))
+            gapStart = block->range.getEnd();
+        else
+            break;
+    }
+
+    if (gapStart >= window.getEnd())
     {
         newBlocks.clear (false);
         return false;
     }
 
-    for (auto p = startPos; p < endPos; p += samplesPerBlock)
+    // Fill as much of the gap as we're allowed to with a single read, as one long
+    // sequential read is much quicker than several shorter ones
+    auto gapEnd = gapStart + samplesPerBlock;
+
+    for (int i = 1; i < maxBlocksToRead && gapEnd < window.getEnd() && getBlockContaining (gapEnd) == nullptr; ++i)
+        gapEnd += samplesPerBlock;
+
+    if (hintReadAhead)
     {
-        if (getBlockContaining (p) == nullptr)
-        {
-            newBlocks.add (new BufferedBlock (*source, p, samplesPerBlock));
-            break; // just do one block
-        }
+        if (readAheadHint == nullptr)
+            if (auto* fileStream = dynamic_cast<FileInputStream*> (source->input))
+                readAheadHint.reset (new ReadAheadHint (fileStream->getFile()));
+
+        if (readAheadHint != nullptr)
+            readAheadHint->hint ({ gapStart, window.getEnd() }, lengthInSamples);
     }
 
+    newBlocks.add (new BufferedBlock (*source, gapStart, (int) (gapEnd - gapStart)));
+
     {
         const ScopedLock sl (lock);
         newBlocks.swapWith (blocks);
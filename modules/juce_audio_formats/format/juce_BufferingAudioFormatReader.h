@@ -31,7 +31,12 @@ namespace juce
     An AudioFormatReader that uses a background thread to pre-read data from
     another reader.
 
-    @see AudioFormatReader
+    The reading can either be done by a TimeSliceThread, which gives each of its
+    clients a turn in rotation, or by a DiskStreamingScheduler, which always tops up
+    whichever of its readers is closest to running out of data first, and reads
+    several blocks at once.
+
+    @see AudioFormatReader, DiskStreamingScheduler
 
     @tags{Audio}
 */
@@ -53,6 +58,19 @@ public:
                           TimeSliceThread& timeSliceThread,
                           int samplesToBuffer);
 
+    /** Creates a reader which is filled by a DiskStreamingScheduler.
+
+        @param sourceReader     the source reader to wrap. This BufferingAudioReader
+                                takes ownership of this object and will delete it later
+                                when no longer needed
+        @param scheduler        the scheduler that should do the background reading. This
+                                must not be deleted while the reader object still exists.
+        @param samplesToBuffer  the total number of samples to buffer ahead.
+    */
+    BufferingAudioReader (AudioFormatReader* sourceReader,
+                          DiskStreamingScheduler& scheduler,
+                          int samplesToBuffer);
+
     ~BufferingAudioReader() override;
 
     /** Sets a number of milliseconds that the reader can block for in its readSamples()
@@ -62,13 +80,49 @@ public:
     */
     void setReadTimeout (int timeoutMilliseconds) noexcept;
 
+    //==============================================================================
+    /** Describes how much data a BufferingAudioReader has ready to be read. */
+    struct BufferHealth
+    {
+        /** The number of samples after the last read position which are in memory,
+            with no gaps. Any samples beyond the end of the source count as buffered.
+        */
+        int64 numSamplesBufferedAhead = 0;
+
+        /** The number of samples after the last read position that the reader is
+            trying to keep in memory.
+        */
+        int64 numSamplesToBuffer = 0;
+
+        /** The number of times that readSamples() has timed out and returned silence
+            because the data it needed hadn't been read yet.
+        */
+        int numUnderruns = 0;
+
+        /** Returns how full the buffer is, between 0 and 1. */
+        double getProportionFilled() const noexcept
+        {
+            return numSamplesToBuffer > 0 ? (double) numSamplesBufferedAhead / (double) numSamplesToBuffer : 1.0;
+        }
+    };
+
+    /** Returns the current state of the buffer. This can be called from any thread. */
+    BufferHealth getBufferHealth() const;
+
+    //==============================================================================
     bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
                       int64 startSampleInFile, int numSamples) override;
 
 private:
+    friend class DiskStreamingScheduler;
+    struct ReadAheadHint;
+
     std::unique_ptr<AudioFormatReader> source;
-    TimeSliceThread& thread;
+    TimeSliceThread* thread = nullptr;
+    DiskStreamingScheduler* scheduler = nullptr;
+    std::unique_ptr<ReadAheadHint> readAheadHint;
     std::atomic<int64> nextReadPosition { 0 };
+    std::atomic<int> numUnderruns { 0 };
     const int numBlocks;
     int timeoutMs = 0;
 
@@ -85,9 +139,12 @@ private:
     CriticalSection lock;
     OwnedArray<BufferedBlock> blocks;
 
+    BufferingAudioReader (AudioFormatReader*, int samplesToBuffer);
+
     BufferedBlock* getBlockContaining (int64 pos) const noexcept;
+    Range<int64> getBufferWindow (int64 pos) const noexcept;
     int useTimeSlice() override;
-    bool readNextBufferChunk();
+    bool readNextBufferChunk (int maxBlocksToRead, bool hintReadAhead = false);
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BufferingAudioReader)
 };
@@ -0,0 +1,461 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+struct DecodedAudioBlockCache::Pool
+{
+    Pool (size_t maxSizeInBytes, int blockSize)
+        : samplesPerBlock (jmax (1, blockSize)), maxSize (maxSizeInBytes)
+    {
+    }
+
+    using BlockPtr = std::shared_ptr<const AudioBuffer<float>>;
+
+    BlockPtr find (const String& sourceID, int64 index)
+    {
+        const ScopedLock sl (lock);
+        auto found = blocks.find ({ sourceID, index });
+
+        if (found == blocks.end())
+        {
+            ++numMisses;
+            return {};
+        }
+
+        ++numHits;
+        usageOrder.splice (usageOrder.end(), usageOrder, found->second.usagePosition);
+        return found->second.block;
+    }
+
+    BlockPtr add (const String& sourceID, int64 index, BlockPtr block)
+    {
+        const ScopedLock sl (lock);
+        const Key key { sourceID, index };
+        auto existing = blocks.find (key);
+
+        // Another reader may have decoded the same block while we were doing it..
+        if (existing != blocks.end())
+            return existing->second.block;
+
+        auto size = getSizeInBytes (*block);
+
+        if (size <= maxSize)
+        {
+            usageOrder.push_back (key);
+            blocks[key] = { block, std::prev (usageOrder.end()) };
+            currentSize += size;
+            removeLeastRecentlyUsedBlocks();
+        }
+
+        return block;
+    }
+
+    void setMaximumSize (size_t newSize)
+    {
+        const ScopedLock sl (lock);
+        maxSize = newSize;
+        removeLeastRecentlyUsedBlocks();
+    }
+
+    void removeBlocksFor (const String& sourceID)
+    {
+        const ScopedLock sl (lock);
+
+        for (auto i = blocks.begin(); i != blocks.end();)
+        {
+            if (i->first.sourceID == sourceID)
+            {
+                currentSize -= getSizeInBytes (*i->second.block);
+                usageOrder.erase (i->second.usagePosition);
+                i = blocks.erase (i);
+            }
+            else
+            {
+                ++i;
+            }
+        }
+    }
+
+    void clear()
+    {
+        const ScopedLock sl (lock);
+        blocks.clear();
+        usageOrder.clear();
+        currentSize = 0;
+    }
+
+    const int samplesPerBlock;
+    std::atomic<size_t> maxSize, currentSize { 0 };
+    std::atomic<int64> numHits { 0 }, numMisses { 0 };
+
+private:
+    struct Key
+    {
+        String sourceID;
+        int64 index;
+
+        bool operator< (const Key& other) const noexcept
+        {
+            return index != other.index ? index < other.index
+                                        : sourceID < other.sourceID;
+        }
+    };
+
+    struct Entry
+    {
+        BlockPtr block;
+        std::list<Key>::iterator usagePosition;
+    };
+
+    CriticalSection lock;
+    std::map<Key, Entry> blocks;
+    std::list<Key> usageOrder;
+
+    static size_t getSizeInBytes (const AudioBuffer<float>& block) noexcept
+    {
+        return (size_t) block.getNumChannels() * (size_t) block.getNumSamples() * sizeof (float);
+    }
+
+    void removeLeastRecentlyUsedBlocks()
+    {
+        while (currentSize > maxSize && ! usageOrder.empty())
+        {
+            auto oldest = blocks.find (usageOrder.front());
+            currentSize -= getSizeInBytes (*oldest->second.block);
+            blocks.erase (oldest);
+            usageOrder.pop_front();
+        }
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Pool)
+};
+
+//==============================================================================
+class DecodedAudioBlockCache::CachingReader  : public AudioFormatReader
+{
+public:
+    CachingReader (std::shared_ptr<Pool> poolToUse, AudioFormatReader* sourceReader, const String& id)
+        : AudioFormatReader (nullptr, sourceReader->getFormatName()),
+          pool (std::move (poolToUse)), source (sourceReader), sourceID (id)
+    {
+        sampleRate            = source->sampleRate;
+        lengthInSamples       = source->lengthInSamples;
+        numChannels           = source->numChannels;
+        metadataValues        = source->metadataValues;
+        bitsPerSample         = 32;
+        usesFloatingPointData = true;
+    }
+
+    bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                      int64 startSampleInFile, int numSamples) override
+    {
+        clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                           startSampleInFile, numSamples, lengthInSamples);
+
+        bool ok = true;
+
+        while (numSamples > 0)
+        {
+            auto index = startSampleInFile / pool->samplesPerBlock;
+            auto block = getBlock (index, ok);
+            auto offset = (int) (startSampleInFile - index * pool->samplesPerBlock);
+            auto numToDo = jmin (numSamples, block->getNumSamples() - offset);
+
+            if (numToDo <= 0)
+                break;
+
+            for (int j = 0; j < numDestChannels; ++j)
+            {
+                if (auto dest = (float*) destSamples[j])
+                {
+                    dest += startOffsetInDestBuffer;
+
+                    if (j < block->getNumChannels())
+                        FloatVectorOperations::copy (dest, block->getReadPointer (j, offset), numToDo);
+                    else
+                        FloatVectorOperations::clear (dest, numToDo);
+                }
+            }
+
+            startOffsetInDestBuffer += numToDo;
+            startSampleInFile += numToDo;
+            numSamples -= numToDo;
+        }
+
+        return ok;
+    }
+
+private:
+    std::shared_ptr<Pool> pool;
+    std::unique_ptr<AudioFormatReader> source;
+    const String sourceID;
+
+    Pool::BlockPtr getBlock (int64 index, bool& ok)
+    {
+        if (auto block = pool->find (sourceID, index))
+            return block;
+
+        auto start = index * pool->samplesPerBlock;
+        auto numSamples = (int) jmin ((int64) pool->samplesPerBlock, lengthInSamples - start);
+
+        auto block = std::make_shared<AudioBuffer<float>> ((int) numChannels, numSamples);
+
+        // A failed read isn't cached, so that it can be tried again next time
+        if (! source->read (block->getArrayOfWritePointers(), (int) numChannels, start, numSamples))
+        {
+            block->clear();
+            ok = false;
+            return block;
+        }
+
+        return pool->add (sourceID, index, std::move (block));
+    }
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CachingReader)
+};
+
+//==============================================================================
+DecodedAudioBlockCache::DecodedAudioBlockCache (size_t maxSizeInBytes, int samplesPerBlock)
+    : pool (std::make_shared<Pool> (maxSizeInBytes, samplesPerBlock))
+{
+}
+
+DecodedAudioBlockCache::~DecodedAudioBlockCache()
+{
+}
+
+AudioFormatReader* DecodedAudioBlockCache::createCachingReader (AudioFormatReader* sourceReader, const String& sourceID)
+{
+    jassert (sourceReader != nullptr);
+    return new CachingReader (pool, sourceReader, sourceID);
+}
+
+void DecodedAudioBlockCache::setMaximumSize (size_t maxSizeInBytes)    { pool->setMaximumSize (maxSizeInBytes); }
+size_t DecodedAudioBlockCache::getMaximumSize() const noexcept          { return pool->maxSize; }
+size_t DecodedAudioBlockCache::getCurrentSize() const noexcept          { return pool->currentSize; }
+int DecodedAudioBlockCache::getSamplesPerBlock() const noexcept         { return pool->samplesPerBlock; }
+void DecodedAudioBlockCache::clear()                                    { pool->clear(); }
+void DecodedAudioBlockCache::removeBlocksFor (const String& sourceID)   { pool->removeBlocksFor (sourceID); }
+int64 DecodedAudioBlockCache::getNumCacheHits() const noexcept          { return pool->numHits; }
+int64 DecodedAudioBlockCache::getNumCacheMisses() const noexcept        { return pool->numMisses; }
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class DecodedAudioBlockCacheTests  : public UnitTest
+{
+public:
+    DecodedAudioBlockCacheTests()
+        : UnitTest ("DecodedAudioBlockCache", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Cached reads match the source");
+        {
+            DecodedAudioBlockCache cache (1 << 20, 1000);
+            std::unique_ptr<AudioFormatReader> reader (cache.createCachingReader (new TestReader (10500), "test"));
+            TestReader reference (10500);
+
+            auto random = getRandom();
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto start = random.nextInt (12000) - 500;
+                auto length = random.nextInt (3000);
+
+                AudioBuffer<float> cached (2, length), expected (2, length);
+                reader->read (&cached, 0, length, start, true, true);
+                reference.read (&expected, 0, length, start, true, true);
+
+                expect (buffersMatch (cached, expected));
+            }
+        }
+
+        beginTest ("Readers with the same ID share blocks");
+        {
+            DecodedAudioBlockCache cache (1 << 20, 1000);
+            auto* source1 = new TestReader (5000);
+            auto* source2 = new TestReader (5000);
+            std::unique_ptr<AudioFormatReader> reader1 (cache.createCachingReader (source1, "shared"));
+            std::unique_ptr<AudioFormatReader> reader2 (cache.createCachingReader (source2, "shared"));
+
+            AudioBuffer<float> buffer (2, 5000);
+            reader1->read (&buffer, 0, 5000, 0, true, true);
+            reader1->read (&buffer, 0, 5000, 0, true, true);
+            reader2->read (&buffer, 0, 5000, 0, true, true);
+
+            expectEquals (source1->numReads, 5);
+            expectEquals (source2->numReads, 0);
+            expectEquals (cache.getNumCacheMisses(), (int64) 5);
+            expectEquals (cache.getNumCacheHits(), (int64) 10);
+
+            cache.removeBlocksFor ("shared");
+            expectEquals (cache.getCurrentSize(), (size_t) 0);
+
+            reader2->read (&buffer, 0, 1000, 0, true, true);
+            expectEquals (source2->numReads, 1);
+        }
+
+        beginTest ("The cache size is limited");
+        {
+            const auto blockSize = 2 * 1000 * sizeof (float);
+            DecodedAudioBlockCache cache (blockSize * 3, 1000);
+            auto* source = new TestReader (10000);
+            std::unique_ptr<AudioFormatReader> reader (cache.createCachingReader (source, "test"));
+
+            AudioBuffer<float> buffer (2, 1000);
+
+            for (int i = 0; i < 10; ++i)
+                reader->read (&buffer, 0, 1000, i * 1000, true, true);
+
+            expectEquals (cache.getCurrentSize(), blockSize * 3);
+            expectEquals (source->numReads, 10);
+
+            // The most recently used blocks should still be there, but the first one has gone
+            reader->read (&buffer, 0, 1000, 9000, true, true);
+            expectEquals (source->numReads, 10);
+            reader->read (&buffer, 0, 1000, 0, true, true);
+            expectEquals (source->numReads, 11);
+
+            cache.setMaximumSize (blockSize);
+            expectEquals (cache.getCurrentSize(), blockSize);
+
+            cache.clear();
+            expectEquals (cache.getCurrentSize(), (size_t) 0);
+        }
+
+        beginTest ("Failed reads aren't cached");
+        {
+            DecodedAudioBlockCache cache (1 << 20, 1000);
+            auto* source = new TestReader (5000);
+            std::unique_ptr<AudioFormatReader> reader (cache.createCachingReader (source, "test"));
+
+            AudioBuffer<float> buffer (2, 1000);
+            auto dest = buffer.getArrayOfWritePointers();
+
+            source->failReads = true;
+            expect (! reader->read (dest, 2, 0, 1000));
+            expectEquals (buffer.getMagnitude (0, 1000), 0.0f);
+            expectEquals (cache.getCurrentSize(), (size_t) 0);
+
+            source->failReads = false;
+            expect (reader->read (dest, 2, 0, 1000));
+            expectEquals (source->numReads, 2);
+            expect (buffer.getMagnitude (0, 1000) > 0.0f);
+            expectEquals (cache.getCurrentSize(), 2 * 1000 * sizeof (float));
+        }
+
+       #if JUCE_USE_FLAC
+        beginTest ("AudioFormatManager shares the cache between readers of compressed files");
+        {
+            TemporaryFile tempFile (".flac");
+            TestReader reference (20000);
+            AudioBuffer<float> expected (2, 20000);
+            reference.read (&expected, 0, 20000, 0, true, true);
+
+            {
+                FlacAudioFormat flac;
+                std::unique_ptr<AudioFormatWriter> writer (flac.createWriterFor (tempFile.getFile().createOutputStream().release(),
+                                                                                 44100.0, 2, 16, {}, 0));
+                expect (writer != nullptr);
+                writer->writeFromAudioSampleBuffer (expected, 0, 20000);
+            }
+
+            AudioFormatManager manager;
+            manager.registerBasicFormats();
+            manager.setDecodedBlockCacheSize (1 << 20);
+
+            std::unique_ptr<AudioFormatReader> reader1 (manager.createReaderFor (tempFile.getFile()));
+            std::unique_ptr<AudioFormatReader> reader2 (manager.createReaderFor (tempFile.getFile()));
+            expect (reader1 != nullptr && reader2 != nullptr);
+            expect (reader1->usesFloatingPointData);
+
+            AudioBuffer<float> result1 (2, 20000), result2 (2, 20000);
+            reader1->read (&result1, 0, 20000, 0, true, true);
+            auto misses = manager.getDecodedBlockCache()->getNumCacheMisses();
+            reader2->read (&result2, 0, 20000, 0, true, true);
+
+            expect (misses > 0);
+            expectEquals (manager.getDecodedBlockCache()->getNumCacheMisses(), misses);
+            expect (buffersMatch (result1, result2));
+
+            for (int ch = 0; ch < 2; ++ch)
+                for (int i = 0; i < 20000; i += 97)
+                    expectWithinAbsoluteError (result1.getSample (ch, i), expected.getSample (ch, i), 1.0f / 16384.0f);
+        }
+       #endif
+    }
+
+private:
+    struct TestReader  : public AudioFormatReader
+    {
+        explicit TestReader (int64 length)  : AudioFormatReader (nullptr, "test")
+        {
+            sampleRate = 44100.0;
+            lengthInSamples = length;
+            numChannels = 2;
+            bitsPerSample = 32;
+            usesFloatingPointData = true;
+        }
+
+        bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            ++numReads;
+            clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                               startSampleInFile, numSamples, lengthInSamples);
+
+            for (int j = 0; j < numDestChannels; ++j)
+                if (auto* dest = (float*) destSamples[j])
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[startOffsetInDestBuffer + i] = (float) ((startSampleInFile + i) % 1000) * (j == 0 ? 0.001f : -0.001f);
+
+            return ! failReads;
+        }
+
+        int numReads = 0;
+        bool failReads = false;
+    };
+
+    static bool buffersMatch (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                if (a.getSample (ch, i) != b.getSample (ch, i))
+                    return false;
+
+        return true;
+    }
+};
+
+static DecodedAudioBlockCacheTests decodedAudioBlockCacheTests;
+
+#endif
+
+} // namespace juce
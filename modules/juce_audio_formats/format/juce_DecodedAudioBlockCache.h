@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A size-limited cache of decoded audio, which can be shared by any number of
+    AudioFormatReaders.
+
+    Formats like WAV and AIFF can be read directly from a memory-mapped file, but
+    compressed formats have to decode their data every time it's read, and when
+    the reads jump around (e.g. in an AudioThumbnail, a looping AudioFormatReaderSource
+    or a Sampler), the same frames can end up being decoded over and over again.
+
+    Readers created with createCachingReader() split the source into fixed-size
+    blocks, which are decoded into floating point data the first time they're needed
+    and then kept in this cache. Blocks are identified by a source ID and their index,
+    so any readers which are created for the same source ID will share the same
+    blocks. When the cache grows beyond its maximum size, the blocks that have gone
+    the longest without being used are discarded.
+
+    The easiest way to use one is with AudioFormatManager::setDecodedBlockCacheSize(),
+    which will make the manager wrap all the readers it creates for compressed files.
+
+    @see AudioFormatManager::setDecodedBlockCacheSize
+
+    @tags{Audio}
+*/
+class JUCE_API  DecodedAudioBlockCache
+{
+public:
+    //==============================================================================
+    /** Creates a cache.
+
+        @param maxSizeInBytes       the maximum amount of decoded audio data to keep
+        @param samplesPerBlock      the number of samples that are decoded at once
+    */
+    explicit DecodedAudioBlockCache (size_t maxSizeInBytes, int samplesPerBlock = 16384);
+
+    /** Destructor.
+        Any readers which were created by this cache will keep working after it has
+        been deleted.
+    */
+    ~DecodedAudioBlockCache();
+
+    //==============================================================================
+    /** Creates a reader which reads from another reader via this cache.
+
+        @param sourceReader     the reader to read from. The object that is returned
+                                takes ownership of this reader, and will delete it when
+                                it's no longer needed
+        @param sourceID         a string which uniquely identifies the audio data in the
+                                source reader. All the readers which are given the same
+                                ID will share blocks, so if the data can change, make
+                                sure that the ID does too (e.g. by adding the file's
+                                modification time to it).
+
+        The reader that is returned always provides floating point data. Like any other
+        reader, a single object mustn't be used by more than one thread at once, but
+        any number of readers can use the same cache from different threads.
+    */
+    AudioFormatReader* createCachingReader (AudioFormatReader* sourceReader, const String& sourceID);
+
+    //==============================================================================
+    /** Changes the maximum size of the cache, discarding any blocks that don't fit. */
+    void setMaximumSize (size_t maxSizeInBytes);
+
+    /** Returns the maximum size of the cache, in bytes. */
+    size_t getMaximumSize() const noexcept;
+
+    /** Returns the number of bytes of decoded audio that are currently in the cache. */
+    size_t getCurrentSize() const noexcept;
+
+    /** Returns the number of samples in each block. */
+    int getSamplesPerBlock() const noexcept;
+
+    /** Discards all the blocks in the cache. */
+    void clear();
+
+    /** Discards any blocks that belong to the given source ID. */
+    void removeBlocksFor (const String& sourceID);
+
+    /** Returns the number of times that a reader has found the block it needed in the cache. */
+    int64 getNumCacheHits() const noexcept;
+
+    /** Returns the number of times that a reader has had to decode a block because it
+        wasn't in the cache.
+    */
+    int64 getNumCacheMisses() const noexcept;
+
+private:
+    //==============================================================================
+    struct Pool;
+    class CachingReader;
+    std::shared_ptr<Pool> pool;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DecodedAudioBlockCache)
+};
+
+} // namespace juce
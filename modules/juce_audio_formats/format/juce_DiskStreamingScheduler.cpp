@@ -0,0 +1,276 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class DiskStreamingScheduler::ServiceThread  : public Thread
+{
+public:
+    ServiceThread (DiskStreamingScheduler& s, const String& name)
+        : Thread (name), scheduler (s)
+    {
+    }
+
+    void run() override
+    {
+        while (! threadShouldExit())
+            if (! scheduler.serviceMostUrgentReader (*this))
+                scheduler.readersNeedData.wait (100);
+    }
+
+    // This is held while a reader is being filled, so that removeReader() can wait
+    // for the thread to finish with it
+    CriticalSection servicingLock;
+    std::atomic<BufferingAudioReader*> currentReader { nullptr };
+
+private:
+    DiskStreamingScheduler& scheduler;
+
+    JUCE_DECLARE_NON_COPYABLE (ServiceThread)
+};
+
+//==============================================================================
+DiskStreamingScheduler::DiskStreamingScheduler (const String& threadName, int numThreads, int blocksPerRead)
+{
+    jassert (numThreads > 0);
+
+    setMaxBlocksPerRead (blocksPerRead);
+
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+        threads.add (new ServiceThread (*this, threadName))->startThread();
+}
+
+DiskStreamingScheduler::~DiskStreamingScheduler()
+{
+    // All the readers must be deleted before the scheduler that fills them!
+    jassert (readers.isEmpty());
+
+    for (auto* t : threads)
+        t->signalThreadShouldExit();
+
+    for (auto* t : threads)
+    {
+        readersNeedData.signal();
+        t->stopThread (4000);
+    }
+}
+
+void DiskStreamingScheduler::setMaxBlocksPerRead (int newMaxBlocksPerRead) noexcept
+{
+    maxBlocksPerRead = jlimit (1, 64, newMaxBlocksPerRead);
+}
+
+int DiskStreamingScheduler::getNumReaders() const
+{
+    const ScopedLock sl (listLock);
+    return readers.size();
+}
+
+void DiskStreamingScheduler::addReader (BufferingAudioReader* reader)
+{
+    {
+        const ScopedLock sl (listLock);
+        readers.addIfNotAlreadyThere (reader);
+    }
+
+    notify();
+}
+
+void DiskStreamingScheduler::removeReader (BufferingAudioReader* reader)
+{
+    const ScopedLock sl (listLock);
+    readers.removeFirstMatchingValue (reader);
+
+    // If a thread is in the middle of filling this reader, wait for it to finish
+    for (auto* t : threads)
+        if (t->currentReader == reader)
+            const ScopedLock servicing (t->servicingLock);
+}
+
+void DiskStreamingScheduler::notify() noexcept
+{
+    readersNeedData.signal();
+}
+
+bool DiskStreamingScheduler::serviceMostUrgentReader (ServiceThread& serviceThread)
+{
+    BufferingAudioReader* mostUrgent = nullptr;
+
+    {
+        const ScopedLock sl (listLock);
+        auto shortestTimeBuffered = std::numeric_limits<double>::max();
+
+        for (auto* reader : readers)
+        {
+            bool isBeingServiced = false;
+
+            for (auto* t : threads)
+                if (t->currentReader == reader)
+                    isBeingServiced = true;
+
+            if (isBeingServiced)
+                continue;
+
+            auto health = reader->getBufferHealth();
+
+            if (health.numSamplesBufferedAhead >= health.numSamplesToBuffer)
+                continue;
+
+            auto timeBuffered = (double) health.numSamplesBufferedAhead / jmax (1.0, reader->sampleRate);
+
+            if (timeBuffered < shortestTimeBuffered)
+            {
+                shortestTimeBuffered = timeBuffered;
+                mostUrgent = reader;
+            }
+        }
+
+        if (mostUrgent == nullptr)
+            return false;
+
+        // This has to be taken before the list lock is released, or the reader could
+        // be removed and deleted before we start reading from it
+        serviceThread.servicingLock.enter();
+        serviceThread.currentReader = mostUrgent;
+    }
+
+    mostUrgent->readNextBufferChunk (maxBlocksPerRead, useReadAheadHints);
+
+    serviceThread.currentReader = nullptr;
+    serviceThread.servicingLock.exit();
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class DiskStreamingSchedulerTests  : public UnitTest
+{
+public:
+    DiskStreamingSchedulerTests()
+        : UnitTest ("DiskStreamingScheduler", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Buffered reads match the sources");
+        {
+            DiskStreamingScheduler scheduler ("test", 2);
+            OwnedArray<BufferingAudioReader> readers;
+
+            for (int i = 0; i < 3; ++i)
+            {
+                readers.add (new BufferingAudioReader (new TestReader (200000), scheduler, 65536));
+                readers.getLast()->setReadTimeout (-1);
+            }
+
+            expectEquals (scheduler.getNumReaders(), 3);
+
+            TestReader reference (200000);
+            auto random = getRandom();
+
+            for (int i = 0; i < 100; ++i)
+            {
+                auto* reader = readers[random.nextInt (readers.size())];
+                auto start = random.nextInt (210000) - 500;
+                auto length = random.nextInt (5000);
+
+                AudioBuffer<float> buffered (2, length), expected (2, length);
+                reader->read (&buffered, 0, length, start, true, true);
+                reference.read (&expected, 0, length, start, true, true);
+
+                expect (buffersMatch (buffered, expected));
+            }
+
+            readers.clear();
+            expectEquals (scheduler.getNumReaders(), 0);
+        }
+
+        beginTest ("Missing blocks are read in batches");
+        {
+            DiskStreamingScheduler scheduler ("test", 1, 4);
+            auto* source = new TestReader (400000);
+            BufferingAudioReader reader (source, scheduler, 8 * 32768);
+
+            for (int i = 0; i < 500 && reader.getBufferHealth().getProportionFilled() < 1.0; ++i)
+                Thread::sleep (10);
+
+            auto health = reader.getBufferHealth();
+            expectEquals (health.numSamplesBufferedAhead, health.numSamplesToBuffer);
+            expectEquals (health.numUnderruns, 0);
+
+            // 3 blocks are read by the constructor, then the other 6 in two reads of 4 and 2
+            expectEquals (source->numReads.load(), 3);
+        }
+    }
+
+private:
+    struct TestReader  : public AudioFormatReader
+    {
+        explicit TestReader (int64 length)  : AudioFormatReader (nullptr, "test")
+        {
+            sampleRate = 44100.0;
+            lengthInSamples = length;
+            numChannels = 2;
+            bitsPerSample = 32;
+            usesFloatingPointData = true;
+        }
+
+        bool readSamples (int** destSamples, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            ++numReads;
+            clearSamplesBeyondAvailableLength (destSamples, numDestChannels, startOffsetInDestBuffer,
+                                               startSampleInFile, numSamples, lengthInSamples);
+
+            for (int j = 0; j < numDestChannels; ++j)
+                if (auto* dest = (float*) destSamples[j])
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[startOffsetInDestBuffer + i] = (float) ((startSampleInFile + i) % 1000) * (j == 0 ? 0.001f : -0.001f);
+
+            return true;
+        }
+
+        std::atomic<int> numReads { 0 };
+    };
+
+    static bool buffersMatch (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                if (a.getSample (ch, i) != b.getSample (ch, i))
+                    return false;
+
+        return true;
+    }
+};
+
+static DiskStreamingSchedulerTests diskStreamingSchedulerTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+class BufferingAudioReader;
+
+//==============================================================================
+/**
+    A set of background threads which keep any number of BufferingAudioReaders
+    topped up with data.
+
+    When lots of files are being streamed from disk at once, giving every reader
+    its turn in strict rotation (as a TimeSliceThread does) means that a reader which
+    is about to run out of data can end up waiting behind others which have plenty
+    left. Instead, each time one of these threads is free, it picks the reader
+    which will run out soonest (i.e. the one with the fewest seconds of audio buffered
+    ahead of its read position), and fills in several of its missing blocks with one
+    large sequential read, which is much kinder to the disk than lots of small reads
+    of different files.
+
+    Readers are attached to a scheduler by passing it to the BufferingAudioReader
+    constructor, and the scheduler must outlive all the readers that use it.
+
+    @see BufferingAudioReader
+
+    @tags{Audio}
+*/
+class JUCE_API  DiskStreamingScheduler
+{
+public:
+    //==============================================================================
+    /** Creates a scheduler and starts its threads.
+
+        @param threadName           the name to give the threads
+        @param numThreads           the number of threads that can be reading at once. On
+                                    a single disk, one thread is usually best, but more
+                                    can help with SSDs, network drives or slow decoders
+        @param maxBlocksPerRead     the maximum number of blocks that are read from a
+                                    reader's source each time it is serviced
+    */
+    explicit DiskStreamingScheduler (const String& threadName = "Disk streaming",
+                                     int numThreads = 1,
+                                     int maxBlocksPerRead = 4);
+
+    /** Destructor.
+        All the readers that use this scheduler must have been deleted before it is.
+    */
+    ~DiskStreamingScheduler();
+
+    //==============================================================================
+    /** Changes the maximum number of blocks that are read for a reader each time
+        it is serviced.
+    */
+    void setMaxBlocksPerRead (int newMaxBlocksPerRead) noexcept;
+
+    /** Returns the maximum number of blocks that are read each time a reader is serviced. */
+    int getMaxBlocksPerRead() const noexcept                 { return maxBlocksPerRead; }
+
+    /** If enabled, the operating system is told which parts of a file are about to
+        be read, so that it can start reading them into its cache in the background.
+
+        This only works for readers whose source is reading from a FileInputStream,
+        and currently only has an effect on Linux, where it uses posix_fadvise().
+        It's disabled by default.
+    */
+    void setUseReadAheadHints (bool shouldUseHints) noexcept { useReadAheadHints = shouldUseHints; }
+
+    /** Returns the number of readers that are currently attached to this scheduler. */
+    int getNumReaders() const;
+
+private:
+    //==============================================================================
+    friend class BufferingAudioReader;
+    class ServiceThread;
+
+    void addReader (BufferingAudioReader*);
+    void removeReader (BufferingAudioReader*);
+    void notify() noexcept;
+    bool serviceMostUrgentReader (ServiceThread&);
+
+    CriticalSection listLock;
+    Array<BufferingAudioReader*> readers;
+    OwnedArray<ServiceThread> threads;
+    WaitableEvent readersNeedData;
+    std::atomic<int> maxBlocksPerRead;
+    std::atomic<bool> useReadAheadHints { false };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DiskStreamingScheduler)
+};
+
+} // namespace juce
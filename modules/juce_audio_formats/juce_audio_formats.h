@@ -114,9 +114,11 @@
 #include "format/juce_AudioFormatWriter.h"
 #include "format/juce_MemoryMappedAudioFormatReader.h"
 #include "format/juce_AudioFormat.h"
+#include "format/juce_DecodedAudioBlockCache.h"
 #include "format/juce_AudioFormatManager.h"
 #include "format/juce_AudioFormatReaderSource.h"
 #include "format/juce_AudioSubsectionReader.h"
+#include "format/juce_DiskStreamingScheduler.h"
 #include "format/juce_BufferingAudioFormatReader.h"
 #include "codecs/juce_AiffAudioFormat.h"
 #include "codecs/juce_CoreAudioFormat.h"
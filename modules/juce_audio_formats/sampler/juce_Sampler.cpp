@@ -52,10 +52,49 @@ SamplerSound::SamplerSound (const String& soundName,
     }
 }
 
+SamplerSound::SamplerSound (const String& soundName,
+                            std::unique_ptr<AudioFormatReader> source,
+                            const BigInteger& notes,
+                            int midiNoteForNormalPitch,
+                            double attackTimeSecs,
+                            double releaseTimeSecs,
+                            double maxSampleLengthSeconds,
+                            int numSamplesToPreload)
+    : name (soundName),
+      sourceSampleRate (source != nullptr ? source->sampleRate : 0.0),
+      midiNotes (notes),
+      midiRootNote (midiNoteForNormalPitch)
+{
+    if (sourceSampleRate > 0 && source->lengthInSamples > 0)
+    {
+        length = jmin ((int) source->lengthInSamples,
+                       (int) (maxSampleLengthSeconds * sourceSampleRate));
+
+        preloadLength = jlimit (1, jmax (1, length), numSamplesToPreload);
+
+        data.reset (new AudioBuffer<float> (jmin (2, (int) source->numChannels), preloadLength + 4));
+
+        source->read (data.get(), 0, preloadLength + 4, 0, true, true);
+
+        // If the whole sample fits in the preloaded part, there's nothing left to stream
+        if (preloadLength < length)
+            streamSource = std::move (source);
+
+        params.attack  = static_cast<float> (attackTimeSecs);
+        params.release = static_cast<float> (releaseTimeSecs);
+    }
+}
+
 SamplerSound::~SamplerSound()
 {
 }
 
+void SamplerSound::readStreamedAudio (AudioBuffer<float>& buffer, int64 startSample, int numSamples)
+{
+    const ScopedLock sl (streamSourceLock);
+    streamSource->read (&buffer, 0, numSamples, startSample, true, true);
+}
+
 bool SamplerSound::appliesToNote (int midiNoteNumber)
 {
     return midiNotes[midiNoteNumber];
@@ -66,10 +105,160 @@ bool SamplerSound::appliesToChannel (int /*midiChannel*/)
     return true;
 }
 
+//==============================================================================
+/*  Reads the streamed part of a SamplerSound into a ring buffer on a background thread.
+
+    The ring buffer holds the samples up to validEnd, and the background thread only ever
+    overwrites samples that are before the voice's play position, so the audio thread can
+    read from it without locking. validEnd is packed into one atomic along with a note
+    generation count, so when the background thread finishes copying a block into the ring
+    buffer, it can publish it with a compare-and-swap which fails if the voice has started
+    another note in the meantime. The lock only guards the sound pointer, and is never held
+    while audio is being read or copied.
+*/
+class SamplerVoice::Streamer  : private TimeSliceClient
+{
+public:
+    Streamer (TimeSliceThread& threadToUse, int bufferSize)
+        : thread (threadToUse),
+          ringBuffer (2, jmax (1024, bufferSize)),
+          readBuffer (2, jmin (8192, ringBuffer.getNumSamples() / 4))
+    {
+        thread.addTimeSliceClient (this);
+    }
+
+    ~Streamer() override
+    {
+        thread.removeTimeSliceClient (this);
+    }
+
+    void start (SamplerSound* soundToStream) noexcept
+    {
+        // The ring buffer overlaps the last preloaded sample, so that it can be interpolated with the next one
+        const auto firstSample = (int64) soundToStream->preloadLength - 1;
+        playPosition.store (firstSample, std::memory_order_release);
+
+        const SpinLock::ScopedLockType sl (lock);
+        sound = soundToStream;
+        state.store (pack (++generation, firstSample), std::memory_order_release);
+    }
+
+    void stop() noexcept
+    {
+        const SpinLock::ScopedLockType sl (lock);
+        sound = nullptr;
+        state.store (pack (++generation, 0), std::memory_order_release);
+    }
+
+    int64 getValidEnd() const noexcept                  { return (int64) (state.load (std::memory_order_acquire) & positionMask); }
+    void setPlayPosition (int64 position) noexcept      { playPosition.store (position, std::memory_order_release); }
+
+    float getSample (int channel, int64 position) const noexcept
+    {
+        return ringBuffer.getSample (channel, (int) (position % ringBuffer.getNumSamples()));
+    }
+
+private:
+    int useTimeSlice() override
+    {
+        ReferenceCountedObjectPtr<SamplerSound> soundToRead;
+        uint64 currentState = 0;
+
+        {
+            const SpinLock::ScopedLockType sl (lock);
+            soundToRead = sound;
+            currentState = state.load (std::memory_order_acquire);
+        }
+
+        if (soundToRead == nullptr)
+            return 5;
+
+        const auto start = (int64) (currentState & positionMask);
+        const auto end = jmin (playPosition.load (std::memory_order_acquire) + ringBuffer.getNumSamples(),
+                               (int64) soundToRead->length + 4);
+
+        if (start >= end)
+            return 5;
+
+        const auto numToRead = (int) jmin ((int64) readBuffer.getNumSamples(), end - start);
+        soundToRead->readStreamedAudio (readBuffer, start, numToRead);
+
+        // If the voice has started another note since we looked, these samples may land in the
+        // ring buffer, but they're never published, so the audio thread won't read them
+        const auto ringSize = ringBuffer.getNumSamples();
+        const auto startIndex = (int) (start % ringSize);
+        const auto numBeforeWrap = jmin (numToRead, ringSize - startIndex);
+
+        for (int ch = 0; ch < ringBuffer.getNumChannels(); ++ch)
+        {
+            ringBuffer.copyFrom (ch, startIndex, readBuffer, ch, 0, numBeforeWrap);
+
+            if (numBeforeWrap < numToRead)
+                ringBuffer.copyFrom (ch, 0, readBuffer, ch, numBeforeWrap, numToRead - numBeforeWrap);
+        }
+
+        const auto newState = (currentState & ~positionMask) | (uint64) (start + numToRead);
+
+        if (! state.compare_exchange_strong (currentState, newState, std::memory_order_acq_rel))
+            return 0; // the voice has moved on to another note
+
+        return start + numToRead < end ? 0 : 5;
+    }
+
+    // The top 16 bits hold the note generation, and the rest hold validEnd
+    static constexpr uint64 positionMask = (((uint64) 1) << 48) - 1;
+
+    static uint64 pack (uint64 noteGeneration, int64 position) noexcept
+    {
+        return (noteGeneration << 48) | ((uint64) position & positionMask);
+    }
+
+    TimeSliceThread& thread;
+    AudioBuffer<float> ringBuffer, readBuffer;
+
+    SpinLock lock;
+    ReferenceCountedObjectPtr<SamplerSound> sound;
+    uint64 generation = 0;
+    std::atomic<uint64> state { 0 };
+    std::atomic<int64> playPosition { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Streamer)
+};
+
 //==============================================================================
 SamplerVoice::SamplerVoice() {}
+
+SamplerVoice::SamplerVoice (TimeSliceThread& readAheadThread, int streamingBufferSizeSamples)
+    : streamer (new Streamer (readAheadThread, streamingBufferSizeSamples))
+{
+}
+
 SamplerVoice::~SamplerVoice() {}
 
+int SamplerVoice::getNumUnderruns() const noexcept
+{
+    return numUnderruns.load();
+}
+
+void SamplerVoice::setUsingSincResampling (bool shouldUseSincResampling, SincResampler::Quality quality)
+{
+    sincResamplers.clear();
+
+    if (shouldUseSincResampling)
+    {
+        for (int i = 0; i < 2; ++i)
+            sincResamplers.emplace_back (quality, 8.0);
+
+        sincInput.setSize (2, 4096);
+        sincOutput.setSize (2, 512);
+    }
+    else
+    {
+        sincInput.setSize (0, 0);
+        sincOutput.setSize (0, 0);
+    }
+}
+
 bool SamplerVoice::canPlaySound (SynthesiserSound* sound)
 {
     return dynamic_cast<const SamplerSound*> (sound) != nullptr;
@@ -77,7 +266,7 @@ bool SamplerVoice::canPlaySound (SynthesiserSound* sound)
 
 void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSound* s, int /*currentPitchWheelPosition*/)
 {
-    if (auto* sound = dynamic_cast<const SamplerSound*> (s))
+    if (auto* sound = dynamic_cast<SamplerSound*> (s))
     {
         pitchRatio = std::pow (2.0, (midiNoteNumber - sound->midiRootNote) / 12.0)
                         * sound->sourceSampleRate / getSampleRate();
@@ -86,10 +275,29 @@ void SamplerVoice::startNote (int midiNoteNumber, float velocity, SynthesiserSou
         lgain = velocity;
         rgain = velocity;
 
+        // The resamplers are primed with their latency's worth of samples the first time
+        // the note is rendered, so that their output lines up with sourceSamplePosition
+        for (auto& r : sincResamplers)
+            r.reset();
+
+        nextSincInputSample = -1;
+
         adsr.setSampleRate (sound->sourceSampleRate);
         adsr.setParameters (sound->params);
 
         adsr.noteOn();
+
+        if (streamer != nullptr)
+        {
+            if (sound->isStreaming())
+                streamer->start (sound);
+            else
+                streamer->stop();
+        }
+
+        // A streaming sound needs a voice that was created with a TimeSliceThread to read it on,
+        // otherwise only the preloaded part of the sample will be played
+        jassert (streamer != nullptr || ! sound->isStreaming());
     }
     else
     {
@@ -107,6 +315,9 @@ void SamplerVoice::stopNote (float /*velocity*/, bool allowTailOff)
     {
         clearCurrentNote();
         adsr.reset();
+
+        if (streamer != nullptr)
+            streamer->stop();
     }
 }
 
@@ -118,6 +329,12 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
 {
     if (auto* playingSound = static_cast<SamplerSound*> (getCurrentlyPlayingSound().get()))
     {
+        if (! sincResamplers.empty())
+        {
+            renderSincResampled (*playingSound, outputBuffer, startSample, numSamples);
+            return;
+        }
+
         auto& data = *playingSound->data;
         const float* const inL = data.getReadPointer (0);
         const float* const inR = data.getNumChannels() > 1 ? data.getReadPointer (1) : nullptr;
@@ -125,16 +342,37 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
         float* outL = outputBuffer.getWritePointer (0, startSample);
         float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
 
+        // Samples from the end of the preloaded data onwards have to come from the streamer
+        const auto preloadEnd = playingSound->isStreaming() ? playingSound->preloadLength
+                                                             : std::numeric_limits<int>::max();
+        const auto streamedEnd = streamer != nullptr ? streamer->getValidEnd() : (int64) 0;
+        bool hasUnderrun = false;
+
         while (--numSamples >= 0)
         {
             auto pos = (int) sourceSamplePosition;
             auto alpha = (float) (sourceSamplePosition - pos);
             auto invAlpha = 1.0f - alpha;
 
+            float l = 0.0f, r = 0.0f;
+
             // just using a very simple linear interpolation here..
-            float l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
-            float r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
-                                       : l;
+            if (pos + 1 < preloadEnd)
+            {
+                l = (inL[pos] * invAlpha + inL[pos + 1] * alpha);
+                r = (inR != nullptr) ? (inR[pos] * invAlpha + inR[pos + 1] * alpha)
+                                     : l;
+            }
+            else if (pos + 1 < streamedEnd)
+            {
+                l = (streamer->getSample (0, pos) * invAlpha + streamer->getSample (0, pos + 1) * alpha);
+                r = (inR != nullptr) ? (streamer->getSample (1, pos) * invAlpha + streamer->getSample (1, pos + 1) * alpha)
+                                     : l;
+            }
+            else
+            {
+                hasUnderrun = true;
+            }
 
             auto envelopeValue = adsr.getNextSample();
 
@@ -159,7 +397,321 @@ void SamplerVoice::renderNextBlock (AudioBuffer<float>& outputBuffer, int startS
                 break;
             }
         }
+
+        if (hasUnderrun)
+            ++numUnderruns;
+
+        if (streamer != nullptr)
+            streamer->setPlayPosition ((int64) sourceSamplePosition);
+    }
+}
+
+void SamplerVoice::renderSincResampled (SamplerSound& sound, AudioBuffer<float>& outputBuffer, int startSample, int numSamples)
+{
+    const auto numSourceChannels = sound.data->getNumChannels();
+    bool hasUnderrun = false;
+
+    if (nextSincInputSample < 0)
+    {
+        auto latency = sincResamplers.front().getLatencyInSamples();
+        nextSincInputSample = 0;
+        hasUnderrun = ! readSourceSamples (sound, latency);
+
+        for (int ch = 0; ch < numSourceChannels; ++ch)
+            sincResamplers[(size_t) ch].pushSamples (sincInput.getReadPointer (ch), latency);
+
+        nextSincInputSample = latency;
+    }
+
+    float* outL = outputBuffer.getWritePointer (0, startSample);
+    float* outR = outputBuffer.getNumChannels() > 1 ? outputBuffer.getWritePointer (1, startSample) : nullptr;
+
+    // Each chunk is limited so that the input it needs will fit in sincInput
+    const auto maxChunkSize = jmin (sincOutput.getNumSamples(),
+                                    jmax (1, (int) ((sincInput.getNumSamples() - 1) / pitchRatio)));
+    bool isFinished = false;
+
+    while (numSamples > 0 && ! isFinished)
+    {
+        auto numThisTime = jmin (numSamples, maxChunkSize);
+        auto numNeeded = sincResamplers.front().getNumInputSamplesNeeded (pitchRatio, numThisTime);
+
+        if (! readSourceSamples (sound, numNeeded))
+            hasUnderrun = true;
+
+        for (int ch = 0; ch < numSourceChannels; ++ch)
+            sincResamplers[(size_t) ch].process (pitchRatio, sincInput.getReadPointer (ch),
+                                                 sincOutput.getWritePointer (ch), numThisTime);
+
+        nextSincInputSample += numNeeded;
+
+        const float* const resampledL = sincOutput.getReadPointer (0);
+        const float* const resampledR = numSourceChannels > 1 ? sincOutput.getReadPointer (1) : resampledL;
+
+        for (int i = 0; i < numThisTime; ++i)
+        {
+            auto envelopeValue = adsr.getNextSample();
+
+            auto l = resampledL[i] * lgain * envelopeValue;
+            auto r = resampledR[i] * rgain * envelopeValue;
+
+            if (outR != nullptr)
+            {
+                *outL++ += l;
+                *outR++ += r;
+            }
+            else
+            {
+                *outL++ += (l + r) * 0.5f;
+            }
+
+            sourceSamplePosition += pitchRatio;
+
+            if (sourceSamplePosition > sound.length)
+            {
+                stopNote (0.0f, false);
+                isFinished = true;
+                break;
+            }
+        }
+
+        numSamples -= numThisTime;
     }
+
+    if (hasUnderrun)
+        ++numUnderruns;
+
+    if (streamer != nullptr)
+        streamer->setPlayPosition ((int64) sourceSamplePosition);
 }
 
+// Copies the source audio from nextSincInputSample onwards into sincInput, taking it from
+// the preloaded data or the streamer as needed. Returns false if some of it hadn't been
+// streamed yet, in which case that part is silent.
+bool SamplerVoice::readSourceSamples (SamplerSound& sound, int numSamples)
+{
+    jassert (numSamples <= sincInput.getNumSamples());
+
+    auto& data = *sound.data;
+    const auto start = nextSincInputSample;
+    const auto end = start + numSamples;
+
+    const auto preloadEnd = jmin ((int64) sound.length, sound.isStreaming() ? (int64) sound.preloadLength
+                                                                             : (int64) sound.length);
+    const auto streamedEnd = jmin ((int64) sound.length, sound.isStreaming() && streamer != nullptr ? streamer->getValidEnd()
+                                                                                                    : (int64) 0);
+
+    const auto numPreloaded = (int) jlimit ((int64) 0, (int64) numSamples, preloadEnd - start);
+    const auto numStreamed  = (int) jlimit ((int64) 0, (int64) (numSamples - numPreloaded), streamedEnd - (start + numPreloaded));
+    const auto numSilent    = numSamples - numPreloaded - numStreamed;
+
+    for (int ch = 0; ch < data.getNumChannels(); ++ch)
+    {
+        if (numPreloaded > 0)
+            sincInput.copyFrom (ch, 0, data, ch, (int) start, numPreloaded);
+
+        for (int i = numPreloaded; i < numPreloaded + numStreamed; ++i)
+            sincInput.setSample (ch, i, streamer->getSample (ch, start + i));
+
+        if (numSilent > 0)
+            sincInput.clear (ch, numPreloaded + numStreamed, numSilent);
+    }
+
+    // Running off the end of the sample is fine, but missing streamed audio isn't
+    return start + numPreloaded + numStreamed >= jmin (end, (int64) sound.length);
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class SamplerStreamingTests  : public UnitTest
+{
+public:
+    SamplerStreamingTests()
+        : UnitTest ("Sampler streaming", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        // The read-ahead threads in these tests are never started. Instead, the voices' streamers
+        // are run by hand between blocks, so the results don't depend on the thread's timing.
+        beginTest ("Streaming voices play the same audio as voices that load the whole sample");
+        {
+            TimeSliceThread thread ("Sampler streaming test");
+            auto* streamingVoice = new SamplerVoice (thread, 8192);
+
+            auto preloaded = render (new SamplerSound ("preloaded", *std::make_unique<TestReader>(), getAllNotes(),
+                                                       60, 0.0, 0.0, 10.0),
+                                     new SamplerVoice());
+
+            auto streamed = render (new SamplerSound ("streamed", std::make_unique<TestReader>(), getAllNotes(),
+                                                      60, 0.0, 0.0, 10.0, 16384),
+                                    streamingVoice, 60, &thread);
+
+            expectEquals (streamingVoice->getNumUnderruns(), 0);
+
+            for (int ch = 0; ch < 2; ++ch)
+                expect (FloatVectorOperations::findMaximum (preloaded.getReadPointer (ch), preloaded.getNumSamples()) > 0.5f
+                         && std::equal (preloaded.getReadPointer (ch), preloaded.getReadPointer (ch) + preloaded.getNumSamples(),
+                                        streamed.getReadPointer (ch)));
+        }
+
+        beginTest ("Voices whose streamer falls behind only play the preloaded audio");
+        {
+            auto sound = new SamplerSound ("streamed", std::make_unique<TestReader>(), getAllNotes(),
+                                           60, 0.0, 0.0, 10.0, 1024);
+            expect (sound->isStreaming());
+
+            TimeSliceThread thread ("Sampler streaming test");
+            auto* voice = new SamplerVoice (thread, 8192);
+            auto output = render (sound, voice);
+
+            expect (voice->getNumUnderruns() > 0);
+            expect (output.getMagnitude (0, 0, 1000) > 0.5f);
+            expect (output.getMagnitude (0, 1024, output.getNumSamples() - 1024) == 0.0f);
+        }
+
+        beginTest ("Retriggered streaming voices play the new note from the start");
+        {
+            TimeSliceThread thread ("Sampler streaming test");
+            auto* voice = new SamplerVoice (thread, 8192);
+
+            Synthesiser synth;
+            synth.addVoice (voice);
+            synth.addSound (new SamplerSound ("streamed", std::make_unique<TestReader>(), getAllNotes(),
+                                              60, 0.0, 0.0, 10.0, 1024));
+            synth.setCurrentPlaybackSampleRate (44100.0);
+
+            AudioBuffer<float> output (2, blockSize);
+            synth.noteOn (1, 60, 1.0f);
+            synth.renderNextBlock (output, {}, 0, blockSize);
+
+            // The streamer never caught up with the first note before the voice was retriggered
+            synth.noteOn (1, 72, 1.0f);
+            auto streamed = render (nullptr, nullptr, 72, &thread, &synth);
+
+            auto expected = render (new SamplerSound ("preloaded", *std::make_unique<TestReader>(), getAllNotes(),
+                                                      60, 0.0, 0.0, 10.0),
+                                    new SamplerVoice(), 72);
+
+            expectEquals (voice->getNumUnderruns(), 0);
+
+            for (int ch = 0; ch < 2; ++ch)
+                expect (std::equal (expected.getReadPointer (ch), expected.getReadPointer (ch) + 20000,
+                                    streamed.getReadPointer (ch)));
+        }
+
+        beginTest ("Sinc resampled voices play smooth audio like linearly interpolated ones");
+        {
+            TimeSliceThread thread ("Sampler streaming test");
+
+            for (auto note : { 60, 67, 48 })
+            {
+                auto* sincVoice = new SamplerVoice();
+                sincVoice->setUsingSincResampling (true);
+
+                auto* streamingSincVoice = new SamplerVoice (thread, 8192);
+                streamingSincVoice->setUsingSincResampling (true);
+
+                auto linear = render (new SamplerSound ("linear", *std::make_unique<TestReader>(), getAllNotes(),
+                                                        60, 0.0, 0.0, 10.0),
+                                      new SamplerVoice(), note);
+
+                auto sinc = render (new SamplerSound ("sinc", *std::make_unique<TestReader>(), getAllNotes(),
+                                                      60, 0.0, 0.0, 10.0),
+                                    sincVoice, note);
+
+                auto streamedSinc = render (new SamplerSound ("streamed", std::make_unique<TestReader>(), getAllNotes(),
+                                                              60, 0.0, 0.0, 10.0, 16384),
+                                            streamingSincVoice, note, &thread);
+
+                expectEquals (streamingSincVoice->getNumUnderruns(), 0);
+
+                for (int ch = 0; ch < 2; ++ch)
+                {
+                    expect (sinc.getMagnitude (ch, 0, sinc.getNumSamples()) > 0.5f);
+
+                    // The filter rings a little at the start and end of the sample, where it's cut off
+                    for (int i = 1000; i < 60000; ++i)
+                        expectWithinAbsoluteError (sinc.getSample (ch, i), linear.getSample (ch, i), 1.0e-3f);
+
+                    expect (std::equal (sinc.getReadPointer (ch), sinc.getReadPointer (ch) + sinc.getNumSamples(),
+                                        streamedSinc.getReadPointer (ch)));
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr int sampleLength = 100000;
+    static constexpr int blockSize = 256;
+
+    struct TestReader  : public AudioFormatReader
+    {
+        TestReader()  : AudioFormatReader (nullptr, "Test")
+        {
+            sampleRate = 44100.0;
+            bitsPerSample = 32;
+            lengthInSamples = sampleLength;
+            numChannels = 2;
+            usesFloatingPointData = true;
+        }
+
+        bool readSamples (int** destChannels, int numDestChannels, int startOffsetInDestBuffer,
+                          int64 startSampleInFile, int numSamples) override
+        {
+            for (int ch = 0; ch < numDestChannels; ++ch)
+                if (auto* dest = reinterpret_cast<float*> (destChannels[ch]))
+                    for (int i = 0; i < numSamples; ++i)
+                        dest[startOffsetInDestBuffer + i] = std::sin ((float) (startSampleInFile + i) * 0.01f * (float) (ch + 1));
+
+            return true;
+        }
+    };
+
+    static BigInteger getAllNotes()
+    {
+        BigInteger notes;
+        notes.setRange (0, 128, true);
+        return notes;
+    }
+
+    // Renders a note, running the read-ahead thread's clients until they've caught up before
+    // each block. If a synth is given, it's used as it is, with the note already playing.
+    static AudioBuffer<float> render (SamplerSound* sound, SamplerVoice* voice, int note = 60,
+                                      TimeSliceThread* readAheadThread = nullptr, Synthesiser* existingSynth = nullptr)
+    {
+        Synthesiser newSynth;
+        auto& synth = existingSynth != nullptr ? *existingSynth : newSynth;
+
+        if (existingSynth == nullptr)
+        {
+            synth.addVoice (voice);
+            synth.addSound (sound);
+            synth.setCurrentPlaybackSampleRate (44100.0);
+            synth.noteOn (1, note, 1.0f);
+        }
+
+        AudioBuffer<float> output (2, sampleLength - blockSize);
+        output.clear();
+
+        for (int pos = 0; pos < output.getNumSamples(); pos += blockSize)
+        {
+            if (readAheadThread != nullptr)
+                for (int i = 0; i < readAheadThread->getNumClients(); ++i)
+                    while (readAheadThread->getClient (i)->useTimeSlice() == 0)
+                    {}
+
+            synth.renderNextBlock (output, {}, pos, jmin (blockSize, output.getNumSamples() - pos));
+        }
+
+        return output;
+    }
+};
+
+static SamplerStreamingTests samplerStreamingTests;
+
+#endif
+
 } // namespace juce
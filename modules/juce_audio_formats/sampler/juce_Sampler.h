@@ -30,9 +30,14 @@ namespace juce
 /**
     A subclass of SynthesiserSound that represents a sampled audio clip.
 
-    This is a pretty basic sampler, and just attempts to load the whole audio stream
+    This is a pretty basic sampler, which normally loads the whole audio stream
     into memory.
 
+    For large sample libraries, a sound can instead be created in streaming mode,
+    which only loads the start of the sample into memory. The rest is read from
+    disk while the sound plays, by SamplerVoice objects that have been given a
+    TimeSliceThread to do their reading on.
+
     To use it, create a Synthesiser, add some SamplerVoice objects to it, then
     give it some SampledSound objects to play.
 
@@ -70,6 +75,40 @@ public:
                   double releaseTimeSecs,
                   double maxSampleLengthSeconds);
 
+    /** Creates a sampled sound which streams its audio from a reader.
+
+        Only the first numSamplesToPreload samples are loaded into memory. The rest of
+        the audio is read from the source while the sound is playing, so the source
+        will be kept by this object and read from a background thread. A voice can only
+        stream the sound if it was created with a TimeSliceThread.
+
+        The preloaded part needs to be long enough to cover the time it takes for the
+        background thread to start reading, so it should be at least a few thousand
+        samples, or more if the audio is being read from a slow disk.
+
+        @param name         a name for the sample
+        @param source       the audio to stream. This object will take ownership of it
+        @param midiNotes    the set of midi keys that this sound should be played on
+        @param midiNoteForNormalPitch   the midi note at which the sample should be played
+                                        with its natural rate
+        @param attackTimeSecs   the attack (fade-in) time, in seconds
+        @param releaseTimeSecs  the decay (fade-out) time, in seconds
+        @param maxSampleLengthSeconds   a maximum length of audio to play from the audio
+                                        source, in seconds
+        @param numSamplesToPreload      the number of samples at the start of the audio
+                                        which should be kept in memory
+
+        @see SamplerVoice
+    */
+    SamplerSound (const String& name,
+                  std::unique_ptr<AudioFormatReader> source,
+                  const BigInteger& midiNotes,
+                  int midiNoteForNormalPitch,
+                  double attackTimeSecs,
+                  double releaseTimeSecs,
+                  double maxSampleLengthSeconds,
+                  int numSamplesToPreload);
+
     /** Destructor. */
     ~SamplerSound() override;
 
@@ -79,9 +118,14 @@ public:
 
     /** Returns the audio sample data.
         This could return nullptr if there was a problem loading the data.
+
+        If the sound is streaming, this will only contain the preloaded part of the sample.
     */
     AudioBuffer<float>* getAudioData() const noexcept       { return data.get(); }
 
+    /** Returns true if the part of the sample after the preloaded data is read from disk. */
+    bool isStreaming() const noexcept                       { return streamSource != nullptr; }
+
     //==============================================================================
     /** Changes the parameters of the ADSR envelope which will be applied to the sample. */
     void setEnvelopeParameters (ADSR::Parameters parametersToUse)    { params = parametersToUse; }
@@ -100,6 +144,12 @@ private:
     BigInteger midiNotes;
     int length = 0, midiRootNote = 0;
 
+    std::unique_ptr<AudioFormatReader> streamSource;
+    CriticalSection streamSourceLock;
+    int preloadLength = 0;
+
+    void readStreamedAudio (AudioBuffer<float>&, int64 startSample, int numSamples);
+
     ADSR::Parameters params;
 
     JUCE_LEAK_DETECTOR (SamplerSound)
@@ -113,7 +163,14 @@ private:
     To use it, create a Synthesiser, add some SamplerVoice objects to it, then
     give it some SampledSound objects to play.
 
-    @see SamplerSound, Synthesiser, SynthesiserVoice
+    To play streaming sounds, create the voices with a TimeSliceThread. Each voice
+    then has a ring buffer that the thread keeps filled with the audio that's about
+    to be played.
+
+    By default the sample is pitched with linear interpolation, which is cheap but
+    can sound dull and aliased. Call setUsingSincResampling() for better quality.
+
+    @see SamplerSound, Synthesiser, SynthesiserVoice, SincResampler
 
     @tags{Audio}
 */
@@ -124,6 +181,14 @@ public:
     /** Creates a SamplerVoice. */
     SamplerVoice();
 
+    /** Creates a SamplerVoice which can play streaming SamplerSounds.
+
+        The thread will be used to read ahead of the playback position into a buffer
+        of the given size, and must be running while the voice is playing. It can be
+        shared with other voices, but must outlive this one.
+    */
+    SamplerVoice (TimeSliceThread& readAheadThread, int streamingBufferSizeSamples = 32768);
+
     /** Destructor. */
     ~SamplerVoice() override;
 
@@ -139,6 +204,29 @@ public:
     void renderNextBlock (AudioBuffer<float>&, int startSample, int numSamples) override;
     using SynthesiserVoice::renderNextBlock;
 
+    //==============================================================================
+    /** Returns the number of blocks in which this voice needed some streamed audio
+        that hadn't been read from disk yet, and so had to output silence instead.
+    */
+    int getNumUnderruns() const noexcept;
+
+    //==============================================================================
+    /** Chooses whether the sample should be pitched with a SincResampler rather than
+        with linear interpolation.
+
+        Notes that are pitched up by more than three octaves relative to the sample's
+        rate won't be fully filtered, so may contain some aliasing.
+
+        This allocates memory, so shouldn't be called while the voice is playing.
+    */
+    void setUsingSincResampling (bool shouldUseSincResampling,
+                                 SincResampler::Quality quality = SincResampler::Quality::high);
+
+    /** Returns true if the voice is using a SincResampler.
+        @see setUsingSincResampling
+    */
+    bool isUsingSincResampling() const noexcept             { return ! sincResamplers.empty(); }
+
 private:
     //==============================================================================
     double pitchRatio = 0;
@@ -147,6 +235,17 @@ private:
 
     ADSR adsr;
 
+    class Streamer;
+    std::unique_ptr<Streamer> streamer;
+    std::atomic<int> numUnderruns { 0 };
+
+    std::vector<SincResampler> sincResamplers;
+    AudioBuffer<float> sincInput, sincOutput;
+    int64 nextSincInputSample = 0;
+
+    void renderSincResampled (SamplerSound&, AudioBuffer<float>&, int startSample, int numSamples);
+    bool readSourceSamples (SamplerSound&, int numSamples);
+
     JUCE_LEAK_DETECTOR (SamplerVoice)
 };
 
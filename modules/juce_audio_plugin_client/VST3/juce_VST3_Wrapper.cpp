@@ -2651,6 +2651,7 @@ public:
 
                         if (auto* param = comPluginInstance->getParamForVSTParamID (vstParamID))
                         {
+                            addParameterEvents (*paramQueue, param->getParameterIndex());
                             param->setValue (floatValue);
 
                             inParameterChangedCallback = true;
@@ -2662,6 +2663,24 @@ public:
         }
     }
 
+    void addParameterEvents (Vst::IParamValueQueue& paramQueue, int parameterIndex)
+    {
+        // Parameters that the wrapper owns, like the bypass parameter, don't have an index
+        if (parameterIndex < 0)
+            return;
+
+        auto& events = pluginInstance->getParameterEvents();
+
+        for (Steinberg::int32 i = 0; i < paramQueue.getPointCount(); ++i)
+        {
+            Steinberg::int32 offsetSamples = 0;
+            double value = 0.0;
+
+            if (paramQueue.getPoint (i, offsetSamples, value) == kResultTrue)
+                events.addEvent (parameterIndex, (int) offsetSamples, (float) value);
+        }
+    }
+
     void addParameterChangeToMidiBuffer (const Steinberg::int32 offsetSamples, const Vst::ParamID id, const double value)
     {
         // If the parameter is mapped to a MIDI CC message then insert it into the midiBuffer.
@@ -2706,10 +2725,16 @@ public:
         }
 
         midiBuffer.clear();
+        pluginInstance->getParameterEvents().clear();
 
         if (data.inputParameterChanges != nullptr)
+        {
             processParameterChanges (*data.inputParameterChanges);
 
+            // Each parameter's queue starts again at the start of the block
+            pluginInstance->getParameterEvents().sort();
+        }
+
        #if JucePlugin_WantsMidiInput
         if (isMidiInputBusEnabled && data.inputEvents != nullptr)
             MidiEventList::toMidiBuffer (midiBuffer, *data.inputEvents);
@@ -2979,6 +3004,9 @@ private:
 
         midiBuffer.ensureSize (2048);
         midiBuffer.clear();
+
+        p.getParameterEvents().ensureSize (2048);
+        p.getParameterEvents().clear();
     }
 
     //==============================================================================
@@ -2172,6 +2172,7 @@ public:
 
         associateWith (data, buffer);
         associateWith (data, midiMessages);
+        addParameterEventsToQueues();
 
         processor->process (data);
 
@@ -2199,6 +2200,34 @@ public:
         inputParameterChanges->clearAllQueues();
     }
 
+    void addParameterEventsToQueues()
+    {
+        auto& events = getParameterEvents();
+
+        if (events.isEmpty())
+            return;
+
+        auto& params = getParameters();
+        Steinberg::int32 index;
+
+        // The events replace any changes that were made with setValue() since the last block,
+        // which would otherwise make the parameter jump to its final value at the start
+        for (auto& e : events)
+            if (auto* param = static_cast<VST3Parameter*> (params[e.parameterIndex]))
+                static_cast<ParamValueQueueList::ParamValueQueue*> (inputParameterChanges->addParameterData (param->paramID, index))->clear();
+
+        for (auto& e : events)
+        {
+            if (auto* param = static_cast<VST3Parameter*> (params[e.parameterIndex]))
+            {
+                inputParameterChanges->addParameterData (param->paramID, index)->addPoint (e.samplePosition, e.value, index);
+
+                if (editController != nullptr)
+                    editController->setParamNormalized (param->paramID, e.value);
+            }
+        }
+    }
+
     //==============================================================================
     bool canAddBus (bool) const override                                       { return false; }
     bool canRemoveBus (bool) const override                                    { return false; }
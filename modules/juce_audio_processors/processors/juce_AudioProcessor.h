@@ -709,6 +709,31 @@ public:
     */
     AudioPlayHead* getPlayHead() const noexcept                 { return playHead; }
 
+    /** Returns the timestamped parameter changes for the block that's being processed.
+
+        If the host or plugin wrapper supports sample-accurate automation, then before each
+        call to processBlock() it'll fill this with the changes that happen during the block.
+        The parameters will already have been set to their values at the end of the block,
+        so processors that don't look at these events will behave as they always have.
+
+        You can ONLY use this from your processBlock() method, as the contents are only
+        valid during the callback.
+
+        If you're hosting a processor, you can add events to this before calling its
+        processBlock(), and plugin formats that support it will pass them on to the plugin.
+        Call ParameterEventBuffer::ensureSize() before processing starts, clear the
+        buffer before each block, and call ParameterEventBuffer::sort() once you've added
+        the block's events.
+
+        @see ParameterEventBuffer
+    */
+    ParameterEventBuffer& getParameterEvents() noexcept                 { return parameterEvents; }
+
+    /** Returns the timestamped parameter changes for the block that's being processed.
+        @see ParameterEventBuffer
+    */
+    const ParameterEventBuffer& getParameterEvents() const noexcept     { return parameterEvents; }
+
     //==============================================================================
     /** Returns the total number of input channels.
 
@@ -1478,6 +1503,7 @@ private:
 
     AudioProcessorParameterGroup parameterTree;
     Array<AudioProcessorParameter*> flatParameterList;
+    ParameterEventBuffer parameterEvents;
 
     AudioProcessorParameter* getParamChecked (int) const;
 
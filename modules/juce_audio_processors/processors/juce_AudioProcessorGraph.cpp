@@ -34,8 +34,86 @@ static void updateOnMessageThread (AsyncUpdater& updater)
         updater.triggerAsyncUpdate();
 }
 
+//==============================================================================
+/*  A ring buffer of the times at which a node processed its most recent blocks.
+
+    Only one thread at a time processes a node, so there's a single writer, and the
+    message thread can read it while the audio is running. A reader ignores any entries
+    that could have been overwritten while it was copying them.
+*/
+struct AudioProcessorGraph::Node::ProcessTimings
+{
+    struct Block
+    {
+        int64 startTicks, endTicks;
+        pointer_sized_int threadID;
+        int numSamples;
+    };
+
+    static constexpr int64 capacity = 1024;
+
+    void add (const Block& block) noexcept
+    {
+        auto index = numWritten.load (std::memory_order_relaxed);
+        numStarted.store (index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence (std::memory_order_release);
+
+        auto& e = entries[index % capacity];
+        e.startTicks.store (block.startTicks, std::memory_order_relaxed);
+        e.endTicks  .store (block.endTicks,   std::memory_order_relaxed);
+        e.threadID  .store (block.threadID,   std::memory_order_relaxed);
+        e.numSamples.store (block.numSamples, std::memory_order_relaxed);
+
+        numWritten.store (index + 1, std::memory_order_release);
+    }
+
+    std::vector<Block> getBlocks() const
+    {
+        auto end = numWritten.load (std::memory_order_acquire);
+        auto start = jmax (end - capacity, firstIndex.load());
+
+        std::vector<Block> blocks;
+        blocks.reserve ((size_t) jmax ((int64) 0, end - start));
+
+        for (auto i = start; i < end; ++i)
+        {
+            auto& e = entries[i % capacity];
+            blocks.push_back ({ e.startTicks.load (std::memory_order_relaxed),
+                                e.endTicks  .load (std::memory_order_relaxed),
+                                e.threadID  .load (std::memory_order_relaxed),
+                                e.numSamples.load (std::memory_order_relaxed) });
+        }
+
+        std::atomic_thread_fence (std::memory_order_acquire);
+
+        auto numOverwritten = numStarted.load (std::memory_order_relaxed) - capacity - start;
+
+        if (numOverwritten > 0)
+            blocks.erase (blocks.begin(), blocks.begin() + (std::ptrdiff_t) jmin ((int64) blocks.size(), numOverwritten));
+
+        return blocks;
+    }
+
+    void clear() noexcept
+    {
+        firstIndex = numWritten.load();
+    }
+
+private:
+    struct Entry
+    {
+        std::atomic<int64> startTicks { 0 }, endTicks { 0 };
+        std::atomic<pointer_sized_int> threadID { 0 };
+        std::atomic<int> numSamples { 0 };
+    };
+
+    Entry entries[capacity];
+    std::atomic<int64> numStarted { 0 }, numWritten { 0 }, firstIndex { 0 };
+};
+
+//==============================================================================
 template <typename FloatType>
-struct GraphRenderSequence
+struct GraphRenderSequence  : private RealtimeWorkerPool::Task
 {
     GraphRenderSequence() {}
 
@@ -43,11 +121,14 @@ struct GraphRenderSequence
     {
         FloatType** audioBuffers;
         MidiBuffer* midiBuffers;
+        FixedCapacityMidiBuffer* midiMergeBuffers;
         AudioPlayHead* audioPlayHead;
         int numSamples;
+        bool recordTimings;
     };
 
-    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead)
+    void perform (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages, AudioPlayHead* audioPlayHead,
+                  RealtimeWorkerPool* threadPool = nullptr, bool recordTimings = false)
     {
         auto numSamples = buffer.getNumSamples();
         auto maxSamples = renderingBuffer.getNumSamples();
@@ -64,7 +145,7 @@ struct GraphRenderSequence
                 midiChunk.clear();
                 midiChunk.addEvents (midiMessages, chunkStartSample, chunkSize, -chunkStartSample);
 
-                perform (audioChunk, midiChunk, audioPlayHead);
+                perform (audioChunk, midiChunk, audioPlayHead, threadPool, recordTimings);
 
                 chunkStartSample += maxSamples;
             }
@@ -79,10 +160,14 @@ struct GraphRenderSequence
         currentMidiOutputBuffer.clear();
 
         {
-            const Context context { renderingBuffer.getArrayOfWritePointers(), midiBuffers.begin(), audioPlayHead, numSamples };
+            const Context context { renderingBuffer.getArrayOfWritePointers(), midiBuffers.begin(),
+                                    midiMergeBuffers.data(), audioPlayHead, numSamples, recordTimings };
 
-            for (auto* op : renderOps)
-                op->perform (context);
+            if (threadPool != nullptr && threadPool->getNumWorkers() > 0 && renderOps.size() > 1)
+                performInParallel (context, *threadPool);
+            else
+                for (auto* op : renderOps)
+                    op->perform (context);
         }
 
         for (int i = 0; i < buffer.getNumChannels(); ++i)
@@ -96,6 +181,7 @@ struct GraphRenderSequence
     void addClearChannelOp (int index)
     {
         createOp ([=] (const Context& c)    { FloatVectorOperations::clear (c.audioBuffers[index], c.numSamples); });
+        addDependencies ({}, { audioResource (index) });
     }
 
     void addCopyChannelOp (int srcIndex, int dstIndex)
@@ -103,6 +189,7 @@ struct GraphRenderSequence
         createOp ([=] (const Context& c)    { FloatVectorOperations::copy (c.audioBuffers[dstIndex],
                                                                            c.audioBuffers[srcIndex],
                                                                            c.numSamples); });
+        addDependencies ({ audioResource (srcIndex) }, { audioResource (dstIndex) });
     }
 
     void addAddChannelOp (int srcIndex, int dstIndex)
@@ -110,33 +197,65 @@ struct GraphRenderSequence
         createOp ([=] (const Context& c)    { FloatVectorOperations::add (c.audioBuffers[dstIndex],
                                                                           c.audioBuffers[srcIndex],
                                                                           c.numSamples); });
+        addDependencies ({ audioResource (srcIndex) }, { audioResource (dstIndex) });
     }
 
     void addClearMidiBufferOp (int index)
     {
         createOp ([=] (const Context& c)    { c.midiBuffers[index].clear(); });
+        addDependencies ({}, { midiResource (index) });
     }
 
     void addCopyMidiBufferOp (int srcIndex, int dstIndex)
     {
         createOp ([=] (const Context& c)    { c.midiBuffers[dstIndex] = c.midiBuffers[srcIndex]; });
+        addDependencies ({ midiResource (srcIndex) }, { midiResource (dstIndex) });
     }
 
     void addAddMidiBufferOp (int srcIndex, int dstIndex)
     {
-        createOp ([=] (const Context& c)    { c.midiBuffers[dstIndex].addEvents (c.midiBuffers[srcIndex],
-                                                                                 0, c.numSamples, 0); });
+        createOp ([=] (const Context& c)
+        {
+            auto& dst = c.midiBuffers[dstIndex];
+            auto& src = c.midiBuffers[srcIndex];
+
+            // Merging both buffers in one pass avoids shifting the later events in dst along
+            // for every event inserted from src. Only the ops writing to dst can use its merge
+            // buffer, and the dependencies already stop those from running at the same time.
+            auto& merged = c.midiMergeBuffers[dstIndex];
+
+            if (merged.mergeFrom ({ dst, { src.cbegin(), src.findNextSamplePosition (c.numSamples) } }))
+                merged.copyTo (dst);
+            else
+                dst.addEvents (src, 0, c.numSamples, 0);
+        });
+
+        addDependencies ({ midiResource (srcIndex) }, { midiResource (dstIndex) });
     }
 
     void addDelayChannelOp (int chan, int delaySize)
     {
         renderOps.add (new DelayChannelOp (chan, delaySize));
+        addDependencies ({}, { audioResource (chan) });
     }
 
     void addProcessOp (const AudioProcessorGraph::Node::Ptr& node,
                        const Array<int>& audioChannelsUsed, int totalNumChans, int midiBuffer)
     {
         renderOps.add (new ProcessOp (node, audioChannelsUsed, totalNumChans, midiBuffer));
+
+        Array<int> resourcesUsed { midiResource (midiBuffer) };
+
+        // The shared read-only buffer of zeros can be handed to any number of nodes at once
+        for (auto index : audioChannelsUsed)
+            if (index != 0)
+                resourcesUsed.addIfNotAlreadyThere (audioResource (index));
+
+        // The graph's I/O nodes all read or write the sequence's own buffers, so keep them in order
+        if (dynamic_cast<AudioProcessorGraph::AudioGraphIOProcessor*> (node->getProcessor()) != nullptr)
+            resourcesUsed.add (graphIOResource);
+
+        addDependencies ({}, resourcesUsed);
     }
 
     void prepareBuffers (int blockSize)
@@ -159,6 +278,18 @@ struct GraphRenderSequence
 
         for (auto&& m : midiBuffers)
             m.ensureSize (defaultMIDIBufferSize);
+
+        midiMergeBuffers.clear();
+        midiMergeBuffers.resize ((size_t) numMidiBuffersNeeded);
+
+        for (auto& m : midiMergeBuffers)
+            m.ensureSize (2 * defaultMIDIBufferSize);
+
+        lastAccesses.clear();
+
+        const auto numOps = (size_t) renderOps.size();
+        numPendingDependencies.reset (new std::atomic<int>[numOps]);
+        readyOps.reset (new std::atomic<int>[numOps]);
     }
 
     void releaseBuffers()
@@ -169,6 +300,7 @@ struct GraphRenderSequence
         currentMidiInputBuffer = nullptr;
         currentMidiOutputBuffer.clear();
         midiBuffers.clear();
+        midiMergeBuffers.clear();
     }
 
     int numBuffersNeeded = 0, numMidiBuffersNeeded = 0;
@@ -180,6 +312,7 @@ struct GraphRenderSequence
     MidiBuffer currentMidiOutputBuffer;
 
     Array<MidiBuffer> midiBuffers;
+    std::vector<FixedCapacityMidiBuffer> midiMergeBuffers;
     MidiBuffer midiChunk;
 
 private:
@@ -195,6 +328,143 @@ private:
 
     OwnedArray<RenderingOp> renderOps;
 
+    //==============================================================================
+    /*  Each op declares which of the sequence's buffers it touches, and depends on the
+        earlier ops which last accessed those buffers. Ops that don't share any buffers
+        can then be run on different threads.
+    */
+    struct OpDependencies
+    {
+        Array<int> dependents;
+        int numDependencies = 0;
+    };
+
+    struct ResourceAccess
+    {
+        int lastWriter = -1;
+        Array<int> readersSinceLastWrite;
+    };
+
+    enum { graphIOResource = -1 };
+
+    static int audioResource (int bufferIndex) noexcept     { return bufferIndex * 2; }
+    static int midiResource  (int bufferIndex) noexcept     { return bufferIndex * 2 + 1; }
+
+    Array<OpDependencies> opDependencies;
+    std::map<int, ResourceAccess> lastAccesses;
+
+    void addDependencies (const Array<int>& resourcesRead, const Array<int>& resourcesWritten)
+    {
+        const auto opIndex = renderOps.size() - 1;
+        jassert (opIndex == opDependencies.size());
+        opDependencies.add ({});
+
+        auto addDependency = [this, opIndex] (int earlierOp)
+        {
+            if (earlierOp >= 0 && earlierOp != opIndex
+                 && opDependencies.getReference (earlierOp).dependents.addIfNotAlreadyThere (opIndex))
+                ++opDependencies.getReference (opIndex).numDependencies;
+        };
+
+        for (auto resource : resourcesRead)
+        {
+            auto& access = lastAccesses[resource];
+            addDependency (access.lastWriter);
+            access.readersSinceLastWrite.add (opIndex);
+        }
+
+        for (auto resource : resourcesWritten)
+        {
+            auto& access = lastAccesses[resource];
+            addDependency (access.lastWriter);
+
+            for (auto reader : access.readersSinceLastWrite)
+                addDependency (reader);
+
+            access.lastWriter = opIndex;
+            access.readersSinceLastWrite.clearQuick();
+        }
+    }
+
+    //==============================================================================
+    const Context* parallelContext = nullptr;
+    std::unique_ptr<std::atomic<int>[]> numPendingDependencies, readyOps;
+    std::atomic<int> numReadyOps { 0 }, nextReadyOp { 0 }, numOpsCompleted { 0 };
+
+    void performInParallel (const Context& context, RealtimeWorkerPool& threadPool) noexcept
+    {
+        const auto numOps = renderOps.size();
+
+        for (int i = 0; i < numOps; ++i)
+        {
+            numPendingDependencies[(size_t) i] = opDependencies.getReference (i).numDependencies;
+            readyOps[(size_t) i] = -1;
+        }
+
+        numReadyOps = 0;
+        nextReadyOp = 0;
+        numOpsCompleted = 0;
+        parallelContext = &context;
+
+        for (int i = 0; i < numOps; ++i)
+            if (opDependencies.getReference (i).numDependencies == 0)
+                pushReadyOp (i);
+
+        threadPool.perform (*this);
+        parallelContext = nullptr;
+    }
+
+    void runConcurrently() noexcept override
+    {
+        const ScopedNoDenormals noDenormals;
+        const auto numOps = renderOps.size();
+
+        while (numOpsCompleted.load (std::memory_order_acquire) < numOps)
+        {
+            auto opIndex = popReadyOp();
+
+            if (opIndex < 0)
+            {
+                Thread::yield();
+                continue;
+            }
+
+            renderOps.getUnchecked (opIndex)->perform (*parallelContext);
+
+            for (auto dependent : opDependencies.getReference (opIndex).dependents)
+                if (numPendingDependencies[(size_t) dependent].fetch_sub (1, std::memory_order_acq_rel) == 1)
+                    pushReadyOp (dependent);
+
+            numOpsCompleted.fetch_add (1, std::memory_order_acq_rel);
+        }
+    }
+
+    // Every op becomes ready exactly once per block, so the queue never needs more than one slot per op
+    void pushReadyOp (int opIndex) noexcept
+    {
+        auto slot = numReadyOps.fetch_add (1, std::memory_order_relaxed);
+        readyOps[(size_t) slot].store (opIndex, std::memory_order_release);
+    }
+
+    int popReadyOp() noexcept
+    {
+        for (;;)
+        {
+            auto slot = nextReadyOp.load (std::memory_order_relaxed);
+
+            if (slot >= numReadyOps.load (std::memory_order_relaxed))
+                return -1;
+
+            auto opIndex = readyOps[(size_t) slot].load (std::memory_order_acquire);
+
+            if (opIndex < 0)
+                return -1; // the op is still being published
+
+            if (nextReadyOp.compare_exchange_weak (slot, slot + 1, std::memory_order_relaxed))
+                return opIndex;
+        }
+    }
+
     //==============================================================================
     template <typename LambdaType>
     void createOp (LambdaType&& fn)
@@ -261,6 +531,23 @@ private:
         }
 
         void perform (const Context& c) override
+        {
+            auto* timings = node->timings.get();
+
+            if (! c.recordTimings || timings == nullptr)
+            {
+                process (c);
+                return;
+            }
+
+            auto startTicks = Time::getHighResolutionTicks();
+            process (c);
+
+            timings->add ({ startTicks, Time::getHighResolutionTicks(),
+                            (pointer_sized_int) Thread::getCurrentThreadId(), c.numSamples });
+        }
+
+        void process (const Context& c)
         {
             processor.setPlayHead (c.audioPlayHead);
 
@@ -337,7 +624,10 @@ template <typename RenderSequence>
 struct RenderSequenceBuilder
 {
     RenderSequenceBuilder (AudioProcessorGraph& g, RenderSequence& s)
-        : graph (g), sequence (s)
+        : graph (g), sequence (s),
+          // When rendering on several threads, recycling buffers would create false
+          // dependencies between otherwise independent nodes, so each one gets its own
+          canReuseBuffers (g.getNumRenderThreads() <= 1)
     {
         createOrderedNodeList();
 
@@ -347,8 +637,12 @@ struct RenderSequenceBuilder
         for (int i = 0; i < orderedNodes.size(); ++i)
         {
             createRenderingOpsForNode (*orderedNodes.getUnchecked(i), i);
-            markAnyUnusedBuffersAsFree (audioBuffers, i);
-            markAnyUnusedBuffersAsFree (midiBuffers, i);
+
+            if (canReuseBuffers)
+            {
+                markAnyUnusedBuffersAsFree (audioBuffers, i);
+                markAnyUnusedBuffersAsFree (midiBuffers, i);
+            }
         }
 
         graph.setLatencySamples (totalLatency);
@@ -362,6 +656,7 @@ struct RenderSequenceBuilder
 
     AudioProcessorGraph& graph;
     RenderSequence& sequence;
+    const bool canReuseBuffers;
 
     Array<AudioProcessorGraph::Node*> orderedNodes;
 
@@ -376,6 +671,8 @@ struct RenderSequenceBuilder
         bool isFree() const noexcept                            { return channel.nodeID == freeNodeID(); }
         bool isAssigned() const noexcept                        { return ! (isReadOnlyEmpty() || isFree()); }
 
+        static AssignedBuffer createAnonymous() noexcept        { return { { anonNodeID(), 0 } }; }
+
         void setFree() noexcept                                 { channel = { freeNodeID(), 0 }; }
         void setAssignedToNonExistentNode() noexcept            { channel = { anonNodeID(), 0 }; }
 
@@ -709,8 +1006,14 @@ struct RenderSequenceBuilder
         return results;
     }
 
-    static int getFreeBuffer (Array<AssignedBuffer>& buffers)
+    int getFreeBuffer (Array<AssignedBuffer>& buffers) const
     {
+        if (! canReuseBuffers)
+        {
+            buffers.add (AssignedBuffer::createAnonymous());
+            return buffers.size() - 1;
+        }
+
         for (int i = 1; i < buffers.size(); ++i)
             if (buffers.getReference (i).isFree())
                 return i;
@@ -810,6 +1113,8 @@ AudioProcessorGraph::Node::Node (NodeID n, std::unique_ptr<AudioProcessor> p) no
     jassert (processor != nullptr);
 }
 
+AudioProcessorGraph::Node::~Node() = default;
+
 void AudioProcessorGraph::Node::prepare (double newSampleRate, int newBlockSize,
                                          AudioProcessorGraph* graph, ProcessingPrecision precision)
 {
@@ -885,6 +1190,14 @@ void AudioProcessorGraph::Node::setBypassed (bool shouldBeBypassed) noexcept
 struct AudioProcessorGraph::RenderSequenceFloat   : public GraphRenderSequence<float> {};
 struct AudioProcessorGraph::RenderSequenceDouble  : public GraphRenderSequence<double> {};
 
+struct AudioProcessorGraph::RenderThreadPool  : public RealtimeWorkerPool
+{
+    explicit RenderThreadPool (int numWorkers)
+        : RealtimeWorkerPool ("Graph render thread", numWorkers, true)
+    {
+    }
+};
+
 //==============================================================================
 AudioProcessorGraph::AudioProcessorGraph()
 {
@@ -958,6 +1271,9 @@ AudioProcessorGraph::Node::Ptr AudioProcessorGraph::addNode (std::unique_ptr<Aud
 
     Node::Ptr n (new Node (nodeID, std::move (newProcessor)));
 
+    if (isProfilingEnabled())
+        n->timings = std::make_unique<Node::ProcessTimings>();
+
     {
         const ScopedLock sl (getCallbackLock());
         nodes.add (n.get());
@@ -1203,6 +1519,178 @@ bool AudioProcessorGraph::removeIllegalConnections()
     return anyRemoved;
 }
 
+//==============================================================================
+void AudioProcessorGraph::setNumRenderThreads (int newNumThreads)
+{
+    newNumThreads = jmax (1, newNumThreads);
+
+    if (newNumThreads == numRenderThreads)
+        return;
+
+    std::unique_ptr<RenderThreadPool> newThreadPool;
+
+    if (newNumThreads > 1)
+        newThreadPool = std::make_unique<RenderThreadPool> (newNumThreads - 1);
+
+    {
+        const ScopedLock sl (getCallbackLock());
+        std::swap (renderThreadPool, newThreadPool);
+        numRenderThreads = newNumThreads;
+    }
+
+    // The current sequence is still valid when run on any number of threads, but
+    // rebuilding it lets independent nodes stop sharing buffers
+    if (isPrepared)
+        updateOnMessageThread (*this);
+}
+
+//==============================================================================
+void AudioProcessorGraph::setProfilingEnabled (bool shouldBeEnabled)
+{
+    if (shouldBeEnabled)
+    {
+        const ScopedLock sl (getCallbackLock());
+
+        for (auto* node : nodes)
+            if (node->timings == nullptr)
+                node->timings = std::make_unique<Node::ProcessTimings>();
+    }
+
+    profilingEnabled = shouldBeEnabled;
+}
+
+std::vector<AudioProcessorGraph::NodeTimingStatistics> AudioProcessorGraph::getNodeTimingStatistics() const
+{
+    std::vector<NodeTimingStatistics> result;
+    const auto sampleRate = getSampleRate();
+
+    for (auto* node : nodes)
+    {
+        NodeTimingStatistics stats;
+        stats.nodeID = node->nodeID;
+        stats.name = node->getProcessor()->getName();
+        stats.latencyInSamples = node->getProcessor()->getLatencySamples();
+
+        if (node->timings != nullptr)
+        {
+            std::vector<double> times;
+            double totalLoad = 0;
+
+            for (auto& block : node->timings->getBlocks())
+            {
+                auto seconds = Time::highResolutionTicksToSeconds (block.endTicks - block.startTicks);
+                times.push_back (seconds * 1000.0);
+
+                if (sampleRate > 0 && block.numSamples > 0)
+                {
+                    auto load = seconds * sampleRate / block.numSamples;
+                    totalLoad += load;
+                    stats.maximumLoad = jmax (stats.maximumLoad, load);
+                }
+            }
+
+            if (! times.empty())
+            {
+                std::sort (times.begin(), times.end());
+
+                stats.numBlocks = (int) times.size();
+                stats.minimumMs = times.front();
+                stats.maximumMs = times.back();
+                stats.averageMs = std::accumulate (times.begin(), times.end(), 0.0) / (double) times.size();
+                stats.averageLoad = totalLoad / (double) times.size();
+
+                auto percentileIndex = (size_t) std::ceil (0.99 * (double) times.size()) - 1;
+                stats.percentile99Ms = times[percentileIndex];
+            }
+        }
+
+        result.push_back (stats);
+    }
+
+    return result;
+}
+
+void AudioProcessorGraph::resetNodeTimings()
+{
+    for (auto* node : nodes)
+        if (node->timings != nullptr)
+            node->timings->clear();
+}
+
+String AudioProcessorGraph::createChromeTrace() const
+{
+    struct NodeBlocks
+    {
+        Node* node;
+        std::vector<Node::ProcessTimings::Block> blocks;
+    };
+
+    std::vector<NodeBlocks> allBlocks;
+    auto firstTicks = std::numeric_limits<int64>::max();
+
+    for (auto* node : nodes)
+    {
+        if (node->timings == nullptr)
+            continue;
+
+        allBlocks.push_back ({ node, node->timings->getBlocks() });
+
+        for (auto& block : allBlocks.back().blocks)
+            firstTicks = jmin (firstTicks, block.startTicks);
+    }
+
+    auto ticksToMicroseconds = [] (int64 ticks)    { return Time::highResolutionTicksToSeconds (ticks) * 1.0e6; };
+
+    // The threads are numbered in the order they first appear, as their IDs are meaningless in a trace
+    Array<pointer_sized_int> threads;
+    Array<var> events;
+
+    for (auto& nodeBlocks : allBlocks)
+    {
+        auto name = nodeBlocks.node->getProcessor()->getName();
+
+        for (auto& block : nodeBlocks.blocks)
+        {
+            threads.addIfNotAlreadyThere (block.threadID);
+
+            DynamicObject::Ptr args (new DynamicObject());
+            args->setProperty ("nodeID", (int) nodeBlocks.node->nodeID.uid);
+            args->setProperty ("numSamples", block.numSamples);
+
+            DynamicObject::Ptr event (new DynamicObject());
+            event->setProperty ("name", name);
+            event->setProperty ("cat", "node");
+            event->setProperty ("ph", "X");
+            event->setProperty ("ts", ticksToMicroseconds (block.startTicks - firstTicks));
+            event->setProperty ("dur", ticksToMicroseconds (block.endTicks - block.startTicks));
+            event->setProperty ("pid", 1);
+            event->setProperty ("tid", threads.indexOf (block.threadID) + 1);
+            event->setProperty ("args", var (args.get()));
+            events.add (var (event.get()));
+        }
+    }
+
+    for (int i = 0; i < threads.size(); ++i)
+    {
+        DynamicObject::Ptr args (new DynamicObject());
+        args->setProperty ("name", "Render thread " + String (i + 1));
+
+        DynamicObject::Ptr event (new DynamicObject());
+        event->setProperty ("name", "thread_name");
+        event->setProperty ("ph", "M");
+        event->setProperty ("pid", 1);
+        event->setProperty ("tid", i + 1);
+        event->setProperty ("args", var (args.get()));
+        events.add (var (event.get()));
+    }
+
+    DynamicObject::Ptr trace (new DynamicObject());
+    trace->setProperty ("traceEvents", events);
+    trace->setProperty ("displayTimeUnit", "ms");
+
+    return JSON::toString (var (trace.get()), true);
+}
+
 //==============================================================================
 void AudioProcessorGraph::clearRenderingSequence()
 {
@@ -1342,12 +1830,17 @@ bool AudioProcessorGraph::producesMidi() const                      { return tru
 void AudioProcessorGraph::getStateInformation (juce::MemoryBlock&)  {}
 void AudioProcessorGraph::setStateInformation (const void*, int)    {}
 
-template <typename FloatType, typename SequenceType>
+// The thread pool is only read while the callback lock is held, because
+// setNumRenderThreads() may replace and delete it as soon as the lock is free
+template <typename FloatType, typename SequenceType, typename ThreadPoolType>
 static void processBlockForBuffer (AudioBuffer<FloatType>& buffer, MidiBuffer& midiMessages,
                                    AudioProcessorGraph& graph,
                                    std::unique_ptr<SequenceType>& renderSequence,
+                                   std::unique_ptr<ThreadPoolType>& threadPool,
                                    std::atomic<bool>& isPrepared)
 {
+    const auto recordTimings = graph.isProfilingEnabled();
+
     if (graph.isNonRealtime())
     {
         while (! isPrepared)
@@ -1356,7 +1849,7 @@ static void processBlockForBuffer (AudioBuffer<FloatType>& buffer, MidiBuffer& m
         const ScopedLock sl (graph.getCallbackLock());
 
         if (renderSequence != nullptr)
-            renderSequence->perform (buffer, midiMessages, graph.getPlayHead());
+            renderSequence->perform (buffer, midiMessages, graph.getPlayHead(), threadPool.get(), recordTimings);
     }
     else
     {
@@ -1365,7 +1858,7 @@ static void processBlockForBuffer (AudioBuffer<FloatType>& buffer, MidiBuffer& m
         if (isPrepared)
         {
             if (renderSequence != nullptr)
-                renderSequence->perform (buffer, midiMessages, graph.getPlayHead());
+                renderSequence->perform (buffer, midiMessages, graph.getPlayHead(), threadPool.get(), recordTimings);
         }
         else
         {
@@ -1380,7 +1873,7 @@ void AudioProcessorGraph::processBlock (AudioBuffer<float>& buffer, MidiBuffer&
     if ((! isPrepared) && MessageManager::getInstance()->isThisTheMessageThread())
         handleAsyncUpdate();
 
-    processBlockForBuffer<float> (buffer, midiMessages, *this, renderSequenceFloat, isPrepared);
+    processBlockForBuffer<float> (buffer, midiMessages, *this, renderSequenceFloat, renderThreadPool, isPrepared);
 }
 
 void AudioProcessorGraph::processBlock (AudioBuffer<double>& buffer, MidiBuffer& midiMessages)
@@ -1388,7 +1881,7 @@ void AudioProcessorGraph::processBlock (AudioBuffer<double>& buffer, MidiBuffer&
     if ((! isPrepared) && MessageManager::getInstance()->isThisTheMessageThread())
         handleAsyncUpdate();
 
-    processBlockForBuffer<double> (buffer, midiMessages, *this, renderSequenceDouble, isPrepared);
+    processBlockForBuffer<double> (buffer, midiMessages, *this, renderSequenceDouble, renderThreadPool, isPrepared);
 }
 
 //==============================================================================
@@ -1547,4 +2040,182 @@ void AudioProcessorGraph::AudioGraphIOProcessor::setParentGraph (AudioProcessorG
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioProcessorGraphTests  : public UnitTest
+{
+public:
+    AudioProcessorGraphTests()
+        : UnitTest ("AudioProcessorGraph", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        ScopedJuceInitialiser_GUI scopedJuceInitialiser_gui;
+
+        beginTest ("Parallel rendering produces the same output as serial rendering");
+        {
+            for (auto numThreads : { 2, 4 })
+            {
+                auto serial   = renderTestGraph (1);
+                auto parallel = renderTestGraph (numThreads);
+
+                expectEquals (parallel.getNumChannels(), serial.getNumChannels());
+
+                for (int ch = 0; ch < serial.getNumChannels(); ++ch)
+                    for (int i = 0; i < serial.getNumSamples(); ++i)
+                        expectWithinAbsoluteError (parallel.getSample (ch, i), serial.getSample (ch, i), 1.0e-6f);
+            }
+        }
+
+        beginTest ("Parallel rendering sums independent branches");
+        {
+            auto output = renderTestGraph (3);
+
+            // input 1.0 through branches with gains 1..numBranches, each followed by a gain of 0.5
+            const auto expected = 0.5f * (float) (numBranches * (numBranches + 1) / 2);
+
+            for (int ch = 0; ch < output.getNumChannels(); ++ch)
+                expectWithinAbsoluteError (output.getSample (ch, blockSize - 1), expected, 1.0e-4f);
+        }
+
+        beginTest ("Profiling measures every block processed by each node");
+        {
+            for (auto numThreads : { 1, 3 })
+            {
+                AudioProcessorGraph graph;
+                graph.setNumRenderThreads (numThreads);
+                graph.setProfilingEnabled (true);
+
+                renderTestGraph (graph);
+
+                auto statistics = graph.getNodeTimingStatistics();
+                expectEquals ((int) statistics.size(), 2 + 2 * numBranches);
+
+                for (auto& stats : statistics)
+                {
+                    expectEquals (stats.numBlocks, numBlocks);
+                    expect (stats.minimumMs <= stats.averageMs && stats.averageMs <= stats.maximumMs);
+                    expect (stats.percentile99Ms <= stats.maximumMs);
+                    expect (stats.averageLoad <= stats.maximumLoad);
+                }
+
+                auto trace = JSON::parse (graph.createChromeTrace());
+                auto* events = trace["traceEvents"].getArray();
+                expect (events != nullptr);
+
+                if (events != nullptr)
+                {
+                    int numBlockEvents = 0;
+
+                    for (auto& event : *events)
+                        if (event["ph"] == "X")
+                            ++numBlockEvents;
+
+                    expectEquals (numBlockEvents, (2 + 2 * numBranches) * numBlocks);
+                }
+
+                graph.resetNodeTimings();
+
+                for (auto& stats : graph.getNodeTimingStatistics())
+                    expectEquals (stats.numBlocks, 0);
+            }
+        }
+
+        beginTest ("Nodes aren't timed unless profiling is enabled");
+        {
+            AudioProcessorGraph graph;
+            renderTestGraph (graph);
+
+            for (auto& stats : graph.getNodeTimingStatistics())
+                expectEquals (stats.numBlocks, 0);
+        }
+    }
+
+private:
+    static constexpr int numBranches = 8;
+    static constexpr int blockSize = 256;
+    static constexpr int numBlocks = 4;
+
+    struct GainProcessor  : public AudioProcessor
+    {
+        explicit GainProcessor (float g)
+            : AudioProcessor (BusesProperties().withInput  ("in",  AudioChannelSet::stereo())
+                                               .withOutput ("out", AudioChannelSet::stereo())),
+              gain (g)
+        {}
+
+        const String getName() const override                   { return "Gain"; }
+        void prepareToPlay (double, int) override               {}
+        void releaseResources() override                        {}
+        void processBlock (AudioBuffer<float>& b, MidiBuffer&) override  { b.applyGain (gain); }
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override            { return 0.0; }
+        bool acceptsMidi() const override                       { return false; }
+        bool producesMidi() const override                      { return false; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+        const float gain;
+    };
+
+    static AudioBuffer<float> renderTestGraph (int numThreads)
+    {
+        AudioProcessorGraph graph;
+        graph.setNumRenderThreads (numThreads);
+        return renderTestGraph (graph);
+    }
+
+    static AudioBuffer<float> renderTestGraph (AudioProcessorGraph& graph)
+    {
+        using IOProcessor = AudioProcessorGraph::AudioGraphIOProcessor;
+
+        graph.setPlayConfigDetails (2, 2, 44100.0, blockSize);
+
+        auto input  = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioInputNode));
+        auto output = graph.addNode (std::make_unique<IOProcessor> (IOProcessor::audioOutputNode));
+
+        for (int i = 0; i < numBranches; ++i)
+        {
+            auto first  = graph.addNode (std::make_unique<GainProcessor> ((float) (i + 1)));
+            auto second = graph.addNode (std::make_unique<GainProcessor> (0.5f));
+
+            for (int ch = 0; ch < 2; ++ch)
+            {
+                graph.addConnection ({ { input->nodeID,  ch }, { first->nodeID,  ch } });
+                graph.addConnection ({ { first->nodeID,  ch }, { second->nodeID, ch } });
+                graph.addConnection ({ { second->nodeID, ch }, { output->nodeID, ch } });
+            }
+        }
+
+        graph.prepareToPlay (44100.0, blockSize);
+
+        AudioBuffer<float> buffer (2, blockSize);
+        MidiBuffer midi;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+                FloatVectorOperations::fill (buffer.getWritePointer (ch), 1.0f, blockSize);
+
+            graph.processBlock (buffer, midi);
+        }
+
+        graph.releaseResources();
+        return buffer;
+    }
+};
+
+static AudioProcessorGraphTests audioProcessorGraphTests;
+
+#endif
+
 } // namespace juce
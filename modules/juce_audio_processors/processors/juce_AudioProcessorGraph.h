@@ -128,6 +128,9 @@ public:
         /** A convenient typedef for referring to a pointer to a node object. */
         using Ptr = ReferenceCountedObjectPtr<Node>;
 
+        /** Destructor. */
+        ~Node() override;
+
     private:
         //==============================================================================
         friend class AudioProcessorGraph;
@@ -142,10 +145,13 @@ public:
             bool operator== (const Connection&) const noexcept;
         };
 
+        struct ProcessTimings;
+
         std::unique_ptr<AudioProcessor> processor;
         Array<Connection> inputs, outputs;
         bool isPrepared = false;
         std::atomic<bool> bypassed { false };
+        std::unique_ptr<ProcessTimings> timings;
 
         Node (NodeID, std::unique_ptr<AudioProcessor>) noexcept;
 
@@ -291,6 +297,95 @@ public:
     */
     bool removeIllegalConnections();
 
+    //==============================================================================
+    /** Sets the number of threads that should be used to render the graph.
+
+        By default, all the nodes in a graph are rendered one after the other on the
+        thread that calls processBlock(). If you pass a number greater than 1 here, the
+        graph will start (numThreads - 1) worker threads, and nodes that don't depend on
+        each other's output will be rendered concurrently by these workers and the
+        calling thread.
+
+        The workers are created by this method rather than during the audio callback.
+        They run at realtime priority, are each pinned to a CPU core, and are handed
+        work without any locking or memory allocation on the audio thread. Workers
+        that have gone to sleep between callbacks are woken by posting to a semaphore.
+
+        Note that when rendering in parallel, the processors in the graph may have their
+        processBlock() methods called from any of these threads, so the processors mustn't
+        rely on always being called from the same thread.
+
+        @see getNumRenderThreads, RealtimeWorkerPool
+    */
+    void setNumRenderThreads (int numThreads);
+
+    /** Returns the number of threads used to render the graph.
+        @see setNumRenderThreads
+    */
+    int getNumRenderThreads() const noexcept                        { return numRenderThreads; }
+
+    //==============================================================================
+    /** A summary of the time that a node has spent processing.
+        @see getNodeTimingStatistics
+    */
+    struct NodeTimingStatistics
+    {
+        NodeID nodeID;
+
+        /** The name of the node's processor. */
+        String name;
+
+        /** The number of blocks that the statistics were measured over. */
+        int numBlocks = 0;
+
+        /** The times taken to process a block, in milliseconds. */
+        double minimumMs = 0, averageMs = 0, percentile99Ms = 0, maximumMs = 0;
+
+        /** The average and largest proportions of the real-time duration of a block
+            which were spent processing it. A value above 1.0 means that a block took
+            longer to process than it takes to play.
+        */
+        double averageLoad = 0, maximumLoad = 0;
+
+        /** The latency that the node's processor reports. */
+        int latencyInSamples = 0;
+    };
+
+    /** Enables or disables timing of each node as it processes.
+
+        While this is enabled, the start and end times of the most recent blocks processed
+        by each node are kept in a lock-free ring buffer, so the measurements can be read
+        with getNodeTimingStatistics() or createChromeTrace() while the graph is playing.
+        The overhead for the audio thread is a couple of timer reads per node per block.
+
+        This may allocate memory, so call it from the message thread.
+    */
+    void setProfilingEnabled (bool shouldBeEnabled);
+
+    /** Returns true if the nodes are being timed.
+        @see setProfilingEnabled
+    */
+    bool isProfilingEnabled() const noexcept                        { return profilingEnabled.load(); }
+
+    /** Returns the timing statistics of each node, measured over the blocks that were
+        processed since profiling was enabled or resetNodeTimings() was called, up to a
+        limit of the most recent 1024 blocks.
+
+        @see setProfilingEnabled
+    */
+    std::vector<NodeTimingStatistics> getNodeTimingStatistics() const;
+
+    /** Discards the timings that have been measured so far. */
+    void resetNodeTimings();
+
+    /** Returns the measured timings of all the blocks processed by each node, in the
+        JSON trace event format that can be loaded into Chrome's about:tracing page or
+        other trace viewers, to see which nodes ran on which threads and when.
+
+        @see setProfilingEnabled
+    */
+    String createChromeTrace() const;
+
     //==============================================================================
     /** A special type of AudioProcessor that can live inside an AudioProcessorGraph
         in order to use the audio that comes into and out of the graph itself.
@@ -430,6 +525,12 @@ private:
     std::unique_ptr<RenderSequenceFloat> renderSequenceFloat;
     std::unique_ptr<RenderSequenceDouble> renderSequenceDouble;
 
+    struct RenderThreadPool;
+    std::unique_ptr<RenderThreadPool> renderThreadPool;
+    int numRenderThreads = 1;
+
+    std::atomic<bool> profilingEnabled { false };
+
     PrepareSettings prepareSettings;
 
     friend class AudioGraphIOProcessor;
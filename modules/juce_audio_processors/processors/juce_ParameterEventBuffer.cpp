@@ -0,0 +1,257 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+void ParameterEventBuffer::ensureSize (int maxNumEvents)
+{
+    if (maxNumEvents > capacity)
+    {
+        events.ensureStorageAllocated (maxNumEvents);
+        sortSpace.realloc ((size_t) maxNumEvents);
+        capacity = maxNumEvents;
+    }
+}
+
+void ParameterEventBuffer::clear() noexcept
+{
+    events.clearQuick();
+    needsSorting = false;
+}
+
+bool ParameterEventBuffer::addEvent (int parameterIndex, int samplePosition, float newValue) noexcept
+{
+    jassert (parameterIndex >= 0);
+
+    if (events.size() >= capacity)
+        return false;
+
+    if (! events.isEmpty() && events.getReference (events.size() - 1).samplePosition > samplePosition)
+        needsSorting = true;
+
+    events.add ({ parameterIndex, samplePosition, newValue });
+    return true;
+}
+
+// The events are usually added as a few runs that are each in order (e.g. one for each
+// of a VST3 host's parameter queues), so this merges neighbouring runs until there's only
+// one left, swapping between the events and the spare space.
+void ParameterEventBuffer::sort() noexcept
+{
+    if (! needsSorting)
+        return;
+
+    needsSorting = false;
+
+    auto numEvents = events.size();
+    auto* source = events.begin();
+    auto* dest = sortSpace.get();
+
+    auto findEndOfRun = [&] (int start)
+    {
+        auto end = start + 1;
+
+        while (end < numEvents && source[end - 1].samplePosition <= source[end].samplePosition)
+            ++end;
+
+        return end;
+    };
+
+    auto isEarlier = [] (const Event& a, const Event& b) { return a.samplePosition < b.samplePosition; };
+
+    for (;;)
+    {
+        int numRuns = 0;
+
+        for (int start = 0; start < numEvents; ++numRuns)
+        {
+            auto middle = findEndOfRun (start);
+            auto end = middle < numEvents ? findEndOfRun (middle) : numEvents;
+
+            std::merge (source + start, source + middle, source + middle, source + end, dest + start, isEarlier);
+            start = end;
+        }
+
+        std::swap (source, dest);
+
+        if (numRuns <= 1)
+            break;
+    }
+
+    if (source != events.begin())
+        std::copy (source, source + numEvents, events.begin());
+}
+
+float ParameterEventBuffer::fillRamp (int parameterIndex, float startValue,
+                                      float* destination, int numSamples) const noexcept
+{
+    int pos = 0, lastEventPos = 0;
+    auto lastValue = startValue;
+
+    for (auto& e : events)
+    {
+        if (e.parameterIndex != parameterIndex)
+            continue;
+
+        auto eventPos = jmax (0, e.samplePosition);
+
+        if (eventPos > lastEventPos)
+        {
+            auto delta = (e.value - lastValue) / (float) (eventPos - lastEventPos);
+
+            for (auto end = jmin (eventPos, numSamples); pos < end; ++pos)
+                destination[pos] = lastValue + delta * (float) (pos - lastEventPos);
+        }
+
+        lastEventPos = eventPos;
+        lastValue = e.value;
+    }
+
+    for (; pos < numSamples; ++pos)
+        destination[pos] = lastValue;
+
+    return lastValue;
+}
+
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ParameterEventBufferTests   : public UnitTest
+{
+public:
+    ParameterEventBufferTests()
+        : UnitTest ("ParameterEventBuffer", UnitTestCategories::audioProcessorParameters)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Sorting puts events in time order");
+        {
+            ParameterEventBuffer buffer;
+            buffer.ensureSize (8);
+
+            expect (buffer.addEvent (0, 10, 0.1f));
+            expect (buffer.addEvent (0, 30, 0.3f));
+            expect (buffer.addEvent (1, 20, 0.2f));
+            expect (buffer.addEvent (1, 10, 0.4f));
+            expect (buffer.addEvent (2, 0,  0.5f));
+
+            expectEquals (buffer.getNumEvents(), 5);
+            buffer.sort();
+
+            const int expectedIndexes[]   = { 2, 0, 1, 1, 0 };
+            const int expectedPositions[] = { 0, 10, 10, 20, 30 };
+            int i = 0;
+
+            for (auto& e : buffer)
+            {
+                expectEquals (e.parameterIndex, expectedIndexes[i]);
+                expectEquals (e.samplePosition, expectedPositions[i]);
+                ++i;
+            }
+        }
+
+        beginTest ("Sorting many runs keeps events at the same position in the order they were added");
+        {
+            ParameterEventBuffer buffer;
+            buffer.ensureSize (2048);
+
+            // Like a host's parameter queues, each parameter's events are in order,
+            // but every parameter starts again from the start of the block
+            for (int parameter = 0; parameter < 64; ++parameter)
+                for (int i = 0; i < 32; ++i)
+                    expect (buffer.addEvent (parameter, i * 16 + (parameter % 3) * 8, (float) i / 32.0f));
+
+            buffer.sort();
+            expectEquals (buffer.getNumEvents(), 2048);
+
+            for (int i = 1; i < buffer.getNumEvents(); ++i)
+            {
+                auto& previous = buffer.getEvent (i - 1);
+                auto& e = buffer.getEvent (i);
+
+                expect (previous.samplePosition < e.samplePosition
+                         || (previous.samplePosition == e.samplePosition && previous.parameterIndex < e.parameterIndex));
+            }
+        }
+
+        beginTest ("Events are dropped when the buffer is full");
+        {
+            ParameterEventBuffer buffer;
+            expect (! buffer.addEvent (0, 0, 1.0f));
+
+            buffer.ensureSize (2);
+            const auto capacity = buffer.getCapacity();
+
+            for (int i = 0; i < capacity; ++i)
+                expect (buffer.addEvent (0, i, 1.0f));
+
+            expect (! buffer.addEvent (0, capacity, 1.0f));
+            expectEquals (buffer.getNumEvents(), capacity);
+            expectEquals (buffer.getCapacity(), capacity);
+
+            buffer.clear();
+            expect (buffer.isEmpty());
+            expectEquals (buffer.getCapacity(), capacity);
+        }
+
+        beginTest ("Ramps pass through each event");
+        {
+            ParameterEventBuffer buffer;
+            buffer.ensureSize (8);
+            buffer.addEvent (3, 4, 1.0f);
+            buffer.addEvent (5, 6, 0.0f);
+            buffer.addEvent (3, 8, 0.5f);
+
+            float ramp[12];
+            expectEquals (buffer.fillRamp (3, 0.0f, ramp, 12), 0.5f);
+
+            const float expected[] = { 0.0f, 0.25f, 0.5f, 0.75f, 1.0f, 0.875f, 0.75f, 0.625f, 0.5f, 0.5f, 0.5f, 0.5f };
+
+            for (int i = 0; i < 12; ++i)
+                expectWithinAbsoluteError (ramp[i], expected[i], 1.0e-6f);
+
+            expectEquals (buffer.fillRamp (4, 0.25f, ramp, 12), 0.25f);
+
+            for (auto v : ramp)
+                expectEquals (v, 0.25f);
+
+            buffer.clear();
+            buffer.addEvent (1, 0, 0.75f);
+            buffer.addEvent (1, 20, 0.0f);
+            expectEquals (buffer.fillRamp (1, 0.0f, ramp, 12), 0.0f);
+            expectEquals (ramp[0], 0.75f);
+            expectWithinAbsoluteError (ramp[11], 0.75f * 9.0f / 20.0f, 1.0e-6f);
+        }
+    }
+};
+
+static ParameterEventBufferTests parameterEventBufferTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Holds a block's worth of timestamped parameter changes.
+
+    An AudioProcessor has one of these, which the host or plugin wrapper fills in
+    before each call to processBlock(), in the same way that the MidiBuffer holds the
+    incoming midi. Each event gives the position in the block at which a parameter
+    reached a new value, so a processor can follow automation with sample accuracy
+    without having to split the block up, or having to smooth every parameter.
+
+    Once all the events for a block have been added, the host calls sort(), which puts
+    them in order of their sample positions, while keeping events at the same position
+    in the order in which they were added. The values are normalised, like the ones
+    passed to AudioProcessorParameter::setValue().
+
+    The buffer never reallocates when events are added, so the host must call
+    ensureSize() before processing starts. Events that don't fit are dropped, but the
+    parameter's value will still be set to its final value for the block.
+
+    @see AudioProcessor::getParameterEvents
+
+    @tags{Audio}
+*/
+class JUCE_API  ParameterEventBuffer
+{
+public:
+    //==============================================================================
+    /** A change to one of a processor's parameters. */
+    struct Event
+    {
+        /** The parameter's index in AudioProcessor::getParameters(). */
+        int parameterIndex;
+
+        /** The position within the block at which the parameter reaches the new value. */
+        int samplePosition;
+
+        /** The parameter's new normalised value, between 0 and 1. */
+        float value;
+    };
+
+    //==============================================================================
+    /** Creates an empty buffer, which has no space for any events. */
+    ParameterEventBuffer() = default;
+
+    /** Makes sure the buffer can hold at least this many events without reallocating. */
+    void ensureSize (int maxNumEvents);
+
+    /** Returns the number of events that can be held without reallocating. */
+    int getCapacity() const noexcept                        { return capacity; }
+
+    /** Removes all the events. */
+    void clear() noexcept;
+
+    /** Returns true if there are no events. */
+    bool isEmpty() const noexcept                           { return events.isEmpty(); }
+
+    /** Returns the number of events. */
+    int getNumEvents() const noexcept                       { return events.size(); }
+
+    /** Adds an event to the end of the buffer.
+
+        If this is earlier than the last event, call sort() once all the events for the
+        block have been added. This doesn't allocate, so it's safe to call on the audio
+        thread.
+
+        @returns false if there wasn't any space for the event, so it was dropped
+    */
+    bool addEvent (int parameterIndex, int samplePosition, float newValue) noexcept;
+
+    /** Sorts the events by their sample positions, keeping events at the same position
+        in the order in which they were added.
+
+        This does nothing if the events were added in order. It doesn't allocate, so
+        it's safe to call on the audio thread.
+    */
+    void sort() noexcept;
+
+    /** Returns one of the events. */
+    const Event& getEvent (int index) const noexcept        { return events.getReference (index); }
+
+    /** Iterates the events in time order. */
+    const Event* begin() const noexcept                     { return events.begin(); }
+
+    /** Iterates the events in time order. */
+    const Event* end() const noexcept                       { return events.end(); }
+
+    //==============================================================================
+    /** Fills an array with a parameter's value at each sample of the block.
+
+        The value ramps linearly from startValue at the start of the block to each of
+        the parameter's events in turn, reaching each one's value at its sample position,
+        and then stays at the last one's value. This is how VST3 interprets its parameter
+        changes, and matches what the host's automation curve looks like.
+
+        @param parameterIndex   the index of the parameter in AudioProcessor::getParameters()
+        @param startValue       the parameter's value at the end of the previous block
+        @param destination      the array to fill with numSamples values
+        @param numSamples       the size of the block
+        @returns the value of the parameter's last event, or startValue if it has none
+    */
+    float fillRamp (int parameterIndex, float startValue, float* destination, int numSamples) const noexcept;
+
+private:
+    //==============================================================================
+    Array<Event> events;
+    HeapBlock<Event> sortSpace;
+    int capacity = 0;
+    bool needsSorting = false;
+
+    JUCE_LEAK_DETECTOR (ParameterEventBuffer)
+};
+
+} // namespace juce
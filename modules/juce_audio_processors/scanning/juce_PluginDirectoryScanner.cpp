@@ -34,6 +34,290 @@ static StringArray readDeadMansPedalFile (const File& file)
     return lines;
 }
 
+//==============================================================================
+struct PluginDirectoryScanner::ScanCache
+{
+    explicit ScanCache (const File& f)  : cacheFile (f)
+    {
+        if (auto xml = parseXMLIfTagMatches (cacheFile, "PLUGINSCANCACHE"))
+        {
+            forEachXmlChildElementWithTagName (*xml, e, "FILE")
+            {
+                Entry entry;
+                entry.modificationTime = e->getStringAttribute ("modified").getLargeIntValue();
+                entry.size             = e->getStringAttribute ("size").getLargeIntValue();
+
+                forEachXmlChildElement (*e, typeXml)
+                {
+                    PluginDescription desc;
+
+                    if (desc.loadFromXml (*typeXml))
+                        entry.types.add (desc);
+                }
+
+                entries[makeKey (e->getStringAttribute ("format"), e->getStringAttribute ("file"))] = entry;
+            }
+        }
+    }
+
+    ~ScanCache()
+    {
+        if (needsSaving)
+            save();
+    }
+
+    bool getCachedTypes (const String& formatName, const String& fileOrIdentifier,
+                         OwnedArray<PluginDescription>& typesFound) const
+    {
+        File file;
+
+        if (! getFileFor (fileOrIdentifier, file))
+            return false;
+
+        const ScopedLock sl (lock);
+        auto found = entries.find (makeKey (formatName, fileOrIdentifier));
+
+        if (found == entries.end()
+             || found->second.modificationTime != file.getLastModificationTime().toMilliseconds()
+             || found->second.size != file.getSize())
+            return false;
+
+        for (auto& desc : found->second.types)
+            typesFound.add (new PluginDescription (desc));
+
+        return true;
+    }
+
+    void store (const String& formatName, const String& fileOrIdentifier,
+                const OwnedArray<PluginDescription>& typesFound)
+    {
+        File file;
+
+        if (! getFileFor (fileOrIdentifier, file))
+            return;
+
+        Entry entry;
+        entry.modificationTime = file.getLastModificationTime().toMilliseconds();
+        entry.size = file.getSize();
+
+        for (auto* desc : typesFound)
+            entry.types.add (*desc);
+
+        const ScopedLock sl (lock);
+        entries[makeKey (formatName, fileOrIdentifier)] = entry;
+        needsSaving = true;
+    }
+
+private:
+    struct Entry
+    {
+        int64 modificationTime = 0, size = 0;
+        Array<PluginDescription> types;
+    };
+
+    File cacheFile;
+    std::map<String, Entry> entries;
+    CriticalSection lock;
+    bool needsSaving = false;
+
+    // Plugins which aren't identified by a file (e.g. AudioUnits) can't be cached
+    static bool getFileFor (const String& fileOrIdentifier, File& result)
+    {
+        if (! File::isAbsolutePath (fileOrIdentifier))
+            return false;
+
+        result = File (fileOrIdentifier);
+        return result.exists();
+    }
+
+    static String makeKey (const String& formatName, const String& fileOrIdentifier)
+    {
+        return formatName + ":" + fileOrIdentifier;
+    }
+
+    void save() const
+    {
+        XmlElement xml ("PLUGINSCANCACHE");
+
+        for (auto& item : entries)
+        {
+            auto* e = xml.createNewChildElement ("FILE");
+            e->setAttribute ("format", item.first.upToFirstOccurrenceOf (":", false, false));
+            e->setAttribute ("file", item.first.fromFirstOccurrenceOf (":", false, false));
+            e->setAttribute ("modified", String (item.second.modificationTime));
+            e->setAttribute ("size", String (item.second.size));
+
+            for (auto& desc : item.second.types)
+                e->addChildElement (desc.createXml().release());
+        }
+
+        xml.writeTo (cacheFile);
+    }
+};
+
+//==============================================================================
+struct PluginDirectoryScanner::WorkerPool
+{
+    enum class Result
+    {
+        scanned,
+        workerDied,
+        failedToLaunch
+    };
+
+    explicit WorkerPool (const OutOfProcessOptions& o)  : options (o)
+    {
+        for (int i = jmax (1, options.numWorkers); --i >= 0;)
+            idleWorkers.add (workers.add (new Worker (options)));
+    }
+
+    Result scan (const String& formatName, const String& fileOrIdentifier,
+                 OwnedArray<PluginDescription>& typesFound)
+    {
+        auto* worker = acquireWorker();
+        auto result = worker->scan (formatName, fileOrIdentifier, typesFound);
+
+        {
+            const ScopedLock sl (lock);
+            idleWorkers.add (worker);
+        }
+
+        workerReleased.signal();
+        return result;
+    }
+
+private:
+    //==============================================================================
+    struct Worker  : public ChildProcessMaster
+    {
+        explicit Worker (const OutOfProcessOptions& o)  : options (o) {}
+
+        Result scan (const String& formatName, const String& fileOrIdentifier,
+                     OwnedArray<PluginDescription>& typesFound)
+        {
+            replyReceived.reset();
+
+            auto request = PluginScannerMessages::createScanRequest (formatName, fileOrIdentifier, options.timeoutMs);
+
+            // If the request can't be sent, the worker died while it was idle (e.g. the
+            // previous plugin crashed while being unloaded), so that's not the fault of
+            // this file. Start a fresh worker and try once more before giving up on it..
+            if (! (ensureRunning() && sendMessageToSlave (request)))
+            {
+                stop();
+
+                if (! ensureRunning())
+                    return Result::failedToLaunch;
+
+                if (! sendMessageToSlave (request))
+                {
+                    stop();
+                    return Result::failedToLaunch;
+                }
+            }
+
+            replyReceived.wait (options.timeoutMs);
+
+            std::unique_ptr<XmlElement> xml;
+
+            {
+                const ScopedLock sl (replyLock);
+                std::swap (xml, reply);
+            }
+
+            if (xml != nullptr && xml->getStringAttribute ("file") == fileOrIdentifier)
+            {
+                forEachXmlChildElement (*xml, typeXml)
+                {
+                    auto desc = std::make_unique<PluginDescription>();
+
+                    if (desc->loadFromXml (*typeXml))
+                        typesFound.add (desc.release());
+                }
+
+                return Result::scanned;
+            }
+
+            // The worker has either crashed, or is stuck, so get rid of it and start
+            // another one next time..
+            stop();
+            return Result::workerDied;
+        }
+
+        bool ensureRunning()
+        {
+            if (! isRunning)
+            {
+                isRunning = launchSlaveProcess (options.workerExecutable, options.commandLineUniqueID, 0, 0);
+
+                // If this fails, check that OutOfProcessOptions::workerExecutable is
+                // an app which creates a PluginScannerWorker when it's launched.
+                jassert (isRunning);
+            }
+
+            return isRunning;
+        }
+
+        void stop()
+        {
+            killSlaveProcess();
+            isRunning = false;
+        }
+
+        void handleMessageFromSlave (const MemoryBlock& message) override
+        {
+            auto xml = PluginScannerMessages::parse (message);
+
+            if (xml != nullptr && xml->hasTagName ("RESULT"))
+            {
+                {
+                    const ScopedLock sl (replyLock);
+                    reply = std::move (xml);
+                }
+
+                replyReceived.signal();
+            }
+        }
+
+        void handleConnectionLost() override
+        {
+            replyReceived.signal();
+        }
+
+        const OutOfProcessOptions& options;
+        bool isRunning = false;
+        CriticalSection replyLock;
+        std::unique_ptr<XmlElement> reply;
+        WaitableEvent replyReceived;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Worker)
+    };
+
+    Worker* acquireWorker()
+    {
+        for (;;)
+        {
+            {
+                const ScopedLock sl (lock);
+
+                if (! idleWorkers.isEmpty())
+                    return idleWorkers.removeAndReturn (idleWorkers.size() - 1);
+            }
+
+            workerReleased.wait (100);
+        }
+    }
+
+    const OutOfProcessOptions options;
+    OwnedArray<Worker> workers;
+    Array<Worker*> idleWorkers;
+    CriticalSection lock;
+    WaitableEvent workerReleased;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerPool)
+};
+
+//==============================================================================
 PluginDirectoryScanner::PluginDirectoryScanner (KnownPluginList& listToAddTo,
                                                 AudioPluginFormat& formatToLookFor,
                                                 FileSearchPath directoriesToSearch,
@@ -70,6 +354,12 @@ void PluginDirectoryScanner::setFilesOrIdentifiersToScan (const StringArray& fil
     nextIndex.set (filesOrIdentifiersToScan.size());
 }
 
+void PluginDirectoryScanner::setOutOfProcessOptions (const OutOfProcessOptions& options)
+{
+    workerPool.reset (new WorkerPool (options));
+    scanCache.reset (options.cacheFile != File() ? new ScanCache (options.cacheFile) : nullptr);
+}
+
 String PluginDirectoryScanner::getNextPluginFileThatWillBeScanned() const
 {
     return format.getNameOfPluginFromIdentifier (filesOrIdentifiersToScan [nextIndex.get() - 1]);
@@ -93,27 +383,74 @@ bool PluginDirectoryScanner::scanNextFile (bool dontRescanIfAlreadyInList,
         {
             nameOfPluginBeingScanned = format.getNameOfPluginFromIdentifier (file);
 
-            OwnedArray<PluginDescription> typesFound;
+            if (workerPool != nullptr)
+                scanFileOutOfProcess (file, dontRescanIfAlreadyInList);
+            else
+                scanFileInProcess (file, dontRescanIfAlreadyInList);
+        }
+    }
 
-            // Add this plugin to the end of the dead-man's pedal list in case it crashes...
-            auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
-            crashedPlugins.removeString (file);
-            crashedPlugins.add (file);
-            setDeadMansPedalFile (crashedPlugins);
+    updateProgress();
+    return index > 0;
+}
 
-            list.scanAndAddFile (file, dontRescanIfAlreadyInList, typesFound, format);
+void PluginDirectoryScanner::scanFileInProcess (const String& file, bool dontRescanIfAlreadyInList)
+{
+    OwnedArray<PluginDescription> typesFound;
 
-            // Managed to load without crashing, so remove it from the dead-man's-pedal..
-            crashedPlugins.removeString (file);
-            setDeadMansPedalFile (crashedPlugins);
+    // Add this plugin to the end of the dead-man's pedal list in case it crashes...
+    auto crashedPlugins = readDeadMansPedalFile (deadMansPedalFile);
+    crashedPlugins.removeString (file);
+    crashedPlugins.add (file);
+    setDeadMansPedalFile (crashedPlugins);
 
-            if (typesFound.size() == 0 && ! list.getBlacklistedFiles().contains (file))
-                failedFiles.add (file);
-        }
+    list.scanAndAddFile (file, dontRescanIfAlreadyInList, typesFound, format);
+
+    // Managed to load without crashing, so remove it from the dead-man's-pedal..
+    crashedPlugins.removeString (file);
+    setDeadMansPedalFile (crashedPlugins);
+
+    if (typesFound.size() == 0 && ! list.getBlacklistedFiles().contains (file))
+    {
+        const ScopedLock sl (failedFilesLock);
+        failedFiles.add (file);
     }
+}
 
-    updateProgress();
-    return index > 0;
+void PluginDirectoryScanner::scanFileOutOfProcess (const String& file, bool dontRescanIfAlreadyInList)
+{
+    {
+        const ScopedLock sl (blacklistLock);
+
+        if (list.getBlacklistedFiles().contains (file))
+            return;
+    }
+
+    OwnedArray<PluginDescription> typesFound;
+    auto result = WorkerPool::Result::scanned;
+
+    if (! (dontRescanIfAlreadyInList && scanCache != nullptr
+            && scanCache->getCachedTypes (format.getName(), file, typesFound)))
+    {
+        result = workerPool->scan (format.getName(), file, typesFound);
+
+        if (result == WorkerPool::Result::scanned && scanCache != nullptr)
+            scanCache->store (format.getName(), file, typesFound);
+    }
+
+    for (auto* desc : typesFound)
+        list.addType (*desc);
+
+    if (result == WorkerPool::Result::workerDied)
+    {
+        const ScopedLock sl (blacklistLock);
+        list.addToBlacklist (file);
+    }
+    else if (typesFound.isEmpty())
+    {
+        const ScopedLock sl (failedFilesLock);
+        failedFiles.add (file);
+    }
 }
 
 bool PluginDirectoryScanner::skipNextFile()
@@ -136,4 +473,111 @@ void PluginDirectoryScanner::applyBlacklistingsFromDeadMansPedal (KnownPluginLis
         list.addToBlacklist (crashedPlugin);
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+struct PluginScanCacheTests  : public UnitTest
+{
+    PluginScanCacheTests()
+        : UnitTest ("PluginDirectoryScanner::ScanCache", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        auto folder = File::getSpecialLocation (File::tempDirectory)
+                        .getNonexistentChildFile ("PluginScanCacheTests", {}, false);
+
+        // On Windows the drive letter already puts a colon into every path, so this makes
+        // sure that the other platforms also check that the keys are split at the first one
+       #if JUCE_WINDOWS
+        auto pluginFolder = folder.getChildFile ("plugins");
+       #else
+        auto pluginFolder = folder.getChildFile ("plug:ins");
+       #endif
+
+        pluginFolder.createDirectory();
+
+        auto pluginFile = pluginFolder.getChildFile ("Test.vst3");
+        pluginFile.replaceWithText ("plugin");
+
+        auto cacheFile = folder.getChildFile ("cache.xml");
+        auto path = pluginFile.getFullPathName();
+
+        OwnedArray<PluginDescription> types;
+        types.add (new PluginDescription());
+        types[0]->name = "Test Plugin";
+        types[0]->pluginFormatName = "VST3";
+        types[0]->fileOrIdentifier = path;
+
+        beginTest ("Cached types are saved and reloaded");
+        {
+            {
+                PluginDirectoryScanner::ScanCache cache (cacheFile);
+                cache.store ("VST3", path, types);
+            }
+
+            auto xml = parseXML (cacheFile);
+            expect (xml != nullptr);
+
+            if (auto* e = xml->getChildByName ("FILE"))
+            {
+                expectEquals (e->getStringAttribute ("format"), String ("VST3"));
+                expectEquals (e->getStringAttribute ("file"), path);
+            }
+            else
+            {
+                expect (false, "No FILE element was saved");
+            }
+
+            PluginDirectoryScanner::ScanCache cache (cacheFile);
+            OwnedArray<PluginDescription> found;
+
+            expect (cache.getCachedTypes ("VST3", path, found));
+            expectEquals (found.size(), 1);
+
+            if (found.size() == 1)
+            {
+                expectEquals (found[0]->name, String ("Test Plugin"));
+                expectEquals (found[0]->fileOrIdentifier, path);
+            }
+
+            expect (! cache.getCachedTypes ("AudioUnit", path, found));
+        }
+
+        beginTest ("Types aren't taken from the cache if the file has been modified");
+        {
+            PluginDirectoryScanner::ScanCache cache (cacheFile);
+            OwnedArray<PluginDescription> found;
+
+            pluginFile.setLastModificationTime (pluginFile.getLastModificationTime() + RelativeTime::seconds (10.0));
+            expect (! cache.getCachedTypes ("VST3", path, found));
+
+            cache.store ("VST3", path, types);
+            expect (cache.getCachedTypes ("VST3", path, found));
+
+            found.clear();
+            auto modificationTime = pluginFile.getLastModificationTime();
+            pluginFile.appendText ("longer");
+            pluginFile.setLastModificationTime (modificationTime);
+            expect (! cache.getCachedTypes ("VST3", path, found));
+            expect (found.isEmpty());
+        }
+
+        beginTest ("Plugins that aren't files aren't cached");
+        {
+            PluginDirectoryScanner::ScanCache cache (cacheFile);
+            OwnedArray<PluginDescription> found;
+
+            cache.store ("AudioUnit", "AudioUnit:Synths/aumu,Test,Test", types);
+            expect (! cache.getCachedTypes ("AudioUnit", "AudioUnit:Synths/aumu,Test,Test", found));
+        }
+
+        folder.deleteRecursively();
+    }
+};
+
+static PluginScanCacheTests pluginScanCacheTests;
+
+#endif
+
 } // namespace juce
@@ -33,6 +33,11 @@ namespace juce
     To use one of these, create it and call scanNextFile() repeatedly, until
     it returns false.
 
+    By default, each plugin is loaded into the current process to be scanned. To
+    avoid the risk of a dodgy plugin crashing your app, and to scan several files
+    at once, use setOutOfProcessOptions() to make the scanner hand each file to
+    one of a set of worker processes instead.
+
     @tags{Audio}
 */
 class JUCE_API  PluginDirectoryScanner
@@ -79,6 +84,54 @@ public:
     */
     void setFilesOrIdentifiersToScan (const StringArray& filesOrIdentifiersToScan);
 
+    //==============================================================================
+    /** The settings used to scan plugins in separate worker processes.
+        @see setOutOfProcessOptions, PluginScannerWorker
+    */
+    struct OutOfProcessOptions
+    {
+        /** The executable to launch for each worker. When it's started, this must create
+            a PluginScannerWorker and call its initialiseFromCommandLine() method with the
+            same commandLineUniqueID. It can be your own app.
+        */
+        File workerExecutable;
+
+        /** The ID which is passed to the workers on their command-line. This must be a
+            short alphanumeric string, with no spaces.
+        */
+        String commandLineUniqueID { "JUCEPluginScanWorker" };
+
+        /** The maximum number of worker processes that will be running at once. */
+        int numWorkers = SystemStats::getNumCpus();
+
+        /** The number of milliseconds that a worker may spend scanning a single file.
+            If it takes longer than this, the worker is killed, and the file is treated
+            in the same way as one which crashed.
+        */
+        int timeoutMs = 30000;
+
+        /** If this isn't File(), then the types found in each file are stored here, along
+            with the file's size and modification time. Later scans will read the results
+            for any files whose size and modification time haven't changed from this cache,
+            rather than launching a worker to load them again.
+        */
+        File cacheFile;
+    };
+
+    /** Makes scanNextFile() hand each file to a worker process rather than loading it
+        into this one.
+
+        If a plugin crashes or hangs its worker, the worker is restarted and the plugin is
+        added to the list's blacklist, so the dead-man's-pedal file isn't needed in this mode.
+
+        Because the workers are independent, scanNextFile() can be called from as many
+        threads as there are workers, and that many files will be scanned in parallel.
+        PluginListComponent::setOutOfProcessScanning() will do this for you.
+
+        This should be called before starting the scan.
+    */
+    void setOutOfProcessOptions (const OutOfProcessOptions& options);
+
     /** Tries the next likely-looking file.
 
         If dontRescanIfAlreadyInList is true, then the file will only be loaded and
@@ -89,6 +142,9 @@ public:
         scanned before the scan starts.
 
         Returns false when there are no more files to try.
+
+        If setOutOfProcessOptions() has been called, this can be called from several
+        threads at once.
     */
     bool scanNextFile (bool dontRescanIfAlreadyInList,
                        String& nameOfPluginBeingScanned);
@@ -125,10 +181,23 @@ private:
     StringArray filesOrIdentifiersToScan;
     File deadMansPedalFile;
     StringArray failedFiles;
+    CriticalSection failedFilesLock, blacklistLock;
     Atomic<int> nextIndex;
     float progress = 0;
     const bool allowAsync;
 
+    struct WorkerPool;
+    struct ScanCache;
+
+   #if JUCE_UNIT_TESTS
+    friend struct PluginScanCacheTests;
+   #endif
+
+    std::unique_ptr<WorkerPool> workerPool;
+    std::unique_ptr<ScanCache> scanCache;
+
+    void scanFileInProcess (const String& file, bool dontRescanIfAlreadyInList);
+    void scanFileOutOfProcess (const String& file, bool dontRescanIfAlreadyInList);
     void updateProgress();
     void setDeadMansPedalFile (const StringArray& newContents);
 
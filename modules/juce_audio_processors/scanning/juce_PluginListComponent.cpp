@@ -208,6 +208,11 @@ void PluginListComponent::setNumberOfThreadsForScanning (int num)
     numThreads = num;
 }
 
+void PluginListComponent::setOutOfProcessScanning (const PluginDirectoryScanner::OutOfProcessOptions& options)
+{
+    outOfProcessOptions.reset (new PluginDirectoryScanner::OutOfProcessOptions (options));
+}
+
 void PluginListComponent::resized()
 {
     auto r = getLocalBounds().reduced (2);
@@ -530,6 +535,12 @@ private:
         scanner.reset (new PluginDirectoryScanner (owner.list, formatToScan, pathList.getPath(),
                                                    true, owner.deadMansPedalFile, allowAsync));
 
+        if (owner.outOfProcessOptions != nullptr)
+        {
+            scanner->setOutOfProcessOptions (*owner.outOfProcessOptions);
+            numThreads = jmax (1, owner.outOfProcessOptions->numWorkers);
+        }
+
         if (! filesOrIdentifiersToScan.isEmpty())
         {
             scanner->setFilesOrIdentifiersToScan (filesOrIdentifiersToScan);
@@ -76,6 +76,13 @@ public:
      be zero (it is one by default). */
     void setNumberOfThreadsForScanning (int numThreads);
 
+    /** Makes future scans load each plugin in one of a set of worker processes, so that a
+        plugin which crashes can't take down your app. Each scan will use one thread for
+        each worker, so setNumberOfThreadsForScanning() is ignored in this mode.
+        @see PluginDirectoryScanner::setOutOfProcessOptions, PluginScannerWorker
+    */
+    void setOutOfProcessScanning (const PluginDirectoryScanner::OutOfProcessOptions& options);
+
     /** Returns the last search path stored in a given properties file for the specified format. */
     static FileSearchPath getLastSearchPath (PropertiesFile&, AudioPluginFormat&);
 
@@ -120,6 +127,7 @@ private:
     String dialogTitle, dialogText;
     bool allowAsync;
     int numThreads;
+    std::unique_ptr<PluginDirectoryScanner::OutOfProcessOptions> outOfProcessOptions;
 
     class TableModel;
     std::unique_ptr<TableListBoxModel> tableModel;
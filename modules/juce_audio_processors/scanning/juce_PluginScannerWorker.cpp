@@ -0,0 +1,152 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+// The messages passed between a PluginDirectoryScanner and its PluginScannerWorkers
+struct PluginScannerMessages
+{
+    static MemoryBlock createScanRequest (const String& formatName, const String& fileOrIdentifier, int timeoutMs)
+    {
+        XmlElement xml ("SCAN");
+        xml.setAttribute ("format", formatName);
+        xml.setAttribute ("file", fileOrIdentifier);
+        xml.setAttribute ("timeout", timeoutMs);
+        return toMemoryBlock (xml);
+    }
+
+    static MemoryBlock createScanResult (const String& fileOrIdentifier, const OwnedArray<PluginDescription>& types)
+    {
+        XmlElement xml ("RESULT");
+        xml.setAttribute ("file", fileOrIdentifier);
+
+        for (auto* desc : types)
+            xml.addChildElement (desc->createXml().release());
+
+        return toMemoryBlock (xml);
+    }
+
+    static MemoryBlock toMemoryBlock (const XmlElement& xml)
+    {
+        auto text = xml.toString (XmlElement::TextFormat().singleLine().withoutHeader());
+        return { text.toRawUTF8(), text.getNumBytesAsUTF8() };
+    }
+
+    static std::unique_ptr<XmlElement> parse (const MemoryBlock& message)
+    {
+        return parseXML (message.toString());
+    }
+};
+
+//==============================================================================
+// If a plugin gets stuck, the message thread can't respond to the scanner killing this
+// process, so this thread makes sure it doesn't hang around once the scanner has given up.
+struct PluginScannerWorker::Watchdog  : private Thread
+{
+    Watchdog()  : Thread ("Plugin scan watchdog")
+    {
+        startThread();
+    }
+
+    ~Watchdog() override
+    {
+        stopThread (1000);
+    }
+
+    void startScan (int timeoutMs) noexcept     { deadline = Time::getMillisecondCounter() + (uint32) jmax (1, timeoutMs); }
+    void scanFinished() noexcept                { deadline = 0; }
+
+private:
+    std::atomic<uint32> deadline { 0 };
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            wait (200);
+
+            auto d = deadline.load();
+
+            if (d != 0 && Time::getMillisecondCounter() > d)
+                Process::terminate();
+        }
+    }
+};
+
+//==============================================================================
+PluginScannerWorker::PluginScannerWorker (AudioPluginFormatManager& formatsToUse)
+    : formatManager (formatsToUse)
+{
+}
+
+PluginScannerWorker::~PluginScannerWorker()
+{
+}
+
+void PluginScannerWorker::handleMessageFromMaster (const MemoryBlock& message)
+{
+    if (auto xml = PluginScannerMessages::parse (message))
+    {
+        if (xml->hasTagName ("SCAN"))
+        {
+            if (watchdog == nullptr)
+                watchdog.reset (new Watchdog());
+
+            watchdog->startScan (xml->getIntAttribute ("timeout"));
+
+            WeakReference<PluginScannerWorker> weakThis (this);
+            auto formatName = xml->getStringAttribute ("format");
+            auto fileOrIdentifier = xml->getStringAttribute ("file");
+
+            MessageManager::callAsync ([weakThis, formatName, fileOrIdentifier]
+            {
+                if (weakThis != nullptr)
+                    weakThis->scanFile (formatName, fileOrIdentifier);
+            });
+        }
+    }
+}
+
+void PluginScannerWorker::handleConnectionLost()
+{
+    // This may be called while the message thread is stuck inside a plugin that the scanner
+    // has given up on, so there's no point trying to quit cleanly..
+    Process::terminate();
+}
+
+void PluginScannerWorker::scanFile (const String& formatName, const String& fileOrIdentifier)
+{
+    OwnedArray<PluginDescription> found;
+
+    for (auto* format : formatManager.getFormats())
+        if (format->getName() == formatName)
+            format->findAllTypesForFile (found, fileOrIdentifier);
+
+    watchdog->scanFinished();
+    sendMessageToMaster (PluginScannerMessages::createScanResult (fileOrIdentifier, found));
+}
+
+} // namespace juce
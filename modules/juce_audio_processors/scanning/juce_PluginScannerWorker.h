@@ -0,0 +1,83 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    The worker end of an out-of-process plugin scan.
+
+    When a PluginDirectoryScanner has been given some OutOfProcessOptions, it
+    launches a set of child processes and asks each of them in turn to load a
+    plugin file and describe the types it contains. This class handles those
+    requests inside the child process.
+
+    To use it, create one of these in your worker app's startup code (this can
+    be your main app, launched with a special command-line), and call
+    initialiseFromCommandLine() with the same commandLineUniqueID that was given
+    to the scanner. If that returns true, the process should keep running its
+    message loop until the connection is lost, at which point the process will be
+    terminated.
+
+    The plugins are scanned on the message thread, because some formats require it.
+    If a scan takes longer than the scanner's timeout, the process terminates itself.
+
+    @see PluginDirectoryScanner::OutOfProcessOptions, ChildProcessSlave
+
+    @tags{Audio}
+*/
+class JUCE_API  PluginScannerWorker  : public ChildProcessSlave
+{
+public:
+    //==============================================================================
+    /** Creates a worker which will use the given formats to scan files.
+        The format manager must stay alive for as long as this object does.
+    */
+    explicit PluginScannerWorker (AudioPluginFormatManager& formatsToUse);
+
+    /** Destructor. */
+    ~PluginScannerWorker() override;
+
+    //==============================================================================
+    /** @internal */
+    void handleMessageFromMaster (const MemoryBlock&) override;
+    /** Terminates the process when the scanner has gone away, or has given up waiting for it. */
+    void handleConnectionLost() override;
+
+private:
+    //==============================================================================
+    AudioPluginFormatManager& formatManager;
+
+    struct Watchdog;
+    std::unique_ptr<Watchdog> watchdog;
+
+    void scanFile (const String& formatName, const String& fileOrIdentifier);
+
+    JUCE_DECLARE_WEAK_REFERENCEABLE (PluginScannerWorker)
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PluginScannerWorker)
+};
+
+} // namespace juce
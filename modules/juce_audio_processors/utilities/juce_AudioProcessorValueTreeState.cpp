@@ -75,6 +75,59 @@ void AudioProcessorValueTreeState::Parameter::valueChanged (float newValue)
         onValueChanged();
 }
 
+//==============================================================================
+/*  Holds a bit for each parameter adapter, which gets set whenever the parameter's value
+    changes, so that flushing the values to the tree only has to visit the parameters that
+    have changed, rather than all of them. The bits can be set on any thread without locking.
+*/
+class AudioProcessorValueTreeState::ChangedParameterFlags
+{
+public:
+    // This mustn't be called while the flags are being used on another thread
+    void setNumFlags (int numFlags)
+    {
+        auto numWordsNeeded = ((size_t) numFlags + bitsPerWord - 1) / bitsPerWord;
+
+        if (numWordsNeeded <= numWords)
+            return;
+
+        auto newNumWords = jmax (numWordsNeeded, numWords * 2);
+        std::unique_ptr<std::atomic<uint64>[]> newWords (new std::atomic<uint64>[newNumWords]);
+
+        for (size_t i = 0; i < newNumWords; ++i)
+            newWords[i] = (i < numWords ? words[i].load() : 0);
+
+        words = std::move (newWords);
+        numWords = newNumWords;
+    }
+
+    void set (int index) noexcept
+    {
+        jassert (isPositiveAndBelow ((size_t) index, numWords * bitsPerWord));
+        words[(size_t) index / bitsPerWord].fetch_or ((uint64) 1 << ((size_t) index % bitsPerWord));
+    }
+
+    // Clears all the flags, calling the function for each one that was set
+    template <typename Fn>
+    void clearAll (Fn&& fn)
+    {
+        for (size_t i = 0; i < numWords; ++i)
+        {
+            for (auto bits = words[i].exchange (0); bits != 0; bits &= bits - 1)
+            {
+                auto lowestBit = bits & (~bits + 1);
+                fn ((int) (i * bitsPerWord) + countNumberOfBits (lowestBit - 1));
+            }
+        }
+    }
+
+private:
+    static constexpr size_t bitsPerWord = 64;
+
+    std::unique_ptr<std::atomic<uint64>[]> words;
+    size_t numWords = 0;
+};
+
 //==============================================================================
 class AudioProcessorValueTreeState::ParameterAdapter   : private AudioProcessorParameter::Listener
 {
@@ -126,6 +179,15 @@ public:
     float getDenormalisedValue() const                { return unnormalisedValue; }
     std::atomic<float>& getRawDenormalisedValue()     { return unnormalisedValue; }
 
+    void setChangedFlag (ChangedParameterFlags& flags, int index)
+    {
+        changedFlags = &flags;
+        changedFlagIndex = index;
+
+        if (needsUpdate)
+            flags.set (index);
+    }
+
     bool flushToTree (const Identifier& key, UndoManager* um)
     {
         auto needsUpdateTestValue = true;
@@ -165,6 +227,9 @@ private:
         listeners.call ([=] (Listener& l) { l.parameterChanged (parameter.paramID, unnormalisedValue); });
         listenersNeedCalling = false;
         needsUpdate = true;
+
+        if (changedFlags != nullptr)
+            changedFlags->set (changedFlagIndex);
     }
 
     float denormalise (float normalised) const
@@ -217,6 +282,8 @@ private:
     std::atomic<float> unnormalisedValue { 0.0f };
     std::atomic<bool> needsUpdate { true }, listenersNeedCalling { true };
     bool ignoreParameterChangedCallbacks { false };
+    ChangedParameterFlags* changedFlags = nullptr;
+    int changedFlagIndex = 0;
 };
 
 //==============================================================================
@@ -278,7 +345,7 @@ AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& proc
 }
 
 AudioProcessorValueTreeState::AudioProcessorValueTreeState (AudioProcessor& p, UndoManager* um)
-    : processor (p), undoManager (um)
+    : processor (p), undoManager (um), changedParameters (new ChangedParameterFlags())
 {
     startTimerHz (10);
     state.addListener (this);
@@ -338,7 +405,17 @@ RangedAudioParameter* AudioProcessorValueTreeState::createAndAddParameter (std::
 //==============================================================================
 void AudioProcessorValueTreeState::addParameterAdapter (RangedAudioParameter& param)
 {
-    adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+    auto inserted = adapterTable.emplace (param.paramID, std::make_unique<ParameterAdapter> (param));
+
+    if (! inserted.second)
+        return;
+
+    auto& adapter = *inserted.first->second;
+    auto index = (int) adaptersInOrder.size();
+
+    changedParameters->setNumFlags (index + 1);
+    adapter.setChangedFlag (*changedParameters, index);
+    adaptersInOrder.push_back (&adapter);
 }
 
 AudioProcessorValueTreeState::ParameterAdapter* AudioProcessorValueTreeState::getParameterAdapter (StringRef paramID) const
@@ -469,8 +546,10 @@ bool AudioProcessorValueTreeState::flushParameterValuesToValueTree()
 
     bool anyUpdated = false;
 
-    for (auto& p : adapterTable)
-        anyUpdated |= p.second->flushToTree (valuePropertyID, undoManager);
+    changedParameters->clearAll ([this, &anyUpdated] (int index)
+    {
+        anyUpdated |= adaptersInOrder[(size_t) index]->flushToTree (valuePropertyID, undoManager);
+    });
 
     return anyUpdated;
 }
@@ -951,6 +1030,51 @@ public:
             expectEquals (listener.value, newValue);
             expectEquals (listener.id, String (key));
         }
+
+        beginTest ("When many parameters exist, only the changed ones are flushed to the tree");
+        {
+            struct PropertyCounter final : public ValueTree::Listener
+            {
+                void valueTreePropertyChanged (ValueTree&, const Identifier&) override    { ++numChanges; }
+                int numChanges = 0;
+            };
+
+            const int numParameters = 1000;
+            ParameterLayout layout;
+
+            for (int i = 0; i < numParameters; ++i)
+                layout.add (std::make_unique<Parameter> (String (i), String(), String(), NormalisableRange<float> (0.0f, 1.0f),
+                                                         0.0f, nullptr, nullptr));
+
+            TestAudioProcessor proc (std::move (layout));
+            proc.state.copyState();
+
+            PropertyCounter counter;
+            proc.state.state.addListener (&counter);
+
+            const int changedIndexes[] = { 0, 63, 64, 999 };
+
+            for (auto index : changedIndexes)
+                proc.state.getParameter (String (index))->setValueNotifyingHost (0.5f);
+
+            const auto copied = proc.state.copyState();
+            expectEquals (counter.numChanges, numElementsInArray (changedIndexes));
+
+            const auto getCopiedValue = [&] (int index)
+            {
+                return (float) copied.getChildWithProperty ("id", String (index)).getProperty ("value");
+            };
+
+            for (auto index : changedIndexes)
+                expectEquals (getCopiedValue (index), 0.5f);
+
+            expectEquals (getCopiedValue (1), 0.0f);
+
+            proc.state.copyState();
+            expectEquals (counter.numChanges, numElementsInArray (changedIndexes));
+
+            proc.state.state.removeListener (&counter);
+        }
     }
 };
 
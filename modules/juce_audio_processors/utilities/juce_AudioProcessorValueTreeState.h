@@ -363,6 +363,7 @@ public:
 private:
     //==============================================================================
     class ParameterAdapter;
+    class ChangedParameterFlags;
 
 public:
     //==============================================================================
@@ -548,7 +549,9 @@ private:
         bool operator() (StringRef a, StringRef b) const noexcept { return a.text.compare (b.text) < 0; }
     };
 
+    std::unique_ptr<ChangedParameterFlags> changedParameters;
     std::map<StringRef, std::unique_ptr<ParameterAdapter>, StringRefLessThan> adapterTable;
+    std::vector<ParameterAdapter*> adaptersInOrder;
 
     CriticalSection valueTreeChanging;
 
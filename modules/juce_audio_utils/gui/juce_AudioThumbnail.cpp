@@ -76,9 +76,6 @@ struct AudioThumbnail::MinMaxValue
                      std::abs ((int) values[1]));
     }
 
-    inline void read (InputStream& input)      { input.read (values, 2); }
-    inline void write (OutputStream& output)   { output.write (values, 2); }
-
 private:
     int8 values[2];
 };
@@ -88,18 +85,24 @@ class AudioThumbnail::LevelDataSource   : public TimeSliceClient
 {
 public:
     LevelDataSource (AudioThumbnail& thumb, AudioFormatReader* newReader, int64 hash)
-        : hashCode (hash), owner (thumb), reader (newReader)
+        : hashCode (hash), owner (thumb), thread (thumb.cache.getLeastBusyThread()), reader (newReader)
     {
+        sourceVersion = makeSourceVersion (reader->lengthInSamples, (int64) reader->sampleRate);
     }
 
     LevelDataSource (AudioThumbnail& thumb, InputSource* src)
-        : hashCode (src->hashCode()), owner (thumb), source (src)
+        : hashCode (src->hashCode()), owner (thumb), thread (thumb.cache.getLeastBusyThread()), source (src)
     {
+        // A FileInputSource's hash code may only depend on the path, so the file's size
+        // and modification time are used to spot saved levels for an older version of it
+        if (auto* fileSource = dynamic_cast<FileInputSource*> (src))
+            sourceVersion = makeSourceVersion (fileSource->getFile().getSize(),
+                                               fileSource->getFile().getLastModificationTime().toMilliseconds());
     }
 
     ~LevelDataSource() override
     {
-        owner.cache.getTimeSliceThread().removeTimeSliceClient (this);
+        thread.removeTimeSliceClient (this);
     }
 
     enum { timeBeforeDeletingReader = 3000 };
@@ -121,7 +124,7 @@ public:
             if (lengthInSamples <= 0 || isFullyLoaded())
                 reader.reset();
             else
-                owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+                thread.addTimeSliceClient (this);
         }
     }
 
@@ -136,7 +139,7 @@ public:
             if (reader != nullptr)
             {
                 lastReaderUseTime = Time::getMillisecondCounter();
-                owner.cache.getTimeSliceThread().addTimeSliceClient (this);
+                thread.addTimeSliceClient (this);
             }
         }
 
@@ -208,18 +211,38 @@ public:
     unsigned int numChannels = 0;
     int64 hashCode = 0;
 
+    // This is saved with the levels, and if it isn't zero, saved levels with a different
+    // version won't be loaded
+    int64 sourceVersion = 0;
+
 private:
     AudioThumbnail& owner;
+    TimeSliceThread& thread;
     std::unique_ptr<InputSource> source;
+
+    static int64 makeSourceVersion (int64 a, int64 b) noexcept
+    {
+        return (int64) (((uint64) a * 1000003) ^ (uint64) b) | 1;
+    }
+
     std::unique_ptr<AudioFormatReader> reader;
+    AudioBuffer<float> readBuffer;
     CriticalSection readerLock;
     std::atomic<uint32> lastReaderUseTime { 0 };
 
     void createReader()
     {
         if (reader == nullptr && source != nullptr)
-            if (auto* audioFileStream = source->createInputStream())
-                reader.reset (owner.formatManagerToUse.createReaderFor (std::unique_ptr<InputStream> (audioFileStream)));
+        {
+            // Files are opened by name where possible, so that the format manager's
+            // decoded block cache can be shared with other readers of the same file
+            if (auto* fileSource = dynamic_cast<FileInputSource*> (source.get()))
+                reader.reset (owner.formatManagerToUse.createReaderFor (fileSource->getFile()));
+
+            if (reader == nullptr)
+                if (auto* audioFileStream = source->createInputStream())
+                    reader.reset (owner.formatManagerToUse.createReaderFor (std::unique_ptr<InputStream> (audioFileStream)));
+        }
     }
 
     bool readNextBlock()
@@ -244,15 +267,19 @@ private:
                 for (int i = 0; i < (int) numChannels; ++i)
                     levels[i] = levelData + i * numThumbSamps;
 
-                HeapBlock<Range<float>> levelsRead (numChannels);
+                // Reading the whole section in one go and then scanning it with the vectorised
+                // findMinAndMax() is much quicker than asking the reader for each value separately
+                auto numSamplesToRead = numThumbSamps * owner.samplesPerThumbSample;
+                readBuffer.setSize ((int) numChannels, numSamplesToRead, false, false, true);
+                reader->read (&readBuffer, 0, numSamplesToRead, firstThumbIndex * (int64) owner.samplesPerThumbSample, true, true);
 
-                for (int i = 0; i < numThumbSamps; ++i)
+                for (int j = 0; j < (int) numChannels; ++j)
                 {
-                    reader->readMaxLevels ((firstThumbIndex + i) * owner.samplesPerThumbSample,
-                                           owner.samplesPerThumbSample, levelsRead, (int) numChannels);
+                    auto* samples = readBuffer.getReadPointer (j);
 
-                    for (int j = 0; j < (int) numChannels; ++j)
-                        levels[j][i].setFloat (levelsRead[j]);
+                    for (int i = 0; i < numThumbSamps; ++i)
+                        levels[j][i].setFloat (FloatVectorOperations::findMinAndMax (samples + i * owner.samplesPerThumbSample,
+                                                                                     owner.samplesPerThumbSample));
                 }
 
                 {
@@ -270,43 +297,43 @@ private:
 };
 
 //==============================================================================
+/*  As well as the full-resolution levels, this keeps a pyramid of coarser copies,
+    where each value covers mipFactor values from the level above. That means that
+    finding the min and max of a long section of a long file (e.g. when a whole
+    file is being drawn) only has to look at a handful of values, rather than scanning
+    every one of them.
+*/
 class AudioThumbnail::ThumbData
 {
 public:
     ThumbData (int numThumbSamples)
+        : levels (1)
     {
         ensureSize (numThumbSamples);
     }
 
-    inline MinMaxValue* getData (int thumbSampleIndex) noexcept
+    inline const MinMaxValue* getData (int thumbSampleIndex) const noexcept
     {
-        jassert (thumbSampleIndex < data.size());
-        return data.getRawDataPointer() + thumbSampleIndex;
+        jassert (thumbSampleIndex < getSize());
+        return levels[0].getRawDataPointer() + thumbSampleIndex;
     }
 
     int getSize() const noexcept
     {
-        return data.size();
+        return levels[0].size();
     }
 
     void getMinMax (int startSample, int endSample, MinMaxValue& result) const noexcept
     {
         if (startSample >= 0)
         {
-            endSample = jmin (endSample, data.size() - 1);
+            endSample = jmin (endSample, getSize() - 1);
 
             int8 mx = -128;
             int8 mn = 127;
 
-            while (startSample <= endSample)
-            {
-                auto& v = data.getReference (startSample);
-
-                if (v.getMinValue() < mn)  mn = v.getMinValue();
-                if (v.getMaxValue() > mx)  mx = v.getMaxValue();
-
-                ++startSample;
-            }
+            if (startSample <= endSample)
+                findMinMax (0, startSample, endSample + 1, mn, mx);
 
             if (mn <= mx)
             {
@@ -322,13 +349,15 @@ public:
     {
         resetPeak();
 
-        if (startIndex + numValues > data.size())
+        if (startIndex + numValues > getSize())
             ensureSize (startIndex + numValues);
 
-        auto* dest = getData (startIndex);
+        auto* dest = levels[0].getRawDataPointer() + startIndex;
 
         for (int i = 0; i < numValues; ++i)
             dest[i] = values[i];
+
+        updateMipLevels (startIndex, startIndex + numValues);
     }
 
     void resetPeak() noexcept
@@ -340,7 +369,8 @@ public:
     {
         if (peakLevel < 0)
         {
-            for (auto& s : data)
+            // The coarsest level has the same overall peak as the full-resolution data
+            for (auto& s : levels.back())
             {
                 auto peak = s.getPeak();
 
@@ -353,15 +383,85 @@ public:
     }
 
 private:
-    Array<MinMaxValue> data;
+    enum { mipFactor = 16 };
+
+    std::vector<Array<MinMaxValue>> levels;
     int peakLevel = -1;
 
     void ensureSize (int thumbSamples)
     {
-        auto extraNeeded = thumbSamples - data.size();
+        auto oldSize = getSize();
+        auto extraNeeded = thumbSamples - oldSize;
 
         if (extraNeeded > 0)
-            data.insertMultiple (-1, MinMaxValue(), extraNeeded);
+        {
+            levels[0].insertMultiple (-1, MinMaxValue(), extraNeeded);
+            updateMipLevels (jmax (0, oldSize - 1), thumbSamples);
+        }
+    }
+
+    // Recalculates the coarser values that cover the range [start, end) of the full-resolution data
+    void updateMipLevels (int start, int end)
+    {
+        for (size_t level = 1; levels[level - 1].size() > mipFactor; ++level)
+        {
+            if (level == levels.size())
+            {
+                levels.emplace_back();
+                start = 0;
+                end = levels[level - 1].size();
+            }
+
+            auto& finer = levels[level - 1];
+            auto& coarser = levels[level];
+
+            auto coarserSize = (finer.size() + mipFactor - 1) / mipFactor;
+
+            if (coarser.size() < coarserSize)
+                coarser.insertMultiple (-1, MinMaxValue(), coarserSize - coarser.size());
+
+            start /= mipFactor;
+            end = (end + mipFactor - 1) / mipFactor;
+
+            for (int i = start; i < end; ++i)
+            {
+                int8 mx = -128;
+                int8 mn = 127;
+                scan (finer, i * mipFactor, jmin ((i + 1) * mipFactor, finer.size()), mn, mx);
+                coarser.getReference (i).set (mn, mx);
+            }
+        }
+    }
+
+    void findMinMax (size_t level, int start, int end, int8& mn, int8& mx) const noexcept
+    {
+        auto& values = levels[level];
+
+        // Any whole groups of values in the middle of the range can be taken from the next level
+        if (level + 1 < levels.size() && end - start >= 2 * mipFactor)
+        {
+            auto coarserStart = (start + mipFactor - 1) / mipFactor;
+            auto coarserEnd = end / mipFactor;
+
+            scan (values, start, coarserStart * mipFactor, mn, mx);
+            findMinMax (level + 1, coarserStart, coarserEnd, mn, mx);
+            scan (values, coarserEnd * mipFactor, end, mn, mx);
+        }
+        else
+        {
+            scan (values, start, end, mn, mx);
+        }
+    }
+
+    static void scan (const Array<MinMaxValue>& values, int start, int end, int8& mn, int8& mx) noexcept
+    {
+        for (int i = start; i < end; ++i)
+        {
+            auto& v = values.getReference (i);
+
+            if (v.getMinValue() < mn)  mn = v.getMinValue();
+            if (v.getMaxValue() > mx)  mx = v.getMaxValue();
+        }
     }
 };
 
@@ -557,6 +657,7 @@ void AudioThumbnail::clear()
 {
     source.reset();
     const ScopedLock sl (lock);
+    sourceVersion = 0;
     clearChannelData();
 }
 
@@ -592,7 +693,15 @@ void AudioThumbnail::createChannels (const int length)
 //==============================================================================
 bool AudioThumbnail::loadFrom (InputStream& rawInput)
 {
-    BufferedInputStream input (rawInput, 4096);
+    // Memory streams (like the cache's entries, or a memory-mapped peak file) are read
+    // in place, rather than being copied into a buffer first
+    auto* memoryInput = dynamic_cast<MemoryInputStream*> (&rawInput);
+    std::unique_ptr<BufferedInputStream> bufferedInput;
+
+    if (memoryInput == nullptr)
+        bufferedInput.reset (new BufferedInputStream (rawInput, 4096));
+
+    InputStream& input = bufferedInput != nullptr ? *bufferedInput : rawInput;
 
     if (input.readByte() != 'j' || input.readByte() != 'a' || input.readByte() != 't' || input.readByte() != 'm')
         return false;
@@ -600,19 +709,64 @@ bool AudioThumbnail::loadFrom (InputStream& rawInput)
     const ScopedLock sl (lock);
     clearChannelData();
 
-    samplesPerThumbSample = input.readInt();
-    totalSamples = input.readInt64();             // Total number of source samples.
-    numSamplesFinished = input.readInt64();       // Number of valid source samples that have been read into the thumbnail.
-    int32 numThumbnailSamples = input.readInt();  // Number of samples in the thumbnail data.
-    numChannels = input.readInt();                // Number of audio channels.
-    sampleRate = input.readInt();                 // Source sample rate.
-    input.skipNextBytes (16);                     // (reserved)
+    auto newSamplesPerThumbSample = input.readInt();
+    auto newTotalSamples = input.readInt64();         // Total number of source samples.
+    auto newNumSamplesFinished = input.readInt64();   // Number of valid source samples that have been read into the thumbnail.
+    int32 numThumbnailSamples = input.readInt();      // Number of samples in the thumbnail data.
+    auto newNumChannels = input.readInt();            // Number of audio channels.
+    auto newSampleRate = input.readInt();             // Source sample rate.
+    auto savedSourceVersion = input.readInt64();      // Identifies the version of the source that was scanned, or 0 if unknown.
+    input.skipNextBytes (8);                          // (reserved)
+
+    // The values are interleaved, so read them all at once and then split them up
+    // into the channels, rather than reading each one from the stream separately
+    const auto numBytes = (size_t) numThumbnailSamples * (size_t) newNumChannels * 2;
+    const int8* raw = nullptr;
+    MemoryBlock interleaved;
+
+    if (newSamplesPerThumbSample > 0 && numThumbnailSamples >= 0 && newNumChannels >= 0
+         && (sourceVersion == 0 || savedSourceVersion == 0 || savedSourceVersion == sourceVersion))
+    {
+        if (memoryInput != nullptr)
+        {
+            auto position = (size_t) memoryInput->getPosition();
+
+            if (memoryInput->getDataSize() - position >= numBytes)
+                raw = static_cast<const int8*> (memoryInput->getData()) + position;
+
+            memoryInput->skipNextBytes ((int64) numBytes);
+        }
+        else if ((size_t) input.readIntoMemoryBlock (interleaved, (ssize_t) numBytes) == numBytes)
+        {
+            raw = static_cast<const int8*> (interleaved.getData());
+        }
+    }
+
+    // Nothing's changed until the data has been validated, so that a failed load
+    // leaves the thumbnail empty, with its original settings
+    if (raw == nullptr)
+        return false;
+
+    samplesPerThumbSample = newSamplesPerThumbSample;
+    totalSamples = newTotalSamples;
+    numSamplesFinished = newNumSamplesFinished;
+    numChannels = newNumChannels;
+    sampleRate = newSampleRate;
 
     createChannels (numThumbnailSamples);
 
-    for (int i = 0; i < numThumbnailSamples; ++i)
-        for (int chan = 0; chan < numChannels; ++chan)
-            channels.getUnchecked(chan)->getData(i)->read (input);
+    HeapBlock<MinMaxValue> channelValues (numThumbnailSamples);
+
+    for (int chan = 0; chan < numChannels; ++chan)
+    {
+        for (int i = 0; i < numThumbnailSamples; ++i)
+        {
+            auto* v = raw + 2 * (i * numChannels + chan);
+            channelValues[i].set (v[0], v[1]);
+        }
+
+        channels.getUnchecked (chan)->write (channelValues, 0, numThumbnailSamples);
+    }
 
     return true;
 }
@@ -630,12 +784,24 @@ void AudioThumbnail::saveTo (OutputStream& output) const
     output.writeInt (numThumbnailSamples);
     output.writeInt (numChannels);
     output.writeInt ((int) sampleRate);
-    output.writeInt64 (0);
+    output.writeInt64 (sourceVersion);
     output.writeInt64 (0);
 
-    for (int i = 0; i < numThumbnailSamples; ++i)
-        for (int chan = 0; chan < numChannels; ++chan)
-            channels.getUnchecked(chan)->getData(i)->write (output);
+    HeapBlock<int8> interleaved ((size_t) numThumbnailSamples * (size_t) numChannels * 2);
+
+    for (int chan = 0; chan < numChannels && numThumbnailSamples > 0; ++chan)
+    {
+        auto* values = channels.getUnchecked (chan)->getData (0);
+
+        for (int i = 0; i < numThumbnailSamples; ++i)
+        {
+            auto* dest = interleaved + 2 * (i * numChannels + chan);
+            dest[0] = values[i].getMinValue();
+            dest[1] = values[i].getMaxValue();
+        }
+    }
+
+    output.write (interleaved, (size_t) numThumbnailSamples * (size_t) numChannels * 2);
 }
 
 //==============================================================================
@@ -644,6 +810,7 @@ bool AudioThumbnail::setDataSource (LevelDataSource* newSource)
     JUCE_ASSERT_MESSAGE_MANAGER_IS_LOCKED
 
     numSamplesFinished = 0;
+    sourceVersion = newSource->sourceVersion;
     auto wasSuccessful = [&] { return sampleRate > 0 && totalSamples > 0; };
 
     if (cache.loadThumb (*this, newSource->hashCode) && isFullyLoaded())
@@ -823,4 +990,209 @@ void AudioThumbnail::drawChannels (Graphics& g, const Rectangle<int>& area, doub
     }
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class AudioThumbnailTests  : public UnitTest
+{
+public:
+    AudioThumbnailTests()
+        : UnitTest ("AudioThumbnail", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        formatManager.registerBasicFormats();
+        auto random = getRandom();
+
+        beginTest ("Min/max queries match a scan of the full-resolution data");
+        {
+            AudioThumbnailCache cache (1);
+            AudioThumbnail thumb (samplesPerThumbSample, formatManager, cache);
+
+            const int numSamples = 200000;
+            auto audio = createRandomAudio (random, numSamples);
+
+            thumb.reset (1, sampleRate, numSamples);
+
+            for (int pos = 0; pos < numSamples;)
+            {
+                auto num = jmin (numSamples - pos, 1 + random.nextInt (5000));
+                thumb.addBlock (pos, audio, pos, num);
+                pos += num;
+            }
+
+            const int numThumbSamples = numSamples / samplesPerThumbSample;
+            Array<Range<float>> values;
+
+            for (int i = 0; i < numThumbSamples; ++i)
+                values.add (getMinMax (thumb, i, i));
+
+            for (int i = 0; i < 2000; ++i)
+            {
+                auto first = random.nextInt (numThumbSamples);
+                auto maxLength = (i % 2 == 0) ? 100 : numThumbSamples;
+                auto last = jmin (numThumbSamples - 1, first + random.nextInt (maxLength));
+
+                auto expected = values[first];
+
+                for (int j = first + 1; j <= last; ++j)
+                    expected = expected.getUnionWith (values.getReference (j));
+
+                auto result = getMinMax (thumb, first, last);
+                expectEquals (result.getStart(), expected.getStart());
+                expectEquals (result.getEnd(), expected.getEnd());
+            }
+        }
+
+        beginTest ("Peak files are reloaded, unless the source has changed");
+        {
+            TemporaryFile audioFile (".wav");
+            auto file = audioFile.getFile();
+            auto peakDirectory = File::getSpecialLocation (File::tempDirectory)
+                                   .getNonexistentChildFile ("peaks", {}, false);
+
+            writeFile (file, createRandomAudio (random, 50000));
+
+            Array<Range<float>> originalValues;
+            File peakFile;
+            int64 originalPeakFileSize = 0;
+
+            {
+                AudioThumbnailCache cache (1);
+                cache.setPeakFileDirectory (peakDirectory);
+                AudioThumbnail thumb (samplesPerThumbSample, formatManager, cache);
+
+                expect (thumb.setSource (new FileInputSource (file)));
+                peakFile = cache.getPeakFileFor (thumb.getHashCode());
+                expect (waitUntil ([&] { return thumb.isFullyLoaded() && peakFile.existsAsFile(); }));
+                originalPeakFileSize = peakFile.getSize();
+
+                for (int i = 0; i < 100; ++i)
+                    originalValues.add (getMinMax (thumb, i * 100, i * 100 + 99));
+            }
+
+            {
+                AudioThumbnailCache cache (1);
+                cache.setPeakFileDirectory (peakDirectory);
+                AudioThumbnail thumb (samplesPerThumbSample, formatManager, cache);
+
+                expect (thumb.setSource (new FileInputSource (file)));
+                expect (thumb.isFullyLoaded());
+                expectEquals (thumb.getTotalLength(), 50000 / sampleRate);
+
+                for (int i = 0; i < 100; ++i)
+                    expect (getMinMax (thumb, i * 100, i * 100 + 99) == originalValues[i]);
+            }
+
+            writeFile (file, createRandomAudio (random, 30000));
+            file.setLastModificationTime (Time::getCurrentTime() + RelativeTime::minutes (1));
+
+            for (int i = 0; i < 2; ++i)
+            {
+                AudioThumbnailCache cache (1);
+                cache.setPeakFileDirectory (peakDirectory);
+                AudioThumbnail thumb (samplesPerThumbSample, formatManager, cache);
+
+                // The first time round, the stale peak file must be ignored and the file
+                // rescanned, and the second time, the rewritten peak file is loaded
+                expect (thumb.setSource (new FileInputSource (file)));
+                expectEquals (thumb.getTotalLength(), 30000 / sampleRate);
+
+                if (i == 0)
+                    expect (waitUntil ([&] { return thumb.isFullyLoaded() && peakFile.getSize() != originalPeakFileSize; }));
+                else
+                    expect (thumb.isFullyLoaded());
+            }
+
+            peakDirectory.deleteRecursively();
+        }
+
+        beginTest ("Data saved without a source version can still be loaded");
+        {
+            TemporaryFile audioFile (".wav");
+            auto file = audioFile.getFile();
+            writeFile (file, createRandomAudio (random, 20000));
+
+            AudioThumbnailCache cache (1);
+            AudioThumbnail thumb (samplesPerThumbSample, formatManager, cache);
+
+            expect (thumb.setSource (new FileInputSource (file)));
+            expect (waitUntil ([&] { return thumb.isFullyLoaded(); }));
+
+            MemoryOutputStream saved;
+            thumb.saveTo (saved);
+
+            // Older versions wrote zeroes where the source version now goes
+            MemoryBlock data (saved.getData(), saved.getDataSize());
+            auto* version = static_cast<char*> (data.getData()) + 36;
+            std::fill (version, version + 8, 0);
+
+            MemoryInputStream oldData (data, false);
+            expect (thumb.loadFrom (oldData));
+            expectEquals (thumb.getTotalLength(), 20000 / sampleRate);
+
+            // ..but data from a different version of the source is rejected
+            std::fill (version, version + 8, 1);
+
+            MemoryInputStream staleData (data, false);
+            expect (! thumb.loadFrom (staleData));
+        }
+    }
+
+private:
+    static constexpr int samplesPerThumbSample = 4;
+    static constexpr double sampleRate = 1024.0;
+
+    AudioFormatManager formatManager;
+
+    static AudioBuffer<float> createRandomAudio (Random& random, int numSamples)
+    {
+        AudioBuffer<float> audio (1, numSamples);
+
+        // Vary the level, so that the ranges don't all end up with the same min and max
+        for (int i = 0; i < numSamples; ++i)
+            audio.setSample (0, i, (random.nextFloat() * 2.0f - 1.0f) * random.nextFloat());
+
+        return audio;
+    }
+
+    static Range<float> getMinMax (const AudioThumbnail& thumb, int firstThumbIndex, int lastThumbIndex)
+    {
+        float minValue, maxValue;
+        thumb.getApproximateMinMax (firstThumbIndex * samplesPerThumbSample / sampleRate,
+                                    lastThumbIndex * samplesPerThumbSample / sampleRate,
+                                    0, minValue, maxValue);
+        return { minValue, maxValue };
+    }
+
+    static void writeFile (const File& file, const AudioBuffer<float>& audio)
+    {
+        file.deleteFile();
+        WavAudioFormat wav;
+
+        std::unique_ptr<AudioFormatWriter> writer (wav.createWriterFor (file.createOutputStream().release(),
+                                                                        sampleRate, 1, 16, {}, 0));
+        writer->writeFromAudioSampleBuffer (audio, 0, audio.getNumSamples());
+    }
+
+    template <typename Condition>
+    static bool waitUntil (Condition&& condition)
+    {
+        for (int i = 0; i < 1000; ++i)
+        {
+            if (condition())
+                return true;
+
+            Thread::sleep (10);
+        }
+
+        return false;
+    }
+};
+
+static AudioThumbnailTests audioThumbnailTests;
+
+#endif
+
 } // namespace juce
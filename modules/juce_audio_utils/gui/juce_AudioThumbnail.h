@@ -41,7 +41,8 @@ namespace juce
     listeners should repaint themselves.
 
     The thumbnail stores an internal low-res version of the wave data, and this can
-    be loaded and saved to avoid having to scan the file again.
+    be loaded and saved to avoid having to scan the file again. If the
+    AudioThumbnailCache has a peak file directory, this happens automatically.
 
     @see AudioThumbnailCache, AudioThumbnailBase
 
@@ -116,6 +117,11 @@ public:
 
         This is not an audio file stream! It takes a stream of thumbnail data that would
         previously have been created by the saveTo() method.
+
+        If the thumbnail has a source, and the data was saved from a different version of
+        it (e.g. a file that has been modified since), this fails. Data saved by older
+        versions of JUCE doesn't say which version of the source it came from, so it's
+        always accepted.
         @see saveTo
     */
     bool loadFrom (InputStream& input) override;
@@ -209,6 +215,7 @@ private:
     int64 numSamplesFinished = 0;
     int32 numChannels = 0;
     double sampleRate = 0;
+    int64 sourceVersion = 0;
     CriticalSection lock;
 
     void clearChannelData();
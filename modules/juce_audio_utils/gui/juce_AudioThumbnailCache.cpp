@@ -59,18 +59,31 @@ private:
 };
 
 //==============================================================================
-AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs)
-    : thread ("thumb cache"),
-      maxNumThumbsToStore (maxNumThumbs)
+AudioThumbnailCache::AudioThumbnailCache (const int maxNumThumbs, const int numThreads)
+    : maxNumThumbsToStore (maxNumThumbs)
 {
     jassert (maxNumThumbsToStore > 0);
-    thread.startThread (2);
+    jassert (numThreads > 0);
+
+    for (int i = 0; i < jmax (1, numThreads); ++i)
+        threads.add (new TimeSliceThread ("thumb cache"))->startThread (2);
 }
 
 AudioThumbnailCache::~AudioThumbnailCache()
 {
 }
 
+TimeSliceThread& AudioThumbnailCache::getLeastBusyThread() noexcept
+{
+    auto* leastBusy = threads.getUnchecked (0);
+
+    for (auto* t : threads)
+        if (t->getNumClients() < leastBusy->getNumClients())
+            leastBusy = t;
+
+    return *leastBusy;
+}
+
 AudioThumbnailCache::ThumbnailCacheEntry* AudioThumbnailCache::findThumbFor (const int64 hash) const
 {
     for (int i = thumbs.size(); --i >= 0;)
@@ -108,8 +121,7 @@ bool AudioThumbnailCache::loadThumb (AudioThumbnailBase& thumb, const int64 hash
         te->lastUsed = Time::getMillisecondCounter();
 
         MemoryInputStream in (te->data, false);
-        thumb.loadFrom (in);
-        return true;
+        return thumb.loadFrom (in);
     }
 
     return loadNewThumb (thumb, hashCode);
@@ -118,24 +130,26 @@ bool AudioThumbnailCache::loadThumb (AudioThumbnailBase& thumb, const int64 hash
 void AudioThumbnailCache::storeThumb (const AudioThumbnailBase& thumb,
                                       const int64 hashCode)
 {
-    const ScopedLock sl (lock);
-    ThumbnailCacheEntry* te = findThumbFor (hashCode);
-
-    if (te == nullptr)
     {
-        te = new ThumbnailCacheEntry (hashCode);
+        const ScopedLock sl (lock);
+        ThumbnailCacheEntry* te = findThumbFor (hashCode);
 
-        if (thumbs.size() < maxNumThumbsToStore)
-            thumbs.add (te);
-        else
-            thumbs.set (findOldestThumb(), te);
-    }
+        if (te == nullptr)
+        {
+            te = new ThumbnailCacheEntry (hashCode);
+
+            if (thumbs.size() < maxNumThumbsToStore)
+                thumbs.add (te);
+            else
+                thumbs.set (findOldestThumb(), te);
+        }
 
-    {
         MemoryOutputStream out (te->data, false);
         thumb.saveTo (out);
     }
 
+    // This may write a file, so it's done without holding the lock, to avoid blocking
+    // other threads that are loading thumbnails from memory
     saveNewlyFinishedThumbnail (thumb, hashCode);
 }
 
@@ -185,13 +199,69 @@ void AudioThumbnailCache::writeToStream (OutputStream& out)
         thumbs.getUnchecked(i)->write (out);
 }
 
-void AudioThumbnailCache::saveNewlyFinishedThumbnail (const AudioThumbnailBase&, int64)
+//==============================================================================
+void AudioThumbnailCache::setPeakFileDirectory (const File& directory)
 {
+    if (directory != File())
+        directory.createDirectory();
+
+    const ScopedLock sl (lock);
+    peakFileDirectory = directory;
 }
 
-bool AudioThumbnailCache::loadNewThumb (AudioThumbnailBase&, int64)
+File AudioThumbnailCache::getPeakFileDirectory() const
 {
-    return false;
+    const ScopedLock sl (lock);
+    return peakFileDirectory;
+}
+
+File AudioThumbnailCache::getPeakFileFor (int64 hashCode) const
+{
+    const ScopedLock sl (lock);
+
+    if (peakFileDirectory == File())
+        return {};
+
+    return peakFileDirectory.getChildFile (String::toHexString (hashCode) + ".peaks");
+}
+
+void AudioThumbnailCache::saveNewlyFinishedThumbnail (const AudioThumbnailBase& thumb, int64 hashCode)
+{
+    auto file = getPeakFileFor (hashCode);
+
+    if (file == File())
+        return;
+
+    // Write to a temporary file first, so that a half-written file can never be loaded
+    TemporaryFile temp (file);
+
+    if (auto out = temp.getFile().createOutputStream())
+    {
+        thumb.saveTo (*out);
+        out->flush();
+
+        if (out->getStatus().wasOk())
+        {
+            out.reset();
+            temp.overwriteTargetFileWithTemporary();
+        }
+    }
+}
+
+bool AudioThumbnailCache::loadNewThumb (AudioThumbnailBase& thumb, int64 hashCode)
+{
+    auto file = getPeakFileFor (hashCode);
+
+    if (! file.existsAsFile())
+        return false;
+
+    MemoryMappedFile mappedFile (file, MemoryMappedFile::readOnly);
+
+    if (mappedFile.getData() == nullptr)
+        return false;
+
+    MemoryInputStream in (mappedFile.getData(), mappedFile.getSize(), false);
+    return thumb.loadFrom (in);
 }
 
 } // namespace juce
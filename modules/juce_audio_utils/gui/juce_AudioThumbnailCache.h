@@ -30,10 +30,17 @@ namespace juce
 /**
     An instance of this class is used to manage multiple AudioThumbnail objects.
 
-    The cache runs a single background thread that is shared by all the thumbnails
-    that need it, and it maintains a set of low-res previews in memory, to avoid
+    The cache runs one or more background threads that are shared by all the thumbnails
+    that need them, and it maintains a set of low-res previews in memory, to avoid
     having to re-scan audio files too often.
 
+    If you give it a peak file directory, every thumbnail that finishes loading is
+    also saved there as a file, and will be reloaded from it the next time a thumbnail
+    with the same hash code is needed, even after the app has been restarted. The file
+    is memory-mapped, and the levels are read straight out of the mapping. For files,
+    AudioThumbnail also saves the file's size and modification time, so a peak file
+    for an older version of a file won't be used.
+
     @see AudioThumbnail
 
     @tags{Audio}
@@ -45,9 +52,11 @@ public:
     /** Creates a cache object.
 
         The maxNumThumbsToStore parameter lets you specify how many previews should
-        be kept in memory at once.
+        be kept in memory at once, and numThreads is the number of background threads
+        that are used to scan the audio, so that several thumbnails can be generated
+        at the same time.
     */
-    explicit AudioThumbnailCache (int maxNumThumbsToStore);
+    explicit AudioThumbnailCache (int maxNumThumbsToStore, int numThreads = 1);
 
     /** Destructor. */
     virtual ~AudioThumbnailCache();
@@ -86,23 +95,56 @@ public:
     */
     void writeToStream (OutputStream& stream);
 
+    //==============================================================================
+    /** Sets a directory in which the thumbnails are saved as peak files once they
+        have finished loading, so that they can be reloaded quickly later on.
+
+        The directory is created if it doesn't already exist. Pass File() to stop
+        using peak files. The files aren't deleted automatically, so you may want to
+        clean the directory up from time to time.
+
+        @see getPeakFileFor
+    */
+    void setPeakFileDirectory (const File& directory);
+
+    /** Returns the directory that was set with setPeakFileDirectory(). */
+    File getPeakFileDirectory() const;
+
+    /** Returns the peak file that's used for the thumbnail with the given hash code,
+        or File() if there's no peak file directory.
+    */
+    File getPeakFileFor (int64 hashCode) const;
+
+    //==============================================================================
     /** Returns the thread that client thumbnails can use. */
-    TimeSliceThread& getTimeSliceThread() noexcept      { return thread; }
+    TimeSliceThread& getTimeSliceThread() noexcept      { return *threads.getUnchecked (0); }
+
+    /** Returns whichever of the cache's threads has the fewest clients, which is where
+        a new thumbnail should do its scanning.
+    */
+    TimeSliceThread& getLeastBusyThread() noexcept;
 
 protected:
     /** This can be overridden to provide a custom callback for saving thumbnails
         once they have finished being loaded.
+
+        By default, this writes the thumbnail to its peak file, if there's a peak
+        file directory.
     */
     virtual void saveNewlyFinishedThumbnail (const AudioThumbnailBase&, int64 hashCode);
 
     /** This can be overridden to provide a custom callback for loading thumbnails
         from pre-saved files to save the cache the trouble of having to create them.
+
+        By default, this reloads the thumbnail from its peak file, if there's a peak
+        file directory and the file exists.
     */
     virtual bool loadNewThumb (AudioThumbnailBase&, int64 hashCode);
 
 private:
     //==============================================================================
-    TimeSliceThread thread;
+    OwnedArray<TimeSliceThread> threads;
+    File peakFileDirectory;
 
     class ThumbnailCacheEntry;
     OwnedArray<ThumbnailCacheEntry> thumbs;
@@ -62,6 +62,7 @@
 #include "gui/juce_AudioAppComponent.cpp"
 #include "players/juce_SoundPlayer.cpp"
 #include "players/juce_AudioProcessorPlayer.cpp"
+#include "players/juce_OfflineAudioRenderer.cpp"
 #include "audio_cd/juce_AudioCDReader.cpp"
 
 #if JUCE_MAC
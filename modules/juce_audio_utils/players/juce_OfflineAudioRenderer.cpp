@@ -0,0 +1,636 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+class OfflineAudioRenderer::PlayHead  : public AudioPlayHead
+{
+public:
+    explicit PlayHead (const Settings& s)  : settings (s) {}
+
+    void setPosition (int64 newPosition) noexcept   { position = newPosition; }
+
+    bool getCurrentPosition (CurrentPositionInfo& result) override
+    {
+        result.resetToDefault();
+
+        result.bpm                = settings.bpm;
+        result.timeSigNumerator   = settings.timeSigNumerator;
+        result.timeSigDenominator = settings.timeSigDenominator;
+        result.timeInSamples      = position;
+        result.timeInSeconds      = (double) position / settings.sampleRate;
+        result.ppqPosition        = result.timeInSeconds * settings.bpm / 60.0;
+        result.isPlaying          = true;
+
+        auto quarterNotesPerBar = settings.timeSigNumerator * 4.0 / settings.timeSigDenominator;
+        result.ppqPositionOfLastBarStart = std::floor (result.ppqPosition / quarterNotesPerBar) * quarterNotesPerBar;
+
+        return true;
+    }
+
+private:
+    const Settings& settings;
+    int64 position = 0;
+
+    JUCE_DECLARE_NON_COPYABLE (PlayHead)
+};
+
+//==============================================================================
+// The MidiBuffer's timestamps are ints, but the position on the timeline may not fit in one
+static void addMidiForBlock (MidiBuffer& dest, const MidiBuffer& source, int64 blockStart, int numSamples)
+{
+    const auto firstPosition = (int) jlimit ((int64) std::numeric_limits<int>::min(),
+                                             (int64) std::numeric_limits<int>::max(),
+                                             blockStart);
+
+    for (auto i = source.findNextSamplePosition (firstPosition); i != source.cend(); ++i)
+    {
+        const auto metadata = *i;
+        const auto offset = (int64) metadata.samplePosition - blockStart;
+
+        if (offset >= numSamples)
+            break;
+
+        if (offset >= 0)
+            dest.addEvent (metadata.data, metadata.numBytes, (int) offset);
+    }
+}
+
+//==============================================================================
+OfflineAudioRenderer::OfflineAudioRenderer (const Settings& s)
+    : settings (s)
+{
+    jassert (settings.sampleRate > 0 && settings.blockSize > 0);
+
+    // the writers need to be able to hold at least one block
+    jassert (settings.numSamplesToBuffer > settings.blockSize);
+
+    writerThread.startThread();
+}
+
+OfflineAudioRenderer::~OfflineAudioRenderer()
+{
+    writerThread.stopThread (4000);
+}
+
+double OfflineAudioRenderer::getProgress() const noexcept
+{
+    auto total = numSamplesToRender.load();
+
+    return total > 0 ? jmin (1.0, (double) numSamplesRendered.load() / (double) total)
+                     : 0.0;
+}
+
+//==============================================================================
+Result OfflineAudioRenderer::render (Job& job)
+{
+    numSamplesToRender += job.range.getLength();
+    return renderJob (job);
+}
+
+Result OfflineAudioRenderer::renderInParallel (const OwnedArray<Job>& jobs, ThreadPool& pool)
+{
+    for (auto* job : jobs)
+        numSamplesToRender += job->range.getLength();
+
+    std::vector<Result> results ((size_t) jobs.size(), Result::ok());
+
+    pool.parallelFor (0, jobs.size(), [&] (int i)
+    {
+        results[(size_t) i] = renderJob (*jobs.getUnchecked (i));
+    });
+
+    for (auto& r : results)
+        if (r.failed())
+            return r;
+
+    return Result::ok();
+}
+
+Result OfflineAudioRenderer::renderJob (Job& job)
+{
+    if (cancelled)
+        return Result::fail ("The render was cancelled");
+
+    if (job.writer == nullptr)
+        return Result::fail ("The job has no writer");
+
+    if (job.processor == nullptr && job.source == nullptr)
+        return Result::fail ("The job has nothing to render");
+
+    const auto numChannels = (int) job.writer->getNumChannels();
+
+    if (job.processor != nullptr && numChannels > job.processor->getTotalNumOutputChannels())
+        return Result::fail ("The writer has more channels than the processor has outputs");
+
+    jassert (job.writer->getSampleRate() == settings.sampleRate);
+
+    // The ThreadedWriter deletes the writer, once it has flushed everything to it
+    AudioFormatWriter::ThreadedWriter writer (job.writer.release(), writerThread, settings.numSamplesToBuffer);
+
+    return job.processor != nullptr ? renderProcessor (job, writer)
+                                    : renderSource (job, writer, numChannels);
+}
+
+//==============================================================================
+Result OfflineAudioRenderer::renderProcessor (Job& job, AudioFormatWriter::ThreadedWriter& writer)
+{
+    auto& processor = *job.processor;
+    const auto wasNonRealtime = processor.isNonRealtime();
+    auto* oldPlayHead = processor.getPlayHead();
+
+    auto automation = job.automation;
+    std::stable_sort (automation.begin(), automation.end(),
+                      [] (const AutomationEvent& a, const AutomationEvent& b)
+                      {
+                          return a.samplePosition < b.samplePosition;
+                      });
+
+    auto& parameters = processor.getParameters();
+    auto& parameterEvents = processor.getParameterEvents();
+    parameterEvents.ensureSize (jmin (automation.size(), 2048));
+    parameterEvents.clear();
+
+    // Any changes before the start of the range just give the parameters their initial values
+    int nextAutomationEvent = 0;
+
+    for (; nextAutomationEvent < automation.size(); ++nextAutomationEvent)
+    {
+        auto& event = automation.getReference (nextAutomationEvent);
+
+        if (event.samplePosition >= job.range.getStart())
+            break;
+
+        if (auto* parameter = parameters[event.parameterIndex])
+        {
+            parameter->setValue (event.value);
+            parameter->sendValueChangedMessageToListeners (event.value);
+        }
+    }
+
+    PlayHead playHead (settings);
+    processor.setNonRealtime (true);
+    processor.setPlayHead (&playHead);
+    processor.setRateAndBufferSizeDetails (settings.sampleRate, settings.blockSize);
+    processor.prepareToPlay (settings.sampleRate, settings.blockSize);
+
+    const auto numChannels = jmax (processor.getTotalNumInputChannels(), processor.getTotalNumOutputChannels());
+    const auto isDoublePrecision = processor.isUsingDoublePrecision();
+
+    AudioBuffer<float> buffer (numChannels, settings.blockSize);
+    AudioBuffer<double> doubleBuffer (isDoublePrecision ? numChannels : 0, isDoublePrecision ? settings.blockSize : 0);
+    MidiBuffer midi;
+    auto result = Result::ok();
+
+    for (auto position = job.range.getStart(); position < job.range.getEnd(); position += settings.blockSize)
+    {
+        if (cancelled)
+        {
+            result = Result::fail ("The render was cancelled");
+            break;
+        }
+
+        const auto numSamples = (int) jmin ((int64) settings.blockSize, job.range.getEnd() - position);
+
+        buffer.setSize (numChannels, numSamples, false, false, true);
+        buffer.clear();
+
+        midi.clear();
+        addMidiForBlock (midi, job.midi, position, numSamples);
+
+        parameterEvents.clear();
+
+        for (; nextAutomationEvent < automation.size(); ++nextAutomationEvent)
+        {
+            auto& event = automation.getReference (nextAutomationEvent);
+
+            if (event.samplePosition >= position + numSamples)
+                break;
+
+            if (auto* parameter = parameters[event.parameterIndex])
+            {
+                // Earlier events have all been used up, so this one is inside the block
+                const auto offsetInBlock = (int) jlimit ((int64) 0, (int64) numSamples - 1, event.samplePosition - position);
+                parameterEvents.addEvent (event.parameterIndex, offsetInBlock, event.value);
+                parameter->setValue (event.value);
+                parameter->sendValueChangedMessageToListeners (event.value);
+            }
+        }
+
+        playHead.setPosition (position);
+
+        {
+            const ScopedLock sl (processor.getCallbackLock());
+
+            if (processor.isSuspended())
+            {
+                buffer.clear();
+            }
+            else if (isDoublePrecision)
+            {
+                doubleBuffer.makeCopyOf (buffer, true);
+                processor.processBlock (doubleBuffer, midi);
+                buffer.makeCopyOf (doubleBuffer, true);
+            }
+            else
+            {
+                processor.processBlock (buffer, midi);
+            }
+        }
+
+        if (! writeBlock (writer, buffer.getArrayOfReadPointers(), numSamples))
+        {
+            result = Result::fail ("The render was cancelled");
+            break;
+        }
+
+        numSamplesRendered += numSamples;
+    }
+
+    parameterEvents.clear();
+    processor.releaseResources();
+    processor.setPlayHead (oldPlayHead);
+    processor.setNonRealtime (wasNonRealtime);
+
+    return result;
+}
+
+Result OfflineAudioRenderer::renderSource (Job& job, AudioFormatWriter::ThreadedWriter& writer, int numChannels)
+{
+    auto& source = *job.source;
+    source.prepareToPlay (settings.blockSize, settings.sampleRate);
+
+    if (auto* positionableSource = dynamic_cast<PositionableAudioSource*> (&source))
+        positionableSource->setNextReadPosition (job.range.getStart());
+
+    AudioBuffer<float> buffer (numChannels, settings.blockSize);
+    auto result = Result::ok();
+
+    for (auto position = job.range.getStart(); position < job.range.getEnd(); position += settings.blockSize)
+    {
+        if (cancelled)
+        {
+            result = Result::fail ("The render was cancelled");
+            break;
+        }
+
+        const auto numSamples = (int) jmin ((int64) settings.blockSize, job.range.getEnd() - position);
+
+        AudioSourceChannelInfo info (&buffer, 0, numSamples);
+        info.clearActiveBufferRegion();
+        source.getNextAudioBlock (info);
+
+        if (! writeBlock (writer, buffer.getArrayOfReadPointers(), numSamples))
+        {
+            result = Result::fail ("The render was cancelled");
+            break;
+        }
+
+        numSamplesRendered += numSamples;
+    }
+
+    source.releaseResources();
+    return result;
+}
+
+bool OfflineAudioRenderer::writeBlock (AudioFormatWriter::ThreadedWriter& writer, const float* const* data, int numSamples)
+{
+    // If the disk can't keep up, wait for the writer thread to make some space
+    while (! writer.write (data, numSamples))
+    {
+        if (cancelled)
+            return false;
+
+        Thread::sleep (1);
+    }
+
+    return true;
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class OfflineAudioRendererTests  : public UnitTest
+{
+public:
+    OfflineAudioRendererTests()
+        : UnitTest ("OfflineAudioRenderer", UnitTestCategories::audio)
+    {}
+
+    void runTest() override
+    {
+        Settings settings;
+        settings.sampleRate = 48000.0;
+        settings.blockSize = 100;
+
+        beginTest ("Sources are rendered from the start of the range");
+        {
+            OfflineAudioRenderer renderer (settings);
+
+            auto random = getRandom();
+            AudioBuffer<float> audio (2, 6000);
+
+            for (int ch = 0; ch < audio.getNumChannels(); ++ch)
+                for (int i = 0; i < audio.getNumSamples(); ++i)
+                    audio.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+            MemoryAudioSource source (audio, false);
+            MemoryBlock data;
+
+            Job job;
+            job.source = &source;
+            job.range = { 1000, 5050 };
+            job.writer = createWriter (data, 2);
+
+            expect (renderer.render (job).wasOk());
+            expectEquals (renderer.getProgress(), 1.0);
+
+            auto result = readBack (data);
+            expectEquals (result.getNumSamples(), 4050);
+
+            for (int ch = 0; ch < 2; ++ch)
+                expect (std::equal (result.getReadPointer (ch), result.getReadPointer (ch) + 4050,
+                                    audio.getReadPointer (ch, 1000)));
+        }
+
+        beginTest ("Processors get sample-accurate MIDI, automation and playhead positions");
+        {
+            for (auto rangeStart : { (int64) 1000, (int64) 1 << 32 })
+            {
+                OfflineAudioRenderer renderer (settings);
+                TestProcessor processor;
+                MemoryBlock data;
+
+                Job job;
+                job.processor = &processor;
+                job.range = { rangeStart, rangeStart + 750 };
+                job.automation.add ({ 0, rangeStart + 350, 1.0f });
+                job.automation.add ({ 0, rangeStart - 800, 0.5f });
+                job.writer = createWriter (data, 2);
+
+                if (rangeStart < std::numeric_limits<int>::max())
+                {
+                    job.midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), (int) rangeStart + 234);
+                    job.midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), (int) rangeStart - 500);
+                }
+
+                expect (renderer.render (job).wasOk());
+                expect (! processor.isPrepared && ! processor.isNonRealtime());
+                expect (processor.getPlayHead() == nullptr);
+
+                expectEquals ((int) processor.blockPositions.size(), 8);
+
+                for (size_t i = 0; i < processor.blockPositions.size(); ++i)
+                    expectEquals (processor.blockPositions[i], rangeStart + (int64) i * settings.blockSize);
+
+                auto result = readBack (data);
+                expectEquals (result.getNumSamples(), 750);
+
+                // The earlier automation sets the initial value, then it ramps up to the next
+                // event within its block, and stays there
+                expectEquals (result.getSample (0, 0), 0.5f);
+                expectEquals (result.getSample (0, 299), 0.5f);
+                expect (result.getSample (0, 325) > 0.5f && result.getSample (0, 325) < 1.0f);
+                expectEquals (result.getSample (0, 350), 1.0f);
+                expectEquals (result.getSample (0, 749), 1.0f);
+
+                std::vector<int> midiPositions;
+
+                for (int i = 0; i < result.getNumSamples(); ++i)
+                    if (result.getSample (1, i) != 0.0f)
+                        midiPositions.push_back (i);
+
+                if (rangeStart < std::numeric_limits<int>::max())
+                    expect (midiPositions == std::vector<int> { 234 });
+                else
+                    expect (midiPositions.empty());
+            }
+        }
+
+        beginTest ("Automation reaches parameters owned by an AudioProcessorValueTreeState");
+        {
+            OfflineAudioRenderer renderer (settings);
+            ValueTreeStateProcessor processor;
+            MemoryBlock data;
+
+            Job job;
+            job.processor = &processor;
+            job.range = { 1000, 1750 };
+            job.automation.add ({ 0, 200, 0.25f });
+            job.automation.add ({ 0, 1350, 0.75f });
+            job.writer = createWriter (data, 2);
+
+            expect (renderer.render (job).wasOk());
+
+            auto result = readBack (data);
+            expectEquals (result.getNumSamples(), 750);
+
+            // The raw value is read once per block, so the change lands at the start of its block
+            expectEquals (result.getSample (0, 0), 0.25f);
+            expectEquals (result.getSample (0, 299), 0.25f);
+            expectEquals (result.getSample (0, 300), 0.75f);
+            expectEquals (result.getSample (0, 749), 0.75f);
+        }
+
+        beginTest ("Jobs rendered in parallel match jobs rendered one at a time");
+        {
+            OfflineAudioRenderer renderer (settings);
+            ThreadPool pool (4);
+
+            OwnedArray<TestProcessor> processors;
+            OwnedArray<MemoryBlock> data;
+            OwnedArray<Job> jobs;
+
+            for (int i = 0; i < 16; ++i)
+            {
+                auto* job = jobs.add (new Job());
+                job->processor = processors.add (new TestProcessor());
+                job->range = { i * 10000, i * 10000 + 9999 };
+                job->midi.addEvent (MidiMessage::noteOn (1, 60, 1.0f), i * 10000 + i * 100);
+                job->automation.add ({ 0, i * 10000 + 5000, (float) i / 16.0f });
+                job->writer = createWriter (*data.add (new MemoryBlock()), 2);
+            }
+
+            expect (renderer.renderInParallel (jobs, pool).wasOk());
+            expectEquals (renderer.getProgress(), 1.0);
+
+            for (int i = 0; i < jobs.size(); ++i)
+            {
+                TestProcessor processor;
+                MemoryBlock expectedData;
+
+                Job job;
+                job.processor = &processor;
+                job.range = jobs[i]->range;
+                job.midi = jobs[i]->midi;
+                job.automation = jobs[i]->automation;
+                job.writer = createWriter (expectedData, 2);
+
+                expect (renderer.render (job).wasOk());
+                expect (processors[i]->blockPositions == processor.blockPositions);
+                expect (*data[i] == expectedData);
+            }
+        }
+
+        beginTest ("Jobs that can't be rendered fail");
+        {
+            OfflineAudioRenderer renderer (settings);
+            TestProcessor processor;
+            MemoryBlock data1, data2;
+
+            Job job;
+            job.processor = &processor;
+            job.range = { 0, 100 };
+            expect (renderer.render (job).failed());
+
+            job.writer = createWriter (data1, 4);
+            expect (renderer.render (job).failed());
+
+            job.writer = createWriter (data2, 2);
+            renderer.cancel();
+            expect (renderer.render (job).failed());
+        }
+    }
+
+private:
+    using Job = OfflineAudioRenderer::Job;
+    using Settings = OfflineAudioRenderer::Settings;
+
+    // Writes the parameter's automation ramp to the first channel, marks the MIDI
+    // events in the second, and remembers where the playhead was for each block
+    struct TestProcessor  : public AudioProcessor
+    {
+        TestProcessor()
+            : AudioProcessor (BusesProperties().withOutput ("out", AudioChannelSet::stereo()))
+        {
+            addParameter (parameter = new AudioParameterFloat ("param", "Param", 0.0f, 1.0f, 0.0f));
+        }
+
+        const String getName() const override                   { return "Test"; }
+        void prepareToPlay (double, int) override               { isPrepared = true; lastValue = parameter->get(); }
+        void releaseResources() override                        { isPrepared = false; }
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer& midi) override
+        {
+            AudioPlayHead::CurrentPositionInfo info;
+            getPlayHead()->getCurrentPosition (info);
+            blockPositions.push_back (info.timeInSamples);
+
+            buffer.clear();
+            lastValue = getParameterEvents().fillRamp (0, lastValue, buffer.getWritePointer (0), buffer.getNumSamples());
+
+            for (const auto metadata : midi)
+                buffer.setSample (1, metadata.samplePosition, 1.0f);
+        }
+
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override            { return 0.0; }
+        bool acceptsMidi() const override                       { return true; }
+        bool producesMidi() const override                      { return false; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+        AudioParameterFloat* parameter = nullptr;
+        float lastValue = 0.0f;
+        bool isPrepared = false;
+        std::vector<int64> blockPositions;
+    };
+
+    // Writes the value that its AudioProcessorValueTreeState holds for its parameter to
+    // the first channel, as most processors read their parameters this way
+    struct ValueTreeStateProcessor  : public AudioProcessor
+    {
+        ValueTreeStateProcessor()
+            : AudioProcessor (BusesProperties().withOutput ("out", AudioChannelSet::stereo())),
+              state (*this, nullptr, "state",
+                     { std::make_unique<AudioParameterFloat> ("gain", "Gain", 0.0f, 1.0f, 0.0f) }),
+              gain (state.getRawParameterValue ("gain"))
+        {}
+
+        const String getName() const override                   { return "Test"; }
+        void prepareToPlay (double, int) override               {}
+        void releaseResources() override                        {}
+
+        void processBlock (AudioBuffer<float>& buffer, MidiBuffer&) override
+        {
+            buffer.clear();
+            FloatVectorOperations::fill (buffer.getWritePointer (0), gain->load(), buffer.getNumSamples());
+        }
+
+        using AudioProcessor::processBlock;
+        double getTailLengthSeconds() const override            { return 0.0; }
+        bool acceptsMidi() const override                       { return false; }
+        bool producesMidi() const override                      { return false; }
+        AudioProcessorEditor* createEditor() override           { return nullptr; }
+        bool hasEditor() const override                         { return false; }
+        int getNumPrograms() override                           { return 1; }
+        int getCurrentProgram() override                        { return 0; }
+        void setCurrentProgram (int) override                   {}
+        const String getProgramName (int) override              { return {}; }
+        void changeProgramName (int, const String&) override    {}
+        void getStateInformation (MemoryBlock&) override        {}
+        void setStateInformation (const void*, int) override    {}
+
+        AudioProcessorValueTreeState state;
+        std::atomic<float>* gain = nullptr;
+    };
+
+    static std::unique_ptr<AudioFormatWriter> createWriter (MemoryBlock& data, int numChannels)
+    {
+        data.reset();
+
+        return std::unique_ptr<AudioFormatWriter> (WavAudioFormat().createWriterFor (new MemoryOutputStream (data, false),
+                                                                                    48000.0, (unsigned int) numChannels,
+                                                                                    32, {}, 0));
+    }
+
+    static AudioBuffer<float> readBack (const MemoryBlock& data)
+    {
+        std::unique_ptr<AudioFormatReader> reader (WavAudioFormat().createReaderFor (new MemoryInputStream (data, false), true));
+
+        if (reader == nullptr)
+            return {};
+
+        AudioBuffer<float> result ((int) reader->numChannels, (int) reader->lengthInSamples);
+        reader->read (&result, 0, result.getNumSamples(), 0, true, true);
+        return result;
+    }
+};
+
+static OfflineAudioRendererTests offlineAudioRendererTests;
+
+#endif
+
+} // namespace juce
@@ -0,0 +1,181 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    Renders AudioProcessors (including AudioProcessorGraphs) and AudioSources offline,
+    as fast as they can run, and writes the results to AudioFormatWriters.
+
+    Each piece of work is described by a Job, which says what to render, which range
+    of samples on the session's timeline to render, and where to write it. A processor
+    is put into non-realtime mode while it's being rendered, and is given a playhead
+    that reports the position of each block on the timeline, along with any MIDI and
+    parameter automation that falls inside the block, with sample accuracy.
+
+    Jobs can be rendered one at a time on the calling thread with render(), or spread
+    over the threads of a ThreadPool with renderInParallel(). This makes it possible to
+    split a session into stems, or into independent time ranges, and render them all
+    at once, as long as each job has its own processor or source.
+
+    The audio is written through an AudioFormatWriter::ThreadedWriter, so the disk
+    writes happen on a background thread that's shared by all the jobs.
+
+    @see AudioProcessorPlayer, AudioFormatWriter::ThreadedWriter
+
+    @tags{Audio}
+*/
+class JUCE_API  OfflineAudioRenderer
+{
+public:
+    //==============================================================================
+    /** The settings that are used for every job. */
+    struct Settings
+    {
+        /** The sample rate to render at. */
+        double sampleRate = 44100.0;
+
+        /** The size of the blocks that are rendered. */
+        int blockSize = 512;
+
+        /** The tempo and time signature that the playhead reports. */
+        double bpm = 120.0;
+        int timeSigNumerator = 4, timeSigDenominator = 4;
+
+        /** The number of samples that each job can buffer before they're written to disk. */
+        int numSamplesToBuffer = 65536;
+    };
+
+    //==============================================================================
+    /** A change to one of a processor's parameters, at a position on the session's timeline. */
+    struct AutomationEvent
+    {
+        /** The parameter's index in AudioProcessor::getParameters(). */
+        int parameterIndex;
+
+        /** The position at which the parameter reaches the new value, in samples from
+            the start of the session's timeline.
+        */
+        int64 samplePosition;
+
+        /** The parameter's new normalised value, between 0 and 1. */
+        float value;
+    };
+
+    //==============================================================================
+    /** Describes something to render. */
+    struct Job
+    {
+        /** The processor to render. This isn't owned by the job.
+
+            The processor is prepared with its current bus layout, and its inputs are
+            given silence. If this is null, the source is rendered instead.
+        */
+        AudioProcessor* processor = nullptr;
+
+        /** The source to render if there's no processor. This isn't owned by the job.
+
+            If it's a PositionableAudioSource, its read position is set to the start
+            of the range before it's rendered.
+        */
+        AudioSource* source = nullptr;
+
+        /** The range of samples on the session's timeline to render. */
+        Range<int64> range;
+
+        /** MIDI to send to the processor, with timestamps in samples from the start
+            of the session's timeline. Events outside the range are ignored.
+        */
+        MidiBuffer midi;
+
+        /** Parameter changes to send to the processor, with sample positions from the
+            start of the session's timeline.
+
+            Changes before the start of the range set the parameters' initial values,
+            and the ones inside the range are passed to the processor in its
+            ParameterEventBuffer as well as setting the parameter's value for each block.
+        */
+        Array<AutomationEvent> automation;
+
+        /** Where to write the audio. This is owned by the job, and gets deleted once
+            the job has been rendered. It can't have more channels than the processor
+            has outputs.
+        */
+        std::unique_ptr<AudioFormatWriter> writer;
+    };
+
+    //==============================================================================
+    /** Creates a renderer. */
+    explicit OfflineAudioRenderer (const Settings& settings);
+
+    /** Destructor. */
+    ~OfflineAudioRenderer();
+
+    //==============================================================================
+    /** Renders a job on the calling thread, and returns once it has been written.
+
+        If the job is cancelled, or something goes wrong, the result has an error message.
+    */
+    Result render (Job& job);
+
+    /** Renders a set of jobs, using all the threads of a ThreadPool, and returns when
+        they've all finished.
+
+        Every job must have its own processor or source, as they may all be rendered at
+        the same time. If any of them fail, the result has the first error message.
+    */
+    Result renderInParallel (const OwnedArray<Job>& jobs, ThreadPool& pool);
+
+    /** Stops any jobs that are being rendered, and makes any that haven't started yet
+        fail straight away. This can be called from any thread.
+    */
+    void cancel() noexcept                              { cancelled = true; }
+
+    /** Returns the proportion of the samples in all the jobs that have been given to
+        this renderer that have been rendered so far, between 0 and 1. This can be called
+        from any thread.
+    */
+    double getProgress() const noexcept;
+
+private:
+    //==============================================================================
+    class PlayHead;
+
+    Result renderJob (Job&);
+    Result renderProcessor (Job&, AudioFormatWriter::ThreadedWriter&);
+    Result renderSource (Job&, AudioFormatWriter::ThreadedWriter&, int numChannels);
+    bool writeBlock (AudioFormatWriter::ThreadedWriter&, const float* const*, int numSamples);
+
+    const Settings settings;
+    TimeSliceThread writerThread { "Offline render writer" };
+    std::atomic<bool> cancelled { false };
+    std::atomic<int64> numSamplesToRender { 0 }, numSamplesRendered { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OfflineAudioRenderer)
+};
+
+} // namespace juce
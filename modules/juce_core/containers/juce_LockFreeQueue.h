@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A bounded lock-free queue, which can be used to pass objects between threads
+    without locking or allocating.
+
+    Any number of threads can push objects into the queue at the same time. If
+    allowMultipleConsumers is true, any number of threads can also pop objects
+    from it concurrently, otherwise only one thread at a time may call pop(), which
+    makes popping a little cheaper. It's usually easiest to use the MPMCQueue and
+    MPSCQueue aliases rather than this class directly.
+
+    The ElementType must be default-constructible and move-assignable. All the
+    elements are created when the queue is constructed, and objects are moved in
+    and out of them, so pushing and popping never allocates.
+
+    Each slot holds a sequence number, so a thread only needs a single atomic
+    compare-and-swap to claim a slot. The read and write positions are kept on
+    separate cache lines, so that producers and consumers don't slow each other
+    down by writing to the same line.
+
+    e.g.
+    @code
+    MPSCQueue<Message> messages { 256 };
+
+    // on any thread..
+    if (! messages.push (Message (...)))
+        handleQueueFull();
+
+    // on the consumer thread..
+    Message m;
+
+    while (messages.pop (m))
+        handleMessage (m);
+    @endcode
+
+    @see AbstractFifo, TripleBuffer
+
+    @tags{Core}
+*/
+template <typename ElementType, bool allowMultipleConsumers>
+class LockFreeQueue
+{
+public:
+    //==============================================================================
+    /** Creates a queue that can hold at least the given number of elements.
+
+        The capacity is rounded up to the next power of two.
+    */
+    explicit LockFreeQueue (int minimumCapacity)
+        : capacity ((size_t) nextPowerOfTwo (jmax (2, minimumCapacity))),
+          mask (capacity - 1),
+          slots (new Slot[capacity])
+    {
+        for (size_t i = 0; i < capacity; ++i)
+            slots[i].sequence.store (i, std::memory_order_relaxed);
+    }
+
+    /** Returns the number of elements that the queue can hold. */
+    int getCapacity() const noexcept                { return (int) capacity; }
+
+    /** Returns the number of elements currently in the queue.
+
+        If other threads are using the queue, this may have changed by the time
+        the method returns, so it should only be used as a hint.
+    */
+    int getNumReady() const noexcept
+    {
+        auto readPos  = readPosition .value.load (std::memory_order_relaxed);
+        auto writePos = writePosition.value.load (std::memory_order_relaxed);
+        return writePos > readPos ? (int) jmin (capacity, writePos - readPos) : 0;
+    }
+
+    //==============================================================================
+    /** Adds an element to the back of the queue, if there's room for it.
+
+        This may be called from any number of threads at once. It never blocks, but
+        threads may have to retry if another thread claims the same slot.
+
+        @returns false if the queue was full, in which case the object isn't moved from
+    */
+    bool push (ElementType&& newElement) noexcept
+    {
+        return pushWith ([&] (ElementType& slot) { slot = std::move (newElement); });
+    }
+
+    /** Adds a copy of an element to the back of the queue, if there's room for it.
+        @returns false if the queue was full
+    */
+    bool push (const ElementType& newElement) noexcept
+    {
+        return pushWith ([&] (ElementType& slot) { slot = newElement; });
+    }
+
+    /** Moves the element at the front of the queue into the given object.
+
+        If allowMultipleConsumers is false, this must only be called from one thread
+        at a time.
+
+        @returns false if the queue was empty, in which case the object isn't changed
+    */
+    bool pop (ElementType& result) noexcept
+    {
+        auto pos = readPosition.value.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& slot = slots[pos & mask];
+            auto sequence = slot.sequence.load (std::memory_order_acquire);
+            auto difference = (std::ptrdiff_t) (sequence - (pos + 1));
+
+            if (difference == 0)
+            {
+                if (! allowMultipleConsumers)
+                {
+                    readPosition.value.store (pos + 1, std::memory_order_relaxed);
+                }
+                else if (! readPosition.value.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                {
+                    continue;
+                }
+
+                result = std::move (slot.value);
+                slot.value = ElementType(); // so the queue doesn't keep anything alive that was moved from
+                slot.sequence.store (pos + capacity, std::memory_order_release);
+                return true;
+            }
+
+            if (difference < 0)
+                return false;
+
+            pos = readPosition.value.load (std::memory_order_relaxed);
+        }
+    }
+
+private:
+    //==============================================================================
+    struct Slot
+    {
+        std::atomic<size_t> sequence { 0 };
+        ElementType value;
+    };
+
+    template <typename AssignFn>
+    bool pushWith (AssignFn&& assign) noexcept
+    {
+        auto pos = writePosition.value.load (std::memory_order_relaxed);
+
+        for (;;)
+        {
+            auto& slot = slots[pos & mask];
+            auto sequence = slot.sequence.load (std::memory_order_acquire);
+            auto difference = (std::ptrdiff_t) (sequence - pos);
+
+            if (difference == 0)
+            {
+                if (writePosition.value.compare_exchange_weak (pos, pos + 1, std::memory_order_relaxed))
+                {
+                    assign (slot.value);
+                    slot.sequence.store (pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (difference < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = writePosition.value.load (std::memory_order_relaxed);
+            }
+        }
+    }
+
+    //==============================================================================
+    static constexpr size_t cacheLineSize = 64;
+
+    // Keeps a position on a cache line of its own, without needing an over-aligned allocation
+    struct PaddedPosition
+    {
+        char paddingBefore[cacheLineSize];
+        std::atomic<size_t> value { 0 };
+        char paddingAfter[cacheLineSize - sizeof (std::atomic<size_t>)];
+    };
+
+    const size_t capacity, mask;
+    std::unique_ptr<Slot[]> slots;
+    PaddedPosition writePosition, readPosition;
+
+    JUCE_DECLARE_NON_COPYABLE (LockFreeQueue)
+};
+
+/** A bounded lock-free queue that any number of threads can push to and pop from.
+    @see LockFreeQueue
+*/
+template <typename ElementType>
+using MPMCQueue = LockFreeQueue<ElementType, true>;
+
+/** A bounded lock-free queue that any number of threads can push to, but only one
+    thread at a time can pop from.
+    @see LockFreeQueue
+*/
+template <typename ElementType>
+using MPSCQueue = LockFreeQueue<ElementType, false>;
+
+} // namespace juce
@@ -0,0 +1,180 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class LockFreeQueueTests  : public UnitTest
+{
+public:
+    LockFreeQueueTests()
+        : UnitTest ("LockFreeQueue", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Capacity is rounded up to a power of two");
+        {
+            MPMCQueue<int> queue (100);
+            expectEquals (queue.getCapacity(), 128);
+        }
+
+        beginTest ("Elements are popped in the order they were pushed");
+        {
+            MPSCQueue<int> queue (8);
+
+            for (int i = 0; i < 8; ++i)
+                expect (queue.push (i));
+
+            expect (! queue.push (8), "pushing to a full queue should fail");
+            expectEquals (queue.getNumReady(), 8);
+
+            int value = -1;
+
+            for (int i = 0; i < 8; ++i)
+            {
+                expect (queue.pop (value));
+                expectEquals (value, i);
+            }
+
+            expect (! queue.pop (value), "popping from an empty queue should fail");
+            expectEquals (value, 7);
+            expectEquals (queue.getNumReady(), 0);
+        }
+
+        beginTest ("Move-only elements");
+        {
+            MPMCQueue<std::unique_ptr<int>> queue (4);
+
+            auto element = std::make_unique<int> (42);
+            expect (queue.push (std::move (element)));
+            expect (element == nullptr);
+
+            std::unique_ptr<int> result;
+            expect (queue.pop (result));
+            expect (result != nullptr && *result == 42);
+        }
+
+        beginTest ("Multiple producers, single consumer");
+        {
+            testConcurrently<false> (4, 1);
+        }
+
+        beginTest ("Multiple producers, multiple consumers");
+        {
+            testConcurrently<true> (4, 4);
+            testConcurrently<true> (1, 4);
+        }
+    }
+
+private:
+    static constexpr int numItemsPerProducer = 50000;
+
+    struct TestThread  : public Thread
+    {
+        TestThread (std::function<void()> fn)
+            : Thread ("LockFreeQueue test"), function (std::move (fn))
+        {
+            startThread();
+        }
+
+        ~TestThread() override
+        {
+            stopThread (10000);
+        }
+
+        void run() override     { function(); }
+
+        std::function<void()> function;
+    };
+
+    template <bool multipleConsumers>
+    void testConcurrently (int numProducers, int numConsumers)
+    {
+        LockFreeQueue<int, multipleConsumers> queue (64);
+
+        const auto totalItems = numProducers * numItemsPerProducer;
+        std::vector<std::atomic<int>> timesSeen ((size_t) totalItems);
+        std::atomic<int> numPopped { 0 }, numOutOfOrder { 0 };
+
+        {
+            OwnedArray<TestThread> threads;
+
+            for (int p = 0; p < numProducers; ++p)
+            {
+                threads.add (new TestThread ([&queue, p]
+                {
+                    for (int i = 0; i < numItemsPerProducer; ++i)
+                        while (! queue.push (p * numItemsPerProducer + i))
+                            Thread::yield();
+                }));
+            }
+
+            for (int c = 0; c < numConsumers; ++c)
+            {
+                threads.add (new TestThread ([&, totalItems]
+                {
+                    // Each consumer should see the items from any one producer in the order they were pushed
+                    std::vector<int> lastFromProducer ((size_t) numProducers, -1);
+                    int value = 0;
+
+                    while (numPopped.load() < totalItems)
+                    {
+                        if (! queue.pop (value))
+                        {
+                            Thread::yield();
+                            continue;
+                        }
+
+                        auto& last = lastFromProducer[(size_t) (value / numItemsPerProducer)];
+
+                        if (value <= last)
+                            ++numOutOfOrder;
+
+                        last = value;
+                        ++timesSeen[(size_t) value];
+                        ++numPopped;
+                    }
+                }));
+            }
+
+            for (auto* t : threads)
+                expect (t->waitForThreadToExit (20000), "test thread timed out");
+        }
+
+        expectEquals (numPopped.load(), totalItems);
+        expectEquals (numOutOfOrder.load(), 0);
+
+        int numWrong = 0;
+
+        for (auto& count : timesSeen)
+            if (count.load() != 1)
+                ++numWrong;
+
+        expectEquals (numWrong, 0, "every item should be popped exactly once");
+    }
+};
+
+static LockFreeQueueTests lockFreeQueueTests;
+
+} // namespace juce
@@ -0,0 +1,133 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A wait-free way of handing a value from one thread to another, where the
+    reader only ever needs the most recent one, such as passing state between
+    the GUI and audio threads.
+
+    There are three copies of the value. The writer fills in its own copy and
+    then publishes it, which swaps it with a shared middle copy. When the reader
+    asks for an update, it swaps its copy with the middle one if a new value has
+    been published since it last looked. Neither side ever waits for the other,
+    and the reader always sees a complete value, never one that's half written.
+
+    Only one thread may write and only one thread may read at a time, but they
+    can be different threads.
+
+    e.g.
+    @code
+    TripleBuffer<FilterSettings> settings;
+
+    // on the message thread..
+    settings.getWriteBuffer() = getSettingsFromSliders();
+    settings.publish();
+
+    // on the audio thread..
+    if (settings.update())
+        applySettings (settings.getReadBuffer());
+    @endcode
+
+    @see LockFreeQueue, AbstractFifo
+
+    @tags{Core}
+*/
+template <typename Type>
+class TripleBuffer
+{
+public:
+    //==============================================================================
+    /** Creates a TripleBuffer with all three copies set to the given value. */
+    explicit TripleBuffer (const Type& initialValue = Type())
+        : buffers { initialValue, initialValue, initialValue }
+    {
+    }
+
+    //==============================================================================
+    /** Returns the writer's copy of the value, which it can change before calling
+        publish(). This must only be called on the writer thread.
+    */
+    Type& getWriteBuffer() noexcept                 { return buffers[writeIndex]; }
+
+    /** Makes the writer's copy of the value available to the reader.
+
+        After this, getWriteBuffer() returns a different copy, which may hold an
+        older value, so it should be filled in completely before the next call.
+    */
+    void publish() noexcept
+    {
+        auto previous = middle.exchange ((uint8) (writeIndex | newValueFlag), std::memory_order_acq_rel);
+        writeIndex = (uint8) (previous & indexMask);
+    }
+
+    /** Copies a new value into the writer's buffer and publishes it. */
+    void write (const Type& newValue)
+    {
+        getWriteBuffer() = newValue;
+        publish();
+    }
+
+    //==============================================================================
+    /** If a new value has been published since the last call, this makes it the one
+        returned by getReadBuffer(). This must only be called on the reader thread.
+
+        @returns true if there was a new value
+    */
+    bool update() noexcept
+    {
+        if ((middle.load (std::memory_order_relaxed) & newValueFlag) == 0)
+            return false;
+
+        auto previous = middle.exchange (readIndex, std::memory_order_acq_rel);
+        readIndex = (uint8) (previous & indexMask);
+        return true;
+    }
+
+    /** Returns the reader's copy of the value. This must only be called on the
+        reader thread, and only changes when update() is called.
+    */
+    const Type& getReadBuffer() const noexcept      { return buffers[readIndex]; }
+
+    /** Updates the reader's copy of the value if there's a new one, and returns it. */
+    const Type& read() noexcept
+    {
+        update();
+        return getReadBuffer();
+    }
+
+private:
+    //==============================================================================
+    enum : uint8 { indexMask = 3, newValueFlag = 4 };
+
+    Type buffers[3];
+    uint8 writeIndex = 0, readIndex = 1;
+    std::atomic<uint8> middle { 2 };
+
+    JUCE_DECLARE_NON_COPYABLE (TripleBuffer)
+};
+
+} // namespace juce
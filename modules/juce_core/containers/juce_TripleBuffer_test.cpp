@@ -0,0 +1,131 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+class TripleBufferTests  : public UnitTest
+{
+public:
+    TripleBufferTests()
+        : UnitTest ("TripleBuffer", UnitTestCategories::containers)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("The reader only sees a value after it's published");
+        {
+            TripleBuffer<int> buffer (1);
+            expectEquals (buffer.getReadBuffer(), 1);
+            expect (! buffer.update());
+
+            buffer.getWriteBuffer() = 2;
+            expect (! buffer.update());
+            expectEquals (buffer.getReadBuffer(), 1);
+
+            buffer.publish();
+            expect (buffer.update());
+            expectEquals (buffer.getReadBuffer(), 2);
+            expect (! buffer.update());
+
+            buffer.write (3);
+            buffer.write (4);
+            expectEquals (buffer.read(), 4);
+            expectEquals (buffer.read(), 4);
+        }
+
+        beginTest ("Values are never torn when written and read concurrently");
+        {
+            TripleBuffer<State> buffer;
+            std::atomic<bool> finished { false };
+
+            struct WriterThread  : public Thread
+            {
+                WriterThread (TripleBuffer<State>& b, std::atomic<bool>& f)
+                    : Thread ("TripleBuffer writer"), buffer (b), finished (f)
+                {
+                    startThread();
+                }
+
+                ~WriterThread() override
+                {
+                    stopThread (10000);
+                }
+
+                void run() override
+                {
+                    for (int i = 1; i <= 200000; ++i)
+                    {
+                        auto& state = buffer.getWriteBuffer();
+
+                        for (auto& v : state.values)
+                            v = i;
+
+                        buffer.publish();
+                    }
+
+                    finished = true;
+                }
+
+                TripleBuffer<State>& buffer;
+                std::atomic<bool>& finished;
+            };
+
+            WriterThread writer (buffer, finished);
+
+            int numTorn = 0, numBackwards = 0, last = 0;
+
+            for (;;)
+            {
+                auto isFinished = finished.load();
+                auto& state = buffer.read();
+
+                for (auto v : state.values)
+                    if (v != state.values[0])
+                        ++numTorn;
+
+                if (state.values[0] < last)
+                    ++numBackwards;
+
+                last = state.values[0];
+
+                if (isFinished)
+                    break;
+            }
+
+            expectEquals (numTorn, 0);
+            expectEquals (numBackwards, 0);
+            expectEquals (last, 200000, "the reader should end up with the last value written");
+        }
+    }
+
+private:
+    struct State
+    {
+        int values[16] = {};
+    };
+};
+
+static TripleBufferTests tripleBufferTests;
+
+} // namespace juce
@@ -72,6 +72,10 @@
   #include <netinet/in.h>
  #endif
 
+ #if ! (JUCE_MAC || JUCE_IOS)
+  #include <semaphore.h>
+ #endif
+
  #if JUCE_LINUX
   #include <stdio.h>
   #include <langinfo.h>
@@ -166,6 +170,7 @@
 #include "threads/juce_ReadWriteLock.cpp"
 #include "threads/juce_Thread.cpp"
 #include "threads/juce_ThreadPool.cpp"
+#include "threads/juce_RealtimeWorkerPool.cpp"
 #include "threads/juce_TimeSliceThread.cpp"
 #include "time/juce_PerformanceCounter.cpp"
 #include "time/juce_RelativeTime.cpp"
@@ -242,6 +247,8 @@
 //==============================================================================
 #if JUCE_UNIT_TESTS
  #include "containers/juce_HashMap_test.cpp"
+ #include "containers/juce_LockFreeQueue_test.cpp"
+ #include "containers/juce_TripleBuffer_test.cpp"
 #endif
 
 //==============================================================================
@@ -49,6 +49,9 @@ public:
     InputStream* createInputStreamFor (const String& relatedItemPath) override;
     int64 hashCode() const override;
 
+    /** Returns the file that this source reads from. */
+    const File& getFile() const noexcept                    { return file; }
+
 private:
     //==============================================================================
     const File file;
@@ -0,0 +1,282 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+// A counting semaphore whose signal() is a single system call which never takes a
+// mutex, unlike WaitableEvent, so that a realtime thread can use it to wake a worker.
+class RealtimeWorkerPool::Semaphore
+{
+public:
+   #if JUCE_WINDOWS
+    Semaphore()                 : handle (CreateSemaphore (nullptr, 0, std::numeric_limits<LONG>::max(), nullptr)) {}
+    ~Semaphore()                { CloseHandle (handle); }
+
+    void signal() noexcept      { ReleaseSemaphore (handle, 1, nullptr); }
+    void wait() noexcept        { WaitForSingleObject (handle, INFINITE); }
+
+   private:
+    HANDLE handle;
+   #elif JUCE_MAC || JUCE_IOS
+    Semaphore()                 { semaphore_create (mach_task_self(), &handle, SYNC_POLICY_FIFO, 0); }
+    ~Semaphore()                { semaphore_destroy (mach_task_self(), handle); }
+
+    void signal() noexcept      { semaphore_signal (handle); }
+    void wait() noexcept        { while (semaphore_wait (handle) == KERN_ABORTED) {} }
+
+   private:
+    semaphore_t handle;
+   #else
+    Semaphore()                 { sem_init (&handle, 0, 0); }
+    ~Semaphore()                { sem_destroy (&handle); }
+
+    void signal() noexcept      { sem_post (&handle); }
+    void wait() noexcept        { while (sem_wait (&handle) != 0 && errno == EINTR) {} }
+
+   private:
+    sem_t handle;
+   #endif
+
+    JUCE_DECLARE_NON_COPYABLE (Semaphore)
+};
+
+//==============================================================================
+struct RealtimeWorkerPool::Worker  : public Thread
+{
+    Worker (RealtimeWorkerPool& p, const String& name)
+        : Thread (name), pool (p)
+    {
+    }
+
+    void run() override
+    {
+        auto lastGeneration = pool.generation.load();
+
+        while (! threadShouldExit())
+        {
+            if (! waitForNextTask (lastGeneration))
+                continue;
+
+            ++pool.numBusyWorkers;
+
+            if (auto* task = pool.currentTask.load())
+                task->runConcurrently();
+
+            --pool.numBusyWorkers;
+        }
+    }
+
+    bool waitForNextTask (uint32& lastGeneration)
+    {
+        // Spin for a short while before going to sleep, because the next task is
+        // usually only a callback period away..
+        for (int i = 0; i < numSpinsBeforeSleeping; ++i)
+        {
+            if (hasNewGeneration (lastGeneration))
+                return true;
+
+            Thread::yield();
+        }
+
+        isSleeping = true;
+
+        // perform() only posts to workers that it sees sleeping, and clears the flag
+        // when it does, so if the flag has already gone, there's a post to consume
+        if (hasNewGeneration (lastGeneration))
+        {
+            if (! isSleeping.exchange (false))
+                wakeUp.wait();
+
+            return true;
+        }
+
+        wakeUp.wait();
+        isSleeping = false;
+        return hasNewGeneration (lastGeneration);
+    }
+
+    bool hasNewGeneration (uint32& lastGeneration) const noexcept
+    {
+        auto current = pool.generation.load();
+
+        if (current == lastGeneration)
+            return false;
+
+        lastGeneration = current;
+        return true;
+    }
+
+    RealtimeWorkerPool& pool;
+    Semaphore wakeUp;
+    std::atomic<bool> isSleeping { false };
+
+    static constexpr int numSpinsBeforeSleeping = 200;
+
+    JUCE_DECLARE_NON_COPYABLE (Worker)
+};
+
+//==============================================================================
+RealtimeWorkerPool::RealtimeWorkerPool (const String& threadName, int numWorkers, bool pinToCores)
+{
+    auto numCpus = jmax (1, SystemStats::getNumCpus());
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto* worker = workers.add (new Worker (*this, threadName + " " + String (i + 1)));
+
+        // The calling thread isn't pinned, so this just stops the workers from
+        // competing with each other, and leaves one core where they never run
+        if (pinToCores && numCpus > 1 && numCpus <= 32)
+            worker->setAffinityMask ((uint32) 1 << (uint32) (1 + i % (numCpus - 1)));
+
+        worker->startThread (Thread::realtimeAudioPriority);
+    }
+}
+
+RealtimeWorkerPool::~RealtimeWorkerPool()
+{
+    // A worker that isn't asleep yet will find this post when it next tries to sleep
+    for (auto* worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->wakeUp.signal();
+    }
+
+    for (auto* worker : workers)
+        worker->stopThread (2000);
+}
+
+int RealtimeWorkerPool::getNumWorkers() const noexcept
+{
+    return workers.size();
+}
+
+void RealtimeWorkerPool::perform (Task& task) noexcept
+{
+    currentTask = &task;
+    ++generation;
+
+    for (auto* worker : workers)
+        if (worker->isSleeping.exchange (false))
+            worker->wakeUp.signal();
+
+    task.runConcurrently();
+
+    // Workers which haven't started on the task yet will find nothing left to do,
+    // so only the ones that are busy need to be waited for
+    currentTask = nullptr;
+
+    while (numBusyWorkers.load() > 0)
+        Thread::yield();
+}
+
+//==============================================================================
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class RealtimeWorkerPoolTests  : public UnitTest
+{
+public:
+    RealtimeWorkerPoolTests()
+        : UnitTest ("RealtimeWorkerPool", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        beginTest ("Every item of a task is done once, by several threads");
+        {
+            RealtimeWorkerPool pool ("Test worker", 3);
+            expectEquals (pool.getNumWorkers(), 3);
+
+            for (int round = 0; round < 100; ++round)
+            {
+                CountingTask task;
+                pool.perform (task);
+
+                expect (std::all_of (std::begin (task.counts), std::end (task.counts),
+                                     [] (const std::atomic<int>& c) { return c.load() == 1; }));
+            }
+        }
+
+        beginTest ("Workers that have gone to sleep are woken up");
+        {
+            RealtimeWorkerPool pool ("Test worker", 2);
+
+            for (int round = 0; round < 5; ++round)
+            {
+                // long enough for the workers to stop spinning
+                Thread::sleep (50);
+
+                WaitForWorkersTask task (pool.getNumWorkers() + 1);
+                pool.perform (task);
+                expectEquals (task.numThreads.load(), pool.getNumWorkers() + 1);
+            }
+        }
+    }
+
+private:
+    struct CountingTask  : public RealtimeWorkerPool::Task
+    {
+        void runConcurrently() noexcept override
+        {
+            for (;;)
+            {
+                auto index = next++;
+
+                if (index >= numElementsInArray (counts))
+                    return;
+
+                ++counts[index];
+            }
+        }
+
+        std::atomic<int> next { 0 };
+        std::atomic<int> counts[1000] = {};
+    };
+
+    // Doesn't return until every thread has joined in, or a second has passed
+    struct WaitForWorkersTask  : public RealtimeWorkerPool::Task
+    {
+        explicit WaitForWorkersTask (int numExpected)  : numExpectedThreads (numExpected) {}
+
+        void runConcurrently() noexcept override
+        {
+            ++numThreads;
+
+            for (auto start = Time::getMillisecondCounter();
+                 numThreads.load() < numExpectedThreads && Time::getMillisecondCounter() < start + 1000;)
+                Thread::yield();
+        }
+
+        const int numExpectedThreads;
+        std::atomic<int> numThreads { 0 };
+    };
+};
+
+static RealtimeWorkerPoolTests realtimeWorkerPoolTests;
+
+#endif
+
+} // namespace juce
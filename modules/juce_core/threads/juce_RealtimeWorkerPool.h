@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   The code included in this file is provided under the terms of the ISC license
+   http://www.isc.org/downloads/software-support-policy/isc-license. Permission
+   To use, copy, modify, and/or distribute this software for any purpose with or
+   without fee is hereby granted provided that the above copyright notice and
+   this permission notice appear in all copies.
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+
+namespace juce
+{
+
+//==============================================================================
+/**
+    A small set of realtime-priority threads which help a realtime thread, such as
+    an audio callback, to get through a piece of work that can be shared out.
+
+    The threads are started when the pool is created. Each call to perform() runs a
+    Task on the calling thread and on every worker at the same time, and returns once
+    they've all finished with it. The workers spin for a little while after each one,
+    as the next usually comes along a callback period later, and then go to sleep on
+    a semaphore.
+
+    Handing out a task never allocates or takes a lock. Waking a sleeping worker
+    means posting to its semaphore, which is a single system call that doesn't use
+    any mutexes, but on most systems it's still a good idea to make the workers'
+    share of the work large enough that this cost doesn't matter.
+
+    @see ThreadPool
+
+    @tags{Core}
+*/
+class JUCE_API  RealtimeWorkerPool
+{
+public:
+    //==============================================================================
+    /** A piece of work that the calling thread and the workers share out between them. */
+    struct Task
+    {
+        virtual ~Task() = default;
+
+        /** Called at the same time on the thread that called perform(), and on each of
+            the workers. It must return as soon as there's nothing left for the thread
+            that's calling it to do.
+        */
+        virtual void runConcurrently() noexcept = 0;
+    };
+
+    //==============================================================================
+    /** Creates a pool and starts its workers.
+
+        @param threadName       the workers are given this name, followed by a number
+        @param numWorkers       the number of threads to start
+        @param pinToCores       if true, each worker is pinned to a different CPU core,
+                                leaving the first core free of workers
+    */
+    RealtimeWorkerPool (const String& threadName, int numWorkers, bool pinToCores = false);
+
+    /** Destructor. This must not be called while perform() is running. */
+    ~RealtimeWorkerPool();
+
+    /** Returns the number of worker threads. */
+    int getNumWorkers() const noexcept;
+
+    /** Runs a task on the calling thread and on all of the workers, and returns once
+        none of the workers are still using it.
+
+        This must only be called from one thread at a time.
+    */
+    void perform (Task& task) noexcept;
+
+private:
+    //==============================================================================
+    class Semaphore;
+    struct Worker;
+
+    OwnedArray<Worker> workers;
+    std::atomic<Task*> currentTask { nullptr };
+    std::atomic<uint32> generation { 0 };
+    std::atomic<int> numBusyWorkers { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RealtimeWorkerPool)
+};
+
+} // namespace juce
@@ -23,6 +23,24 @@
 namespace juce
 {
 
+struct ThreadPool::Task  : public ReferenceCountedObject
+{
+    explicit Task (std::function<void()> f)  : function (std::move (f)) {}
+
+    std::function<void()> function;
+
+    // The extra count stops the task being queued until all its dependencies have been added
+    std::atomic<int> numPendingDependencies { 1 };
+    std::atomic<bool> finished { false };
+    WaitableEvent finishedEvent { true };
+
+    // This also guards finished being set, so that nothing is added to these lists afterwards
+    SpinLock continuationLock;
+    ReferenceCountedArray<Task> continuations;
+    Array<Thread*> waitingPoolThreads;
+};
+
+//==============================================================================
 struct ThreadPool::ThreadPoolThread  : public Thread
 {
     ThreadPoolThread (ThreadPool& p, size_t stackSize)
@@ -33,13 +51,67 @@ struct ThreadPool::ThreadPoolThread  : public Thread
     void run() override
     {
         while (! threadShouldExit())
-            if (! pool.runNextJob (*this))
+        {
+            if (pool.runNextTask (this) || pool.runNextJob (*this))
+                continue;
+
+            // Any thread adding work after this flag is set will wake us up, so check
+            // once more for anything that was added just before
+            isSleeping = true;
+
+            if (! (pool.anyTasksQueued() || pool.anyJobsWaiting()))
                 wait (500);
+
+            isSleeping = false;
+        }
+    }
+
+    // The owning thread pushes and pops tasks at the back, other threads steal from the front
+    void pushTask (Task* task)
+    {
+        const SpinLock::ScopedLockType sl (taskLock);
+        tasks.add (task);
+    }
+
+    Task* popTask (bool fromBack)
+    {
+        const SpinLock::ScopedLockType sl (taskLock);
+
+        if (tasks.size() <= firstTask)
+            return nullptr;
+
+        auto* task = fromBack ? tasks.removeAndReturn (tasks.size() - 1)
+                              : tasks.getUnchecked (firstTask++);
+
+        // Stolen tasks leave a gap at the front, which is reclaimed once it's big enough
+        if (firstTask == tasks.size())
+        {
+            tasks.clearQuick();
+            firstTask = 0;
+        }
+        else if (firstTask > 32 && firstTask > tasks.size() / 2)
+        {
+            tasks.removeRange (0, firstTask);
+            firstTask = 0;
+        }
+
+        return task;
+    }
+
+    bool hasTasks() const
+    {
+        const SpinLock::ScopedLockType sl (taskLock);
+        return tasks.size() > firstTask;
     }
 
     std::atomic<ThreadPoolJob*> currentJob { nullptr };
+    std::atomic<bool> isSleeping { false };
     ThreadPool& pool;
 
+    SpinLock taskLock;
+    Array<Task*> tasks;
+    int firstTask = 0;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ThreadPoolThread)
 };
 
@@ -106,6 +178,10 @@ ThreadPool::~ThreadPool()
 {
     removeAllJobs (true, 5000);
     stopThreads();
+
+    for (auto* t : threads)
+        while (auto* task = t->popTask (true))
+            task->decReferenceCount();
 }
 
 void ThreadPool::createThreads (int numThreads, size_t threadStackSize)
@@ -143,8 +219,7 @@ void ThreadPool::addJob (ThreadPoolJob* job, bool deleteJobWhenFinished)
             jobs.add (job);
         }
 
-        for (auto* t : threads)
-            t->notify();
+        wakeUpSleepingThread();
     }
 }
 
@@ -420,6 +495,280 @@ bool ThreadPool::runNextJob (ThreadPoolThread& thread)
     return false;
 }
 
+//==============================================================================
+ThreadPool::TaskHandle::TaskHandle() noexcept = default;
+ThreadPool::TaskHandle::TaskHandle (Task* t) noexcept  : task (t) {}
+ThreadPool::TaskHandle::~TaskHandle() = default;
+ThreadPool::TaskHandle::TaskHandle (const TaskHandle&) noexcept = default;
+ThreadPool::TaskHandle& ThreadPool::TaskHandle::operator= (const TaskHandle&) noexcept = default;
+
+bool ThreadPool::TaskHandle::isFinished() const noexcept
+{
+    return task != nullptr && task->finished.load();
+}
+
+bool ThreadPool::TaskHandle::wait (int timeOutMs) const
+{
+    if (task == nullptr)
+        return true;
+
+    auto* poolThread = dynamic_cast<ThreadPoolThread*> (Thread::getCurrentThread());
+
+    if (poolThread == nullptr)
+        return task->finishedEvent.wait (timeOutMs);
+
+    auto start = Time::getMillisecondCounter();
+
+    while (! task->finished.load())
+    {
+        auto msLeft = -1;
+
+        if (timeOutMs >= 0)
+        {
+            auto elapsed = (int) (Time::getMillisecondCounter() - start);
+
+            if (elapsed >= timeOutMs)
+                return false;
+
+            msLeft = timeOutMs - elapsed;
+        }
+
+        // A pool thread helps out rather than blocking, in case the task is waiting
+        // behind others in its own queue
+        if (poolThread->pool.runNextTask (poolThread))
+            continue;
+
+        // Otherwise it sleeps until either the task finishes, or more work is added
+        {
+            const SpinLock::ScopedLockType sl (task->continuationLock);
+
+            if (task->finished.load())
+                break;
+
+            task->waitingPoolThreads.add (poolThread);
+        }
+
+        poolThread->isSleeping = true;
+
+        if (! poolThread->pool.anyTasksQueued())
+            poolThread->wait (msLeft);
+
+        poolThread->isSleeping = false;
+
+        const SpinLock::ScopedLockType sl (task->continuationLock);
+        task->waitingPoolThreads.removeFirstMatchingValue (poolThread);
+    }
+
+    return true;
+}
+
+ThreadPool::TaskHandle ThreadPool::addTask (std::function<void()> function)
+{
+    return addTask (std::move (function), {});
+}
+
+ThreadPool::TaskHandle ThreadPool::addTask (std::function<void()> function, const Array<TaskHandle>& dependencies)
+{
+    jassert (function != nullptr);
+
+    TaskHandle handle (new Task (std::move (function)));
+    auto* task = handle.task.get();
+
+    for (auto& dependency : dependencies)
+    {
+        if (auto* d = dependency.task.get())
+        {
+            const SpinLock::ScopedLockType sl (d->continuationLock);
+
+            if (! d->finished.load())
+            {
+                ++task->numPendingDependencies;
+                d->continuations.add (task);
+            }
+        }
+    }
+
+    if (--task->numPendingDependencies == 0)
+        addTaskToQueue (task);
+
+    return handle;
+}
+
+void ThreadPool::parallelFor (int startIndex, int endIndex, const std::function<void (int)>& function)
+{
+    auto numIndices = endIndex - startIndex;
+
+    if (numIndices <= 0)
+        return;
+
+    // Handing out the indices in batches keeps the shared counter from becoming a
+    // bottleneck, and having more batches than threads balances uneven workloads
+    const auto numBatches = jmin (numIndices, jmax (1, threads.size()) * 8);
+    const auto batchSize = (numIndices + numBatches - 1) / numBatches;
+
+    // The counters outlive this call, so that a helper which only starts after all the
+    // batches have been taken can still look at them, find nothing to do, and return
+    // without touching anything else on this stack frame
+    struct Counters
+    {
+        std::atomic<int> nextBatch { 0 }, numBatchesDone { 0 };
+        WaitableEvent allBatchesDone;
+    };
+
+    auto counters = std::make_shared<Counters>();
+
+    auto runBatches = [counters, startIndex, endIndex, numBatches, batchSize, &function]
+    {
+        for (;;)
+        {
+            auto batch = counters->nextBatch++;
+
+            if (batch >= numBatches)
+                return;
+
+            auto batchStart = startIndex + batch * batchSize;
+            auto batchEnd = jmin (endIndex, batchStart + batchSize);
+
+            for (auto i = batchStart; i < batchEnd; ++i)
+                function (i);
+
+            if (++counters->numBatchesDone == numBatches)
+                counters->allBatchesDone.signal();
+        }
+    };
+
+    for (int i = jmin (threads.size(), numBatches - 1); --i >= 0;)
+        addTask (runBatches);
+
+    runBatches();
+
+    // Only the batches that other threads are already running are left, so there's no
+    // need to run their tasks, or anyone else's, while waiting for them
+    counters->allBatchesDone.wait();
+}
+
+ThreadPool::ThreadPoolThread* ThreadPool::getCurrentPoolThread() const noexcept
+{
+    if (auto* t = dynamic_cast<ThreadPoolThread*> (Thread::getCurrentThread()))
+        if (&t->pool == this)
+            return t;
+
+    return nullptr;
+}
+
+void ThreadPool::addTaskToQueue (Task* task)
+{
+    task->incReferenceCount();
+
+    // There's always at least one thread, unless the pool is being deleted
+    if (threads.isEmpty())
+    {
+        runTask (task);
+        return;
+    }
+
+    if (auto* current = getCurrentPoolThread())
+        current->pushTask (task);
+    else
+        threads.getUnchecked ((int) (nextThreadForTask++ % (uint32) threads.size()))->pushTask (task);
+
+    wakeUpSleepingThread();
+}
+
+bool ThreadPool::runNextTask (ThreadPoolThread* thread)
+{
+    Task* task = nullptr;
+
+    if (thread != nullptr)
+        task = thread->popTask (true);
+
+    if (task == nullptr)
+    {
+        auto numThreads = threads.size();
+        auto first = thread != nullptr ? threads.indexOf (thread) + 1 : 0;
+
+        for (int i = 0; i < numThreads && task == nullptr; ++i)
+        {
+            auto* victim = threads.getUnchecked ((first + i) % numThreads);
+
+            if (victim != thread)
+                task = victim->popTask (false);
+        }
+    }
+
+    if (task == nullptr)
+        return false;
+
+    runTask (task);
+    return true;
+}
+
+void ThreadPool::runTask (Task* task)
+{
+    try
+    {
+        task->function();
+    }
+    catch (...)
+    {
+        jassertfalse; // Your task mustn't throw any exceptions!
+    }
+
+    // release anything the function captured as soon as possible
+    task->function = nullptr;
+
+    ReferenceCountedArray<Task> readyToQueue;
+
+    {
+        const SpinLock::ScopedLockType sl (task->continuationLock);
+        task->finished = true;
+        readyToQueue.swapWith (task->continuations);
+
+        for (auto* waiter : task->waitingPoolThreads)
+            waiter->notify();
+    }
+
+    task->finishedEvent.signal();
+
+    for (auto* continuation : readyToQueue)
+        if (--continuation->numPendingDependencies == 0)
+            addTaskToQueue (continuation);
+
+    task->decReferenceCount();
+}
+
+bool ThreadPool::anyTasksQueued() const noexcept
+{
+    for (auto* t : threads)
+        if (t->hasTasks())
+            return true;
+
+    return false;
+}
+
+bool ThreadPool::anyJobsWaiting() const
+{
+    const ScopedLock sl (lock);
+
+    for (auto* job : jobs)
+        if (! job->isActive)
+            return true;
+
+    return false;
+}
+
+void ThreadPool::wakeUpSleepingThread()
+{
+    for (auto* t : threads)
+    {
+        if (t->isSleeping.exchange (false))
+        {
+            t->notify();
+            return;
+        }
+    }
+}
+
 void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, ThreadPoolJob* job) const
 {
     job->shouldStop = true;
@@ -429,4 +778,149 @@ void ThreadPool::addToDeleteList (OwnedArray<ThreadPoolJob>& deletionList, Threa
         deletionList.add (job);
 }
 
+//==============================================================================
+#if JUCE_UNIT_TESTS
+
+class ThreadPoolTests  : public UnitTest
+{
+public:
+    ThreadPoolTests()
+        : UnitTest ("ThreadPool", UnitTestCategories::threads)
+    {}
+
+    void runTest() override
+    {
+        ThreadPool pool (4);
+
+        beginTest ("Tasks");
+        {
+            std::atomic<int> count { 0 };
+            Array<ThreadPool::TaskHandle> handles;
+
+            for (int i = 0; i < 10000; ++i)
+                handles.add (pool.addTask ([&count] { ++count; }));
+
+            for (auto& h : handles)
+                expect (h.wait (10000));
+
+            expectEquals (count.load(), 10000);
+        }
+
+        beginTest ("Task dependencies");
+        {
+            std::atomic<int> a { 0 }, b { 0 }, c { 0 }, d { 0 };
+
+            auto taskA = pool.addTask ([&] { Thread::sleep (20); a = 1; });
+            auto taskB = pool.addTask ([&] { b = a + 1; }, { taskA });
+            auto taskC = pool.addTask ([&] { c = a + 2; }, { taskA });
+            auto taskD = pool.addTask ([&] { d = b + c; }, { taskB, taskC });
+
+            expect (taskD.wait (10000));
+            expect (taskA.isFinished() && taskB.isFinished() && taskC.isFinished());
+            expectEquals (d.load(), 5);
+
+            // depending on a task that has already finished shouldn't hold anything up
+            auto taskE = pool.addTask ([&] { d = 10; }, { taskA, ThreadPool::TaskHandle() });
+            expect (taskE.wait (10000));
+            expectEquals (d.load(), 10);
+        }
+
+        beginTest ("Tasks can wait for the tasks they add");
+        {
+            std::atomic<int> count { 0 };
+
+            auto outer = pool.addTask ([&]
+            {
+                Array<ThreadPool::TaskHandle> inner;
+
+                for (int i = 0; i < 100; ++i)
+                    inner.add (pool.addTask ([&count] { ++count; }));
+
+                for (auto& h : inner)
+                    h.wait();
+            });
+
+            expect (outer.wait (10000));
+            expectEquals (count.load(), 100);
+        }
+
+        beginTest ("parallelFor");
+        {
+            std::vector<std::atomic<int>> timesCalled (1000);
+
+            pool.parallelFor (0, 1000, [&] (int i) { ++timesCalled[(size_t) i]; });
+
+            int numWrong = 0;
+
+            for (auto& t : timesCalled)
+                if (t.load() != 1)
+                    ++numWrong;
+
+            expectEquals (numWrong, 0);
+
+            std::atomic<int> total { 0 };
+
+            auto nested = pool.addTask ([&]
+            {
+                pool.parallelFor (10, 20, [&] (int i)
+                {
+                    pool.parallelFor (0, i, [&] (int) { ++total; });
+                });
+            });
+
+            expect (nested.wait (10000));
+            expectEquals (total.load(), 145);
+        }
+
+        beginTest ("parallelFor doesn't run other tasks on the calling thread");
+        {
+            ThreadPool singleThreadPool (1);
+            WaitableEvent started, release;
+
+            auto blocker = singleThreadPool.addTask ([&] { started.signal(); release.wait (10000); });
+            expect (started.wait (10000));
+
+            std::atomic<Thread::ThreadID> unrelatedThread { nullptr };
+            auto unrelated = singleThreadPool.addTask ([&] { unrelatedThread = Thread::getCurrentThreadId(); });
+
+            // The pool's only thread is busy, so the caller has to do all the work itself,
+            // and shouldn't wait for its helper, or run the task that's queued before it
+            std::atomic<int> total { 0 };
+            singleThreadPool.parallelFor (0, 100, [&] (int) { ++total; });
+
+            expectEquals (total.load(), 100);
+            expect (! unrelated.isFinished());
+
+            release.signal();
+            expect (unrelated.wait (10000));
+            expect (unrelatedThread.load() != Thread::getCurrentThreadId());
+            expect (blocker.isFinished());
+        }
+
+        beginTest ("ThreadPoolJobs still run alongside tasks");
+        {
+            std::atomic<int> count { 0 };
+
+            for (int i = 0; i < 100; ++i)
+            {
+                pool.addJob ([&count] { ++count; });
+                pool.addTask ([&count] { ++count; });
+            }
+
+            auto start = Time::getMillisecondCounter();
+
+            while ((pool.getNumJobs() > 0 || count.load() < 200)
+                     && Time::getMillisecondCounter() < start + 10000)
+                Thread::sleep (1);
+
+            expectEquals (pool.getNumJobs(), 0);
+            expectEquals (count.load(), 200);
+        }
+    }
+};
+
+static ThreadPoolTests threadPoolTests;
+
+#endif
+
 } // namespace juce
@@ -148,6 +148,13 @@ private:
     When a ThreadPoolJob object is added to the ThreadPool's list, its runJob() method
     will be called by the next pooled thread that becomes free.
 
+    For large numbers of short pieces of work, the pool can also run lightweight tasks,
+    which are added with addTask() or parallelFor(). These don't go into the job list,
+    but into a queue owned by one of the threads, and threads that run out of work steal
+    tasks from the others' queues, so adding and running tasks never has to wait for a
+    lock shared by the whole pool. Tasks can depend on other tasks, so they only start
+    once those have finished.
+
     @see ThreadPoolJob, Thread
 
     @tags{Core}
@@ -315,6 +322,78 @@ public:
     */
     bool setThreadPriorities (int newPriority);
 
+    //==============================================================================
+private:
+    struct Task;
+
+public:
+    /** Refers to a task that was added to a pool with addTask().
+
+        A default-constructed TaskHandle doesn't refer to any task.
+    */
+    class JUCE_API  TaskHandle
+    {
+    public:
+        TaskHandle() noexcept;
+        ~TaskHandle();
+        TaskHandle (const TaskHandle&) noexcept;
+        TaskHandle& operator= (const TaskHandle&) noexcept;
+
+        /** Returns true if this refers to a task. */
+        bool isValid() const noexcept                   { return task != nullptr; }
+
+        /** Returns true if the task has finished running. */
+        bool isFinished() const noexcept;
+
+        /** Waits for the task to finish.
+
+            If this is called from one of the pool's threads, it runs other tasks from the
+            pool while it waits, so a task can safely wait for the tasks that it adds.
+
+            The ThreadPool must not be deleted while a thread is waiting.
+
+            @returns false if the timeout expired before the task finished
+        */
+        bool wait (int timeOutMilliseconds = -1) const;
+
+    private:
+        friend class ThreadPool;
+        explicit TaskHandle (Task*) noexcept;
+
+        ReferenceCountedObjectPtr<Task> task;
+    };
+
+    /** Adds a function to be called by one of the pool's threads as a task.
+
+        This is much cheaper than adding a ThreadPoolJob, so it's the best way to run
+        thousands of short pieces of work. Tasks are run before any ThreadPoolJobs that are
+        waiting, and tasks that are added from one of the pool's threads are usually run
+        by that same thread, unless another thread runs out of work first.
+
+        Tasks that haven't started when the pool is deleted will never be run.
+    */
+    TaskHandle addTask (std::function<void()> function);
+
+    /** Adds a function to be called as a task once all the given tasks have finished.
+
+        This can be used to make a chain of continuations, or to wait for a set of tasks
+        to finish before combining their results, without blocking any threads.
+    */
+    TaskHandle addTask (std::function<void()> function, const Array<TaskHandle>& dependencies);
+
+    /** Calls a function for each index in the range startIndex to (endIndex - 1), using
+        all the pool's threads, and returns when they've all been done.
+
+        The calling thread also does some of the work, and the indices are handed out in
+        small batches as each thread becomes free, so it doesn't matter if some of them
+        take much longer than others. This can be called from inside a task or job that
+        is running on the same pool.
+
+        The calling thread only ever runs this call's own indices. Once they've all been
+        taken, it blocks until the pool's threads have finished the ones they're running,
+        and it never picks up any other tasks from the pool while it waits.
+    */
+    void parallelFor (int startIndex, int endIndex, const std::function<void (int index)>& function);
 
 private:
     //==============================================================================
@@ -326,7 +405,15 @@ private:
 
     CriticalSection lock;
     WaitableEvent jobFinishedSignal;
-
+    std::atomic<uint32> nextThreadForTask { 0 };
+
+    ThreadPoolThread* getCurrentPoolThread() const noexcept;
+    void addTaskToQueue (Task*);
+    bool runNextTask (ThreadPoolThread*);
+    void runTask (Task*);
+    bool anyTasksQueued() const noexcept;
+    bool anyJobsWaiting() const;
+    void wakeUpSleepingThread();
     bool runNextJob (ThreadPoolThread&);
     ThreadPoolJob* pickNextJobToRun();
     void addToDeleteList (OwnedArray<ThreadPoolJob>&, ThreadPoolJob*) const;
@@ -357,6 +357,30 @@ struct SIMDRegister
         return snapPointerToAlignment (ptr, SIMDRegisterSize);
     }
 
+    //==============================================================================
+    /** Returns true if the CPU that the code is running on supports the instruction set
+        that SIMDRegister has been compiled for.
+
+        Unlike FloatVectorOperations, which picks an instruction set at runtime, the width
+        of a SIMDRegister is fixed when the code is compiled. A binary built with AVX2
+        enabled will crash on a CPU that doesn't support it, so you can call this at
+        startup to detect that situation. It uses the same detection as
+        FloatVectorOperations::getInstructionSet().
+    */
+    static bool isSupportedOnCurrentCPU() noexcept
+    {
+       #if defined (__AVX2__) && JUCE_USE_AVX_INTRINSICS
+        const auto instructionSet = FloatVectorOperations::getInstructionSet();
+
+        return instructionSet == FloatVectorOperations::InstructionSet::avx2
+            || instructionSet == FloatVectorOperations::InstructionSet::avx512;
+       #elif defined (__AVX2__)
+        return SystemStats::hasAVX2();
+       #else
+        return true;
+       #endif
+    }
+
 private:
     static vMaskType JUCE_VECTOR_CALLTYPE toMaskType (vSIMDType a) noexcept
     {
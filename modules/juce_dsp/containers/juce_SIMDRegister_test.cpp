@@ -909,6 +909,9 @@ public:
         runTestSigned<CheckAbs> ("CheckAbs");
 
         runTestFloatingPoint<CheckTruncate> ("CheckTruncate");
+
+        beginTest ("CheckCPUSupport");
+        expect (SIMDRegister<float>::isSupportedOnCurrentCPU());
     }
 };
 
@@ -28,50 +28,6 @@ namespace juce
 namespace dsp
 {
 
-template <typename Element>
-class Queue
-{
-public:
-    explicit Queue (int size)
-        : fifo (size), storage (static_cast<size_t> (size)) {}
-
-    bool push (Element& element) noexcept
-    {
-        if (fifo.getFreeSpace() == 0)
-            return false;
-
-        const auto writer = fifo.write (1);
-
-        if (writer.blockSize1 != 0)
-            storage[static_cast<size_t> (writer.startIndex1)] = std::move (element);
-        else if (writer.blockSize2 != 0)
-            storage[static_cast<size_t> (writer.startIndex2)] = std::move (element);
-
-        return true;
-    }
-
-    template <typename Fn>
-    void pop (Fn&& fn) { popN (1, std::forward<Fn> (fn)); }
-
-    template <typename Fn>
-    void popAll (Fn&& fn) { popN (fifo.getNumReady(), std::forward<Fn> (fn)); }
-
-    bool hasPendingMessages() const noexcept { return fifo.getNumReady() > 0; }
-
-private:
-    template <typename Fn>
-    void popN (int n, Fn&& fn)
-    {
-        fifo.read (n).forEach ([&] (int index)
-                               {
-                                   fn (storage[static_cast<size_t> (index)]);
-                               });
-    }
-
-    AbstractFifo fifo;
-    std::vector<Element> storage;
-};
-
 class BackgroundMessageQueue  : private Thread
 {
 public:
@@ -82,14 +38,19 @@ public:
     using IncomingCommand = FixedSizeFunction<400, void()>;
 
     // Push functions here, and they'll be called later on a background thread.
-    // This function is wait-free.
-    // This function is only safe to call from a single thread at a time.
-    bool push (IncomingCommand& command) { return queue.push (command); }
+    // This function is lock-free, and can be called from any number of threads at once.
+    bool push (IncomingCommand& command) { return queue.push (std::move (command)); }
 
     void popAll()
     {
         const ScopedLock lock (popMutex);
-        queue.popAll ([] (IncomingCommand& command) { command(); command = nullptr; });
+        IncomingCommand command;
+
+        for (auto numToPop = queue.getNumReady(); --numToPop >= 0 && queue.pop (command);)
+        {
+            command();
+            command = nullptr;
+        }
     }
 
     using Thread::startThread;
@@ -103,11 +64,12 @@ private:
             const auto tryPop = [&]
             {
                 const ScopedLock lock (popMutex);
+                IncomingCommand command;
 
-                if (! queue.hasPendingMessages())
+                if (! queue.pop (command))
                     return false;
 
-                queue.pop ([] (IncomingCommand& command) { command(); command = nullptr;});
+                command();
                 return true;
             };
 
@@ -116,8 +78,9 @@ private:
         }
     }
 
+    // Only one thread pops at a time, as popping happens under the popMutex
     CriticalSection popMutex;
-    Queue<IncomingCommand> queue;
+    MPSCQueue<IncomingCommand> queue;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundMessageQueue)
 };
@@ -439,6 +402,168 @@ struct ConvolutionEngine
     std::vector<AudioBuffer<float>> buffersInputSegments, buffersImpulseSegments;
 };
 
+//==============================================================================
+// Processes one stage of a multi-stage non-uniform convolution, convolving a segment
+// of the impulse response which starts at least two partitions into the response.
+// Each input partition is only needed in the output a whole partition after it has
+// been collected, so the convolution itself can happen on a background thread.
+// If the thread falls behind (when rendering faster than realtime, for example), the
+// audio thread finishes the outstanding partition itself.
+class BackgroundConvolutionStage  : private Thread
+{
+public:
+    BackgroundConvolutionStage (const AudioBuffer<float>& buf,
+                                int numChannels,
+                                int offset,
+                                int length,
+                                int partitionSizeIn,
+                                int priority)
+        : Thread ("Convolution stage"),
+          partitionSize (partitionSizeIn)
+    {
+        jassert (isPowerOfTwo (partitionSize));
+        jassert (offset >= 2 * partitionSize);
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            engines.emplace_back (std::make_unique<ConvolutionEngine> (buf.getReadPointer (jmin (buf.getNumChannels() - 1, channel), offset),
+                                                                       static_cast<size_t> (length),
+                                                                       static_cast<size_t> (partitionSize)));
+
+        for (auto& slot : inputSlots)
+            slot.setSize (numChannels, partitionSize);
+
+        for (auto& slot : outputSlots)
+            slot.setSize (numChannels, partitionSize);
+
+        clearBuffers();
+        startThread (priority);
+    }
+
+    ~BackgroundConvolutionStage() override
+    {
+        signalThreadShouldExit();
+        partitionReady.signal();
+        stopThread (-1);
+    }
+
+    void reset()
+    {
+        waitForPendingPartition();
+
+        for (auto& engine : engines)
+            engine->reset();
+
+        clearBuffers();
+    }
+
+    // Reads the input and adds this stage's contribution to the output, which must not
+    // alias the input.
+    void processSamples (const AudioBlock<const float>& input, const AudioBlock<float>& output, size_t numChannelsToUse)
+    {
+        const auto numSamples = input.getNumSamples();
+        size_t numSamplesProcessed = 0;
+        numChannelsToUse = jmin (numChannelsToUse, engines.size());
+
+        while (numSamplesProcessed < numSamples)
+        {
+            const auto numSamplesToProcess = jmin (numSamples - numSamplesProcessed,
+                                                   static_cast<size_t> (partitionSize - positionInPartition));
+
+            for (size_t channel = 0; channel < numChannelsToUse; ++channel)
+            {
+                // The output slot for this partition holds the result for the partition
+                // collected two partitions ago
+                FloatVectorOperations::copy (inputSlots[currentSlot].getWritePointer ((int) channel, positionInPartition),
+                                             input.getChannelPointer (channel) + numSamplesProcessed,
+                                             static_cast<int> (numSamplesToProcess));
+
+                FloatVectorOperations::add (output.getChannelPointer (channel) + numSamplesProcessed,
+                                            outputSlots[currentSlot].getReadPointer ((int) channel, positionInPartition),
+                                            static_cast<int> (numSamplesToProcess));
+            }
+
+            positionInPartition += static_cast<int> (numSamplesToProcess);
+            numSamplesProcessed += numSamplesToProcess;
+
+            if (positionInPartition == partitionSize)
+            {
+                waitForPendingPartition();
+
+                pendingSlot = currentSlot;
+                pendingNumChannels = numChannelsToUse;
+                state = State::pending;
+                partitionReady.signal();
+
+                currentSlot ^= 1u;
+                positionInPartition = 0;
+            }
+        }
+    }
+
+private:
+    enum class State { idle, pending, processing };
+
+    void run() override
+    {
+        while (! threadShouldExit())
+        {
+            partitionReady.wait (100);
+            tryToProcessPendingPartition();
+        }
+    }
+
+    bool tryToProcessPendingPartition()
+    {
+        auto expected = State::pending;
+
+        if (! state.compare_exchange_strong (expected, State::processing))
+            return false;
+
+        for (size_t channel = 0; channel < pendingNumChannels; ++channel)
+            engines[channel]->processSamples (inputSlots[pendingSlot].getReadPointer ((int) channel),
+                                              outputSlots[pendingSlot].getWritePointer ((int) channel),
+                                              static_cast<size_t> (partitionSize));
+
+        state = State::idle;
+        return true;
+    }
+
+    void waitForPendingPartition()
+    {
+        if (tryToProcessPendingPartition())
+            return;
+
+        // The background thread is part-way through the previous partition
+        while (state.load() != State::idle)
+            Thread::yield();
+    }
+
+    void clearBuffers()
+    {
+        for (auto& slot : inputSlots)
+            slot.clear();
+
+        for (auto& slot : outputSlots)
+            slot.clear();
+
+        currentSlot = 0;
+        positionInPartition = 0;
+    }
+
+    const int partitionSize;
+    std::vector<std::unique_ptr<ConvolutionEngine>> engines;
+    std::array<AudioBuffer<float>, 2> inputSlots, outputSlots;
+    size_t currentSlot = 0;
+    int positionInPartition = 0;
+
+    std::atomic<State> state { State::idle };
+    size_t pendingSlot = 0;
+    size_t pendingNumChannels = 0;
+    WaitableEvent partitionReady;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BackgroundConvolutionStage)
+};
+
 //==============================================================================
 class MultichannelEngine
 {
@@ -447,8 +572,10 @@ public:
                         int maxBlockSize,
                         int maxBufferSize,
                         Convolution::NonUniform headSizeIn,
-                        bool isZeroDelayIn)
-        : tailBuffer (1, maxBlockSize),
+                        bool isZeroDelayIn,
+                        bool processTailInBackground,
+                        int numChannelsToProcess)
+        : tailBuffer (processTailInBackground ? 2 : 1, maxBlockSize),
           latency (isZeroDelayIn ? 0 : maxBufferSize),
           irSize (buf.getNumSamples()),
           blockSize (maxBlockSize),
@@ -463,7 +590,30 @@ public:
                                                         static_cast<size_t> (thisBlockSize));
         };
 
-        if (headSizeIn.headSizeInSamples == 0)
+        if (processTailInBackground && isZeroDelay)
+        {
+            // The head is processed on the audio thread, and covers the first two partitions of the
+            // first background stage. Each following stage uses partitions four times larger than
+            // the previous one, and starts two of its own partitions into the impulse response.
+            auto partitionSize = jmax (nextPowerOfTwo (maxBufferSize), headSizeIn.headSizeInSamples);
+            auto offset = jmin (buf.getNumSamples(), 2 * partitionSize);
+
+            for (int i = 0; i < numChannels; ++i)
+                head.emplace_back (makeEngine (i, 0, offset, static_cast<uint32> (maxBufferSize)));
+
+            for (auto priority = 8; offset < buf.getNumSamples(); priority = jmax (5, priority - 1))
+            {
+                const auto nextPartitionSize = jmin (maxPartitionSize, 4 * partitionSize);
+                const auto end = nextPartitionSize > partitionSize ? jmin (buf.getNumSamples(), 2 * nextPartitionSize)
+                                                                   : buf.getNumSamples();
+
+                stages.emplace_back (std::make_unique<BackgroundConvolutionStage> (buf, jlimit (1, numChannels, numChannelsToProcess), offset, end - offset, partitionSize, priority));
+
+                offset = end;
+                partitionSize = nextPartitionSize;
+            }
+        }
+        else if (headSizeIn.headSizeInSamples == 0)
         {
             for (int i = 0; i < numChannels; ++i)
                 head.emplace_back (makeEngine (i, 0, buf.getNumSamples(), static_cast<uint32> (maxBufferSize)));
@@ -490,6 +640,9 @@ public:
 
         for (const auto& e : tail)
             e->reset();
+
+        for (const auto& s : stages)
+            s->reset();
     }
 
     void processSamples (const AudioBlock<const float>& input, AudioBlock<float>& output)
@@ -502,6 +655,15 @@ public:
 
         const auto isUniform = tail.empty();
 
+        if (! stages.empty())
+        {
+            // The stages must read the input before the head overwrites it, in case they're the same block
+            tailBlock.clear();
+
+            for (const auto& s : stages)
+                s->processSamples (input.getSubBlock (0, (size_t) numSamples), tailBlock, numChannels);
+        }
+
         for (size_t channel = 0; channel < numChannels; ++channel)
         {
             if (! isUniform)
@@ -520,6 +682,8 @@ public:
 
             if (! isUniform)
                 output.getSingleChannelBlock (channel) += tailBlock;
+            else if (! stages.empty())
+                output.getSingleChannelBlock (channel) += tailBlock.getSingleChannelBlock (channel);
         }
 
         const auto numOutputChannels = output.getNumChannels();
@@ -533,7 +697,10 @@ public:
     int getBlockSize() const noexcept  { return blockSize; }
 
 private:
+    static constexpr int maxPartitionSize = 16384;
+
     std::vector<std::unique_ptr<ConvolutionEngine>> head, tail;
+    std::vector<std::unique_ptr<BackgroundConvolutionStage>> stages;
     AudioBuffer<float> tailBuffer;
 
     const int latency;
@@ -731,10 +898,12 @@ class ConvolutionEngineFactory
 {
 public:
     ConvolutionEngineFactory (Convolution::Latency requiredLatency,
-                              Convolution::NonUniform requiredHeadSize)
+                              Convolution::NonUniform requiredHeadSize,
+                              bool processTailInBackground)
         : latency  { (requiredLatency.latencyInSamples   <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredLatency.latencyInSamples)) },
           headSize { (requiredHeadSize.headSizeInSamples <= 0) ? 0 : jmax (64, nextPowerOfTwo (requiredHeadSize.headSizeInSamples)) },
-          shouldBeZeroLatency (requiredLatency.latencyInSamples == 0)
+          shouldBeZeroLatency (requiredLatency.latencyInSamples == 0),
+          shouldProcessTailInBackground (processTailInBackground)
     {}
 
     // It is safe to call this method simultaneously with other public
@@ -790,7 +959,9 @@ private:
                                                      processSpec.maximumBlockSize,
                                                      maxBufferSize,
                                                      headSize,
-                                                     shouldBeZeroLatency);
+                                                     shouldBeZeroLatency,
+                                                     shouldProcessTailInBackground,
+                                                     static_cast<int> (processSpec.numChannels));
     }
 
     static AudioBuffer<float> makeImpulseBuffer()
@@ -807,6 +978,7 @@ private:
     const Convolution::Latency latency;
     const Convolution::NonUniform headSize;
     const bool shouldBeZeroLatency;
+    const bool shouldProcessTailInBackground;
 
     TryLockedPtr<MultichannelEngine> engine;
 
@@ -848,8 +1020,9 @@ class ConvolutionEngineQueue  : public std::enable_shared_from_this<ConvolutionE
 public:
     ConvolutionEngineQueue (BackgroundMessageQueue& queue,
                             Convolution::Latency latencyIn,
-                            Convolution::NonUniform headSizeIn)
-        : messageQueue (queue), factory (latencyIn, headSizeIn) {}
+                            Convolution::NonUniform headSizeIn,
+                            bool processTailInBackground)
+        : messageQueue (queue), factory (latencyIn, headSizeIn, processTailInBackground) {}
 
     void loadImpulseResponse (AudioBuffer<float>&& buffer,
                               double sr,
@@ -1013,11 +1186,13 @@ class Convolution::Impl
 public:
     Impl (Latency requiredLatency,
           NonUniform requiredHeadSize,
+          bool processTailInBackground,
           OptionalQueue&& queue)
         : messageQueue (std::move (queue)),
           engineQueue (std::make_shared<ConvolutionEngineQueue> (*messageQueue->pimpl,
                                                                  requiredLatency,
-                                                                 requiredHeadSize))
+                                                                 requiredHeadSize,
+                                                                 processTailInBackground))
     {}
 
     void reset()
@@ -1205,27 +1380,41 @@ Convolution::Convolution (ConvolutionMessageQueue& queue)
 Convolution::Convolution (const Latency& requiredLatency)
     : Convolution (requiredLatency,
                    {},
+                   false,
                    OptionalQueue { std::make_unique<ConvolutionMessageQueue>() })
 {}
 
 Convolution::Convolution (const NonUniform& nonUniform)
     : Convolution ({},
                    nonUniform,
+                   false,
+                   OptionalQueue { std::make_unique<ConvolutionMessageQueue>() })
+{}
+
+Convolution::Convolution (const MultiStageNonUniform& multiStage)
+    : Convolution ({},
+                   { multiStage.headSizeInSamples },
+                   true,
                    OptionalQueue { std::make_unique<ConvolutionMessageQueue>() })
 {}
 
 Convolution::Convolution (const Latency& requiredLatency, ConvolutionMessageQueue& queue)
-    : Convolution (requiredLatency, {}, OptionalQueue { queue })
+    : Convolution (requiredLatency, {}, false, OptionalQueue { queue })
 {}
 
 Convolution::Convolution (const NonUniform& nonUniform, ConvolutionMessageQueue& queue)
-    : Convolution ({}, nonUniform, OptionalQueue { queue })
+    : Convolution ({}, nonUniform, false, OptionalQueue { queue })
+{}
+
+Convolution::Convolution (const MultiStageNonUniform& multiStage, ConvolutionMessageQueue& queue)
+    : Convolution ({}, { multiStage.headSizeInSamples }, true, OptionalQueue { queue })
 {}
 
 Convolution::Convolution (const Latency& latency,
                           const NonUniform& nonUniform,
+                          bool processTailInBackground,
                           OptionalQueue&& queue)
-    : pimpl (std::make_unique<Impl> (latency, nonUniform, std::move (queue)))
+    : pimpl (std::make_unique<Impl> (latency, nonUniform, processTailInBackground, std::move (queue)))
 {}
 
 Convolution::~Convolution() noexcept = default;
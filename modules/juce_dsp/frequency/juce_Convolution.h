@@ -87,8 +87,9 @@ private:
     Note: The default operation of this class uses zero latency and a uniform
     partitioned algorithm. If the impulse response size is large, or if the
     algorithm is too CPU intensive, it is possible to use either a fixed
-    latency version of the algorithm, or a simple non-uniform partitioned
-    convolution algorithm.
+    latency version of the algorithm, a simple non-uniform partitioned
+    convolution algorithm, or a multi-stage non-uniform algorithm which processes
+    most of the impulse response on background threads.
 
     Threading: It is not safe to interleave calls to the methods of this
     class. If you need to load new impulse responses during processing the
@@ -145,6 +146,32 @@ public:
      */
     explicit Convolution (const NonUniform& requiredHeadSize);
 
+    /** Contains configuration information for a multi-stage non-uniform convolution. */
+    struct MultiStageNonUniform { int headSizeInSamples; };
+
+    /** Initialises an object for performing zero-latency convolution using a
+        multi-stage non-uniform partitioned algorithm.
+
+        Only the start of the impulse response is processed on the audio thread,
+        using partitions the size of the processing block. The rest of the
+        impulse response is split into stages with progressively larger
+        partitions, which are each processed on their own background thread.
+        This makes it possible to use very long impulse responses (several
+        seconds of reverb, for example) at a fraction of the CPU cost on the
+        audio thread.
+
+        If a background thread falls behind, the audio thread will finish
+        its work rather than outputting incorrect samples, so this mode also
+        works when rendering faster than realtime.
+
+        @param requiredHeadSize       the partition size of the first background
+                                      stage, which will be rounded up to a power of
+                                      two and to at least the maximum block size.
+                                      The audio thread processes the first two of
+                                      these partitions.
+    */
+    explicit Convolution (const MultiStageNonUniform& requiredHeadSize);
+
     /** Behaves the same as the constructor taking a single Latency argument,
         but with a shared background message queue.
 
@@ -161,6 +188,14 @@ public:
     */
     Convolution (const NonUniform&, ConvolutionMessageQueue&);
 
+    /** Behaves the same as the constructor taking a single MultiStageNonUniform
+        argument, but with a shared background message queue.
+
+        IMPORTANT: the queue *must* remain alive throughout the lifetime of the
+        Convolution.
+    */
+    Convolution (const MultiStageNonUniform&, ConvolutionMessageQueue&);
+
     ~Convolution() noexcept;
 
     //==============================================================================
@@ -261,6 +296,7 @@ private:
     //==============================================================================
     Convolution (const Latency&,
                  const NonUniform&,
+                 bool processTailInBackground,
                  OptionalScopedPointer<ConvolutionMessageQueue>&&);
 
     void processSamples (const AudioBlock<const float>&, AudioBlock<float>&, bool isBypassed) noexcept;
@@ -122,6 +122,11 @@ class ConvolutionTest  : public UnitTest
 
     void checkLatency (const Convolution&, const Convolution::NonUniform&) {}
 
+    void checkLatency (const Convolution& convolution, const Convolution::MultiStageNonUniform&)
+    {
+        expect (convolution.getLatency() == 0);
+    }
+
     template <typename ConvolutionConfig>
     void testConvolution (const ProcessSpec& spec,
                           const ConvolutionConfig& config,
@@ -545,6 +550,23 @@ public:
             }
         }
 
+        beginTest ("Multi-stage non-uniform convolutions work");
+        {
+            const auto ramp = makeStereoRamp (static_cast<int> (spec.maximumBlockSize) * 80);
+
+            for (auto headSize : { 0, static_cast<int> (spec.maximumBlockSize) * 2 })
+            {
+                testConvolution (spec,
+                                 Convolution::MultiStageNonUniform { headSize },
+                                 ramp,
+                                 spec.sampleRate,
+                                 Convolution::Stereo::yes,
+                                 Convolution::Trim::yes,
+                                 Convolution::Normalise::no,
+                                 ramp);
+            }
+        }
+
         beginTest ("Convolutions with latency work");
         {
             const auto ramp = makeRamp (static_cast<int> (spec.maximumBlockSize) * 8);
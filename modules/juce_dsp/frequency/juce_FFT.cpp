@@ -421,6 +421,476 @@ struct FFTFallback  : public FFT::Instance
 
 FFT::EngineImpl<FFTFallback> fftFallback;
 
+//==============================================================================
+//==============================================================================
+#if JUCE_USE_SIMD
+struct SIMDFFT  : public FFT::Instance
+{
+    // faster than the fallback, but the platform libraries should still be preferred
+    static constexpr int priority = 0;
+
+    static SIMDFFT* create (int order)
+    {
+        // the real-only transforms need a complex transform of at least two points
+        return order >= 2 ? new SIMDFFT (order) : nullptr;
+    }
+
+    explicit SIMDFFT (int order)
+        : size (1 << order),
+          complexPlan (size),
+          halfPlan (size / 2)
+    {
+        const auto half = size / 2;
+        realTwiddles.allocate (2 * half);
+
+        for (int k = 0; k < half; ++k)
+        {
+            auto phase = -MathConstants<double>::twoPi * k / size;
+
+            realTwiddles.data[k]        = (float) std::cos (phase);
+            realTwiddles.data[half + k] = (float) std::sin (phase);
+        }
+
+        for (auto& buffer : scratch)
+            buffer.allocate (2 * size);
+    }
+
+    //==============================================================================
+    void perform (const Complex<float>* input, Complex<float>* output, bool inverse) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        auto* re = scratch[2].data;
+        auto* im = scratch[2].data + size;
+
+        deinterleave (reinterpret_cast<const float*> (input), re, im, size);
+
+        auto result = inverse ? complexPlan.perform (im, re, scratch[0].data + size, scratch[0].data,
+                                                     scratch[1].data + size, scratch[1].data)
+                              : complexPlan.perform (re, im, scratch[0].data, scratch[0].data + size,
+                                                     scratch[1].data, scratch[1].data + size);
+
+        if (inverse)
+            std::swap (result.re, result.im);
+
+        interleave (result.re, result.im, reinterpret_cast<float*> (output), size,
+                    inverse ? 1.0f / (float) size : 1.0f);
+    }
+
+    void performRealOnlyForwardTransform (float* d, bool) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        const auto half = size / 2;
+
+        // The even and odd samples become the real and imaginary parts of a half-length transform
+        auto* zr = scratch[2].data;
+        auto* zi = scratch[2].data + half;
+
+        deinterleave (d, zr, zi, half);
+
+        auto z = halfPlan.perform (zr, zi, scratch[0].data, scratch[0].data + half,
+                                   scratch[1].data, scratch[1].data + half);
+
+        // The packing pass needs z[half - k] alongside z[k], so keep a reversed copy
+        auto* revr = scratch[2].data;
+        auto* revi = scratch[2].data + half;
+        reverseHalfSpectrum (z.re, z.im, revr, revi, half, 0);
+
+        // The output goes into whichever of the ping-pong buffers isn't holding z
+        auto* outBuffer = z.re == scratch[0].data ? scratch[1].data : scratch[0].data;
+        auto* outr = outBuffer;
+        auto* outi = outBuffer + size;
+
+        auto packBlock = [&] (auto zero, int k)
+        {
+            using T = decltype (zero);
+
+            const auto scale = broadcast (0.5f, zero);
+            const auto ar = load (z.re + k, zero), ai = load (z.im + k, zero);
+            const auto br = load (revr + k, zero), bi = load (revi + k, zero);
+            const auto wr = load (realTwiddles.data + k, zero), wi = load (realTwiddles.data + half + k, zero);
+
+            const T er = (ar + br) * scale, ei = (ai - bi) * scale;
+            const T orr = (ai + bi) * scale, oi = (br - ar) * scale;
+            const T tr = orr * wr - oi * wi, ti = orr * wi + oi * wr;
+
+            store (outr + k,        er + tr);
+            store (outi + k,        ei + ti);
+            store (outr + k + half, er - tr);
+            store (outi + k + half, ei - ti);
+        };
+
+        forEachBlock (half, packBlock);
+
+        interleave (outr, outi, d, size, 1.0f);
+    }
+
+    void performRealOnlyInverseTransform (float* d) const noexcept override
+    {
+        const SpinLock::ScopedLockType sl (processLock);
+
+        const auto half = size / 2;
+
+        // Only the bins up to and including Nyquist are used, the rest are assumed to be their mirror image
+        auto* xr = scratch[0].data;
+        auto* xi = scratch[0].data + size;
+        deinterleave (d, xr, xi, half + 1);
+
+        auto* revr = scratch[1].data;
+        auto* revi = scratch[1].data + size;
+        reverseHalfSpectrum (xr, xi, revr, revi, half, 1);
+
+        auto* zr = scratch[2].data;
+        auto* zi = scratch[2].data + size;
+
+        auto unpackBlock = [&] (auto zero, int k)
+        {
+            using T = decltype (zero);
+
+            const auto scale = broadcast (0.5f, zero);
+            const auto ar = load (xr + k, zero),   ai = load (xi + k, zero);
+            const auto br = load (revr + k, zero), bi = load (revi + k, zero);
+            const auto wr = load (realTwiddles.data + k, zero), wi = load (realTwiddles.data + half + k, zero);
+
+            const T er = (ar + br) * scale, ei = (ai - bi) * scale;
+            const T dr = (ar - br) * scale, di = (ai + bi) * scale;
+            const T orr = dr * wr + di * wi, oi = di * wr - dr * wi;
+
+            store (zr + k, er - oi);
+            store (zi + k, ei + orr);
+        };
+
+        forEachBlock (half, unpackBlock);
+
+        // The inverse transform is done by swapping the real and imaginary parts
+        auto z = halfPlan.perform (zi, zr, scratch[0].data + half, scratch[0].data,
+                                   scratch[1].data + half, scratch[1].data);
+
+        interleave (z.im, z.re, d, half, 1.0f / (float) half);
+        zeromem (d + size, (size_t) size * sizeof (float));
+    }
+
+private:
+    //==============================================================================
+    using Vec = SIMDRegister<float>;
+    static constexpr int vecSize = (int) Vec::SIMDNumElements;
+
+    static forcedinline float load (const float* p, float) noexcept           { return *p; }
+    static forcedinline Vec load (const float* p, Vec) noexcept               { return Vec::fromRawArray (p); }
+    static forcedinline void store (float* p, float v) noexcept               { *p = v; }
+    static forcedinline void store (float* p, Vec v) noexcept                 { v.copyToRawArray (p); }
+    static forcedinline float broadcast (float v, float) noexcept             { return v; }
+    static forcedinline Vec broadcast (float v, Vec) noexcept                 { return Vec::expand (v); }
+
+    /*  Calls fn (T(), index) over the range [0, num), using vectors where the arrays are long
+        enough and scalars otherwise. All the arrays are aligned, and vecSize always divides num
+        when num is at least vecSize, because the lengths are powers of two.
+    */
+    template <typename Fn>
+    static forcedinline void forEachBlock (int num, Fn&& fn) noexcept
+    {
+        if (num >= vecSize)
+        {
+            for (int i = 0; i < num; i += vecSize)
+                fn (Vec(), i);
+        }
+        else
+        {
+            for (int i = 0; i < num; ++i)
+                fn (0.0f, i);
+        }
+    }
+
+    static void deinterleave (const float* source, float* re, float* im, int num) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+        {
+            re[i] = source[2 * i];
+            im[i] = source[2 * i + 1];
+        }
+    }
+
+    static void interleave (const float* re, const float* im, float* dest, int num, float gain) noexcept
+    {
+        for (int i = 0; i < num; ++i)
+        {
+            dest[2 * i]     = re[i] * gain;
+            dest[2 * i + 1] = im[i] * gain;
+        }
+    }
+
+    /*  Fills rev[k] with x[half - k], or x[(half - k) % half] if the array only holds half bins. */
+    static void reverseHalfSpectrum (const float* xr, const float* xi, float* revr, float* revi,
+                                     int half, int hasNyquistBin) noexcept
+    {
+        revr[0] = xr[hasNyquistBin != 0 ? half : 0];
+        revi[0] = xi[hasNyquistBin != 0 ? half : 0];
+
+        for (int k = 1; k < half; ++k)
+        {
+            revr[k] = xr[half - k];
+            revi[k] = xi[half - k];
+        }
+    }
+
+    //==============================================================================
+    struct AlignedBuffer
+    {
+        void allocate (int numFloats)
+        {
+            // enough for the widest SIMD registers
+            constexpr size_t alignment = 64;
+
+            storage.allocate ((size_t) numFloats + alignment / sizeof (float), true);
+            data = snapPointerToAlignment (storage.getData(), alignment);
+        }
+
+        HeapBlock<float> storage;
+        float* data = nullptr;
+    };
+
+    struct SplitComplex  { const float* re; const float* im; };
+
+    /*  A forward complex transform of a fixed size, working on split real and imaginary arrays.
+
+        This is a Stockham autosort FFT, so the output comes out in natural order without a
+        bit-reversal pass. Each pass reads from one buffer and writes to the other.
+    */
+    struct Plan
+    {
+        explicit Plan (int sizeToUse)  : fftSize (sizeToUse)
+        {
+            int twiddleSize = 0;
+
+            for (int n = fftSize, s = 1; n >= 4; n /= 4, s *= 4)
+            {
+                stages.add ({ n, s, twiddleSize });
+                twiddleSize += 6 * roundUpToVec (n / 4);
+            }
+
+            twiddles.allocate (jmax (1, twiddleSize));
+
+            // Each radix-4 pass needs w^p, w^2p and w^3p, stored as six aligned arrays
+            for (auto& stage : stages)
+            {
+                const auto m = stage.n / 4;
+                const auto stride = roundUpToVec (m);
+                auto* w = twiddles.data + stage.twiddleOffset;
+
+                for (int p = 0; p < m; ++p)
+                {
+                    for (int i = 1; i <= 3; ++i)
+                    {
+                        auto phase = -MathConstants<double>::twoPi * i * p / stage.n;
+
+                        w[(2 * i - 2) * stride + p] = (float) std::cos (phase);
+                        w[(2 * i - 1) * stride + p] = (float) std::sin (phase);
+                    }
+                }
+            }
+        }
+
+        /*  Transforms the input, and returns the buffer that holds the result, which will be one
+            of the two ping-pong buffers. The input is left untouched.
+        */
+        SplitComplex perform (const float* inRe, const float* inIm,
+                              float* aRe, float* aIm, float* bRe, float* bIm) const noexcept
+        {
+            const float* srcRe = inRe;
+            const float* srcIm = inIm;
+            float* dstRe = aRe;
+            float* dstIm = aIm;
+
+            auto swapBuffers = [&]
+            {
+                srcRe = dstRe;
+                srcIm = dstIm;
+                dstRe = (dstRe == aRe ? bRe : aRe);
+                dstIm = (dstIm == aIm ? bIm : aIm);
+            };
+
+            int s = 1;
+
+            for (auto& stage : stages)
+            {
+                radix4Pass (stage, srcRe, srcIm, dstRe, dstIm);
+                swapBuffers();
+                s = stage.s * 4;
+            }
+
+            // odd orders finish with a single radix-2 pass
+            if (s < fftSize)
+            {
+                radix2Pass (s, srcRe, srcIm, dstRe, dstIm);
+                swapBuffers();
+            }
+
+            return { srcRe, srcIm };
+        }
+
+    private:
+        struct Stage { int n, s, twiddleOffset; };
+
+        static int roundUpToVec (int n) noexcept    { return (n + vecSize - 1) & ~(vecSize - 1); }
+
+        /*  The values are { ar, ai, br, bi, cr, ci, dr, di }, and the twiddles are
+            { w1r, w1i, w2r, w2i, w3r, w3i }.
+        */
+        template <typename T>
+        static forcedinline void butterfly (T* v, const T* w) noexcept
+        {
+            const T apcr = v[0] + v[4], apci = v[1] + v[5];
+            const T amcr = v[0] - v[4], amci = v[1] - v[5];
+            const T bpdr = v[2] + v[6], bpdi = v[3] + v[7];
+            const T bmdr = v[2] - v[6], bmdi = v[3] - v[7];
+
+            const T t1r = amcr + bmdi, t1i = amci - bmdr;
+            const T t2r = apcr - bpdr, t2i = apci - bpdi;
+            const T t3r = amcr - bmdi, t3i = amci + bmdr;
+
+            v[0] = apcr + bpdr;
+            v[1] = apci + bpdi;
+            v[2] = t1r * w[0] - t1i * w[1];
+            v[3] = t1r * w[1] + t1i * w[0];
+            v[4] = t2r * w[2] - t2i * w[3];
+            v[5] = t2r * w[3] + t2i * w[2];
+            v[6] = t3r * w[4] - t3i * w[5];
+            v[7] = t3r * w[5] + t3i * w[4];
+        }
+
+        void radix4Pass (const Stage& stage, const float* xr, const float* xi, float* yr, float* yi) const noexcept
+        {
+            const auto s = stage.s, m = stage.n / 4;
+            const auto stride = roundUpToVec (m);
+            const auto* w = twiddles.data + stage.twiddleOffset;
+
+            if (s >= vecSize)
+            {
+                // Later passes: the twiddle is the same across each run of s values
+                for (int p = 0; p < m; ++p)
+                {
+                    Vec tw[6];
+
+                    for (int i = 0; i < 6; ++i)
+                        tw[i] = Vec::expand (w[i * stride + p]);
+
+                    for (int q = 0; q < s; q += vecSize)
+                    {
+                        Vec v[8];
+
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            v[2 * k]     = Vec::fromRawArray (xr + q + s * (p + k * m));
+                            v[2 * k + 1] = Vec::fromRawArray (xi + q + s * (p + k * m));
+                        }
+
+                        butterfly (v, tw);
+
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            v[2 * k]    .copyToRawArray (yr + q + s * (4 * p + k));
+                            v[2 * k + 1].copyToRawArray (yi + q + s * (4 * p + k));
+                        }
+                    }
+                }
+            }
+            else if (s == 1 && m >= vecSize)
+            {
+                // First pass: the inputs and twiddles are contiguous, but the outputs are interleaved
+                alignas (64) float results[8][vecSize];
+
+                for (int p = 0; p < m; p += vecSize)
+                {
+                    Vec tw[6], v[8];
+
+                    for (int i = 0; i < 6; ++i)
+                        tw[i] = Vec::fromRawArray (w + i * stride + p);
+
+                    for (int k = 0; k < 4; ++k)
+                    {
+                        v[2 * k]     = Vec::fromRawArray (xr + p + k * m);
+                        v[2 * k + 1] = Vec::fromRawArray (xi + p + k * m);
+                    }
+
+                    butterfly (v, tw);
+
+                    for (int i = 0; i < 8; ++i)
+                        v[i].copyToRawArray (results[i]);
+
+                    for (int j = 0; j < vecSize; ++j)
+                    {
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            yr[4 * (p + j) + k] = results[2 * k][j];
+                            yi[4 * (p + j) + k] = results[2 * k + 1][j];
+                        }
+                    }
+                }
+            }
+            else
+            {
+                for (int p = 0; p < m; ++p)
+                {
+                    float tw[6];
+
+                    for (int i = 0; i < 6; ++i)
+                        tw[i] = w[i * stride + p];
+
+                    for (int q = 0; q < s; ++q)
+                    {
+                        float v[8];
+
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            v[2 * k]     = xr[q + s * (p + k * m)];
+                            v[2 * k + 1] = xi[q + s * (p + k * m)];
+                        }
+
+                        butterfly (v, tw);
+
+                        for (int k = 0; k < 4; ++k)
+                        {
+                            yr[q + s * (4 * p + k)] = v[2 * k];
+                            yi[q + s * (4 * p + k)] = v[2 * k + 1];
+                        }
+                    }
+                }
+            }
+        }
+
+        static void radix2Pass (int s, const float* xr, const float* xi, float* yr, float* yi) noexcept
+        {
+            forEachBlock (s, [&] (auto zero, int q)
+            {
+                const auto ar = load (xr + q, zero),     ai = load (xi + q, zero);
+                const auto br = load (xr + q + s, zero), bi = load (xi + q + s, zero);
+
+                store (yr + q,     ar + br);
+                store (yi + q,     ai + bi);
+                store (yr + q + s, ar - br);
+                store (yi + q + s, ai - bi);
+            });
+        }
+
+        int fftSize;
+        Array<Stage> stages;
+        AlignedBuffer twiddles;
+    };
+
+    //==============================================================================
+    const int size;
+    Plan complexPlan, halfPlan;
+    AlignedBuffer realTwiddles;
+    mutable AlignedBuffer scratch[3];
+    SpinLock processLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SIMDFFT)
+};
+
+FFT::EngineImpl<SIMDFFT> simdFFT;
+#endif
+
 //==============================================================================
 //==============================================================================
 #if (JUCE_MAC || JUCE_IOS) && JUCE_USE_VDSP_FRAMEWORK
@@ -31,9 +31,10 @@ namespace dsp
 /**
     Performs a fast fourier transform.
 
-    This is only a simple low-footprint implementation and isn't tuned for speed - it may
-    be useful for simple applications where one of the more complex FFT libraries would be
-    overkill. (But in the future it may end up becoming optimised of course...)
+    The transform is performed by the fastest engine that's available on the platform:
+    vDSP on Apple platforms, or FFTW or Intel's libraries if they've been enabled. Otherwise,
+    a built-in engine that's vectorised using SIMDRegister will be used, or a simple scalar
+    implementation on platforms without SIMD support.
 
     The FFT class itself contains lookup tables, so there's some overhead in creating
     one, you should create and cache an FFT object for each size/direction of transform
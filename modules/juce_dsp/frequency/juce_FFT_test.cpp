@@ -192,6 +192,62 @@ struct FFTUnitTest  : public UnitTest
         }
     };
 
+    struct LargeOrderTest
+    {
+        static void run (FFTUnitTest& u)
+        {
+            Random random (378272);
+
+            for (int order = 9; order <= 13; ++order)
+            {
+                auto n = (size_t) 1 << order;
+
+                FFT fft (order);
+
+                HeapBlock<Complex<float>> input (n), output (n), roundTrip (n);
+                fillRandom (random, input.getData(), n);
+
+                fft.perform (input.getData(), output.getData(), false);
+
+                // The full reference transform is too slow at these sizes, so only check some of the bins
+                for (int i = 0; i < 16; ++i)
+                {
+                    auto bin = (size_t) random.nextInt ((int) n);
+                    std::complex<double> expected;
+
+                    for (size_t k = 0; k < n; ++k)
+                        expected += std::complex<double> (input[k])
+                                      * std::polar (1.0, -MathConstants<double>::twoPi * (double) ((bin * k) % n) / (double) n);
+
+                    u.expect (std::abs (expected - std::complex<double> (output[bin])) < 1.0e-3 * std::sqrt ((double) n));
+                }
+
+                fft.perform (output.getData(), roundTrip.getData(), true);
+                u.expect (checkArrayIsSimilar (roundTrip.getData(), input.getData(), n));
+
+                // The real-only transform should match the complex one with zero imaginary parts
+                HeapBlock<float> real (n * 2, true);
+
+                for (size_t i = 0; i < n; ++i)
+                {
+                    real[i] = input[i].real();
+                    input[i].imag (0.0f);
+                }
+
+                fft.perform (input.getData(), output.getData(), false);
+                fft.performRealOnlyForwardTransform (real.getData());
+
+                for (size_t i = 0; i < n; ++i)
+                    u.expect (std::abs (output[i] - Complex<float> (real[i * 2], real[i * 2 + 1])) < 1.0e-5f * (float) n);
+
+                fft.performRealOnlyInverseTransform (real.getData());
+
+                for (size_t i = 0; i < n; ++i)
+                    u.expect (std::abs (real[i] - input[i].real()) < 1.0e-3f);
+            }
+        }
+    };
+
     template <class TheTest>
     void runTestForAllTypes (const char* unitTestName)
     {
@@ -205,6 +261,7 @@ struct FFTUnitTest  : public UnitTest
         runTestForAllTypes<RealTest> ("Real input numbers Test");
         runTestForAllTypes<FrequencyOnlyTest> ("Frequency only Test");
         runTestForAllTypes<ComplexTest> ("Complex input numbers Test");
+        runTestForAllTypes<LargeOrderTest> ("Large orders Test");
     }
 };
 
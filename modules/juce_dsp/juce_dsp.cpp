@@ -56,9 +56,11 @@
 
 #include "processors/juce_FIRFilter.cpp"
 #include "processors/juce_IIRFilter.cpp"
+#include "processors/juce_BiquadCascade.cpp"
 #include "processors/juce_FirstOrderTPTFilter.cpp"
 #include "processors/juce_Panner.cpp"
 #include "processors/juce_Oversampling.cpp"
+#include "processors/juce_SampleRateConverter.cpp"
 #include "processors/juce_BallisticsFilter.cpp"
 #include "processors/juce_LinkwitzRileyFilter.cpp"
 #include "processors/juce_DelayLine.cpp"
@@ -104,6 +106,9 @@
  #include "containers/juce_FixedSizeFunction_test.cpp"
  #include "frequency/juce_Convolution_test.cpp"
  #include "frequency/juce_FFT_test.cpp"
+ #include "processors/juce_BiquadCascade_test.cpp"
  #include "processors/juce_FIRFilter_test.cpp"
+ #include "processors/juce_Oversampling_test.cpp"
  #include "processors/juce_ProcessorChain_test.cpp"
+ #include "processors/juce_SampleRateConverter_test.cpp"
 #endif
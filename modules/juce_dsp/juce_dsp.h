@@ -244,22 +244,24 @@ namespace juce
 #include "maths/juce_LogRampedValue.h"
 #include "containers/juce_AudioBlock.h"
 #include "containers/juce_FixedSizeFunction.h"
+#include "frequency/juce_FFT.h"
 #include "processors/juce_ProcessContext.h"
 #include "processors/juce_ProcessorWrapper.h"
 #include "processors/juce_ProcessorChain.h"
 #include "processors/juce_ProcessorDuplicator.h"
 #include "processors/juce_IIRFilter.h"
+#include "processors/juce_BiquadCascade.h"
 #include "processors/juce_FIRFilter.h"
 #include "processors/juce_StateVariableFilter.h"
 #include "processors/juce_FirstOrderTPTFilter.h"
 #include "processors/juce_Panner.h"
 #include "processors/juce_DelayLine.h"
 #include "processors/juce_Oversampling.h"
+#include "processors/juce_SampleRateConverter.h"
 #include "processors/juce_BallisticsFilter.h"
 #include "processors/juce_LinkwitzRileyFilter.h"
 #include "processors/juce_DryWetMixer.h"
 #include "processors/juce_StateVariableTPTFilter.h"
-#include "frequency/juce_FFT.h"
 #include "frequency/juce_Convolution.h"
 #include "frequency/juce_Windowing.h"
 #include "filter_design/juce_FilterDesign.h"
@@ -0,0 +1,321 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+/*  The state of one section for a group of channels, with one lane per channel.
+    The coefficients are stored in the order b0, b1, b2, a1, a2.
+*/
+template <typename SampleType>
+struct BiquadCascade<SampleType>::Section
+{
+    static constexpr size_t numCoefficients = 5;
+
+    ProcessingType coefficients[numCoefficients], targets[numCoefficients], deltas[numCoefficients];
+    ProcessingType state[2];
+    int numRampSamplesRemaining;
+
+    SampleType* lanes (ProcessingType* values) noexcept     { return reinterpret_cast<SampleType*> (values); }
+};
+
+//==============================================================================
+template <typename SampleType>
+BiquadCascade<SampleType>::BiquadCascade (size_t sectionsPerChannel)
+    : numSections (sectionsPerChannel)
+{
+    jassert (numSections > 0);
+}
+
+template <typename SampleType>
+BiquadCascade<SampleType>::~BiquadCascade() = default;
+
+template <typename SampleType>
+typename BiquadCascade<SampleType>::Section& BiquadCascade<SampleType>::getSection (size_t group, size_t section) noexcept
+{
+    jassert (group < numGroups && section < numSections);
+    return sections[group * numSections + section];
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::setRampLength (int numSamples) noexcept
+{
+    jassert (numSamples >= 0);
+    rampLength = jmax (0, numSamples);
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::setCoefficients (size_t channel, size_t section,
+                                                 const Coefficients<SampleType>& newCoefficients) noexcept
+{
+    // The cascade must be prepared before setting the coefficients for a channel
+    jassert (channel < numChannels);
+
+    if (channel >= numChannels)
+        return;
+
+    auto order = newCoefficients.getFilterOrder();
+    auto* raw = newCoefficients.getRawCoefficients();
+
+    // Only first and second order sections are supported
+    jassert (order <= 2);
+
+    SampleType values[Section::numCoefficients] = {};
+    values[0] = raw[0];
+
+    if (order == 1)
+    {
+        values[1] = raw[1];
+        values[3] = raw[2];
+    }
+    else if (order == 2)
+    {
+        for (size_t i = 1; i < Section::numCoefficients; ++i)
+            values[i] = raw[i];
+    }
+
+    auto& s = getSection (channel / numLanes, section);
+    auto lane = channel % numLanes;
+
+    for (size_t i = 0; i < Section::numCoefficients; ++i)
+        s.lanes (s.targets + i)[lane] = values[i];
+
+    startRamp (s);
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::setCoefficients (size_t section, const Coefficients<SampleType>& newCoefficients) noexcept
+{
+    for (size_t channel = 0; channel < numChannels; ++channel)
+        setCoefficients (channel, section, newCoefficients);
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::startRamp (Section& s) noexcept
+{
+    if (rampLength == 0)
+    {
+        for (size_t i = 0; i < Section::numCoefficients; ++i)
+            s.coefficients[i] = s.targets[i];
+
+        s.numRampSamplesRemaining = 0;
+        return;
+    }
+
+    // Any lanes which were already ramping start again from where they are now,
+    // so that all the lanes of a section finish together.
+    auto scale = static_cast<SampleType> (1) / static_cast<SampleType> (rampLength);
+
+    for (size_t i = 0; i < Section::numCoefficients; ++i)
+        for (size_t lane = 0; lane < numLanes; ++lane)
+            s.lanes (s.deltas + i)[lane] = (s.lanes (s.targets + i)[lane] - s.lanes (s.coefficients + i)[lane]) * scale;
+
+    s.numRampSamplesRemaining = rampLength;
+}
+
+//==============================================================================
+template <typename SampleType>
+void BiquadCascade<SampleType>::prepare (const ProcessSpec& spec)
+{
+    numChannels = (size_t) spec.numChannels;
+    numGroups = (numChannels + numLanes - 1) / numLanes;
+    maximumBlockSize = jmax ((size_t) 1, (size_t) spec.maximumBlockSize);
+
+    constexpr auto alignment = alignof (ProcessingType);
+
+    sectionMemory.malloc (sizeof (Section) * numGroups * numSections + alignment);
+    sections = reinterpret_cast<Section*> (snapPointerToAlignment (sectionMemory.getData(), alignment));
+
+    bufferMemory.malloc (sizeof (ProcessingType) * maximumBlockSize + alignment);
+    buffer = reinterpret_cast<ProcessingType*> (snapPointerToAlignment (bufferMemory.getData(), alignment));
+
+    for (size_t i = 0; i < numGroups * numSections; ++i)
+    {
+        auto& s = sections[i];
+
+        for (size_t c = 0; c < Section::numCoefficients; ++c)
+        {
+            s.coefficients[c] = static_cast<SampleType> (c == 0 ? 1 : 0);
+            s.targets[c] = s.coefficients[c];
+            s.deltas[c] = static_cast<SampleType> (0);
+        }
+    }
+
+    reset();
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::reset() noexcept
+{
+    for (size_t i = 0; i < numGroups * numSections; ++i)
+    {
+        auto& s = sections[i];
+
+        for (size_t c = 0; c < Section::numCoefficients; ++c)
+            s.coefficients[c] = s.targets[c];
+
+        s.state[0] = s.state[1] = static_cast<SampleType> (0);
+        s.numRampSamplesRemaining = 0;
+    }
+}
+
+//==============================================================================
+template <typename SampleType>
+void BiquadCascade<SampleType>::processBlock (const AudioBlock<const SampleType>& inputBlock,
+                                              const AudioBlock<SampleType>& outputBlock,
+                                              bool isBypassed) noexcept
+{
+    jassert (inputBlock.getNumChannels() == numChannels);
+    jassert (outputBlock.getNumChannels() == numChannels);
+    jassert (inputBlock.getNumSamples() == outputBlock.getNumSamples());
+
+    auto numSamples = outputBlock.getNumSamples();
+
+    if (numChannels == 0)
+        return;
+
+    for (size_t start = 0; start < numSamples; start += maximumBlockSize)
+    {
+        auto num = jmin (maximumBlockSize, numSamples - start);
+
+        for (size_t group = 0; group < numGroups; ++group)
+        {
+            auto* samples = reinterpret_cast<SampleType*> (buffer);
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                auto channel = group * numLanes + lane;
+
+                if (channel < numChannels)
+                {
+                    auto* src = inputBlock.getChannelPointer (channel) + start;
+
+                    for (size_t i = 0; i < num; ++i)
+                        samples[i * numLanes + lane] = src[i];
+                }
+                else
+                {
+                    for (size_t i = 0; i < num; ++i)
+                        samples[i * numLanes + lane] = 0;
+                }
+            }
+
+            processGroup (group, buffer, num);
+
+            if (isBypassed)
+                continue;
+
+            for (size_t lane = 0; lane < numLanes; ++lane)
+            {
+                auto channel = group * numLanes + lane;
+
+                if (channel >= numChannels)
+                    break;
+
+                auto* dst = outputBlock.getChannelPointer (channel) + start;
+
+                for (size_t i = 0; i < num; ++i)
+                    dst[i] = samples[i * numLanes + lane];
+            }
+        }
+    }
+
+    if (isBypassed && inputBlock.getChannelPointer (0) != outputBlock.getChannelPointer (0))
+        outputBlock.copyFrom (inputBlock);
+}
+
+template <typename SampleType>
+void BiquadCascade<SampleType>::processGroup (size_t group, ProcessingType* samples, size_t numSamples) noexcept
+{
+    for (size_t section = 0; section < numSections; ++section)
+    {
+        auto& s = getSection (group, section);
+
+        auto b0 = s.coefficients[0], b1 = s.coefficients[1], b2 = s.coefficients[2];
+        auto a1 = s.coefficients[3], a2 = s.coefficients[4];
+        auto lv1 = s.state[0], lv2 = s.state[1];
+
+        size_t i = 0;
+
+        if (s.numRampSamplesRemaining > 0)
+        {
+            auto numToRamp = jmin (numSamples, (size_t) s.numRampSamplesRemaining);
+
+            auto db0 = s.deltas[0], db1 = s.deltas[1], db2 = s.deltas[2];
+            auto da1 = s.deltas[3], da2 = s.deltas[4];
+
+            for (; i < numToRamp; ++i)
+            {
+                b0 += db0;  b1 += db1;  b2 += db2;
+                a1 += da1;  a2 += da2;
+
+                auto input = samples[i];
+                auto output = (input * b0) + lv1;
+                lv1 = (input * b1) - (output * a1) + lv2;
+                lv2 = (input * b2) - (output * a2);
+                samples[i] = output;
+            }
+
+            s.numRampSamplesRemaining -= (int) numToRamp;
+
+            if (s.numRampSamplesRemaining == 0)
+            {
+                // Snap to the exact targets, to avoid any accumulated rounding errors
+                b0 = s.targets[0];  b1 = s.targets[1];  b2 = s.targets[2];
+                a1 = s.targets[3];  a2 = s.targets[4];
+            }
+
+            s.coefficients[0] = b0;  s.coefficients[1] = b1;  s.coefficients[2] = b2;
+            s.coefficients[3] = a1;  s.coefficients[4] = a2;
+        }
+
+        for (; i < numSamples; ++i)
+        {
+            auto input = samples[i];
+            auto output = (input * b0) + lv1;
+            lv1 = (input * b1) - (output * a1) + lv2;
+            lv2 = (input * b2) - (output * a2);
+            samples[i] = output;
+        }
+
+        s.state[0] = lv1;
+        s.state[1] = lv2;
+
+        for (auto* state : { s.state, s.state + 1 })
+            for (size_t lane = 0; lane < numLanes; ++lane)
+                util::snapToZero (s.lanes (state)[lane]);
+    }
+}
+
+template class BiquadCascade<float>;
+template class BiquadCascade<double>;
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,138 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+/**
+    A multi-channel cascade of first and second order IIR sections, using the
+    Transposed Direct Form II structure.
+
+    Each channel runs through the same number of sections in series, but every
+    channel can have its own coefficients for each section. This gives the same
+    results as a chain of Filter objects for every channel, but when SIMD is
+    available, the channels are interleaved and processed in groups, as many at
+    a time as fit in a SIMDRegister, which is much faster when there are lots of
+    channels.
+
+    New coefficients can be faded in over a number of samples, by setting a ramp
+    length. The coefficients are then interpolated linearly for each sample, which
+    avoids the clicks you'd get from switching them suddenly, without having to
+    design a new filter for every sample. If the old and new sections are both
+    stable, then so is every section in between.
+
+    The coefficients should be changed on the same thread that calls process().
+
+    @see Filter, ProcessorDuplicator
+
+    @tags{DSP}
+*/
+template <typename SampleType>
+class JUCE_API  BiquadCascade
+{
+public:
+    //==============================================================================
+    /** Creates a cascade with the given number of sections.
+
+        All the sections are initially set to pass the signal through unchanged.
+    */
+    explicit BiquadCascade (size_t numSections = 1);
+
+    /** Destructor. */
+    ~BiquadCascade();
+
+    //==============================================================================
+    /** Returns the number of sections in each channel's cascade. */
+    size_t getNumSections() const noexcept                  { return numSections; }
+
+    /** Returns the number of channels that the cascade was prepared for. */
+    size_t getNumChannels() const noexcept                  { return numChannels; }
+
+    /** Sets the number of samples over which new coefficients are faded in. If this
+        is zero, they take effect immediately.
+    */
+    void setRampLength (int numSamples) noexcept;
+
+    /** Changes the coefficients for one of the sections of a channel.
+
+        The coefficients must be for a first or second order filter.
+    */
+    void setCoefficients (size_t channel, size_t section, const Coefficients<SampleType>& newCoefficients) noexcept;
+
+    /** Changes the coefficients for one of the sections of every channel. */
+    void setCoefficients (size_t section, const Coefficients<SampleType>& newCoefficients) noexcept;
+
+    //==============================================================================
+    /** Initialises the processor. This allocates the state for the number of channels
+        in the ProcessSpec, and resets all the coefficients to pass the signal through.
+    */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the state of all the filters, and finishes any coefficient ramps. */
+    void reset() noexcept;
+
+    /** Processes a block of samples. */
+    template <typename ProcessContext>
+    void process (const ProcessContext& context) noexcept
+    {
+        processBlock (context.getInputBlock(), context.getOutputBlock(), context.isBypassed);
+    }
+
+private:
+    //==============================================================================
+   #if JUCE_USE_SIMD
+    using ProcessingType = SIMDRegister<SampleType>;
+   #else
+    using ProcessingType = SampleType;
+   #endif
+
+    static constexpr size_t numLanes = sizeof (ProcessingType) / sizeof (SampleType);
+
+    struct Section;
+
+    void processBlock (const AudioBlock<const SampleType>&, const AudioBlock<SampleType>&, bool isBypassed) noexcept;
+    void processGroup (size_t group, ProcessingType* buffer, size_t numSamples) noexcept;
+    void startRamp (Section&) noexcept;
+
+    Section& getSection (size_t group, size_t section) noexcept;
+
+    //==============================================================================
+    size_t numSections, numChannels = 0, numGroups = 0, maximumBlockSize = 0;
+    int rampLength = 0;
+
+    HeapBlock<char> sectionMemory, bufferMemory;
+    Section* sections = nullptr;
+    ProcessingType* buffer = nullptr;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (BiquadCascade)
+};
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
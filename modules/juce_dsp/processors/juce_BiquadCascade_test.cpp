@@ -0,0 +1,160 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+namespace IIR
+{
+
+class BiquadCascadeTest : public UnitTest
+{
+public:
+    BiquadCascadeTest()
+        : UnitTest ("BiquadCascade", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        beginTest ("A cascade gives the same result as a chain of filters for each channel");
+        {
+            testMatchesFilters<float>  (1.0e-4);
+            testMatchesFilters<double> (1.0e-10);
+        }
+
+        beginTest ("Coefficients are interpolated linearly over the ramp length");
+        {
+            testRamp<float>  (1.0e-5);
+            testRamp<double> (1.0e-12);
+        }
+    }
+
+private:
+    template <typename SampleType>
+    void testMatchesFilters (double tolerance)
+    {
+        constexpr size_t numChannels = 5, numSections = 3, blockSize = 128;
+        const double sampleRate = 48000.0;
+
+        BiquadCascade<SampleType> cascade (numSections);
+        cascade.prepare ({ sampleRate, (uint32) blockSize, (uint32) numChannels });
+
+        std::vector<Filter<SampleType>> filters (numChannels * numSections);
+
+        for (size_t ch = 0; ch < numChannels; ++ch)
+        {
+            auto frequency = static_cast<SampleType> (200.0 * (double) (ch + 1));
+
+            typename Coefficients<SampleType>::Ptr sectionCoefficients[] =
+            {
+                Coefficients<SampleType>::makePeakFilter (sampleRate, frequency, static_cast<SampleType> (0.7),
+                                                          static_cast<SampleType> (2.0)),
+                Coefficients<SampleType>::makeFirstOrderHighPass (sampleRate, frequency / 4),
+                Coefficients<SampleType>::makeLowPass (sampleRate, frequency * 8)
+            };
+
+            for (size_t section = 0; section < numSections; ++section)
+            {
+                cascade.setCoefficients (ch, section, *sectionCoefficients[section]);
+                filters[ch * numSections + section].coefficients = sectionCoefficients[section];
+            }
+        }
+
+        Random random (0x1234);
+        const size_t blockSizes[] = { blockSize, 57, blockSize * 3 };
+
+        for (auto numSamples : blockSizes)
+        {
+            AudioBuffer<SampleType> input ((int) numChannels, (int) numSamples);
+
+            for (int ch = 0; ch < input.getNumChannels(); ++ch)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    input.setSample (ch, i, static_cast<SampleType> (random.nextDouble() * 2.0 - 1.0));
+
+            AudioBuffer<SampleType> output (input), expected (input);
+
+            AudioBlock<SampleType> block (output);
+            cascade.process (ProcessContextReplacing<SampleType> (block));
+
+            for (size_t ch = 0; ch < numChannels; ++ch)
+            {
+                AudioBlock<SampleType> channelBlock (expected);
+                auto singleChannel = channelBlock.getSingleChannelBlock (ch);
+
+                for (size_t section = 0; section < numSections; ++section)
+                    filters[ch * numSections + section].process (ProcessContextReplacing<SampleType> (singleChannel));
+            }
+
+            expectBuffersMatch (output, expected, tolerance);
+        }
+    }
+
+    template <typename SampleType>
+    void testRamp (double tolerance)
+    {
+        constexpr int rampLength = 100, numSamples = 256;
+
+        BiquadCascade<SampleType> cascade;
+        cascade.prepare ({ 44100.0, (uint32) numSamples, 2 });
+        cascade.setRampLength (rampLength);
+        cascade.setCoefficients (0, Coefficients<SampleType> (3, 0, 1, 0));
+
+        AudioBuffer<SampleType> buffer (2, numSamples);
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+            for (int i = 0; i < numSamples; ++i)
+                buffer.setSample (ch, i, static_cast<SampleType> (1));
+
+        AudioBlock<SampleType> block (buffer);
+        cascade.process (ProcessContextReplacing<SampleType> (block));
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            for (int i = 0; i < numSamples; ++i)
+            {
+                auto expected = i < rampLength ? 1.0 + 2.0 * (i + 1) / rampLength : 3.0;
+                expectWithinAbsoluteError ((double) buffer.getSample (ch, i), expected, tolerance);
+            }
+        }
+    }
+
+    template <typename SampleType>
+    void expectBuffersMatch (const AudioBuffer<SampleType>& a, const AudioBuffer<SampleType>& b, double tolerance)
+    {
+        double maxError = 0;
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                maxError = jmax (maxError, std::abs ((double) a.getSample (ch, i) - (double) b.getSample (ch, i)));
+
+        expectLessThan (maxError, tolerance);
+    }
+};
+
+static BiquadCascadeTest biquadCascadeTest;
+
+} // namespace IIR
+} // namespace dsp
+} // namespace juce
@@ -41,10 +41,18 @@ namespace FIR
         A processing class that can perform FIR filtering on an audio signal, in the
         time domain.
 
-        Using FIRFilter is fast enough for FIRCoefficients with a size lower than 128
-        samples. For longer filters, it might be more efficient to use the class
-        Convolution instead, which does the same processing in the frequency domain
-        thanks to FFT.
+        When a whole block is processed, the filter's taps are run through SIMD
+        registers, and for long filters of floats, each block is convolved with
+        the filter's frequency response using an FFT (the overlap-save method) when
+        that needs fewer operations. The two methods give the same results, apart
+        from rounding errors, and neither adds any latency, so you can keep using
+        this class for filters with hundreds or thousands of coefficients.
+        Processing one sample at a time with processSample() always happens in the
+        time domain.
+
+        For very long impulse responses, such as reverbs, it's still much more
+        efficient to use the class Convolution instead, which splits the response
+        into partitions and does all its processing in the frequency domain.
 
         @see FIRFilter::Coefficients, Convolution, FFT
 
@@ -97,15 +105,13 @@ namespace FIR
                 auto newSize = coefficients->getFilterOrder() + 1;
 
                 if (newSize != size)
-                {
-                    memory.malloc (1 + jmax (newSize, size, static_cast<size_t> (128)));
+                    allocate (newSize);
 
-                    fifo = snapPointerToAlignment (memory.getData(), sizeof (SampleType));
-                    size = newSize;
-                }
+                for (size_t i = 0; i < historySize + historyPadding; ++i)
+                    history[i] = SampleType {0};
 
-                for (size_t i = 0; i < size; ++i)
-                    fifo[i] = SampleType {0};
+                pos = size - 1;
+                updateKernels();
             }
         }
 
@@ -127,6 +133,9 @@ namespace FIR
                            "The sample-type of the FIR filter must match the sample-type supplied to this process callback");
             check();
 
+            if (! kernelsMatch())
+                updateKernels();
+
             auto&& inputBlock  = context.getInputBlock();
             auto&& outputBlock = context.getOutputBlock();
 
@@ -139,24 +148,24 @@ namespace FIR
             auto* src = inputBlock .getChannelPointer (0);
             auto* dst = outputBlock.getChannelPointer (0);
 
-            auto* fir = coefficients->getRawCoefficients();
-            size_t p = pos;
-
-            if (context.isBypassed)
-            {
-                for (size_t i = 0; i < numSamples; ++i)
-                {
-                    fifo[p] = dst[i] = src[i];
-                    p = (p == 0 ? size - 1 : p - 1);
-                }
-            }
-            else
+            while (numSamples > 0)
             {
-                for (size_t i = 0; i < numSamples; ++i)
-                    dst[i] = processSingleSample (src[i], fifo, fir, size, p);
-            }
+                auto numToDo = jmin (numSamples, historySize - pos, fftSegmentSize);
+
+                // The input is copied into the history first, so src and dst can be the same
+                std::copy (src, src + numToDo, history + pos);
+                std::fill (history + pos + numToDo, history + pos + numToDo + historyPadding, SampleType {0});
 
-            pos = p;
+                if (context.isBypassed)
+                    std::copy (src, src + numToDo, dst);
+                else if (! processSegmentWithFFT (dst, numToDo))
+                    processSegment (dst, numToDo);
+
+                advance (numToDo);
+                src += numToDo;
+                dst += numToDo;
+                numSamples -= numToDo;
+            }
         }
 
 
@@ -166,14 +175,51 @@ namespace FIR
         SampleType JUCE_VECTOR_CALLTYPE processSample (SampleType sample) noexcept
         {
             check();
-            return processSingleSample (sample, fifo, coefficients->getRawCoefficients(), size, pos);
+            auto* fir = coefficients->getRawCoefficients();
+
+            auto* buf = history + pos;
+            *buf = sample;
+
+            SampleType out (0);
+
+            for (size_t k = 0; k < size; ++k)
+                out += *(buf - k) * fir[k];
+
+            advance (1);
+            return out;
         }
 
     private:
         //==============================================================================
+        // The history holds the input in time order. The last size - 1 samples are
+        // followed by space for at least another size, so that the input for each
+        // output is contiguous. When the space runs out, the last size - 1 samples
+        // are moved back to the start.
         HeapBlock<SampleType> memory;
-        SampleType* fifo = nullptr;
-        size_t pos = 0, size = 0;
+        SampleType* history = nullptr;
+        size_t pos = 0, size = 0, historySize = 0;
+
+        // The kernels are the coefficients in reverse order. There's a copy for each
+        // possible alignment of the input, shifted along by that many zeros, so that
+        // every load is aligned.
+       #if JUCE_USE_SIMD
+        static constexpr size_t numLanes = std::is_same<SampleType, NumericType>::value ? SIMDRegister<NumericType>::SIMDNumElements : 1;
+       #else
+        static constexpr size_t numLanes = 1;
+       #endif
+        static constexpr size_t historyPadding = 2 * numLanes;
+        HeapBlock<NumericType> kernelMemory;
+        NumericType* kernels = nullptr;
+        size_t kernelSize = 0;
+
+        // For overlap-save processing, which is only done for long filters of floats
+        static constexpr size_t minimumSizeForFFT = 64;
+        static constexpr double fftCostFactor = 1.5;
+        std::unique_ptr<FFT> fft;
+        HeapBlock<float> fftMemory;
+        float* fftKernel = nullptr;
+        float* fftBuffer = nullptr;
+        size_t fftSegmentSize = std::numeric_limits<size_t>::max();
 
         //==============================================================================
         void check()
@@ -184,25 +230,189 @@ namespace FIR
                 reset();
         }
 
-        static SampleType JUCE_VECTOR_CALLTYPE processSingleSample (SampleType sample, SampleType* buf,
-                                                                    const NumericType* fir, size_t m, size_t& p) noexcept
+        void allocate (size_t newSize)
         {
-            SampleType out (0);
+            auto alignment = numLanes * sizeof (NumericType);
+
+            size = newSize;
+            allocateFFT (std::is_same<SampleType, float>());
+
+            auto spaceForInput = jmax (size, (size_t) 64, fft != nullptr ? fftSegmentSize : 0);
+            historySize = size - 1 + spaceForInput;
+            memory.malloc (historySize + historyPadding + 1 + alignment / sizeof (SampleType));
+            history = snapPointerToAlignment (memory.getData(), jmax (alignment, sizeof (SampleType)));
+
+            kernelSize = numLanes * ((size + 2 * numLanes - 2) / numLanes);
+            kernelMemory.malloc (numLanes * kernelSize + numLanes);
+            kernels = snapPointerToAlignment (kernelMemory.getData(), alignment);
+        }
+
+        void allocateFFT (std::true_type)
+        {
+            fft.reset();
+            fftSegmentSize = std::numeric_limits<size_t>::max();
+
+            if (size >= minimumSizeForFFT)
+            {
+                auto fftOrder = (int) std::ceil (std::log2 ((double) size * 2));
+                auto fftSize = (size_t) 1 << fftOrder;
+
+                fft.reset (new FFT (fftOrder));
+                fftMemory.malloc (4 * fftSize);
+                fftKernel = fftMemory.getData();
+                fftBuffer = fftKernel + 2 * fftSize;
+                fftSegmentSize = fftSize - size + 1;
+            }
+        }
+
+        void allocateFFT (std::false_type) {}
+
+        bool kernelsMatch() const noexcept
+        {
+            auto* fir = coefficients->getRawCoefficients();
+
+            for (size_t i = 0; i < size; ++i)
+                if (kernels[size - 1 - i] != fir[i])
+                    return false;
+
+            return true;
+        }
+
+        void updateKernels()
+        {
+            auto* fir = coefficients->getRawCoefficients();
+
+            for (size_t offset = 0; offset < numLanes; ++offset)
+            {
+                auto* kernel = kernels + offset * kernelSize;
+
+                std::fill (kernel, kernel + kernelSize, NumericType());
+                std::reverse_copy (fir, fir + size, kernel + offset);
+            }
+
+            updateFFTKernel (std::is_same<SampleType, float>());
+        }
+
+        void updateFFTKernel (std::true_type)
+        {
+            if (fft != nullptr)
+            {
+                auto fftSize = (size_t) fft->getSize();
+                auto* fir = coefficients->getRawCoefficients();
+
+                std::fill (fftKernel, fftKernel + 2 * fftSize, 0.0f);
+                std::copy (fir, fir + size, fftKernel);
+                fft->performRealOnlyForwardTransform (fftKernel, true);
+            }
+        }
+
+        void updateFFTKernel (std::false_type) {}
+
+        //==============================================================================
+        void advance (size_t numSamples) noexcept
+        {
+            pos += numSamples;
+
+            if (pos == historySize)
+            {
+                std::copy (history + historySize - (size - 1), history + historySize, history);
+                pos = size - 1;
+            }
+        }
 
-            buf[p] = sample;
+        void processSegment (SampleType* dst, size_t numSamples) noexcept
+        {
+            auto start = pos + 1 - size;
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dst[i] = dotProduct (start + i);
+        }
+
+       #if JUCE_USE_SIMD
+        SampleType dotProduct (size_t start) const noexcept
+        {
+            return dotProduct (start, std::integral_constant<bool, (numLanes > 1)>());
+        }
 
-            size_t k;
-            for (k = 0; k < m - p; ++k)
-                out += buf[(p + k)] * fir[k];
+        SampleType dotProduct (size_t start, std::true_type) const noexcept
+        {
+            using Vec = SIMDRegister<NumericType>;
+
+            auto offset = start % numLanes;
+            auto* buf = reinterpret_cast<const NumericType*> (history + start - offset);
+            auto* kernel = kernels + offset * kernelSize;
+
+            auto sum = Vec::expand (0);
 
-            for (size_t j = 0; j < p; ++j)
-                out += buf[j] * fir[j + k];
+            for (size_t k = 0; k < kernelSize; k += numLanes)
+                sum += Vec::fromRawArray (buf + k) * Vec::fromRawArray (kernel + k);
 
-            p = (p == 0 ? m - 1 : p - 1);
+            return static_cast<SampleType> (sum.sum());
+        }
+
+        SampleType dotProduct (size_t start, std::false_type) const noexcept
+       #else
+        SampleType dotProduct (size_t start) const noexcept
+       #endif
+        {
+            auto* buf = history + start;
+            SampleType out (0);
+
+            // Newest sample first, to match processSample()
+            for (size_t k = size; k > 0; --k)
+                out += buf[k - 1] * kernels[k - 1];
 
             return out;
         }
 
+        //==============================================================================
+        bool processSegmentWithFFT (SampleType* dst, size_t numSamples) noexcept
+        {
+            return processSegmentWithFFT (dst, numSamples, std::is_same<SampleType, float>());
+        }
+
+        bool processSegmentWithFFT (SampleType*, size_t, std::false_type) noexcept
+        {
+            return false;
+        }
+
+        bool processSegmentWithFFT (SampleType* dst, size_t numSamples, std::true_type) noexcept
+        {
+            if (fft == nullptr)
+                return false;
+
+            auto fftSize = (size_t) fft->getSize();
+
+            // A rough comparison of the number of operations for each method
+            auto timeDomainCost = (double) numSamples * (double) size / (double) numLanes;
+            auto fftCost = fftCostFactor * (double) fftSize * std::log2 ((double) fftSize);
+
+            if (timeDomainCost < fftCost)
+                return false;
+
+            auto numInputs = size - 1 + numSamples;
+            auto* input = history + pos + 1 - size;
+
+            std::copy (input, input + numInputs, fftBuffer);
+            std::fill (fftBuffer + numInputs, fftBuffer + 2 * fftSize, 0.0f);
+
+            fft->performRealOnlyForwardTransform (fftBuffer, true);
+
+            for (size_t i = 0; i <= fftSize; i += 2)
+            {
+                auto re = fftBuffer[i] * fftKernel[i]     - fftBuffer[i + 1] * fftKernel[i + 1];
+                auto im = fftBuffer[i] * fftKernel[i + 1] + fftBuffer[i + 1] * fftKernel[i];
+
+                fftBuffer[i]     = re;
+                fftBuffer[i + 1] = im;
+            }
+
+            fft->performRealOnlyInverseTransform (fftBuffer);
+
+            // The first size - 1 results wrap around, and are thrown away
+            std::copy (fftBuffer + size - 1, fftBuffer + numInputs, dst);
+            return true;
+        }
 
         JUCE_LEAK_DETECTOR (Filter)
     };
@@ -39,10 +39,10 @@ class FIRFilterTest : public UnitTest
                 buffer[i] = (2.0f * random.nextFloat()) - 1.0f;
         }
 
-        static bool checkArrayIsSimilar (Type* a, Type* b, size_t n) noexcept
+        static bool checkArrayIsSimilar (Type* a, Type* b, size_t n, double tolerance) noexcept
         {
             for (size_t i = 0; i < n; ++i)
-                if (std::abs (a[i] - b[i]) > 1e-6f)
+                if (std::abs (a[i] - b[i]) > tolerance)
                     return false;
 
             return true;
@@ -58,11 +58,11 @@ class FIRFilterTest : public UnitTest
             Helpers<Type>::fillRandom (random, reinterpret_cast<Type*> (buffer), n * SIMDRegister<Type>::size());
         }
 
-        static bool checkArrayIsSimilar (SIMDRegister<Type>* a, SIMDRegister<Type>* b, size_t n) noexcept
+        static bool checkArrayIsSimilar (SIMDRegister<Type>* a, SIMDRegister<Type>* b, size_t n, double tolerance) noexcept
         {
             return Helpers<Type>::checkArrayIsSimilar (reinterpret_cast<Type*> (a),
                                                        reinterpret_cast<Type*> (b),
-                                                       n * SIMDRegister<Type>::size());
+                                                       n * SIMDRegister<Type>::size(), tolerance);
         }
     };
    #endif
@@ -71,7 +71,7 @@ class FIRFilterTest : public UnitTest
     static void fillRandom (Random& random, Type* buffer, size_t n) { Helpers<Type>::fillRandom (random, buffer, n); }
 
     template <typename Type>
-    static bool checkArrayIsSimilar (Type* a, Type* b, size_t n) noexcept { return Helpers<Type>::checkArrayIsSimilar (a, b, n); }
+    static bool checkArrayIsSimilar (Type* a, Type* b, size_t n, double tolerance = 1e-6) noexcept { return Helpers<Type>::checkArrayIsSimilar (a, b, n, tolerance); }
 
     //==============================================================================
     // reference implementation of an FIR
@@ -161,14 +161,12 @@ class FIRFilterTest : public UnitTest
 
     //==============================================================================
     template <typename TheTest, typename SampleType, typename NumericType>
-    void runTestForType()
+    void runTestForType (std::initializer_list<int> sizes, size_t n, double tolerance)
     {
         Random random (8392829);
 
-        for (auto size : {1, 2, 4, 8, 12, 13, 25})
+        for (auto size : sizes)
         {
-            constexpr size_t n = 813;
-
             HeapBlock<char> inputBuffer, outputBuffer, refBuffer;
             AudioBlock<SampleType> input (inputBuffer, 1, n), output (outputBuffer, 1, n), ref (refBuffer, 1, n);
             fillRandom (random, input.getChannelPointer (0), n);
@@ -178,14 +176,14 @@ class FIRFilterTest : public UnitTest
             fillRandom (random, fir.getChannelPointer (0), static_cast<size_t> (size));
 
             FIR::Filter<SampleType> filter (*new FIR::Coefficients<NumericType> (fir.getChannelPointer (0), static_cast<size_t> (size)));
-            ProcessSpec spec {0.0, n, 1};
+            ProcessSpec spec {0.0, (uint32) n, 1};
             filter.prepare (spec);
 
             reference<SampleType, NumericType> (fir.getChannelPointer (0), static_cast<size_t> (size),
                                                 input.getChannelPointer (0), ref.getChannelPointer (0), n);
 
             TheTest::template run<SampleType> (filter, input.getChannelPointer (0), output.getChannelPointer (0), n);
-            expect (checkArrayIsSimilar (output.getChannelPointer (0), ref.getChannelPointer (0), n));
+            expect (checkArrayIsSimilar (output.getChannelPointer (0), ref.getChannelPointer (0), n, tolerance));
         }
     }
 
@@ -194,14 +192,57 @@ class FIRFilterTest : public UnitTest
     {
         beginTest (unitTestName);
 
-        runTestForType<TheTest, float, float>();
-        runTestForType<TheTest, double, double>();
+        const std::initializer_list<int> sizes { 1, 2, 4, 8, 12, 13, 25 };
+
+        runTestForType<TheTest, float, float> (sizes, 813, 1e-6);
+        runTestForType<TheTest, double, double> (sizes, 813, 1e-6);
+       #if JUCE_USE_SIMD
+        runTestForType<TheTest, SIMDRegister<float>, float> (sizes, 813, 1e-6);
+        runTestForType<TheTest, SIMDRegister<double>, double> (sizes, 813, 1e-6);
+       #endif
+    }
+
+    // Long filters are processed with an FFT, which has bigger rounding errors
+    template <typename TheTest>
+    void runLongFilterTestForAllTypes (const char* unitTestName)
+    {
+        beginTest (unitTestName);
+
+        const std::initializer_list<int> sizes { 63, 64, 200, 513, 1024 };
+
+        runTestForType<TheTest, float, float> (sizes, 5000, 1e-3);
+        runTestForType<TheTest, double, double> (sizes, 5000, 1e-9);
        #if JUCE_USE_SIMD
-        runTestForType<TheTest, SIMDRegister<float>, float>();
-        runTestForType<TheTest, SIMDRegister<double>, double>();
+        runTestForType<TheTest, SIMDRegister<float>, float> (sizes, 5000, 1e-3);
+        runTestForType<TheTest, SIMDRegister<double>, double> (sizes, 5000, 1e-9);
        #endif
     }
 
+    void runCoefficientChangeTest()
+    {
+        beginTest ("Changing the coefficients between blocks");
+
+        Random random (8392829);
+        constexpr size_t size = 300, n = 2048;
+
+        HeapBlock<float> input (n), output (n), ref (n), fir1 (size), fir2 (size);
+        fillRandom (random, input.get(), n);
+        fillRandom (random, fir1.get(), size);
+        fillRandom (random, fir2.get(), size);
+
+        FIR::Filter<float> filter (*new FIR::Coefficients<float> (fir1, size));
+        filter.prepare ({ 0.0, (uint32) n, 1 });
+
+        LargeBlockTest::run (filter, input.get(), output.get(), n / 2);
+
+        // The new coefficients should be used straight away, without resetting the filter
+        std::copy (fir2.get(), fir2.get() + size, filter.coefficients->getRawCoefficients());
+        LargeBlockTest::run (filter, input.get() + n / 2, output.get() + n / 2, n / 2);
+
+        reference (fir2.get(), size, input.get(), ref.get(), n);
+        expect (checkArrayIsSimilar (output.get() + n / 2, ref.get() + n / 2, n / 2, 1e-3));
+    }
+
 
 public:
     FIRFilterTest()
@@ -213,6 +254,12 @@ public:
         runTestForAllTypes<LargeBlockTest> ("Large Blocks");
         runTestForAllTypes<SampleBySampleTest> ("Sample by Sample");
         runTestForAllTypes<SplitBlockTest> ("Split Block");
+
+        runLongFilterTestForAllTypes<LargeBlockTest> ("Long filters, Large Blocks");
+        runLongFilterTestForAllTypes<SampleBySampleTest> ("Long filters, Sample by Sample");
+        runLongFilterTestForAllTypes<SplitBlockTest> ("Long filters, Split Block");
+
+        runCoefficientChangeTest();
     }
 };
 
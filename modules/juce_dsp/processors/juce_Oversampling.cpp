@@ -103,16 +103,92 @@ struct OversamplingDummy   : public Oversampling<SampleType>::OversamplingStage
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OversamplingDummy)
 };
 
+//==============================================================================
+/** Helper functions for the oversampling stages, which process their channels
+    in groups.
+
+    When ProcessingType is a SIMDRegister, each group holds as many channels as
+    there are elements in the register, interleaved so that every operation
+    processes all of them at once. Otherwise each group holds a single channel.
+*/
+template <typename SampleType, typename ProcessingType>
+struct OversamplingChannelGroups
+{
+    static constexpr size_t numLanes = sizeof (ProcessingType) / sizeof (SampleType);
+
+    static size_t getNumGroups (size_t numChannels) noexcept
+    {
+        return (numChannels + numLanes - 1) / numLanes;
+    }
+
+    /** Copies every stride-th sample from the channels of a group, starting at
+        startSample, into an interleaved buffer. Any lanes which don't have a
+        channel in the block are filled with zeros.
+    */
+    static void interleave (const AudioBlock<const SampleType>& block, size_t group,
+                            size_t startSample, size_t stride, SampleType gain,
+                            ProcessingType* destination, size_t numSamples) noexcept
+    {
+        auto* dest = reinterpret_cast<SampleType*> (destination);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            auto channel = group * numLanes + lane;
+
+            if (channel < block.getNumChannels())
+            {
+                auto* src = block.getChannelPointer (channel) + startSample;
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    dest[i * numLanes + lane] = src[i * stride] * gain;
+            }
+            else
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                    dest[i * numLanes + lane] = 0;
+            }
+        }
+    }
+
+    /** Copies an interleaved buffer back to the channels of a group. */
+    static void deinterleave (const ProcessingType* source, size_t numSamples,
+                              const AudioBlock<SampleType>& block, size_t group) noexcept
+    {
+        auto* src = reinterpret_cast<const SampleType*> (source);
+
+        for (size_t lane = 0; lane < numLanes; ++lane)
+        {
+            auto channel = group * numLanes + lane;
+
+            if (channel >= block.getNumChannels())
+                break;
+
+            auto* dest = block.getChannelPointer (channel);
+
+            for (size_t i = 0; i < numSamples; ++i)
+                dest[i] = src[i * numLanes + lane];
+        }
+    }
+};
+
 //==============================================================================
 /** Oversampling stage class performing 2 times oversampling using the Filter
     Design FIR Equiripple method. The resulting filter is linear phase,
     symmetric, and has every two samples but the middle one equal to zero,
     leading to specific processing optimizations.
+
+    The filter is split into its two polyphase components. The one made of the
+    even coefficients is symmetric, and the other one is a single coefficient,
+    so the multiplications by the zeros, and by the stuffed zeros of the
+    upsampled signal, are never done. The history of each component is kept in
+    a linear buffer with the new block appended to it, so no data is shifted
+    for each sample.
 */
-template <typename SampleType>
+template <typename SampleType, typename ProcessingType = SampleType>
 struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::OversamplingStage
 {
     using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Groups = OversamplingChannelGroups<SampleType, ProcessingType>;
 
     Oversampling2TimesEquirippleFIR (size_t numChans,
                                      SampleType normalisedTransitionWidthUp,
@@ -124,17 +200,16 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         coefficientsUp   = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthUp,   stopbandAmplitudedBUp);
         coefficientsDown = *FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (normalisedTransitionWidthDown, stopbandAmplitudedBDown);
 
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        stateUp.setSize (static_cast<int> (this->numChannels), static_cast<int> (N));
+        // The middle coefficient must have an odd index, for the zeros to be at the even ones
+        jassert (coefficientsUp.getFilterOrder() % 4 == 2 && coefficientsDown.getFilterOrder() % 4 == 2);
 
-        N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
+        historyUp   = (coefficientsUp.getFilterOrder()   + 1) / 2;
+        historyDown = (coefficientsDown.getFilterOrder() + 1) / 2;
+        delayDown   = historyDown / 2 + 1;
 
-        stateDown.setSize  (static_cast<int> (this->numChannels), static_cast<int> (N));
-        stateDown2.setSize (static_cast<int> (this->numChannels), static_cast<int> (Ndiv4 + 1));
-
-        position.resize (static_cast<int> (this->numChannels));
+        auto numGroups = Groups::getNumGroups (this->numChannels);
+        stateUp   = AudioBlock<ProcessingType> (stateUpMemory,   numGroups, historyUp);
+        stateDown = AudioBlock<ProcessingType> (stateDownMemory, numGroups, historyDown + delayDown);
     }
 
     //==============================================================================
@@ -143,15 +218,21 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
         return static_cast<SampleType> (coefficientsUp.getFilterOrder() + coefficientsDown.getFilterOrder()) * 0.5f;
     }
 
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+
+        scratch = AudioBlock<ProcessingType> (scratchMemory, 3,
+                                              jmax (historyUp, historyDown, delayDown)
+                                                + maximumNumberOfSamplesBeforeOversampling * 2);
+    }
+
     void reset() override
     {
         ParentType::reset();
 
         stateUp.clear();
         stateDown.clear();
-        stateDown2.clear();
-
-        position.fill (0);
     }
 
     void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
@@ -161,36 +242,39 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
 
         // Initialization
         auto fir = coefficientsUp.getRawCoefficients();
-        auto N = coefficientsUp.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
+        auto Ndiv2 = historyUp;
         auto numSamples = inputBlock.getNumSamples();
+        auto numChannelsToProcess = inputBlock.getNumChannels();
+        auto outputBlock = AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numChannelsToProcess);
+
+        auto buf = scratch.getChannelPointer (0);
+        auto bufferSamples = scratch.getChannelPointer (1);
 
         // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group < Groups::getNumGroups (numChannelsToProcess); ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateUp.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            // Input, after the last Ndiv2 input samples
+            auto state = stateUp.getChannelPointer (group);
+            std::copy (state, state + Ndiv2, buf);
+            Groups::interleave (inputBlock, group, 0, 1, 2, buf + Ndiv2, numSamples);
 
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = 2 * samples[i];
+                auto samples = buf + i;
 
                 // Convolution
-                auto out = static_cast<SampleType> (0.0);
+                auto out = static_cast<ProcessingType> (0.0);
 
                 for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                    out += (samples[k / 2] + samples[Ndiv2 - k / 2]) * fir[k];
 
                 // Outputs
                 bufferSamples[i << 1] = out;
-                bufferSamples[(i << 1) + 1] = buf[Ndiv2 + 1] * fir[Ndiv2];
-
-                // Shift data
-                for (size_t k = 0; k < N - 2; k += 2)
-                    buf[k] = buf[k + 2];
+                bufferSamples[(i << 1) + 1] = samples[(Ndiv2 + 1) / 2] * fir[Ndiv2];
             }
+
+            std::copy (buf + numSamples, buf + numSamples + Ndiv2, state);
+            Groups::deinterleave (bufferSamples, numSamples * 2, outputBlock, group);
         }
     }
 
@@ -201,55 +285,54 @@ struct Oversampling2TimesEquirippleFIR  : public Oversampling<SampleType>::Overs
 
         // Initialization
         auto fir = coefficientsDown.getRawCoefficients();
-        auto N = coefficientsDown.getFilterOrder() + 1;
-        auto Ndiv2 = N / 2;
-        auto Ndiv4 = Ndiv2 / 2;
+        auto Ndiv2 = historyDown;
         auto numSamples = outputBlock.getNumSamples();
+        auto numChannelsToProcess = outputBlock.getNumChannels();
+        auto inputBlock = AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numChannelsToProcess);
+
+        auto buf = scratch.getChannelPointer (0);
+        auto buf2 = scratch.getChannelPointer (1);
+        auto samples = scratch.getChannelPointer (2);
 
         // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group < Groups::getNumGroups (numChannelsToProcess); ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto buf = stateDown.getWritePointer (static_cast<int> (channel));
-            auto buf2 = stateDown2.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto pos = position.getUnchecked (static_cast<int> (channel));
+            // Even input samples after the last Ndiv2 ones, and odd input samples
+            // after the last delayDown ones
+            auto state = stateDown.getChannelPointer (group);
+            std::copy (state, state + Ndiv2, buf);
+            std::copy (state + Ndiv2, state + Ndiv2 + delayDown, buf2);
+            Groups::interleave (inputBlock, group, 0, 2, 1, buf + Ndiv2, numSamples);
+            Groups::interleave (inputBlock, group, 1, 2, 1, buf2 + delayDown, numSamples);
 
             for (size_t i = 0; i < numSamples; ++i)
             {
-                // Input
-                buf[N - 1] = bufferSamples[i << 1];
+                auto evenSamples = buf + i;
 
                 // Convolution
-                auto out = static_cast<SampleType> (0.0);
+                auto out = static_cast<ProcessingType> (0.0);
 
                 for (size_t k = 0; k < Ndiv2; k += 2)
-                    out += (buf[k] + buf[N - k - 1]) * fir[k];
+                    out += (evenSamples[k / 2] + evenSamples[Ndiv2 - k / 2]) * fir[k];
 
                 // Output
-                out += buf2[pos] * fir[Ndiv2];
-                buf2[pos] = bufferSamples[(i << 1) + 1];
-
+                out += buf2[i] * fir[Ndiv2];
                 samples[i] = out;
-
-                // Shift data
-                for (size_t k = 0; k < N - 2; ++k)
-                    buf[k] = buf[k + 2];
-
-                // Circular buffer
-                pos = (pos == 0 ? Ndiv4 : pos - 1);
             }
 
-            position.setUnchecked (static_cast<int> (channel), pos);
+            std::copy (buf + numSamples, buf + numSamples + Ndiv2, state);
+            std::copy (buf2 + numSamples, buf2 + numSamples + delayDown, state + Ndiv2);
+            Groups::deinterleave (samples, numSamples, outputBlock, group);
         }
-
     }
 
 private:
     //==============================================================================
     FIR::Coefficients<SampleType> coefficientsUp, coefficientsDown;
-    AudioBuffer<SampleType> stateUp, stateDown, stateDown2;
-    Array<size_t> position;
+    size_t historyUp = 0, historyDown = 0, delayDown = 0;
+
+    HeapBlock<char> stateUpMemory, stateDownMemory, scratchMemory;
+    AudioBlock<ProcessingType> stateUp, stateDown, scratch;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesEquirippleFIR)
@@ -261,10 +344,11 @@ private:
     Design IIR Polyphase Allpass Cascaded method. The resulting filter is minimum
     phase, and provided with a method to get the exact resulting latency.
 */
-template <typename SampleType>
+template <typename SampleType, typename ProcessingType = SampleType>
 struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::OversamplingStage
 {
     using ParentType = typename Oversampling<SampleType>::OversamplingStage;
+    using Groups = OversamplingChannelGroups<SampleType, ProcessingType>;
 
     Oversampling2TimesPolyphaseIIR (size_t numChans,
                                     SampleType normalisedTransitionWidthUp,
@@ -293,9 +377,10 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         for (auto i = 1; i < structureDown.delayedPath.size(); ++i)
             coefficientsDown.add (structureDown.delayedPath.getObjectPointer (i)->coefficients[0]);
 
-        v1Up.setSize   (static_cast<int> (this->numChannels), coefficientsUp.size());
-        v1Down.setSize (static_cast<int> (this->numChannels), coefficientsDown.size());
-        delayDown.resize (static_cast<int> (this->numChannels));
+        auto numGroups = Groups::getNumGroups (this->numChannels);
+        v1Up      = AudioBlock<ProcessingType> (v1UpMemory,      numGroups, static_cast<size_t> (coefficientsUp.size()));
+        v1Down    = AudioBlock<ProcessingType> (v1DownMemory,    numGroups, static_cast<size_t> (coefficientsDown.size()));
+        delayDown = AudioBlock<ProcessingType> (delayDownMemory, numGroups, 1);
     }
 
     //==============================================================================
@@ -304,12 +389,19 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         return latency;
     }
 
+    void initProcessing (size_t maximumNumberOfSamplesBeforeOversampling) override
+    {
+        ParentType::initProcessing (maximumNumberOfSamplesBeforeOversampling);
+
+        scratch = AudioBlock<ProcessingType> (scratchMemory, 2, maximumNumberOfSamplesBeforeOversampling * 2);
+    }
+
     void reset() override
     {
         ParentType::reset();
         v1Up.clear();
         v1Down.clear();
-        delayDown.fill (0);
+        delayDown.clear();
     }
 
     void processSamplesUp (const AudioBlock<const SampleType>& inputBlock) override
@@ -323,13 +415,17 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         auto delayedStages = numStages / 2;
         auto directStages = numStages - delayedStages;
         auto numSamples = inputBlock.getNumSamples();
+        auto numChannelsToProcess = inputBlock.getNumChannels();
+        auto outputBlock = AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numChannelsToProcess);
+
+        auto samples = scratch.getChannelPointer (0);
+        auto bufferSamples = scratch.getChannelPointer (1);
 
         // Processing
-        for (size_t channel = 0; channel < inputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group < Groups::getNumGroups (numChannelsToProcess); ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Up.getWritePointer (static_cast<int> (channel));
-            auto samples = inputBlock.getChannelPointer (channel);
+            auto lv1 = v1Up.getChannelPointer (group);
+            Groups::interleave (inputBlock, group, 0, 1, 1, samples, numSamples);
 
             for (size_t i = 0; i < numSamples; ++i)
             {
@@ -339,8 +435,8 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
                 for (auto n = 0; n < directStages; ++n)
                 {
                     auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
+                    auto output = input * alpha + lv1[n];
+                    lv1[n] = input - output * alpha;
                     input = output;
                 }
 
@@ -353,14 +449,16 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
                 for (auto n = directStages; n < numStages; ++n)
                 {
                     auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
+                    auto output = input * alpha + lv1[n];
+                    lv1[n] = input - output * alpha;
                     input = output;
                 }
 
                 // Output
                 bufferSamples[(i << 1) + 1] = input;
             }
+
+            Groups::deinterleave (bufferSamples, numSamples * 2, outputBlock, group);
         }
 
        #if JUCE_SNAP_TO_ZERO
@@ -379,14 +477,18 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
         auto delayedStages = numStages / 2;
         auto directStages = numStages - delayedStages;
         auto numSamples = outputBlock.getNumSamples();
+        auto numChannelsToProcess = outputBlock.getNumChannels();
+        auto inputBlock = AudioBlock<SampleType> (ParentType::buffer).getSubsetChannelBlock (0, numChannelsToProcess);
+
+        auto bufferSamples = scratch.getChannelPointer (0);
+        auto samples = scratch.getChannelPointer (1);
 
         // Processing
-        for (size_t channel = 0; channel < outputBlock.getNumChannels(); ++channel)
+        for (size_t group = 0; group < Groups::getNumGroups (numChannelsToProcess); ++group)
         {
-            auto bufferSamples = ParentType::buffer.getWritePointer (static_cast<int> (channel));
-            auto lv1 = v1Down.getWritePointer (static_cast<int> (channel));
-            auto samples = outputBlock.getChannelPointer (channel);
-            auto delay = delayDown.getUnchecked (static_cast<int> (channel));
+            auto lv1 = v1Down.getChannelPointer (group);
+            auto delay = *delayDown.getChannelPointer (group);
+            Groups::interleave (inputBlock, group, 0, 1, 1, bufferSamples, numSamples * 2);
 
             for (size_t i = 0; i < numSamples; ++i)
             {
@@ -396,8 +498,8 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
                 for (auto n = 0; n < directStages; ++n)
                 {
                     auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
+                    auto output = input * alpha + lv1[n];
+                    lv1[n] = input - output * alpha;
                     input = output;
                 }
 
@@ -409,8 +511,8 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
                 for (auto n = directStages; n < numStages; ++n)
                 {
                     auto alpha = coeffs[n];
-                    auto output = alpha * input + lv1[n];
-                    lv1[n] = input - alpha * output;
+                    auto output = input * alpha + lv1[n];
+                    lv1[n] = input - output * alpha;
                     input = output;
                 }
 
@@ -419,7 +521,8 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
                 delay = input;
             }
 
-            delayDown.setUnchecked (static_cast<int> (channel), delay);
+            *delayDown.getChannelPointer (group) = delay;
+            Groups::deinterleave (samples, numSamples, outputBlock, group);
         }
 
        #if JUCE_SNAP_TO_ZERO
@@ -429,27 +532,14 @@ struct Oversampling2TimesPolyphaseIIR  : public Oversampling<SampleType>::Oversa
 
     void snapToZero (bool snapUpProcessing)
     {
-        if (snapUpProcessing)
-        {
-            for (auto channel = 0; channel < ParentType::buffer.getNumChannels(); ++channel)
-            {
-                auto lv1 = v1Up.getWritePointer (channel);
-                auto numStages = coefficientsUp.size();
+        auto& state = snapUpProcessing ? v1Up : v1Down;
 
-                for (auto n = 0; n < numStages; ++n)
-                    util::snapToZero (lv1[n]);
-            }
-        }
-        else
+        for (size_t group = 0; group < state.getNumChannels(); ++group)
         {
-            for (auto channel = 0; channel < ParentType::buffer.getNumChannels(); ++channel)
-            {
-                auto lv1 = v1Down.getWritePointer (channel);
-                auto numStages = coefficientsDown.size();
+            auto lv1 = state.getChannelPointer (group);
 
-                for (auto n = 0; n < numStages; ++n)
-                    util::snapToZero (lv1[n]);
-            }
+            for (size_t n = 0; n < state.getNumSamples(); ++n)
+                util::snapToZero (lv1[n]);
         }
     }
 
@@ -520,14 +610,33 @@ private:
     Array<SampleType> coefficientsUp, coefficientsDown;
     SampleType latency;
 
-    AudioBuffer<SampleType> v1Up, v1Down;
-    Array<SampleType> delayDown;
+    HeapBlock<char> v1UpMemory, v1DownMemory, delayDownMemory, scratchMemory;
+    AudioBlock<ProcessingType> v1Up, v1Down, delayDown, scratch;
 
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (Oversampling2TimesPolyphaseIIR)
 };
 
 
+//==============================================================================
+template <typename SampleType, typename ProcessingType>
+typename Oversampling<SampleType>::OversamplingStage* createOversamplingStage (typename Oversampling<SampleType>::FilterType type,
+                                                                              size_t numChannels,
+                                                                              float normalisedTransitionWidthUp,
+                                                                              float stopbandAmplitudedBUp,
+                                                                              float normalisedTransitionWidthDown,
+                                                                              float stopbandAmplitudedBDown)
+{
+    if (type == Oversampling<SampleType>::FilterType::filterHalfBandPolyphaseIIR)
+        return new Oversampling2TimesPolyphaseIIR<SampleType, ProcessingType> (numChannels,
+                                                                               normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                                               normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+
+    return new Oversampling2TimesEquirippleFIR<SampleType, ProcessingType> (numChannels,
+                                                                            normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                                            normalisedTransitionWidthDown, stopbandAmplitudedBDown);
+}
+
 //==============================================================================
 template <typename SampleType>
 Oversampling<SampleType>::Oversampling (size_t newNumChannels)
@@ -606,15 +715,18 @@ void Oversampling<SampleType>::addOversamplingStage (FilterType type,
                                                      float normalisedTransitionWidthDown,
                                                      float stopbandAmplitudedBDown)
 {
-    if (type == FilterType::filterHalfBandPolyphaseIIR)
+   #if JUCE_USE_SIMD
+    // With more than one channel, several of them can be processed at once
+    if (numChannels > 1)
     {
-        stages.add (new Oversampling2TimesPolyphaseIIR<SampleType> (numChannels,
-                                                                    normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
-                                                                    normalisedTransitionWidthDown, stopbandAmplitudedBDown));
+        stages.add (createOversamplingStage<SampleType, SIMDRegister<SampleType>> (type, numChannels,
+                                                                                   normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
+                                                                                   normalisedTransitionWidthDown, stopbandAmplitudedBDown));
     }
     else
+   #endif
     {
-        stages.add (new Oversampling2TimesEquirippleFIR<SampleType> (numChannels,
+        stages.add (createOversamplingStage<SampleType, SampleType> (type, numChannels,
                                                                      normalisedTransitionWidthUp,   stopbandAmplitudedBUp,
                                                                      normalisedTransitionWidthDown, stopbandAmplitudedBDown));
     }
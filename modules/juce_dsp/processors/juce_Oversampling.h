@@ -47,6 +47,11 @@ namespace dsp
     latency is maximised. With IIR filtering the phase is compromised around the
     Nyquist frequency but the latency is minimised.
 
+    When there is more than one channel and SIMD is available, the channels are
+    interleaved and filtered in groups, as many at a time as fit in a
+    SIMDRegister. If you process fewer channels than the number this object was
+    created with, the unused channels of a group will be fed with silence.
+
     @see FilterDesign.
 
     @tags{DSP}
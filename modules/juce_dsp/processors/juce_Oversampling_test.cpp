@@ -0,0 +1,198 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class OversamplingTest : public UnitTest
+{
+public:
+    OversamplingTest()
+        : UnitTest ("Oversampling", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        for (auto useIIR : { false, true })
+        {
+            beginTest (String ("Processing channels together gives the same result as processing them separately, ")
+                         + (useIIR ? "IIR" : "FIR"));
+
+            testChannelsAreIndependent<float>  (useIIR);
+            testChannelsAreIndependent<double> (useIIR);
+        }
+
+        beginTest ("FIR processing matches a direct convolution with the half-band coefficients");
+
+        for (auto numChannels : { 1, 5 })
+        {
+            testMatchesReferenceConvolution<float>  ((size_t) numChannels, 1.0e-5);
+            testMatchesReferenceConvolution<double> ((size_t) numChannels, 1.0e-12);
+        }
+    }
+
+private:
+    template <typename SampleType>
+    void testMatchesReferenceConvolution (size_t numChannels, double tolerance)
+    {
+        constexpr size_t blockSize = 256;
+        const size_t blockSizes[] = { blockSize, 67, blockSize };
+
+        Oversampling<SampleType> oversampling (numChannels, 1, Oversampling<SampleType>::filterHalfBandFIREquiripple);
+        oversampling.initProcessing (blockSize);
+
+        // These are the parameters that the constructor uses for a single maximum quality stage
+        auto coefficientsUp   = FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (0.05f, -90.0f);
+        auto coefficientsDown = FilterDesign<SampleType>::designFIRLowpassHalfBandEquirippleMethod (0.06f, -75.0f);
+
+        auto convolve = [] (const std::vector<double>& signal, const FIR::Coefficients<SampleType>& coefficients, size_t index)
+        {
+            auto* fir = coefficients.getRawCoefficients();
+            auto result = 0.0;
+
+            for (size_t i = 0; i <= jmin (index, coefficients.getFilterOrder()); ++i)
+                result += (double) fir[i] * signal[index - i];
+
+            return result;
+        };
+
+        std::vector<std::vector<double>> zeroStuffedInputs (numChannels), upsampledOutputs (numChannels);
+        AudioBuffer<SampleType> buffer ((int) numChannels, (int) blockSize);
+        Random random (2749103);
+        size_t numProcessed = 0;
+
+        for (auto numSamples : blockSizes)
+        {
+            for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            {
+                for (size_t i = 0; i < numSamples; ++i)
+                {
+                    auto sample = static_cast<SampleType> (random.nextFloat() * 2.0f - 1.0f);
+                    buffer.setSample (channel, (int) i, sample);
+
+                    zeroStuffedInputs[(size_t) channel].push_back ((double) sample);
+                    zeroStuffedInputs[(size_t) channel].push_back (0.0);
+                }
+            }
+
+            auto block = AudioBlock<SampleType> (buffer).getSubBlock (0, numSamples);
+            auto upsampled = oversampling.processSamplesUp (block);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto& input = zeroStuffedInputs[channel];
+                auto& output = upsampledOutputs[channel];
+
+                // Every other input sample is a zero, so the output has to be doubled to keep the same level
+                for (size_t i = 0; i < upsampled.getNumSamples(); ++i)
+                {
+                    auto index = numProcessed * 2 + i;
+                    output.push_back ((double) upsampled.getSample ((int) channel, (int) i));
+
+                    expectWithinAbsoluteError (output[index], 2.0 * convolve (input, *coefficientsUp, index), tolerance);
+                }
+            }
+
+            oversampling.processSamplesDown (block);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+                for (size_t i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError ((double) block.getSample ((int) channel, (int) i),
+                                               convolve (upsampledOutputs[channel], *coefficientsDown, (numProcessed + i) * 2),
+                                               tolerance);
+
+            numProcessed += numSamples;
+        }
+    }
+
+    template <typename SampleType>
+    void testChannelsAreIndependent (bool useIIR)
+    {
+        auto filterType = useIIR ? Oversampling<SampleType>::filterHalfBandPolyphaseIIR
+                                 : Oversampling<SampleType>::filterHalfBandFIREquiripple;
+
+        constexpr size_t numChannels = 5, factor = 2, blockSize = 256;
+        const size_t blockSizes[] = { blockSize, 67, blockSize };
+
+        Oversampling<SampleType> multiChannel (numChannels, factor, filterType);
+        multiChannel.initProcessing (blockSize);
+
+        OwnedArray<Oversampling<SampleType>> singleChannels;
+
+        for (size_t channel = 0; channel < numChannels; ++channel)
+        {
+            singleChannels.add (new Oversampling<SampleType> (1, factor, filterType));
+            singleChannels.getLast()->initProcessing (blockSize);
+        }
+
+        AudioBuffer<SampleType> input ((int) numChannels, (int) blockSize), output ((int) numChannels, (int) blockSize);
+        Random random (8392829);
+
+        for (auto numSamples : blockSizes)
+        {
+            for (int channel = 0; channel < input.getNumChannels(); ++channel)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    input.setSample (channel, i, static_cast<SampleType> (random.nextFloat() * 2.0f - 1.0f));
+
+            auto inputBlock  = AudioBlock<SampleType> (input) .getSubBlock (0, numSamples);
+            auto outputBlock = AudioBlock<SampleType> (output).getSubBlock (0, numSamples);
+
+            auto upsampled = multiChannel.processSamplesUp (inputBlock);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto upsampledChannel = singleChannels.getUnchecked ((int) channel)
+                                          ->processSamplesUp (inputBlock.getSingleChannelBlock (channel));
+
+                for (size_t i = 0; i < upsampledChannel.getNumSamples(); ++i)
+                    expectWithinAbsoluteError (upsampledChannel.getSample (0, (int) i),
+                                               upsampled.getSample ((int) channel, (int) i),
+                                               static_cast<SampleType> (1.0e-6));
+
+                upsampledChannel.multiplyBy (static_cast<SampleType> (0.5));
+            }
+
+            upsampled.multiplyBy (static_cast<SampleType> (0.5));
+            multiChannel.processSamplesDown (outputBlock);
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto outputChannel = inputBlock.getSingleChannelBlock (channel);
+                singleChannels.getUnchecked ((int) channel)->processSamplesDown (outputChannel);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    expectWithinAbsoluteError (outputChannel.getSample (0, (int) i),
+                                               outputBlock.getSample ((int) channel, (int) i),
+                                               static_cast<SampleType> (1.0e-6));
+            }
+        }
+    }
+};
+
+static OversamplingTest oversamplingUnitTest;
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,128 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+SampleRateConverter::SampleRateConverter (SincResampler::Quality q)
+    : quality (q)
+{
+}
+
+void SampleRateConverter::setSpeedRatio (double inputSamplesPerOutputSample) noexcept
+{
+    jassert (inputSamplesPerOutputSample > 0);
+
+    // The pending input buffer is only big enough for the leftovers at this ratio
+    ratio = jmin (inputSamplesPerOutputSample, SincResampler::maximumSupportedSpeedRatio);
+}
+
+void SampleRateConverter::setSampleRates (double inputSampleRate, double outputSampleRate) noexcept
+{
+    jassert (inputSampleRate > 0 && outputSampleRate > 0);
+    setSpeedRatio (inputSampleRate / outputSampleRate);
+}
+
+int SampleRateConverter::getLatencyInSamples() const noexcept
+{
+    return resamplers.empty() ? 0 : resamplers.front().getLatencyInSamples();
+}
+
+int SampleRateConverter::getMaximumNumOutputSamples (int numInputSamples) const noexcept
+{
+    // allows for the input that was left over from the previous block
+    return (int) std::ceil ((numInputSamples + ratio + 1.0) / ratio) + 1;
+}
+
+//==============================================================================
+void SampleRateConverter::prepare (const ProcessSpec& spec)
+{
+    jassert (spec.numChannels > 0);
+
+    auto maxRatio = jmin (jmax (1.0, ratio), SincResampler::maximumSupportedSpeedRatio);
+
+    resamplers.clear();
+
+    for (uint32 i = 0; i < spec.numChannels; ++i)
+        resamplers.emplace_back (quality, maxRatio);
+
+    // The leftovers from one block can never be more than the input for a single output sample
+    pendingInput.setSize ((int) spec.numChannels,
+                          (int) spec.maximumBlockSize + (int) SincResampler::maximumSupportedSpeedRatio + 2);
+
+    reset();
+}
+
+void SampleRateConverter::reset() noexcept
+{
+    for (auto& r : resamplers)
+        r.reset();
+
+    numPending = 0;
+}
+
+int SampleRateConverter::process (const AudioBlock<const float>& input, const AudioBlock<float>& output) noexcept
+{
+    const auto numChannels = jmin ((int) resamplers.size(), (int) input.getNumChannels(), (int) output.getNumChannels());
+
+    jassert (numChannels == (int) resamplers.size()); // all the channels need to be processed together
+    jassert (numPending + (int) input.getNumSamples() <= pendingInput.getNumSamples()); // was prepare() called with a big enough block size?
+
+    // If the input block is too big, or earlier output blocks were too small to use up
+    // the input, whatever doesn't fit has to be dropped
+    const auto numInputSamples = jmin ((int) input.getNumSamples(), pendingInput.getNumSamples() - numPending);
+
+    if (numChannels == 0)
+        return 0;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        pendingInput.copyFrom (ch, numPending, input.getChannelPointer ((size_t) ch), numInputSamples);
+
+    numPending += numInputSamples;
+
+    auto numAvailable = resamplers.front().getNumOutputSamplesAvailable (ratio, numPending);
+    jassert (numAvailable <= (int) output.getNumSamples());
+
+    const auto numOutputSamples = jmin (numAvailable, (int) output.getNumSamples());
+    int numUsed = 0;
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        numUsed = resamplers[(size_t) ch].process (ratio, pendingInput.getReadPointer (ch),
+                                                   output.getChannelPointer ((size_t) ch), numOutputSamples);
+
+    numPending -= numUsed;
+
+    if (numPending > 0)
+        for (int ch = 0; ch < numChannels; ++ch)
+            memmove (pendingInput.getWritePointer (ch), pendingInput.getReadPointer (ch, numUsed),
+                     sizeof (float) * (size_t) numPending);
+
+    return numOutputSamples;
+}
+
+} // namespace dsp
+} // namespace juce
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+/**
+    A processor that converts multi-channel audio from one sample rate to another,
+    using a SincResampler for each channel.
+
+    Because the number of output samples for each block of input isn't fixed, this
+    doesn't use a ProcessContext. Instead, each call to process() takes a block of
+    input, and returns the number of samples that it wrote to the output block. Any
+    input that isn't needed yet is kept until the next call.
+
+    @see SincResampler
+
+    @tags{DSP}
+*/
+class JUCE_API  SampleRateConverter
+{
+public:
+    //==============================================================================
+    /** Creates a converter that uses the given quality of filter. */
+    explicit SampleRateConverter (SincResampler::Quality quality = SincResampler::Quality::high);
+
+    //==============================================================================
+    /** Sets the ratio of the input sample rate to the output sample rate.
+
+        This can be changed while processing, but ratios that are higher than the one
+        that was set when prepare() was called may alias slightly. Ratios above
+        SincResampler::maximumSupportedSpeedRatio are clamped to it.
+    */
+    void setSpeedRatio (double inputSamplesPerOutputSample) noexcept;
+
+    /** Sets the speed ratio from a pair of sample rates. */
+    void setSampleRates (double inputSampleRate, double outputSampleRate) noexcept;
+
+    /** Returns the ratio of the input sample rate to the output sample rate. */
+    double getSpeedRatio() const noexcept                   { return ratio; }
+
+    /** Returns the latency of the conversion, in input samples. */
+    int getLatencyInSamples() const noexcept;
+
+    /** Returns the largest number of samples that a call to process() may write,
+        for a given number of input samples.
+    */
+    int getMaximumNumOutputSamples (int numInputSamples) const noexcept;
+
+    //==============================================================================
+    /** Initialises the processor.
+
+        The maximumBlockSize is the largest number of input samples that will be
+        passed to process().
+    */
+    void prepare (const ProcessSpec& spec);
+
+    /** Resets the internal state of the processor. */
+    void reset() noexcept;
+
+    /** Converts a block of input.
+
+        The output block must be able to hold getMaximumNumOutputSamples() samples. If
+        it's smaller, the input that it doesn't have room for is kept, but anything that
+        won't fit in the space that prepare() allocated is thrown away.
+
+        @returns the number of samples that were written to the output block
+    */
+    int process (const AudioBlock<const float>& input, const AudioBlock<float>& output) noexcept;
+
+private:
+    //==============================================================================
+    SincResampler::Quality quality;
+    double ratio = 1.0;
+    std::vector<SincResampler> resamplers;
+    AudioBuffer<float> pendingInput;
+    int numPending = 0;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SampleRateConverter)
+};
+
+} // namespace dsp
+} // namespace juce
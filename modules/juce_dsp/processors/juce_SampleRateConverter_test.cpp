@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+   This file is part of the JUCE library.
+   Copyright (c) 2020 - Raw Material Software Limited
+
+   JUCE is an open source library subject to commercial or open-source
+   licensing.
+
+   By using JUCE, you agree to the terms of both the JUCE 6 End-User License
+   Agreement and JUCE Privacy Policy (both effective as of the 16th June 2020).
+
+   End User License Agreement: www.juce.com/juce-6-licence
+   Privacy Policy: www.juce.com/juce-privacy-policy
+
+   Or: You may also use this code under the terms of the GPL v3 (see
+   www.gnu.org/licenses).
+
+   JUCE IS PROVIDED "AS IS" WITHOUT ANY WARRANTY, AND ALL WARRANTIES, WHETHER
+   EXPRESSED OR IMPLIED, INCLUDING MERCHANTABILITY AND FITNESS FOR PURPOSE, ARE
+   DISCLAIMED.
+
+  ==============================================================================
+*/
+
+namespace juce
+{
+namespace dsp
+{
+
+class SampleRateConverterTests  : public UnitTest
+{
+public:
+    SampleRateConverterTests()
+        : UnitTest ("SampleRateConverter", UnitTestCategories::dsp) {}
+
+    void runTest() override
+    {
+        beginTest ("Converting in blocks matches a resampler for each channel");
+        {
+            auto random = getRandom();
+            AudioBuffer<float> input (2, 20000);
+
+            for (int ch = 0; ch < input.getNumChannels(); ++ch)
+                for (int i = 0; i < input.getNumSamples(); ++i)
+                    input.setSample (ch, i, random.nextFloat() * 2.0f - 1.0f);
+
+            for (auto ratio : { 44100.0 / 48000.0, 48000.0 / 44100.0, 0.25, 3.0 })
+            {
+                auto expected = resampleEachChannel (input, ratio);
+
+                for (auto maximumBlockSize : { 1, 64, 1000 })
+                {
+                    expect (matches (convert (input, ratio, maximumBlockSize, nullptr), expected));
+                    expect (matches (convert (input, ratio, maximumBlockSize, &random), expected));
+                }
+            }
+        }
+
+        beginTest ("Ratios are limited to the largest one that a resampler supports");
+        {
+            SampleRateConverter converter;
+            converter.setSpeedRatio (100.0);
+            expectEquals (converter.getSpeedRatio(), SincResampler::maximumSupportedSpeedRatio);
+
+            converter.setSampleRates (8000.0, 48000.0);
+            expectEquals (converter.getSpeedRatio(), 1.0 / 6.0);
+        }
+    }
+
+private:
+    static constexpr auto quality = SincResampler::Quality::medium;
+
+    // Feeds the input through a converter in blocks of up to maximumBlockSize samples, which
+    // are a random size if a Random is given
+    static AudioBuffer<float> convert (const AudioBuffer<float>& input, double ratio,
+                                       int maximumBlockSize, Random* random)
+    {
+        SampleRateConverter converter (quality);
+        converter.setSpeedRatio (ratio);
+        converter.prepare ({ 44100.0, (uint32) maximumBlockSize, (uint32) input.getNumChannels() });
+
+        AudioBuffer<float> output (input.getNumChannels(), converter.getMaximumNumOutputSamples (input.getNumSamples()));
+        int numIn = 0, numOut = 0;
+
+        while (numIn < input.getNumSamples())
+        {
+            auto numToDo = jmin (input.getNumSamples() - numIn,
+                                 random != nullptr ? random->nextInt (maximumBlockSize) + 1 : maximumBlockSize);
+
+            auto inputBlock = AudioBlock<const float> (input).getSubBlock ((size_t) numIn, (size_t) numToDo);
+            auto outputBlock = AudioBlock<float> (output).getSubBlock ((size_t) numOut,
+                                                                       (size_t) converter.getMaximumNumOutputSamples (numToDo));
+
+            numIn += numToDo;
+            numOut += converter.process (inputBlock, outputBlock);
+        }
+
+        output.setSize (output.getNumChannels(), numOut, true);
+        return output;
+    }
+
+    static AudioBuffer<float> resampleEachChannel (const AudioBuffer<float>& input, double ratio)
+    {
+        SincResampler resampler (quality, jmax (1.0, ratio));
+        AudioBuffer<float> output (input.getNumChannels(),
+                                   resampler.getNumOutputSamplesAvailable (ratio, input.getNumSamples()));
+
+        for (int ch = 0; ch < input.getNumChannels(); ++ch)
+        {
+            resampler.reset();
+            resampler.process (ratio, input.getReadPointer (ch), output.getWritePointer (ch), output.getNumSamples());
+        }
+
+        return output;
+    }
+
+    static bool matches (const AudioBuffer<float>& a, const AudioBuffer<float>& b)
+    {
+        if (a.getNumChannels() != b.getNumChannels() || a.getNumSamples() != b.getNumSamples())
+            return false;
+
+        for (int ch = 0; ch < a.getNumChannels(); ++ch)
+            if (! std::equal (a.getReadPointer (ch), a.getReadPointer (ch) + a.getNumSamples(), b.getReadPointer (ch)))
+                return false;
+
+        return true;
+    }
+};
+
+static SampleRateConverterTests sampleRateConverterTests;
+
+} // namespace dsp
+} // namespace juce